@@ -1,6 +1,7 @@
 #!/bin/bash
 
 PROFILING="OFF"
+PROFILE_FLAG=""
 CLEAN=""
 DEVICE_TYPE=""
 MODEL_TYPE=TNN
@@ -107,7 +108,7 @@ function bench_armlinux() {
 
         for benchmark_model in ${benchmark_model_list[*]}
         do
-            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
+            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest ${PROFILE_FLAG} -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
         done
     fi
 
@@ -121,7 +122,7 @@ function bench_armlinux() {
         echo "benchmark device: ${device} " >> $WORK_DIR/$OUTPUT_LOG_FILE
         for benchmark_model in ${benchmark_model_list[*]}
         do
-            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
+            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest ${PROFILE_FLAG} -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
         done
     fi
 
@@ -150,6 +151,7 @@ while [ "$1" != "" ]; do
         -f)
             shift
             PROFILING="ON"
+            PROFILE_FLAG="-pf"
             ;;
         -t)
             shift
@@ -0,0 +1,483 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "test/test_utils.h"
+#include "tnn/core/common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/mat.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+static const char model_dir_message[] = "tnnproto file or directory of tnnproto files, the weights are random";
+
+static const char device_type_message[] = "devices to sweep, comma separated: NAIVE, ARM, X86 (default ARM)";
+
+static const char precision_message[] = "precisions to sweep, comma separated: AUTO, HIGH, NORMAL, LOW (default AUTO)";
+
+static const char thread_num_message[] = "cpu thread numbers to sweep, comma separated (default 1)";
+
+static const char batch_message[] = "batch sizes to sweep, comma separated (default 1)";
+
+static const char warm_up_count_message[] = "warm up count of each config (default 5)";
+
+static const char iterations_count_message[] = "measured iterations of each config (default 20)";
+
+static const char output_path_message[] = "json result path (default benchmark_result.json)";
+
+static const char baseline_path_message[] = "json result of a previous run to compare with";
+
+static const char threshold_message[] =
+    "regression threshold of p50 latency and peak rss relative to the baseline (default 0.1)";
+
+DEFINE_bool(h, false, "print a usage message.");
+
+DEFINE_string(md, "", model_dir_message);
+
+DEFINE_string(dt, "ARM", device_type_message);
+
+DEFINE_string(pr, "AUTO", precision_message);
+
+DEFINE_string(th, "1", thread_num_message);
+
+DEFINE_string(bs, "1", batch_message);
+
+DEFINE_int32(wc, 5, warm_up_count_message);
+
+DEFINE_int32(ic, 20, iterations_count_message);
+
+DEFINE_string(op, "benchmark_result.json", output_path_message);
+
+DEFINE_string(bl, "", baseline_path_message);
+
+DEFINE_double(rt, 0.1, threshold_message);
+
+namespace TNN_NS {
+
+namespace benchmark {
+
+    struct BenchmarkResult {
+        std::string model     = "";
+        std::string device    = "";
+        std::string precision = "";
+        int threads           = 1;
+        int batch             = 1;
+        std::string status    = "ok";
+
+        double init_ms     = 0;
+        double min_ms      = 0;
+        double mean_ms     = 0;
+        double p50_ms      = 0;
+        double p90_ms      = 0;
+        double p99_ms      = 0;
+        double max_ms      = 0;
+        double throughput  = 0;
+        double peak_rss_mb = 0;
+
+        std::string Key() const {
+            std::ostringstream ostr;
+            ostr << model << " " << device << " " << precision << " th" << threads << " bs" << batch;
+            return ostr.str();
+        }
+    };
+
+    static std::vector<std::string> SplitList(const std::string& str) {
+        std::vector<std::string> items;
+        std::istringstream istr(str);
+        std::string item;
+        while (std::getline(istr, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    static double NowMs() {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(now).count();
+    }
+
+    static std::vector<std::string> ListModels(const std::string& path) {
+        std::vector<std::string> models;
+        const std::string suffix = ".tnnproto";
+        DIR* dir                 = opendir(path.c_str());
+        if (!dir) {
+            models.push_back(path);
+            return models;
+        }
+        while (auto entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.size() > suffix.size() && name.substr(name.size() - suffix.size()) == suffix) {
+                models.push_back(path + "/" + name);
+            }
+        }
+        closedir(dir);
+        std::sort(models.begin(), models.end());
+        return models;
+    }
+
+    static std::string GetModelName(const std::string& path) {
+        auto name = path.substr(path.find_last_of('/') + 1);
+        return name.substr(0, name.find_last_of('.'));
+    }
+
+    // reset the peak resident set to the current one, so VmHWM excludes the memory released before
+    static void ResetPeakRss() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        if (clear_refs.is_open()) {
+            clear_refs << "5";
+        }
+    }
+
+    static double GetPeakRssMB() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) {
+                return atof(line.substr(6).c_str()) / 1024.0;
+            }
+        }
+        return 0;
+    }
+
+    // nearest rank percentile of sorted values
+    static double Percentile(const std::vector<double>& sorted, double percent) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        int rank = (int)std::ceil(percent / 100.0 * sorted.size());
+        return sorted[std::min(std::max(rank, 1), (int)sorted.size()) - 1];
+    }
+
+    static std::shared_ptr<Instance> CreateInstance(TNN& net, const std::string& proto, NetworkConfig& config,
+                                                    InputShapesMap shapes, Status& status) {
+        ModelConfig model_config;
+        model_config.model_type = MODEL_TYPE_TNN;
+        // empty model content, weights are generated randomly in benchmark mode
+        model_config.params = {proto, ""};
+        status              = net.Init(model_config);
+        if (status != TNN_OK) {
+            return nullptr;
+        }
+        return net.CreateInst(config, status, shapes);
+    }
+
+    static Status SetRandomInputs(std::shared_ptr<Instance> instance) {
+        BlobMap input_blobs;
+        RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+        for (auto iter : input_blobs) {
+            auto dims = iter.second->GetBlobDesc().dims;
+            auto mat  = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dims);
+            auto data = reinterpret_cast<float*>(mat->GetData());
+            int count = DimsVectorUtils::Count(dims);
+            for (int i = 0; i < count; i++) {
+                data[i] = (float)(rand() % 256 - 128) / 128.0f;
+            }
+            RETURN_ON_NEQ(instance->SetInputMat(mat, MatConvertParam(), iter.first), TNN_OK);
+        }
+        return TNN_OK;
+    }
+
+    static Status Run(const std::string& proto, BenchmarkResult& result) {
+        NetworkConfig config;
+        config.device_type = ConvertDeviceType(result.device);
+        config.precision   = ConvertPrecision(result.precision);
+
+        // the input shapes of other batch sizes are derived from the model
+        InputShapesMap shapes;
+        if (result.batch > 1) {
+            TNN net;
+            Status status;
+            auto instance = CreateInstance(net, proto, config, InputShapesMap(), status);
+            RETURN_ON_NEQ(status, TNN_OK);
+            BlobMap input_blobs;
+            instance->GetAllInputBlobs(input_blobs);
+            for (auto iter : input_blobs) {
+                auto dims          = iter.second->GetBlobDesc().dims;
+                dims[0]            = result.batch;
+                shapes[iter.first] = dims;
+            }
+        }
+
+        ResetPeakRss();
+        double init_start = NowMs();
+        TNN net;
+        Status status;
+        auto instance = CreateInstance(net, proto, config, shapes, status);
+        RETURN_ON_NEQ(status, TNN_OK);
+        RETURN_ON_NEQ(instance->SetCpuNumThreads(result.threads), TNN_OK);
+        result.init_ms = NowMs() - init_start;
+
+        RETURN_ON_NEQ(SetRandomInputs(instance), TNN_OK);
+        for (int i = 0; i < FLAGS_wc; i++) {
+            RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+        }
+
+        std::vector<double> latencies;
+        for (int i = 0; i < FLAGS_ic; i++) {
+            double start = NowMs();
+            RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+            latencies.push_back(NowMs() - start);
+        }
+        result.peak_rss_mb = GetPeakRssMB();
+
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0;
+        for (auto latency : latencies) {
+            sum += latency;
+        }
+        result.min_ms     = latencies.front();
+        result.max_ms     = latencies.back();
+        result.mean_ms    = sum / latencies.size();
+        result.p50_ms     = Percentile(latencies, 50);
+        result.p90_ms     = Percentile(latencies, 90);
+        result.p99_ms     = Percentile(latencies, 99);
+        result.throughput = result.mean_ms > 0 ? result.batch * 1000.0 / result.mean_ms : 0;
+        return TNN_OK;
+    }
+
+    // one result per line, so that a baseline can be read back line by line
+    static std::string ToJson(const BenchmarkResult& result) {
+        std::ostringstream ostr;
+        ostr.setf(std::ios::fixed);
+        ostr.precision(3);
+        ostr << "{\"model\":\"" << result.model << "\",\"device\":\"" << result.device << "\",\"precision\":\""
+             << result.precision << "\",\"threads\":" << result.threads << ",\"batch\":" << result.batch
+             << ",\"status\":\"" << result.status << "\",\"init_ms\":" << result.init_ms
+             << ",\"min_ms\":" << result.min_ms << ",\"mean_ms\":" << result.mean_ms
+             << ",\"p50_ms\":" << result.p50_ms << ",\"p90_ms\":" << result.p90_ms << ",\"p99_ms\":" << result.p99_ms
+             << ",\"max_ms\":" << result.max_ms << ",\"throughput\":" << result.throughput
+             << ",\"peak_rss_mb\":" << result.peak_rss_mb << "}";
+        return ostr.str();
+    }
+
+    static std::string GetJsonValue(const std::string& line, const std::string& key) {
+        auto pos = line.find("\"" + key + "\":");
+        if (pos == std::string::npos) {
+            return "";
+        }
+        pos += key.size() + 3;
+        if (line[pos] == '"') {
+            return line.substr(pos + 1, line.find('"', pos + 1) - pos - 1);
+        }
+        return line.substr(pos, line.find_first_of(",}", pos) - pos);
+    }
+
+    static BenchmarkResult FromJson(const std::string& line) {
+        BenchmarkResult result;
+        result.model       = GetJsonValue(line, "model");
+        result.device      = GetJsonValue(line, "device");
+        result.precision   = GetJsonValue(line, "precision");
+        result.threads     = atoi(GetJsonValue(line, "threads").c_str());
+        result.batch       = atoi(GetJsonValue(line, "batch").c_str());
+        result.status      = GetJsonValue(line, "status");
+        result.init_ms     = atof(GetJsonValue(line, "init_ms").c_str());
+        result.min_ms      = atof(GetJsonValue(line, "min_ms").c_str());
+        result.mean_ms     = atof(GetJsonValue(line, "mean_ms").c_str());
+        result.p50_ms      = atof(GetJsonValue(line, "p50_ms").c_str());
+        result.p90_ms      = atof(GetJsonValue(line, "p90_ms").c_str());
+        result.p99_ms      = atof(GetJsonValue(line, "p99_ms").c_str());
+        result.max_ms      = atof(GetJsonValue(line, "max_ms").c_str());
+        result.throughput  = atof(GetJsonValue(line, "throughput").c_str());
+        result.peak_rss_mb = atof(GetJsonValue(line, "peak_rss_mb").c_str());
+        return result;
+    }
+
+    static std::map<std::string, BenchmarkResult> LoadBaseline(const std::string& path) {
+        std::map<std::string, BenchmarkResult> baseline;
+        std::ifstream stream(path);
+        std::string line;
+        while (std::getline(stream, line)) {
+            if (line.find("\"model\":") != std::string::npos) {
+                auto result            = FromJson(line);
+                baseline[result.Key()] = result;
+            }
+        }
+        return baseline;
+    }
+
+    /*
+     * Each config runs in a forked process, so that the peak rss is not raised by the previous configs and
+     * a crash of one config does not stop the sweep. The result is sent back as a json line through a pipe.
+     */
+    static void RunIsolated(const std::string& proto, BenchmarkResult& result) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            result.status = "failed";
+            return;
+        }
+        // flush before fork, or the buffered output is printed by both processes
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            Status status = Run(proto, result);
+            if (status != TNN_OK) {
+                result.status = "failed";
+                printf("%s failed: %s\n", result.Key().c_str(), status.description().c_str());
+            }
+            fflush(stdout);
+            auto json = ToJson(result) + "\n";
+            if (write(fds[1], json.c_str(), json.size()) != (ssize_t)json.size()) {
+                _exit(1);
+            }
+            close(fds[1]);
+            _exit(0);
+        }
+
+        close(fds[1]);
+        std::string json;
+        char buffer[1024];
+        ssize_t size = 0;
+        while (pid > 0 && (size = read(fds[0], buffer, sizeof(buffer))) > 0) {
+            json.append(buffer, size);
+        }
+        close(fds[0]);
+        int child_status = 0;
+        if (pid > 0) {
+            waitpid(pid, &child_status, 0);
+        }
+        if (json.empty()) {
+            result.status = "crashed";
+            printf("%s crashed\n", result.Key().c_str());
+        } else {
+            result = FromJson(json);
+        }
+    }
+
+    // return the number of regressions
+    static int CompareBaseline(const std::vector<BenchmarkResult>& results, const std::string& path) {
+        auto baseline = LoadBaseline(path);
+        if (baseline.empty()) {
+            printf("baseline %s is empty or not found\n", path.c_str());
+            return 0;
+        }
+
+        int regressions = 0;
+        printf("\n%-56s %12s %12s %8s %12s %12s %8s\n", "config", "base p50", "p50", "diff", "base rss", "rss",
+               "diff");
+        for (auto& result : results) {
+            if (baseline.count(result.Key()) == 0 || result.status != "ok" || baseline[result.Key()].status != "ok") {
+                continue;
+            }
+            auto& base         = baseline[result.Key()];
+            double p50_diff    = base.p50_ms > 0 ? result.p50_ms / base.p50_ms - 1 : 0;
+            double rss_diff    = base.peak_rss_mb > 0 ? result.peak_rss_mb / base.peak_rss_mb - 1 : 0;
+            bool is_regression = p50_diff > FLAGS_rt || rss_diff > FLAGS_rt;
+            regressions += is_regression ? 1 : 0;
+            printf("%-56s %12.3f %12.3f %+7.1f%% %12.1f %12.1f %+7.1f%% %s\n", result.Key().c_str(), base.p50_ms,
+                   result.p50_ms, p50_diff * 100, base.peak_rss_mb, result.peak_rss_mb, rss_diff * 100,
+                   is_regression ? "REGRESSION" : "");
+        }
+        printf("%d regressions over threshold %.1f%%\n", regressions, FLAGS_rt * 100);
+        return regressions;
+    }
+
+    static void ShowUsage() {
+        printf("TNNBenchmark [OPTION]\n");
+        printf("    -h                      \t%s\n", "print a usage message.");
+        printf("    -md \"<model dir>\"       \t%s\n", model_dir_message);
+        printf("    -dt \"<devices>\"         \t%s\n", device_type_message);
+        printf("    -pr \"<precisions>\"      \t%s\n", precision_message);
+        printf("    -th \"<threads>\"         \t%s\n", thread_num_message);
+        printf("    -bs \"<batch sizes>\"     \t%s\n", batch_message);
+        printf("    -wc \"<warm up count>\"   \t%s\n", warm_up_count_message);
+        printf("    -ic \"<iterations>\"      \t%s\n", iterations_count_message);
+        printf("    -op \"<output path>\"     \t%s\n", output_path_message);
+        printf("    -bl \"<baseline path>\"   \t%s\n", baseline_path_message);
+        printf("    -rt \"<threshold>\"       \t%s\n", threshold_message);
+    }
+
+    int Run(int argc, char* argv[]) {
+        gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+        if (FLAGS_h || FLAGS_md.empty() || FLAGS_ic <= 0) {
+            ShowUsage();
+            return FLAGS_h ? 0 : -1;
+        }
+
+        srand(102);
+        std::vector<BenchmarkResult> results;
+        for (auto model_path : ListModels(FLAGS_md)) {
+            std::ifstream proto_stream(model_path);
+            if (!proto_stream.is_open() || !proto_stream.good()) {
+                printf("read proto file %s failed\n", model_path.c_str());
+                continue;
+            }
+            std::string proto((std::istreambuf_iterator<char>(proto_stream)), std::istreambuf_iterator<char>());
+
+            for (auto device : SplitList(FLAGS_dt)) {
+                for (auto precision : SplitList(FLAGS_pr)) {
+                    for (auto threads : SplitList(FLAGS_th)) {
+                        for (auto batch : SplitList(FLAGS_bs)) {
+                            BenchmarkResult result;
+                            result.model     = GetModelName(model_path);
+                            result.device    = device;
+                            result.precision = precision;
+                            result.threads   = std::max(atoi(threads.c_str()), 1);
+                            result.batch     = std::max(atoi(batch.c_str()), 1);
+
+                            RunIsolated(proto, result);
+                            if (result.status == "ok") {
+                                printf("%-56s init %9.3f ms  p50 %9.3f ms  p90 %9.3f ms  p99 %9.3f ms  %8.2f/s  "
+                                       "rss %7.1f MB\n",
+                                       result.Key().c_str(), result.init_ms, result.p50_ms, result.p90_ms,
+                                       result.p99_ms, result.throughput, result.peak_rss_mb);
+                            }
+                            results.push_back(result);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::ofstream output(FLAGS_op);
+        output << "{\"warm_up_count\":" << FLAGS_wc << ",\"iterations\":" << FLAGS_ic << ",\"results\":[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            output << ToJson(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        output << "]}\n";
+        output.close();
+        printf("result is saved to %s\n", FLAGS_op.c_str());
+
+        if (!FLAGS_bl.empty() && CompareBaseline(results, FLAGS_bl) > 0) {
+            return 1;
+        }
+        return 0;
+    }
+
+}  // namespace benchmark
+
+}  // namespace TNN_NS
+
+int main(int argc, char* argv[]) {
+    return TNN_NS::benchmark::Run(argc, argv);
+}
@@ -0,0 +1,137 @@
+#!/bin/bash
+
+CLEAN=""
+OPENMP="ON"
+DEVICES="ARM"
+PRECISIONS="AUTO"
+THREADS="1"
+BATCHES="1"
+BASELINE=""
+THRESHOLD=0.1
+
+if [ -z $TNN_ROOT_PATH ]
+then
+    TNN_ROOT_PATH=$(cd `dirname $0`; pwd)/../..
+fi
+
+WORK_DIR=`pwd`
+BENCHMARK_MODEL_DIR=$WORK_DIR/../benchmark-model
+BUILD_DIR=build
+OUTPUT_FILE=benchmark_models_result.json
+LOOP_COUNT=16
+WARM_UP_COUNT=8
+
+function usage() {
+    echo "usage: ./benchmark_models.sh  [-c] [-b] [-d] <devices> [-p] <precisions> [-t] <threads> [-n] <batches> [-r] <baseline>"
+    echo "options:"
+    echo "        -c    Clean up build folders."
+    echo "        -b    build targets only"
+    echo "        -d    devices to sweep, comma separated, eg: ARM,NAIVE (default ARM)"
+    echo "        -p    precisions to sweep, comma separated, eg: AUTO,HIGH,LOW (default AUTO)"
+    echo "        -t    thread numbers to sweep, comma separated, eg: 1,4 (default 1)"
+    echo "        -n    batch sizes to sweep, comma separated, eg: 1,8 (default 1)"
+    echo "        -r    baseline json to compare with, exit with 1 if p50 latency or peak rss regresses"
+    echo "        -s    regression threshold relative to the baseline (default 0.1)"
+}
+
+function exit_with_msg() {
+    echo $1
+    exit 1
+}
+
+function clean_build() {
+    echo $1 | grep "$BUILD_DIR\b" > /dev/null
+    if [[ "$?" != "0" ]]; then
+        exit_with_msg "Warnning: $1 seems not to be a BUILD folder."
+    fi
+    rm -rf $1
+    mkdir $1
+}
+
+function build_linux_bench() {
+    if [ "-c" == "$CLEAN" ]; then
+        clean_build $BUILD_DIR
+    fi
+    mkdir -p build
+    cd $BUILD_DIR
+    cmake ${TNN_ROOT_PATH} \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DTNN_CPU_ENABLE=ON \
+        -DTNN_ARM_ENABLE=ON \
+        -DTNN_OPENMP_ENABLE:BOOL=$OPENMP \
+        -DTNN_TEST_ENABLE=ON \
+        -DTNN_UNIT_TEST_ENABLE=OFF \
+        -DTNN_BUILD_SHARED=ON \
+        -DTNN_BENCHMARK_MODE=ON
+
+    make -j4 TNNBenchmark
+}
+
+function bench_linux() {
+    build_linux_bench
+    if [ $? != 0 ];then
+        exit_with_msg "build failed"
+    fi
+
+    if [ "" != "$BUILD_ONLY" ]; then
+        echo "build done!"
+        exit 0
+    fi
+
+    BASELINE_FLAG=""
+    if [ "" != "$BASELINE" ]; then
+        BASELINE_FLAG="-bl $BASELINE -rt $THRESHOLD"
+    fi
+
+    cd ${WORK_DIR}
+    ./build/benchmark/benchmark_linux/TNNBenchmark -md ${BENCHMARK_MODEL_DIR} -dt ${DEVICES} -pr ${PRECISIONS} \
+        -th ${THREADS} -bs ${BATCHES} -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -op ${OUTPUT_FILE} ${BASELINE_FLAG}
+}
+
+while [ "$1" != "" ]; do
+    case $1 in
+        -c)
+            shift
+            CLEAN="-c"
+            ;;
+        -b)
+            shift
+            BUILD_ONLY="-b"
+            ;;
+        -d)
+            shift
+            DEVICES="$1"
+            shift
+            ;;
+        -p)
+            shift
+            PRECISIONS="$1"
+            shift
+            ;;
+        -t)
+            shift
+            THREADS="$1"
+            shift
+            ;;
+        -n)
+            shift
+            BATCHES="$1"
+            shift
+            ;;
+        -r)
+            shift
+            BASELINE=`realpath $1`
+            shift
+            ;;
+        -s)
+            shift
+            THRESHOLD="$1"
+            shift
+            ;;
+        *)
+            usage
+            exit 1
+    esac
+done
+
+bench_linux
@@ -142,6 +142,15 @@ struct PUBLIC NetworkConfig {
 
     // cache path to store possible cache models
     std::string cache_path = "";
+
+    // numa node to run on, -1: not bound. the forward threads are pinned to the cpus of the node, the blob
+    // memory and packed weights are allocated on it, and the weights are replicated once per node.
+    int numa_node = -1;
+
+    // weight only quantized models (int8/int4 weights with float scales): the weights are dequantized to float
+    // when the layers are initialized. true to keep them quantized for the layers able to dequantize them in
+    // the kernel (arm InnerProduct), reading 4x less weight memory in each forward.
+    bool keep_quantized_weights = false;
 };
 
 struct PUBLIC ModelConfig {
@@ -155,6 +164,12 @@ struct PUBLIC ModelConfig {
     // hiai model need two params: order is model name, model_file_path.
     // atlas model need one param: config string.
     std::vector<std::string> params = {};
+
+    // tnn model only: index the layer resources in model file first, and
+    // deserialize each of them when the layer is initialized. params[1] is
+    // the path of the model file instead of the model content. resources whose
+    // weights are packed by the layer acc are released after init.
+    bool lazy_load_resource = false;
 };
 
 }  // namespace TNN_NS
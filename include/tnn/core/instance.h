@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "tnn/core/blob.h"
@@ -32,6 +33,7 @@ namespace TNN_NS {
 
 class AbstractNetwork;
 class AbstractModelInterpreter;
+class ProfileResult;
 
 struct LayerInfo;
 
@@ -61,6 +63,15 @@ public:
     //  will result in undefined behavior.
     Status SetForwardMemory(void* memory);
 
+    //  bind memory allocated by the user to an input or output blob, so the blob data is
+    //  read from or written to the memory directly without copy. data_format must be the
+    //  data format of the blob, and bytes_size must cover the memory the device requires
+    //  for the blob, including alignment and padding (e.g. ARM: NC4HW4, 32 bytes aligned).
+    //  the first binding of a blob replans the forward memory, instance created with
+    //  SHARE_MEMORY_MODE_SET_FROM_EXTERNAL must call SetForwardMemory again after it.
+    //  bind again after Reshape if the blob grows.
+    Status BindBlobMemory(const std::string& blob_name, void* data, int bytes_size, DataFormat data_format);
+
     // reshape instance with new input shapes
     Status Reshape(const InputShapesMap& inputs);
 
@@ -70,6 +81,16 @@ public:
     // @brief tnn instance network infer, it will wait until all layer infer complete.
     Status Forward();
 
+    // @brief tnn instance network infer, only the layers required by output_names are computed.
+    // output_names must be output blobs of the instance, see TNN::AddOutput. data of other
+    // output blobs is left unchanged.
+    Status ForwardPartial(const std::set<std::string>& output_names);
+
+    // @brief plan the blob memory for the layers required by output_names only, which saves the
+    // memory of the other layers. Forward fails and ForwardPartial only takes subsets of output_names
+    // until it is called with empty output_names. the data of the blobs is lost, set the inputs after it.
+    Status SetPartialOutputs(const std::set<std::string>& output_names);
+
 #ifdef FORWARD_CALLBACK_ENABLE
     // tnn instance network infer with callback to get blob info
     Status ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after);
@@ -87,17 +108,21 @@ public:
 
     // set threads run on cpu
     virtual Status SetCpuNumThreads(int num_threads);
-#if TNN_PROFILE
+
 public:
-    /**start to profile each layer, dont call this func if you only want to profile the whole mode*/
-    void StartProfile();
+    /**start to profile each layer, dont call this func if you only want to profile the whole mode.
+     * hardware_counters: also capture the cpu counters of each layer with perf_event_open on linux,
+     * call it after SetCpuNumThreads as the counters are opened on each cpu thread */
+    void StartProfile(bool hardware_counters = false);
     /**finish profile each layer and show result*/
     std::string FinishProfile(bool do_print = false);
-#endif
+    /**timeline of the last finished profile in chrome trace json, open it in chrome://tracing*/
+    std::string GetProfileTrace();
 
 private:
     std::shared_ptr<AbstractModelInterpreter> interpreter_;
     std::shared_ptr<AbstractNetwork> network_;
+    std::shared_ptr<ProfileResult> profile_result_;
     NetworkConfig net_config_;
     ModelConfig model_config_;
     
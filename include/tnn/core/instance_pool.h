@@ -0,0 +1,158 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_CORE_INSTANCE_POOL_H_
+#define TNN_INCLUDE_TNN_CORE_INSTANCE_POOL_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+#include "tnn/core/tnn.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+struct PUBLIC InstancePoolConfig {
+    // number of warm instances
+    int num_instances = 1;
+
+    // cpus split into num_instances disjoint sets of the same size, one set for each instance.
+    // the instance runs size / num_instances threads pinned to its set. empty: no affinity
+    std::vector<int> cpu_list;
+
+    // number of forward memory arenas shared by the instances, instance i uses arena i % num_arenas
+    // and the instances of one arena are never leased at the same time.
+    // 0: each instance owns its forward memory
+    int num_arenas = 0;
+};
+
+struct PUBLIC InstancePoolStats {
+    int num_instances = 0;
+    // instances leased now
+    int num_leased = 0;
+    // callers waiting for an instance now
+    int num_waiting = 0;
+
+    long long num_leases   = 0;
+    long long num_timeouts = 0;
+
+    // time spent in Acquire
+    double total_wait_ms = 0;
+    double max_wait_ms   = 0;
+    double avg_wait_ms   = 0;
+
+    // leased time over wall time since Init or ResetStats, of each instance and of the pool
+    std::vector<double> instance_utilisation;
+    double utilisation = 0;
+};
+
+// @brief InstancePool keeps warm instances of one model created by TNN::CreateInst and hands them out
+// to the calling threads. The instances share the model weights of the interpreter.
+class PUBLIC InstancePool {
+public:
+    // @brief a leased instance, given back to the pool when the lease is destroyed or released
+    class PUBLIC Lease {
+    public:
+        Lease();
+        ~Lease();
+        Lease(Lease&& other);
+        Lease& operator=(Lease&& other);
+
+        Lease(const Lease&)            = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        // @brief give the instance back to the pool
+        void Release();
+
+        bool IsValid() const;
+
+        Instance* operator->() const;
+        std::shared_ptr<Instance> GetInstance() const;
+
+    private:
+        friend class InstancePool;
+
+        InstancePool* pool_ = nullptr;
+        int index_          = -1;
+    };
+
+    InstancePool();
+
+    ~InstancePool();
+
+    InstancePool(const InstancePool&)            = delete;
+    InstancePool& operator=(const InstancePool&) = delete;
+
+    // @brief create the instances. tnn must stay valid until the pool is destroyed.
+    Status Init(TNN& tnn, NetworkConfig& config, const InstancePoolConfig& pool_config,
+                InputShapesMap inputs_shape = InputShapesMap());
+
+    // @brief lease an idle instance, wait until one is given back if all are leased.
+    // the calling thread and its omp threads are pinned to the cpus of the instance if cpu_list is set,
+    // and stay pinned after the lease is released.
+    // @param timeout_ms max time to wait, negative to wait forever
+    Status Acquire(Lease& lease, int timeout_ms = -1);
+
+    InstancePoolStats GetStats();
+
+    void ResetStats();
+
+private:
+    Status CreateInstances(TNN& tnn, const InstancePoolConfig& pool_config, InputShapesMap& inputs_shape);
+    void Clear();
+    int FindIdleInstance();
+    void Release(int index);
+    Status PinCurrentThread(int index);
+    void FreeArenas();
+
+    struct Slot {
+        std::shared_ptr<Instance> instance;
+        std::vector<int> cpu_list;
+        int arena      = -1;
+        bool leased    = false;
+        double busy_ms = 0;
+        std::chrono::steady_clock::time_point lease_start;
+    };
+
+    std::vector<Slot> slots_;
+    // idle instances, the last given back on top to reuse the warm caches
+    std::vector<int> idle_;
+    std::vector<void*> arenas_;
+    std::vector<bool> arena_leased_;
+    NetworkConfig config_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    int num_waiting_        = 0;
+    long long num_leases_   = 0;
+    long long num_timeouts_ = 0;
+    double total_wait_ms_   = 0;
+    double max_wait_ms_     = 0;
+    std::chrono::steady_clock::time_point stats_start_;
+};
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_CORE_INSTANCE_POOL_H_
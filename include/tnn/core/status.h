@@ -61,6 +61,7 @@ enum StatusCode {
     TNNERR_ALLOC_INSTANCE   = 0x5002,
     TNNERR_INVALID_INSTANCE = 0x5003,
     TNNERR_CONTEXT_ERR      = 0x5004,
+    TNNERR_INST_TIMEOUT     = 0x5005,
 
     // common errcode
     TNNERR_COMMON_ERROR     = 0x6000,
@@ -77,6 +78,7 @@ enum StatusCode {
     TNNERR_FORWARD_MEM_NOT_SET                   = 0x8001,
     TNNERR_SHARED_MEMORY_FORWARD_NOT_SAME_THREAD = 0x8003,
     TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT         = 0x8004,
+    TNNERR_INVALID_EXTERNAL_MEMORY               = 0x8005,
 
     // device
     TNNERR_DEVICE_NOT_SUPPORT                 = 0x9000,
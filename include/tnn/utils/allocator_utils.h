@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_UTILS_ALLOCATOR_UTILS_H_
+#define TNN_INCLUDE_TNN_UTILS_ALLOCATOR_UTILS_H_
+
+#include <stddef.h>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+typedef enum {
+    // memory is freed to the system when it is released
+    ALLOCATOR_TYPE_SYSTEM = 0,
+    // released memory is cached by size class and reused, e.g. by the instances created for new shapes
+    ALLOCATOR_TYPE_POOL = 1,
+} AllocatorType;
+
+struct PUBLIC AllocatorConfig {
+    AllocatorType type = ALLOCATOR_TYPE_SYSTEM;
+
+    // memory of at least this size is mapped with huge pages, 0: disabled
+    size_t huge_page_threshold = 0;
+
+    // map with MAP_HUGETLB from the reserved huge pages, fall back to transparent huge pages if none are left
+    bool use_hugetlb = false;
+
+    // pool only: max bytes of the released memory kept for reuse
+    size_t max_cached_bytes = 256 * 1024 * 1024;
+};
+
+struct PUBLIC AllocatorStats {
+    // memory allocated from the system, in use or cached
+    size_t bytes_reserved = 0;
+    // memory allocated by tnn and not released
+    size_t bytes_in_use = 0;
+    // memory mapped with huge pages, included in bytes_reserved
+    size_t bytes_huge_page = 0;
+
+    long long num_allocations = 0;
+    // allocations served by the cached memory
+    long long num_pool_hits = 0;
+
+    // page faults of the process
+    long long minor_page_faults = 0;
+    long long major_page_faults = 0;
+};
+
+// @brief AllocatorUtils sets the allocator of the host memory: the blob memory of the ARM and NAIVE devices,
+// the workspaces, the weights and the packed weights.
+class PUBLIC AllocatorUtils {
+public:
+    // @brief replace the allocator, call it before the models are loaded to cover their weights.
+    // memory allocated by the previous allocator is still released to it.
+    static Status SetAllocator(const AllocatorConfig& config);
+
+    // @brief stats of the allocator and the previous ones still in use
+    static AllocatorStats GetAllocatorStats();
+
+    // @brief release the memory cached by the pool to the system
+    static void TrimAllocator();
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_INCLUDE_TNN_UTILS_ALLOCATOR_UTILS_H_
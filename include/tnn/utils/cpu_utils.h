@@ -35,6 +35,14 @@ public:
 
     // @brief get cpu fp16 capability
     PUBLIC static bool CpuSupportFp16();
+
+    // @brief get the number of numa nodes from sysfs, 1 if numa is not supported
+    PUBLIC static int GetNumaNodeCount();
+
+    // @brief get the cpus of a numa node from sysfs
+    // @param node numa node id, node 0 has all the cpus if numa is not supported
+    // @param cpu_list vector of cpuids
+    PUBLIC static Status GetNumaNodeCpuList(int node, std::vector<int>& cpu_list);
 };
 
 }  // namespace TNN_NS
@@ -31,8 +31,42 @@ std::shared_ptr<const ImplementedPrecision> AbstractDevice::GetImplementedPrecis
     return std::make_shared<ImplementedPrecision>();
 }
 
+std::shared_ptr<const ImplementedLayout> AbstractDevice::GetImplementedLayout(LayerType type) {
+    return std::make_shared<ImplementedLayout>();
+}
+
+bool AbstractDevice::IsLayerAccImplemented(LayerType type) {
+    return false;
+}
+
+Status AbstractDevice::CheckExternalMemory(BlobDesc& desc, void* handle, int bytes_size) {
+    if (handle == nullptr) {
+        return Status(TNNERR_INVALID_EXTERNAL_MEMORY, "external memory is nil");
+    }
+    BlobMemorySizeInfo size_info = Calculate(desc);
+    if (size_info.dims.size() != 1) {
+        return Status(TNNERR_INVALID_EXTERNAL_MEMORY, "external memory is unsupported for blob with 2d memory");
+    }
+    if (bytes_size < GetBlobMemoryBytesSize(size_info)) {
+        LOGE("external memory size %d is less than blob memory size %d\n", bytes_size,
+             GetBlobMemoryBytesSize(size_info));
+        return Status(TNNERR_INVALID_EXTERNAL_MEMORY, "external memory size is too small");
+    }
+    return TNN_OK;
+}
+
 AbstractDevice* GetDevice(DeviceType type) {
-    return GetGlobalDeviceMap()[type].get();
+    // lookup only, the instances of the devices are created concurrently
+    auto &device_map = GetGlobalDeviceMap();
+    auto iter        = device_map.find(type);
+    return iter != device_map.end() ? iter->second.get() : nullptr;
+}
+
+AbstractDevice* GetFallbackDevice(DeviceType type) {
+    if (type == DEVICE_ARM) {
+        return GetDevice(DEVICE_NAIVE);
+    }
+    return nullptr;
 }
 
 /*
@@ -32,6 +32,11 @@ struct ImplementedPrecision {
     bool bfp16_implemented = false;
 };
 
+// data formats implemented by a layer acc besides the default one of the device
+struct ImplementedLayout {
+    std::vector<DataFormat> layouts;
+};
+
 // @brief AbstractDevice define create memory, context and layer acc interface.
 class AbstractDevice {
 public:
@@ -58,6 +63,13 @@ public:
     // @return TNN_OK if free success, otherwise error code.
     virtual Status Allocate(void** handle, BlobMemorySizeInfo& size_info) = 0;
 
+    // @brief Check memory allocated by the user can hold the blob described by desc
+    // @param desc blob description
+    // @param handle memory allocated by the user
+    // @param bytes_size size of the memory in bytes
+    // @return TNN_OK if the memory can be bound to the blob, otherwise error code.
+    virtual Status CheckExternalMemory(BlobDesc& desc, void* handle, int bytes_size);
+
     // @brief Releases memory resources associated by the handle.
     // @return TNN_OK if free success, otherwise error code.
     virtual Status Free(void* handle) = 0;
@@ -79,6 +91,13 @@ public:
     // @brief get implemented precisions on the device by layer type
     virtual std::shared_ptr<const ImplementedPrecision> GetImplementedPrecision(LayerType type);
 
+    // @brief get implemented layouts on the device by layer type
+    virtual std::shared_ptr<const ImplementedLayout> GetImplementedLayout(LayerType type);
+
+    // @brief whether a layer acc of the type is registered on the device, used to pick the
+    // layers run by the fallback device
+    virtual bool IsLayerAccImplemented(LayerType type);
+
     // @brief get factory device type
     DeviceType GetDeviceType();
 
@@ -92,6 +111,10 @@ std::map<DeviceType, std::shared_ptr<AbstractDevice>>& GetGlobalDeviceMap();
 // @brief Get Device
 AbstractDevice* GetDevice(DeviceType type);
 
+// @brief Get the device running the layers which are not implemented on the device of the type,
+// it shares the host memory of the blobs, nullptr if there is none
+AbstractDevice* GetFallbackDevice(DeviceType type);
+
 // @brief TypeDeviceRegister contruct register device
 template <typename T>
 class TypeDeviceRegister {
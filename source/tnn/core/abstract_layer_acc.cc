@@ -21,6 +21,10 @@ namespace TNN_NS {
 
 Status AbstractLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                               const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return ResolveBlobDataFormats(inputs, outputs);
+}
+
+Status AbstractLayerAcc::ResolveBlobDataFormats(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     /*
      * Check whether the format is supported by LayerAcc or not.
      * The supported format of each layer is given by LayerAcc.
@@ -41,7 +45,6 @@ Status AbstractLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     return TNN_OK;
 }
 
-#if TNN_PROFILE
 void AbstractLayerAcc::UpdateProfilingData(ProfilingData *pdata, LayerParam *param, DimsVector input_dim,
                                            DimsVector output_dim) {
     if (!pdata) {
@@ -101,7 +104,6 @@ double AbstractLayerAcc::GetFlops() {
 double AbstractLayerAcc::GetBandwidth() {
     return 0;
 }
-#endif
 
 Status AbstractLayerAcc::ResolveBlobDataFormat(Blob *blob) {
     BlobDesc desc                        = blob->GetBlobDesc();
@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_CORE_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_CORE_LAYER_ACC_H_
 
+#include <string>
 #include <vector>
 
 #include "tnn/core/blob.h"
@@ -28,6 +29,21 @@
 
 namespace TNN_NS {
 
+// @brief the weights packed by a layer acc at init. the layout names the impl and what its packing depends on,
+// e.g. the arch and the data type, a layer acc only takes back the buffers packed in its own layout.
+// the buffers may be read only data of the binary, the layer accs never write them.
+struct PackedWeights {
+    PackedWeights() {}
+    PackedWeights(const std::string &layout, const std::vector<RawBuffer> &buffers, bool repackable = true)
+        : layout(layout), buffers(buffers), repackable(repackable) {}
+
+    std::string layout;
+    std::vector<RawBuffer> buffers;
+    // false if the layer resource has no raw weights, e.g. dropped by tnn2cpp, then the weights can not be
+    // packed again in another layout
+    bool repackable = true;
+};
+
 // @brief AbstractLayerAcc define the layer acc interface
 class AbstractLayerAcc {
 public:
@@ -43,6 +59,10 @@ public:
     virtual Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                         const std::vector<Blob *> &outputs) = 0;
 
+    // @brief decide the data format of the blobs left auto and check the others, it is part of Init,
+    // and done ahead of it when the layer accs are initialized concurrently.
+    Status ResolveBlobDataFormats(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     // @brief prepare with inputs and outpus.
     // @param inputs    input blobs
     // @param outputs   output blobs
@@ -55,12 +75,52 @@ public:
     // @return execution result
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) = 0;
 
-#if TNN_PROFILE
+    // @brief whether the layer resouce is not used after init, e.g. the
+    // weights have been packed into the buffers owned by the layer acc.
+    virtual bool IsResourceReleasable() {
+        return false;
+    }
+
+    // @brief drop the pointers to the layer resource, called before the resource
+    // is released. only called if IsResourceReleasable returns true.
+    virtual void ReleaseResource() {}
+
+    // @brief the weights packed by the layer acc at init, empty if the layer acc cannot
+    // take them back. they are embedded ahead of time by tnn2cpp.
+    virtual PackedWeights GetPackedWeights() {
+        return PackedWeights();
+    }
+
+    // @brief use the weights packed ahead of time instead of packing them in Init, called before Init.
+    // Init packs the weights again if they are not in the layout of the impl it selects.
+    virtual Status SetPackedWeights(const PackedWeights &packed_weights) {
+        return Status(TNNERR_LAYER_ERR, "the layer acc does not take packed weights");
+    }
+
+    // @brief whether the layer acc computes with the int8 weights of a weight
+    // only quantized resource, otherwise they are dequantized to float before init.
+    virtual bool IsQuantizedWeightsSupported(LayerParam *param, LayerResource *resource,
+                                             const std::vector<Blob *> &inputs) {
+        return false;
+    }
+
+    // @brief whether the layer acc runs with blobs placed by the blob manager as
+    // channel views of each other, skipping the copy of the viewed channels.
+    virtual bool IsBlobViewSupported() {
+        return false;
+    }
+
+    // @brief whether the layer acc computes correctly when the output shares the
+    // memory of input 0 or input 1 of the same data type and format.
+    virtual bool IsInplaceSupported() {
+        return false;
+    }
+
     virtual void UpdateProfilingData(ProfilingData *pdata, LayerParam *param, DimsVector input_dim,
                                      DimsVector output_dim);
+    // @brief mflops and mbytes of the layer, 0 if not reported by the layer acc
     virtual double GetFlops();
     virtual double GetBandwidth();
-#endif
 
 private:
     // @brief return device layer acc support data format
@@ -24,12 +24,25 @@ Status AbstractNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSt
 }
 #endif  // end of FORWARD_CALLBACK_ENABLE
 
+// network without partial forward support computes all the outputs
+Status AbstractNetwork::ForwardPartial(const std::set<std::string> &output_names) {
+    return Forward();
+}
+
+Status AbstractNetwork::SetPartialOutputs(const std::set<std::string> &output_names) {
+    return TNN_OK;
+}
+
+Status AbstractNetwork::BindBlobMemory(const std::string &blob_name, void *data, int bytes_size,
+                                       DataFormat data_format) {
+    return Status(TNNERR_NET_ERR, "network does not support binding blob memory");
+}
+
 Status AbstractNetwork::SetCpuNumThreads(int num_threads) {
     return TNN_OK;
 }
 
-#if TNN_PROFILE
-void AbstractNetwork::StartProfile() {
+void AbstractNetwork::StartProfile(bool hardware_counters) {
     LOGI("subclass should implement the func: StartProfile\n");
 }
 
@@ -37,7 +50,6 @@ std::shared_ptr<ProfileResult> AbstractNetwork::FinishProfile() {
     LOGI("subclass should implement the func: FinishProfile\n");
     return std::make_shared<ProfileResult>();
 }
-#endif
 
 std::map<NetworkType, std::shared_ptr<AbstractNetworkImplFactory>> &NetworkImplManager::GetNetworkImplFactoryMap() {
     static std::map<NetworkType, std::shared_ptr<AbstractNetworkImplFactory>> s_network_impl_factory_map;
@@ -17,6 +17,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "tnn/core/blob.h"
@@ -61,6 +62,13 @@ public:
     //
     virtual Status SetForwardMemory(void *memory) = 0;
 
+    // @brief bind memory allocated by the user to an input or output blob
+    // @param blob_name name of the input or output blob
+    // @param data memory allocated by the user
+    // @param bytes_size size of the memory in bytes
+    // @param data_format data format of the memory
+    virtual Status BindBlobMemory(const std::string &blob_name, void *data, int bytes_size, DataFormat data_format);
+
     // @brief network infer
     virtual Status Reshape(const InputShapesMap &inputs) = 0;
 
@@ -71,6 +79,12 @@ public:
     // @brief network infer, it will sync to wait result
     virtual Status Forward() = 0;
 
+    // @brief network infer, only compute the layers required by output_names
+    virtual Status ForwardPartial(const std::set<std::string> &output_names);
+
+    // @brief plan the memory for the layers required by output_names only, all layers if empty
+    virtual Status SetPartialOutputs(const std::set<std::string> &output_names);
+
 #ifdef FORWARD_CALLBACK_ENABLE
     // @brief network infer with callbach to statistic blob info
     virtual Status ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after);
@@ -90,11 +104,9 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
-#if TNN_PROFILE
 public:
-    virtual void StartProfile();
+    virtual void StartProfile(bool hardware_counters = false);
     virtual std::shared_ptr<ProfileResult> FinishProfile();
-#endif
 };
 
 class AbstractNetworkImplFactory {
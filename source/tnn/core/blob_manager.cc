@@ -23,6 +23,7 @@
 #include "tnn/memory_manager/memory_mode_state_factory.h"
 #include "tnn/memory_manager/memory_seperate_assign_strategy.h"
 #include "tnn/memory_manager/memory_unify_assign_strategy.h"
+#include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
@@ -90,6 +91,8 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
         // set to the specified data format
         if (config.data_format != DATA_FORMAT_AUTO) {
             desc.data_format = config.data_format;
+        } else if (net_structure_->blobs_format.count(node_name) > 0) {
+            desc.data_format = net_structure_->blobs_format[node_name];
         }
 
         // check whether the input_shape is defined or not.
@@ -126,12 +129,21 @@ Status BlobManager::Init(NetworkConfig &config, NetStructure *net_structure, Inp
  */
 Status BlobManager::AllocateBlobMemory() {
     const auto &input_shapes_map = net_structure_->inputs_shape_map;
+    // the shapes the instance is created with are the largest ones, replans may happen at smaller shapes
+    if (planned_dims_.empty()) {
+        for (auto iter : blobs_) {
+            planned_dims_[iter.first] = iter.second->GetBlobDesc().dims;
+        }
+    }
 
     for (auto iter : input_shapes_map) {
         std::string current_blob_name = iter.first;
-        Blob *current_blob            = blobs_[current_blob_name];
+        if (external_blobs_.count(current_blob_name) > 0) {
+            continue;
+        }
+        Blob *current_blob = blobs_[current_blob_name];
         // todo. need refactor
-        BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+        BlobMemorySizeInfo info = CalculatePlannedSize(current_blob);
         if (info.dims.size() > 1 && config_.share_memory_mode != SHARE_MEMORY_MODE_DEFAULT) {
             return Status(TNNERR_SHARE_MEMORY_MODE_NOT_SUPPORT, "share_memory_mode option is unsupported");
         }
@@ -141,12 +153,45 @@ Status BlobManager::AllocateBlobMemory() {
         blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
     }
 
+    PlanBlobViews();
+    std::map<std::string, int> producer_index;
+    for (int layer_index = 0; layer_index < net_structure_->layers.size(); layer_index++) {
+        for (auto name : net_structure_->layers[layer_index]->outputs) {
+            producer_index[name] = layer_index;
+        }
+    }
+
     /*
      *  We reuse blob memory of the previos layers if it is not referenced.
      *  So, a use_count is calculated here.
      */
     for (int layer_index = 0; layer_index < net_structure_->layers.size(); layer_index++) {
         LayerInfo *layer_info = net_structure_->layers[layer_index].get();
+        // the layers not planned do not run, only the network outputs keep their memory
+        if (!IsLayerActive(layer_info)) {
+            for (auto current_blob_name : layer_info->outputs) {
+                Blob *current_blob = blobs_[current_blob_name];
+                if (output_blobs_.count(current_blob_name) > 0 && external_blobs_.count(current_blob_name) == 0 &&
+                    blob_memory_mapping_.count(current_blob) == 0) {
+                    BlobMemorySizeInfo info = CalculatePlannedSize(current_blob);
+                    BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(1, info, false);
+                    blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+                }
+            }
+            continue;
+        }
+
+        // the output of an in place layer is a view at offset 0 of the input it overwrites
+        if (inplace_layers_.count(layer_info->name) > 0) {
+            Blob *input = GetInplaceInput(layer_info);
+            if (input) {
+                BlobView view;
+                view.parent                                 = input;
+                view.inplace                                = true;
+                blob_views_[blobs_[layer_info->outputs[0]]] = view;
+            }
+        }
+
         // allocating blob memory for every out nodes of this layer
         for (auto current_blob_name : layer_info->outputs) {
             Blob *current_blob = blobs_[current_blob_name];
@@ -156,21 +201,41 @@ Status BlobManager::AllocateBlobMemory() {
                 return Status(TNNERR_LAYER_ERR, "blob dims is invaid");
             }
 
-            if (blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
+            if (blob_views_.count(current_blob) > 0) {
+                // a view uses the memory of its root blob, allocated by the first view produced before the root
+                Blob *root              = GetBlobViewRoot(current_blob);
+                const std::string &name = root->GetBlobDesc().name;
+                BlobMemory *root_memory = nullptr;
+                if (blob_memory_mapping_.count(root) == 0) {
+                    int use_count           = GetBlobUseCount(producer_index[name], name);
+                    BlobMemorySizeInfo info = CalculatePlannedSize(root);
+                    root_memory             = blob_memory_pool_->BorrowBlobMemory(use_count, info, false);
+                    blob_memory_mapping_.insert(std::make_pair(root, root_memory));
+                } else {
+                    root_memory = blob_memory_mapping_[root];
+                }
+                root_memory->SetUseCount(root_memory->GetUseCount() +
+                                         GetBlobUseCount(layer_index, current_blob_name));
+                continue;
+            }
+
+            if (external_blobs_.count(current_blob_name) == 0 &&
+                blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
                 // calculate the use count of this blob
                 int use_count = GetBlobUseCount(layer_index, current_blob_name);
 
-                BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+                BlobMemorySizeInfo info = CalculatePlannedSize(current_blob);
                 // find an available BlobMemory
                 BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(use_count, info, false);
                 blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
             }
         }
 
-        // refund the input blob memory
-        for (auto current_blob_name : layer_info->inputs) {
-            Blob *current_blob = blobs_[current_blob_name];
-            if (input_shapes_map.count(current_blob_name) == 0) {
+        // refund the input blob memory, views refund the memory of their root
+        for (auto input_name : layer_info->inputs) {
+            Blob *current_blob                   = GetBlobViewRoot(blobs_[input_name]);
+            const std::string &current_blob_name = current_blob->GetBlobDesc().name;
+            if (input_shapes_map.count(current_blob_name) == 0 && external_blobs_.count(current_blob_name) == 0) {
                 std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
                     blob_memory_mapping_.find(current_blob);
                 ASSERT(blob_memory_iter->second->GetUseCount() > 0);
@@ -211,12 +276,16 @@ Status BlobManager::AllocateBlobMemory() {
 /*
  * This function calculate the use count of the given blob.
  * output layer is regarded as an additional reference.
+ * The layers not planned do not use the blob.
  */
 int BlobManager::GetBlobUseCount(int layer_index, std::string current_blob_name) {
     int use_count                            = 0;
     std::set<std::string> &output_blob_names = net_structure_->outputs;
     for (int next_layer_id = layer_index + 1; next_layer_id != net_structure_->layers.size(); ++next_layer_id) {
         LayerInfo *next_layer_info = net_structure_->layers[next_layer_id].get();
+        if (!IsLayerActive(next_layer_info)) {
+            continue;
+        }
         for (auto blob_name : next_layer_info->inputs) {
             if (strcmp(current_blob_name.c_str(), blob_name.c_str()) == 0) {
                 ++use_count;
@@ -231,6 +300,81 @@ int BlobManager::GetBlobUseCount(int layer_index, std::string current_blob_name)
     return use_count;
 }
 
+/*
+ * Input and output blobs may use memory allocated by the user, which saves
+ * the copy in and out of the blob. The first binding of a blob replans the
+ * memory of the other blobs without it, later ones only replace the handle.
+ */
+Status BlobManager::BindExternalBlobMemory(const std::string &name, void *handle, int bytes_size,
+                                           DataFormat data_format) {
+    if (input_blobs_.count(name) == 0 && output_blobs_.count(name) == 0) {
+        LOGE("blob %s is not an input or output blob\n", name.c_str());
+        return Status(TNNERR_PARAM_ERR, "only input or output blob can bind external memory");
+    }
+
+    Blob *blob     = blobs_[name];
+    BlobDesc &desc = blob->GetBlobDesc();
+    if (desc.data_format != data_format) {
+        LOGE("blob %s data format is %d, but external memory data format is %d\n", name.c_str(), desc.data_format,
+             data_format);
+        return Status(TNNERR_INVALID_EXTERNAL_MEMORY, "external memory data format not match");
+    }
+    Status status = device_->CheckExternalMemory(desc, handle, bytes_size);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    BlobHandle blob_handle;
+    blob_handle.base = handle;
+    blob->SetHandle(blob_handle);
+
+    bool bound            = external_blobs_.count(name) > 0;
+    external_blobs_[name] = bytes_size;
+    if (bound) {
+        return TNN_OK;
+    }
+    return ReallocateBlobMemory();
+}
+
+/*
+ * The external memory is checked against the shape of the blob when it is
+ * bound, a later reshape may need more memory than the user allocated.
+ */
+Status BlobManager::CheckExternalBlobMemory() {
+    for (auto iter : external_blobs_) {
+        Blob *blob    = blobs_[iter.first];
+        Status status = device_->CheckExternalMemory(blob->GetBlobDesc(), blob->GetHandle().base, iter.second);
+        if (status != TNN_OK) {
+            LOGE("external memory of blob %s is too small for the shape\n", iter.first.c_str());
+            return status;
+        }
+    }
+    return TNN_OK;
+}
+
+/*
+ * Rebuild the blob memory pool, used when the blobs sharing it changed.
+ * SET_FROM_EXTERNAL instances need to set the forward memory again.
+ */
+Status BlobManager::ReallocateBlobMemory() {
+    if (config_.share_memory_mode == SHARE_MEMORY_MODE_SHARE_ONE_THREAD) {
+        SharedMemoryManager::ReleaseSharedMemory(init_thread_id_, device_, config_.device_id, this);
+    }
+
+    blob_memory_mapping_.clear();
+    delete blob_memory_pool_;
+    // the blobs not planned again must not keep the memory of the old pool
+    for (auto iter : blobs_) {
+        if (external_blobs_.count(iter.first) == 0) {
+            iter.second->SetHandle(BlobHandle());
+        }
+    }
+    blob_memory_pool_ = BlobMemoryPoolFactory::CreateBlobMemoryPool(device_);
+
+    delete memory_mode_state_;
+    memory_mode_state_ = MemoryModeStateFactory::CreateMemoryModeState(config_.share_memory_mode);
+
+    return AllocateBlobMemory();
+}
+
 Status BlobManager::DeInit() {
     if (config_.share_memory_mode == SHARE_MEMORY_MODE_SHARE_ONE_THREAD) {
         SharedMemoryManager::ReleaseSharedMemory(init_thread_id_, device_, config_.device_id, this);
@@ -275,6 +419,264 @@ void BlobManager::BindBlobMemory() {
     for (auto iter : blob_memory_mapping_) {
         iter.first->SetHandle(iter.second->GetHandle());
     }
+    UpdateBlobViews();
+}
+
+void BlobManager::SetBlobViewLayers(const std::set<std::string> &layer_names) {
+    blob_view_layers_ = layer_names;
+}
+
+void BlobManager::SetInplaceLayers(const std::set<std::string> &layer_names) {
+    inplace_layers_ = layer_names;
+}
+
+/*
+ * The memory of the layers which are never run, like the layers pruned by a
+ * partial forward, is not planned, which saves their memory and lets the other
+ * blobs share less. The memory pool is rebuilt, so the data of the blobs is lost.
+ */
+Status BlobManager::SetActiveLayers(const std::set<std::string> &layer_names) {
+    if (layer_names == active_layers_) {
+        return TNN_OK;
+    }
+    active_layers_ = layer_names;
+    return ReallocateBlobMemory();
+}
+
+bool BlobManager::IsLayerActive(LayerInfo *layer_info) {
+    return active_layers_.empty() || active_layers_.count(layer_info->name) > 0;
+}
+
+/*
+ * A blob view uses the channels of its parent blob instead of its own memory,
+ * which saves the copy of the channels: the inputs of a channel concat are
+ * produced in place in the concat output, the outputs of a channel split or
+ * slice are read from the sliced blob. Views are planned for the layers whose
+ * accs support them, when the blobs are batch 1 NC4HW4 blobs in 1d memory and
+ * the channel offsets are aligned to 4. The other blobs keep their own memory
+ * and are copied by the layers.
+ */
+void BlobManager::PlanBlobViews() {
+    blob_views_.clear();
+    const auto &input_shapes_map = net_structure_->inputs_shape_map;
+    const auto &output_names     = net_structure_->outputs;
+
+    for (auto layer_info : net_structure_->layers) {
+        if (blob_view_layers_.count(layer_info->name) == 0 || !IsLayerActive(layer_info.get())) {
+            continue;
+        }
+
+        Blob *parent = nullptr;
+        std::vector<std::string> view_names;
+        std::vector<int> channel_offsets;
+        if (layer_info->type == LAYER_CONCAT) {
+            auto param = dynamic_cast<ConcatLayerParam *>(layer_info->param.get());
+            if (!param || param->axis != 1 || layer_info->outputs.size() != 1) {
+                continue;
+            }
+            parent     = blobs_[layer_info->outputs[0]];
+            view_names = layer_info->inputs;
+        } else if (layer_info->type == LAYER_SPLITV) {
+            auto param = dynamic_cast<SplitVLayerParam *>(layer_info->param.get());
+            if (!param || param->axis != 1 || layer_info->inputs.size() != 1) {
+                continue;
+            }
+            parent     = blobs_[layer_info->inputs[0]];
+            view_names = layer_info->outputs;
+        } else if (layer_info->type == LAYER_STRIDED_SLICE) {
+            auto param = dynamic_cast<StrideSliceLayerParam *>(layer_info->param.get());
+            if (!param || layer_info->inputs.size() != 1 || layer_info->outputs.size() != 1) {
+                continue;
+            }
+            parent = blobs_[layer_info->inputs[0]];
+            // a slice of channels only, the begins are in order [w h c n]
+            auto &dims   = parent->GetBlobDesc().dims;
+            auto begins  = param->begins;
+            auto strides = param->strides;
+            std::reverse(begins.begin(), begins.end());
+            if (dims.size() < 2 || begins.size() != dims.size() ||
+                std::any_of(strides.begin(), strides.end(), [](int s) { return s != 1; })) {
+                continue;
+            }
+            int channel_begin = begins[1] < 0 ? begins[1] + dims[1] : begins[1];
+            begins[1]         = 0;
+            if (std::any_of(begins.begin(), begins.end(), [](int b) { return b != 0; })) {
+                continue;
+            }
+            view_names      = layer_info->outputs;
+            channel_offsets = {channel_begin};
+        } else {
+            continue;
+        }
+
+        if (channel_offsets.empty()) {
+            int offset = 0;
+            for (auto name : view_names) {
+                channel_offsets.push_back(offset);
+                offset += blobs_[name]->GetBlobDesc().dims.size() > 1 ? blobs_[name]->GetBlobDesc().dims[1] : 0;
+            }
+        }
+
+        // all the blobs of the layer are views or none, the layer copies otherwise
+        std::set<std::string> unique_names(view_names.begin(), view_names.end());
+        bool viewable = unique_names.size() == view_names.size();
+        for (int i = 0; i < view_names.size() && viewable; i++) {
+            Blob *blob = blobs_[view_names[i]];
+            viewable   = blob != parent && blob_views_.count(blob) == 0 && input_shapes_map.count(view_names[i]) == 0 &&
+                         output_names.count(view_names[i]) == 0 && external_blobs_.count(view_names[i]) == 0 &&
+                         IsBlobViewCompatible(blob, parent);
+            // the c4 planes of a view are whole planes of the parent, only the last one may have padded channels
+            if (viewable) {
+                int channels        = blob->GetBlobDesc().dims[1];
+                int parent_channels = parent->GetBlobDesc().dims[1];
+                viewable            = channel_offsets[i] % 4 == 0 && channel_offsets[i] + channels <= parent_channels &&
+                                      (channels % 4 == 0 || channel_offsets[i] + channels == parent_channels);
+            }
+        }
+        if (!viewable) {
+            continue;
+        }
+        for (int i = 0; i < view_names.size(); i++) {
+            BlobView view;
+            view.parent                        = parent;
+            view.channel_offset                = channel_offsets[i];
+            blob_views_[blobs_[view_names[i]]] = view;
+        }
+    }
+}
+
+bool BlobManager::IsBlobViewCompatible(Blob *blob, Blob *parent) {
+    auto &desc        = blob->GetBlobDesc();
+    auto &parent_desc = parent->GetBlobDesc();
+    if (desc.data_format != DATA_FORMAT_NC4HW4 || parent_desc.data_format != DATA_FORMAT_NC4HW4 ||
+        desc.data_type != parent_desc.data_type || desc.data_type == DATA_TYPE_INT8) {
+        return false;
+    }
+    if (desc.dims.size() < 2 || desc.dims.size() != parent_desc.dims.size() || desc.dims[0] != 1 ||
+        parent_desc.dims[0] != 1 || desc.dims[1] > parent_desc.dims[1]) {
+        return false;
+    }
+    for (int i = 2; i < desc.dims.size(); i++) {
+        if (desc.dims[i] != parent_desc.dims[i]) {
+            return false;
+        }
+    }
+    // a view is an offset in the memory of the parent
+    return external_blobs_.count(parent_desc.name) == 0 && device_->Calculate(desc).dims.size() == 1 &&
+           device_->Calculate(parent_desc).dims.size() == 1;
+}
+
+/*
+ * An in place layer writes its output over an input whose memory is not used
+ * after the layer, which saves the output memory and lets the layer skip the
+ * copy when the data is unchanged, like an nc4hw4 compatible reshape. Layers
+ * with more than 2 inputs accumulate the others into the output, so only input
+ * 0 or 1 may be overwritten. Network inputs and external memory are kept.
+ */
+Blob *BlobManager::GetInplaceInput(LayerInfo *layer_info) {
+    if (layer_info->outputs.size() != 1) {
+        return nullptr;
+    }
+    const auto &input_shapes_map  = net_structure_->inputs_shape_map;
+    const std::string output_name = layer_info->outputs[0];
+    Blob *output                  = blobs_[output_name];
+    if (blob_views_.count(output) > 0 || external_blobs_.count(output_name) > 0) {
+        return nullptr;
+    }
+
+    auto &output_desc              = output->GetBlobDesc();
+    BlobMemorySizeInfo output_info = CalculatePlannedSize(output);
+    for (int i = 0; i < layer_info->inputs.size() && i < 2; i++) {
+        Blob *input           = blobs_[layer_info->inputs[i]];
+        Blob *root            = GetBlobViewRoot(input);
+        const auto &root_name = root->GetBlobDesc().name;
+        if (input_shapes_map.count(root_name) > 0 || external_blobs_.count(root_name) > 0 ||
+            blob_memory_mapping_.count(root) == 0) {
+            continue;
+        }
+        // the layer is the last user of the memory
+        if (blob_memory_mapping_[root]->GetUseCount() != 1) {
+            continue;
+        }
+        auto &input_desc              = input->GetBlobDesc();
+        BlobMemorySizeInfo input_info = CalculatePlannedSize(input);
+        if (input_desc.data_type == output_desc.data_type && input_desc.data_format == output_desc.data_format &&
+            input_info.dims.size() == 1 && output_info.dims.size() == 1 && output_info.dims[0] <= input_info.dims[0]) {
+            return input;
+        }
+    }
+    return nullptr;
+}
+
+BlobMemorySizeInfo BlobManager::CalculatePlannedSize(Blob *blob) {
+    BlobDesc desc = blob->GetBlobDesc();
+    auto iter     = planned_dims_.find(desc.name);
+    if (iter != planned_dims_.end()) {
+        desc.dims = iter->second;
+    }
+    return device_->Calculate(desc);
+}
+
+Blob *BlobManager::GetBlobViewRoot(Blob *blob) {
+    while (blob_views_.count(blob) > 0) {
+        blob = blob_views_[blob].parent;
+    }
+    return blob;
+}
+
+void BlobManager::UpdateBlobViews() {
+    for (auto iter : blob_views_) {
+        Blob *root       = iter.first;
+        int bytes_offset = 0;
+        while (blob_views_.count(root) > 0) {
+            const auto &view = blob_views_[root];
+            auto &desc       = view.parent->GetBlobDesc();
+            bytes_offset += view.channel_offset * DimsVectorUtils::Count(desc.dims, 2) *
+                            DataTypeUtils::GetBytesSize(desc.data_type);
+            root = view.parent;
+        }
+        // the memory of the root is not assigned yet
+        BlobHandle handle = root->GetHandle();
+        if (handle.base == nullptr) {
+            continue;
+        }
+        handle.bytes_offset += bytes_offset;
+        iter.first->SetHandle(handle);
+    }
+}
+
+/*
+ * The channel views are planned for the shapes the memory is planned with, a
+ * reshape may change the batch or the channels, which makes the views invalid
+ * or new views possible. The in place views depend on the planned sizes only.
+ */
+Status BlobManager::ReshapeBlobViews() {
+    auto previous_views = blob_views_;
+    PlanBlobViews();
+
+    bool changed = false;
+    for (auto iter : previous_views) {
+        if (iter.second.inplace) {
+            continue;
+        }
+        auto view = blob_views_.find(iter.first);
+        changed |= view == blob_views_.end() || view->second.parent != iter.second.parent;
+    }
+    for (auto iter : blob_views_) {
+        auto view = previous_views.find(iter.first);
+        changed |= view == previous_views.end() || view->second.inplace;
+    }
+    if (changed) {
+        return ReallocateBlobMemory();
+    }
+
+    for (auto iter : previous_views) {
+        if (iter.second.inplace) {
+            blob_views_[iter.first] = iter.second;
+        }
+    }
+    UpdateBlobViews();
+    return TNN_OK;
 }
 
 int BlobManager::GetAllBlobMemorySize() {
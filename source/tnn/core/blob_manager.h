@@ -17,6 +17,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <thread>
 
@@ -59,6 +60,17 @@ public:
     // @brief set blob forward memory
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief bind memory allocated by the user to an input or output blob, the
+    // blob is excluded from the blob memory pool afterwards.
+    // @param name blob name
+    // @param handle memory allocated by the user
+    // @param bytes_size size of the memory in bytes
+    // @param data_format data format of the memory, must match the blob
+    Status BindExternalBlobMemory(const std::string &name, void *handle, int bytes_size, DataFormat data_format);
+
+    // @brief check the memory bound by the user still fits the current shapes of the blobs
+    Status CheckExternalBlobMemory();
+
     // @brief get all input blobs
     // @param blobs blob map
     virtual Status GetAllInputBlobs(BlobMap &blobs);
@@ -79,9 +91,42 @@ public:
     // @brief replace blob with new_blob, and delete the original blob if exist
     void ReplaceBlob(std::string name, Blob *new_blob);
 
+    // @brief set the layers whose accs run with blob views, must be called before AllocateBlobMemory
+    void SetBlobViewLayers(const std::set<std::string> &layer_names);
+
+    // @brief set the layers whose accs can write the output over a dying input, must be called before
+    // AllocateBlobMemory
+    void SetInplaceLayers(const std::set<std::string> &layer_names);
+
+    // @brief move the blob views to the channel offsets of the current blob shapes
+    void UpdateBlobViews();
+
+    // @brief plan the blob views again for the current blob shapes, the blob memory is planned
+    // again if the views changed, otherwise the views are moved to the new channel offsets
+    Status ReshapeBlobViews();
+
+    // @brief plan the blob memory for the given layers only, the blobs of the other layers get
+    // no memory except the network outputs. all the layers are planned if layer_names is empty.
+    Status SetActiveLayers(const std::set<std::string> &layer_names);
+
 private:
+    // a blob placed in the channels [channel_offset, channel_offset + channels) of its parent
+    struct BlobView {
+        Blob *parent       = nullptr;
+        int channel_offset = 0;
+        // the output of an in place layer at offset 0 of its input, independent of the shapes
+        bool inplace = false;
+    };
+
     void BindBlobMemory();
+    Status ReallocateBlobMemory();
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    void PlanBlobViews();
+    bool IsBlobViewCompatible(Blob *blob, Blob *parent);
+    Blob *GetBlobViewRoot(Blob *blob);
+    Blob *GetInplaceInput(LayerInfo *layer_info);
+    bool IsLayerActive(LayerInfo *layer_info);
+    BlobMemorySizeInfo CalculatePlannedSize(Blob *blob);
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -92,6 +137,14 @@ private:
     std::shared_ptr<MemoryAssignStrategy> strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
+    // bytes size of the memory bound to each external blob
+    std::map<std::string, int> external_blobs_;
+    std::set<std::string> blob_view_layers_;
+    std::set<std::string> inplace_layers_;
+    std::map<Blob *, BlobView> blob_views_;
+    std::set<std::string> active_layers_;
+    // dims of the blobs when the memory is planned first
+    std::map<std::string, DimsVector> planned_dims_;
 
     std::thread::id init_thread_id_;
     MemoryModeState *memory_mode_state_;
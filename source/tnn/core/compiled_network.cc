@@ -0,0 +1,190 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/compiled_network.h"
+
+#include "tnn/memory_manager/blob_memory_size_info.h"
+
+namespace TNN_NS {
+
+CompiledNetwork::~CompiledNetwork() {
+    layers_.clear();
+    blobs_.clear();
+    if (memory_ && device_) {
+        device_->Free(memory_);
+        memory_ = nullptr;
+    }
+    if (context_) {
+        delete context_;
+        context_ = nullptr;
+    }
+}
+
+/*
+ * Init follows DefaultNetwork::Init without the interpreter, optimizer and memory planner:
+ *  1. create the blobs with the shapes, types and formats resolved at generation.
+ *  2. init the layers in order, on the device chosen for each of them. the weights packed ahead of time are
+ *     handed to the layer accs, which skip packing them if they are in the layout of the selected impl. they
+ *     stay in the read only data of the binary.
+ *  3. place the blobs at their offsets of one forward memory and reshape the layers.
+ */
+Status CompiledNetwork::Init(const CompiledNetInfo &info, std::vector<std::shared_ptr<LayerParam>> &params,
+                             std::vector<std::shared_ptr<LayerResource>> &resources,
+                             std::vector<PackedWeights> &packed_weights) {
+    if ((int)params.size() != info.layer_count || (int)resources.size() != info.layer_count ||
+        (int)packed_weights.size() != info.layer_count) {
+        LOGE("CompiledNetwork: got %d params, %d resources and %d packed weights for %d layers\n",
+             (int)params.size(), (int)resources.size(), (int)packed_weights.size(), info.layer_count);
+        return Status(TNNERR_PARAM_ERR, "CompiledNetwork: invalid params or resources");
+    }
+
+    device_ = GetDevice(info.device_type);
+    if (device_ == NULL) {
+        return TNNERR_DEVICE_NOT_SUPPORT;
+    }
+    context_ = device_->CreateContext(0);
+    if (context_ == NULL) {
+        return TNNERR_DEVICE_CONTEXT_CREATE;
+    }
+    RETURN_ON_NEQ(context_->SetPrecision(info.precision), TNN_OK);
+
+    for (int i = 0; i < info.blob_count; i++) {
+        const CompiledBlobInfo &blob_info = info.blobs[i];
+        BlobDesc desc;
+        desc.device_type = info.device_type;
+        desc.data_type   = blob_info.data_type;
+        desc.data_format = blob_info.data_format;
+        desc.dims        = DimsVector(blob_info.dims, blob_info.dims + blob_info.dims_size);
+        desc.name        = blob_info.name;
+        auto blob        = std::make_shared<Blob>(desc);
+        blobs_.push_back(blob);
+        blob_map_[desc.name] = blob.get();
+    }
+
+    for (int i = 0; i < info.layer_count; i++) {
+        const CompiledLayerInfo &layer_info = info.layers[i];
+        std::shared_ptr<BaseLayer> layer(CreateLayer(layer_info.type));
+        if (!layer) {
+            LOGE("Error: CreateLayer failed, type:%d\n", layer_info.type);
+            return Status(TNNERR_PARAM_ERR, "CreateLayer failed");
+        }
+        layer->SetLayerName(layer_info.name);
+
+        std::vector<Blob *> inputs;
+        for (int j = 0; j < layer_info.inputs_count; j++) {
+            inputs.push_back(blobs_[info.layer_blobs[layer_info.inputs_begin + j]].get());
+        }
+        std::vector<Blob *> outputs;
+        for (int j = 0; j < layer_info.outputs_count; j++) {
+            outputs.push_back(blobs_[info.layer_blobs[layer_info.outputs_begin + j]].get());
+        }
+
+        auto layer_device = GetDevice(layer_info.device_type);
+        if (layer_device == NULL) {
+            return TNNERR_DEVICE_NOT_SUPPORT;
+        }
+        Status ret = layer->PrepareInit(context_, params[i].get(), resources[i].get(), inputs, outputs, layer_device);
+        if (ret == TNN_OK && !packed_weights[i].buffers.empty()) {
+            if (use_packed_weights_) {
+                ret = layer->SetPackedWeights(packed_weights[i]);
+            }
+            // the layer acc packs the weights at init instead, if the raw weights are generated
+            if (ret != TNN_OK || !use_packed_weights_) {
+                if (!packed_weights[i].repackable) {
+                    LOGE("layer %s can not pack its weights, the raw weights are not generated\n", layer_info.name);
+                    ret = Status(TNNERR_LAYER_ERR, "the packed weights are not taken and no raw weights to pack");
+                } else {
+                    LOGD("layer %s does not take the packed weights in %s\n", layer_info.name,
+                         packed_weights[i].layout.c_str());
+                    ret = TNN_OK;
+                }
+            }
+        }
+        if (ret == TNN_OK) {
+            ret = layer->InitLayerAcc();
+        }
+        if (ret != TNN_OK) {
+            LOGE("Error Init layer %s (err: %d or 0x%X)\n", layer_info.name, (int)ret, (int)ret);
+            return ret;
+        }
+        layers_.push_back(layer);
+    }
+    // the params and resources are referred by the layers
+    params_    = params;
+    resources_ = resources;
+
+    BlobMemorySizeInfo size_info;
+    size_info.dims.push_back((int)info.memory_size);
+    RETURN_ON_NEQ(device_->Allocate(&memory_, size_info), TNN_OK);
+    for (int i = 0; i < info.blob_count; i++) {
+        BlobHandle handle;
+        handle.base = static_cast<char *>(memory_) + info.blobs[i].offset;
+        blobs_[i]->SetHandle(handle);
+    }
+
+    for (auto layer : layers_) {
+        Status ret = layer->Reshape();
+        if (ret != TNN_OK) {
+            LOGE("Error Reshape layer %s (err: %d or 0x%X)\n", layer->GetLayerName().c_str(), (int)ret, (int)ret);
+            return ret;
+        }
+    }
+    return TNN_OK;
+}
+
+void CompiledNetwork::SetUsePackedWeights(bool use_packed_weights) {
+    use_packed_weights_ = use_packed_weights;
+}
+
+Status CompiledNetwork::Forward() {
+    if (!context_) {
+        return Status(TNNERR_CONTEXT_ERR, "context is nil");
+    }
+    context_->OnInstanceForwardBegin();
+    for (auto &layer : layers_) {
+        Status ret = layer->Forward();
+        if (ret != TNN_OK) {
+            LOGE("Forward error %s, exit\n", ret.description().c_str());
+            return ret;
+        }
+    }
+    context_->OnInstanceForwardEnd();
+    return context_->Synchronize();
+}
+
+Status CompiledNetwork::SetCpuNumThreads(int num_threads) {
+    if (context_)
+        return context_->SetNumThreads(num_threads);
+    else
+        return Status(TNNERR_CONTEXT_ERR, "context is nil");
+}
+
+Blob *CompiledNetwork::GetBlob(const std::string &name) {
+    auto iter = blob_map_.find(name);
+    return iter == blob_map_.end() ? nullptr : iter->second;
+}
+
+RawBuffer CompiledNetwork::MakeBuffer(const unsigned char *data, int bytes_size, DataType data_type) {
+    RawBuffer buffer(bytes_size, reinterpret_cast<const char *>(data));
+    buffer.SetDataType(data_type);
+    return buffer;
+}
+
+RawBuffer CompiledNetwork::MakeReadOnlyBuffer(const unsigned char *data, int bytes_size, DataType data_type) {
+    RawBuffer buffer = RawBuffer::ReadOnlyView(bytes_size, reinterpret_cast<const char *>(data));
+    buffer.SetDataType(data_type);
+    return buffer;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,117 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_COMPILED_NETWORK_H_
+#define TNN_SOURCE_TNN_CORE_COMPILED_NETWORK_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/blob.h"
+#include "tnn/core/common.h"
+#include "tnn/core/context.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_NS {
+
+static const int kCompiledMaxDims = 6;
+
+// @brief a blob of a compiled network, placed at a fixed offset of the forward memory
+struct CompiledBlobInfo {
+    const char *name;
+    int dims[kCompiledMaxDims];
+    int dims_size;
+    DataType data_type;
+    DataFormat data_format;
+    size_t offset;
+};
+
+// @brief a layer of a compiled network, its blobs are listed in CompiledNetInfo::layer_blobs
+struct CompiledLayerInfo {
+    LayerType type;
+    const char *name;
+    DeviceType device_type;
+    int inputs_begin;
+    int inputs_count;
+    int outputs_begin;
+    int outputs_count;
+};
+
+// @brief the tables generated by tnn2cpp, see tools/tnn2cpp
+struct CompiledNetInfo {
+    DeviceType device_type;
+    Precision precision;
+    size_t memory_size;
+    const CompiledBlobInfo *blobs;
+    int blob_count;
+    const CompiledLayerInfo *layers;
+    int layer_count;
+    const int *layer_blobs;
+};
+
+// @brief CompiledNetwork runs a network generated ahead of time by tnn2cpp. The optimized layers, the blob
+// shapes, formats and memory offsets are fixed at generation, so no model is interpreted, optimized or
+// planned at runtime. The layers run the same accs as DefaultNetwork, the outputs are identical.
+class CompiledNetwork {
+public:
+    ~CompiledNetwork();
+
+    // @brief create the layers and place the blobs, the params, resources and packed weights are in the order
+    // of the layers. the layer accs use the packed weights instead of packing them, empty if not packed ahead.
+    // the layer accs pack the weights at init if the packed ones are not in the layout of their impl.
+    Status Init(const CompiledNetInfo &info, std::vector<std::shared_ptr<LayerParam>> &params,
+                std::vector<std::shared_ptr<LayerResource>> &resources,
+                std::vector<PackedWeights> &packed_weights);
+
+    // @brief whether Init hands the weights packed ahead of time to the layer accs, true by default.
+    // otherwise the layer accs pack the weights at init as in DefaultNetwork.
+    void SetUsePackedWeights(bool use_packed_weights);
+
+    Status Forward();
+
+    Status SetCpuNumThreads(int num_threads);
+
+    // @brief get a blob by name, the input and output blobs keep the formats chosen at generation
+    Blob *GetBlob(const std::string &name);
+
+    // @brief copy the generated weights out of the read only data of the binary, the layers may write their
+    // resources
+    static RawBuffer MakeBuffer(const unsigned char *data, int bytes_size, DataType data_type);
+
+    // @brief view of the generated packed weights in the read only data of the binary, without a copy. the
+    // layer accs only read the packed weights, so their pages are shared by the processes running the binary
+    static RawBuffer MakeReadOnlyBuffer(const unsigned char *data, int bytes_size, DataType data_type);
+
+private:
+    AbstractDevice *device_  = nullptr;
+    Context *context_        = nullptr;
+    void *memory_            = nullptr;
+    bool use_packed_weights_ = true;
+
+    std::vector<std::shared_ptr<Blob>> blobs_;
+    std::map<std::string, Blob *> blob_map_;
+    std::vector<std::shared_ptr<BaseLayer>> layers_;
+    std::vector<std::shared_ptr<LayerParam>> params_;
+    std::vector<std::shared_ptr<LayerResource>> resources_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_COMPILED_NETWORK_H_
@@ -14,6 +14,8 @@
 
 #include "tnn/core/context.h"
 #include "tnn/core/profile.h"
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/numa_utils.h"
 #include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
@@ -40,14 +42,41 @@ Precision Context::GetPrecision() {
     return precision_;
 }
 
-#if TNN_PROFILE
-void Context::StartProfile() {
+Status Context::SetNumaNode(int numa_node) {
+    numa_cpu_mask_.clear();
+    if (numa_node < 0) {
+        return TNN_OK;
+    }
+    if (numa_node >= CpuUtils::GetNumaNodeCount()) {
+        return Status(TNNERR_PARAM_ERR, "numa_node exceeds the number of numa nodes");
+    }
+    std::vector<int> cpu_list;
+    RETURN_ON_NEQ(CpuUtils::GetNumaNodeCpuList(numa_node, cpu_list), TNN_OK);
+    // the mask is built once here, the threads are pinned to it in every forward
+    numa_cpu_mask_ = NumaUtils::GetCpuMask(cpu_list);
+    return TNN_OK;
+}
+
+void Context::SetKeepQuantizedWeights(bool keep) {
+    keep_quantized_weights_ = keep;
+}
+
+bool Context::GetKeepQuantizedWeights() {
+    return keep_quantized_weights_;
+}
+
+void Context::StartProfile(bool hardware_counters) {
     profile_layer     = true;
     profiling_result_ = std::make_shared<ProfileResult>();
+    profiling_recorder_.Start(65536, hardware_counters);
 }
 
 std::shared_ptr<ProfileResult> Context::FinishProfile() {
     profile_layer = false;
+    profiling_recorder_.Stop();
+    if (profiling_result_) {
+        profiling_result_->AddProfilingSpans(profiling_recorder_.GetSpans(), profiling_recorder_.GetLayers());
+    }
     return profiling_result_;
 }
 
@@ -56,6 +85,9 @@ void Context::AddProfilingData(std::shared_ptr<ProfilingData> pdata) {
         profiling_result_->AddProfilingData(pdata);
     }
 }
-#endif
+
+ProfilingRecorder *Context::GetProfilingRecorder() {
+    return &profiling_recorder_;
+}
 
 }  // namespace TNN_NS
@@ -55,20 +55,34 @@ public:
     // @brief get precision to run on device
     virtual Precision GetPrecision();
 
-#if TNN_PROFILE
+    // @brief run the forward threads on the cpus of the numa node, -1 for any cpu
+    Status SetNumaNode(int numa_node);
+
+    // @brief keep the weight only quantized weights for the layer accs dequantizing them in the kernel
+    void SetKeepQuantizedWeights(bool keep);
+
+    bool GetKeepQuantizedWeights();
+
 public:
-    virtual void StartProfile();
+    // @brief start to record the time of each layer
+    virtual void StartProfile(bool hardware_counters = false);
     virtual std::shared_ptr<ProfileResult> FinishProfile();
     void AddProfilingData(std::shared_ptr<ProfilingData> pdata);
 
+    // @brief recorder of the layer and worker spans, always valid
+    ProfilingRecorder *GetProfilingRecorder();
+
     bool profile_layer = false;
 
 protected:
     std::shared_ptr<ProfileResult> profiling_result_ = nullptr;
-#endif
+    ProfilingRecorder profiling_recorder_;
 
 protected:
     Precision precision_ = PRECISION_AUTO;
+    // mask of the cpus of the numa node, empty if not bound
+    std::vector<unsigned long> numa_cpu_mask_;
+    bool keep_quantized_weights_ = false;
 };
 
 }  // namespace TNN_NS
@@ -16,24 +16,27 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "tnn/core/blob_int8.h"
 #include "tnn/core/profile.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/interpreter/layer_param.h"
 #include "tnn/interpreter/layer_resource_generator.h"
+#include "tnn/optimizer/net_optimizer_insert_fallback_reformat.h"
 #include "tnn/optimizer/net_optimizer_manager.h"
 #include "tnn/utils/blob_dump_utils.h"
 #include "tnn/utils/blob_transfer_utils.h"
 #include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/numa_utils.h"
+#include "tnn/utils/thread_pool.h"
 
 namespace TNN_NS {
 
 NetworkImplFactoryRegister<NetworkImplFactory<DefaultNetwork>> g_network_impl_default_factory_register(
     NETWORK_TYPE_DEFAULT);
 
-std::mutex DefaultNetwork::optimize_mtx_;
-
 DefaultNetwork::DefaultNetwork()
     : device_(nullptr), context_(nullptr), blob_manager_(nullptr), net_structure_(nullptr) {}
 
@@ -67,6 +70,9 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         return Status(TNNERR_NULL_PARAM, "network_ is nil, network_type may not support");
     }
 
+    // the blob memory and packed weights are placed on the numa node of the instance
+    NumaNodeGuard numa_guard(net_config.numa_node);
+
     device_ = GetDevice(net_config.device_type);
     if (device_ == NULL) {
         return TNNERR_DEVICE_NOT_SUPPORT;
@@ -82,6 +88,12 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         return ret;
     }
 
+    ret = context_->SetNumaNode(net_config.numa_node);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    context_->SetKeepQuantizedWeights(net_config.keep_quantized_weights);
+
     ret = context_->LoadLibrary(net_config.library_path);
     if (ret != TNN_OK) {
         return ret;
@@ -91,15 +103,20 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
      * The NetOptimizeManager holds a list of network optimization processes.
      * The optimization process may change the network structure accoundingly.
      * eg. fuse conv+bn, conv+relu.
+     * The interpreted structure is shared by the instances, it is optimized on a copy which is cached by the
+     * interpreter for the instances of the same optimize key.
      */
-    {
-        // use mutex to protect net_resource and net_structure in multi-thread
-        std::unique_lock<std::mutex> lck(optimize_mtx_);
-        ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config);
-        if (ret != TNN_OK) {
-            return ret;
-        }
+    auto optimize_func = [&](NetStructure *structure) {
+        return optimizer::NetOptimizerManager::Optimize(structure, net_resource, net_config);
+    };
+    ret = default_interpreter->GetOptimizedNetStructure(optimizer::NetOptimizerManager::GetOptimizeKey(net_config),
+                                                        optimize_func, optimized_structure_);
+    if (ret != TNN_OK) {
+        return ret;
     }
+    net_structure = optimized_structure_.get();
+    // the fallback layers are the ones wrapped by the optimizer
+    fallback_device_ = optimizer::NetOptimizerInsertFallbackReformat::GetFallbackDevice(net_config, net_structure);
 
     blob_manager_ = new BlobManager(device_);
 
@@ -113,6 +130,19 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         return ret;
     }
 
+    std::set<std::string> blob_view_layers;
+    std::set<std::string> inplace_layers;
+    for (auto layer : layers_) {
+        if (layer->IsBlobViewSupported()) {
+            blob_view_layers.insert(layer->GetLayerName());
+        }
+        if (layer->IsInplaceSupported()) {
+            inplace_layers.insert(layer->GetLayerName());
+        }
+    }
+    blob_manager_->SetBlobViewLayers(blob_view_layers);
+    blob_manager_->SetInplaceLayers(inplace_layers);
+
     ret = blob_manager_->AllocateBlobMemory();
     if (ret != TNN_OK) {
         return ret;
@@ -130,10 +160,15 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
  *  2. Set data_tyep accordingly.
  *  3. Infer the blob shapes.
  *  4. Check the weights required.
+ * The layers are prepared in order. The accs of the layers with weights are initialized after all the
+ * layers are prepared, concurrently, since their weight transforms dominate the init time.
  */
 Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_resource) {
     Status ret = TNN_OK;
     bool is_quantized_net = GetQuantizedInfoFromNetStructure(net_structure);
+    std::vector<BaseLayer *> weight_layers;
+    // keep the lazily loaded resources until the weights are prepared
+    std::vector<std::shared_ptr<LayerResource>> weight_resources;
     for (auto layer_info : net_structure->layers) {
         LayerType type       = layer_info->type;
         BaseLayer *cur_layer = CreateLayer(type);
@@ -185,22 +220,73 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
             outputs.push_back(blob);
         }
 
-        LayerResource *layer_resource = nullptr;
-        if (net_resource->resource_map.count(layer_name) != 0) {
-            layer_resource = net_resource->resource_map[layer_name].get();
+        // resource is loaded here if the net resource is loaded lazily
+        auto layer_resource = GetLayerResource(net_resource, layer_name);
+
+        // the reformat layers inserted by the optimizer convert the blobs of the fallback layers to nchw
+        auto layer_device = IsFallbackLayer(type) ? fallback_device_ : device_;
+        ret = cur_layer->PrepareInit(context_, layer_info->param.get(), layer_resource.get(), inputs, outputs,
+                                     layer_device);
+        if (ret != TNN_OK) {
+            LOGE("Error Init layer %s (err: %d or 0x%X)\n", cur_layer->GetLayerName().c_str(), (int)ret, (int)ret);
+            delete cur_layer;
+            return ret;
         }
+        layers_.push_back(cur_layer);
 
-        ret = cur_layer->Init(context_, layer_info->param.get(), layer_resource, inputs, outputs, device_);
+        if (layer_resource) {
+            weight_layers.push_back(cur_layer);
+            weight_resources.push_back(layer_resource);
+            continue;
+        }
+        ret = cur_layer->InitLayerAcc();
         if (ret != TNN_OK) {
             LOGE("Error Init layer %s (err: %d or 0x%X)\n", cur_layer->GetLayerName().c_str(), (int)ret, (int)ret);
             return ret;
         }
+    }
 
-        layers_.push_back(cur_layer);
+    ret = InitLayerAccs(weight_layers);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    // the weights have been packed by the layer accs, the original resources
+    // can be loaded again by other instances if needed. the layers drop their
+    // pointers to the resources first.
+    for (auto layer : weight_layers) {
+        if (net_resource->lazy_loader && layer->IsResourceReleasable()) {
+            layer->ReleaseResource();
+            ReleaseLayerResource(net_resource, layer->GetLayerName());
+        }
     }
     return ret;
 }
 
+/*
+ * The threads of the shared pool pick the next layer and init its acc, which only touches the layer itself.
+ * A layer is initialized the same way whichever thread runs it, so the prepared weights do not depend on the
+ * threads. The pool is bounded by the cores, however many instances are initialized at once.
+ */
+Status DefaultNetwork::InitLayerAccs(std::vector<BaseLayer *> &layers) {
+    const int count = (int)layers.size();
+    std::vector<Status> status(count, TNN_OK);
+    ThreadPool::GetShared()->ParallelFor(count, [&](int i) {
+        // the prepared weights are placed on the numa node of the instance
+        NumaNodeGuard numa_guard(config_.numa_node);
+        status[i] = layers[i]->InitLayerAcc();
+    });
+
+    for (int i = 0; i < count; i++) {
+        if (status[i] != TNN_OK) {
+            LOGE("Error Init layer %s (err: %d or 0x%X)\n", layers[i]->GetLayerName().c_str(), (int)status[i],
+                 (int)status[i]);
+            return status[i];
+        }
+    }
+    return TNN_OK;
+}
+
 Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *net_resource, Blob **blob) {
     auto new_blob = new BlobInt8((*blob)->GetBlobDesc(), (*blob)->GetHandle());
     CHECK_PARAM_NULL(new_blob);
@@ -214,12 +300,13 @@ Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *ne
         net_resource->resource_map[blob_scale_name] = std::shared_ptr<LayerResource>(layer_res);
     }
 #endif
-    if (net_resource->resource_map.find(blob_scale_name) == net_resource->resource_map.end()) {
+    auto blob_scale_resource = GetLayerResource(net_resource, blob_scale_name);
+    if (!blob_scale_resource) {
         LOGE("Error Init layer, can not get output blob scale %s \n", blob_scale_name.c_str());
         return TNNERR_NULL_PARAM;
     }
 
-    new_blob->SetIntResource(reinterpret_cast<IntScaleResource *>(net_resource->resource_map[blob_scale_name].get()));
+    new_blob->SetIntResource(reinterpret_cast<IntScaleResource *>(blob_scale_resource.get()));
     blob_manager_->ReplaceBlob(name, new_blob);
     *blob = new_blob;
 
@@ -242,6 +329,9 @@ Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *ne
             if (layer_info->param->quantized && desc.data_type != DATA_TYPE_INT8) {
                 RETURN_ON_NEQ(GenerateInt8Blob(name, net_resource, blob), TNN_OK);
             }
+        } else if (IsFallbackLayer(layer_type)) {
+            // the fallback device runs in fp32
+            desc.data_type = DATA_TYPE_FLOAT;
         } else {
             bool layer_implemented_fp16 = device_->GetImplementedPrecision(layer_type)->fp16_implemented;
             // update blob of non-quantized network by config precision and enabled precision
@@ -269,6 +359,10 @@ Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *ne
     return TNN_OK;
 }
 
+bool DefaultNetwork::IsFallbackLayer(LayerType type) {
+    return optimizer::NetOptimizerInsertFallbackReformat::IsFallbackLayer(device_, fallback_device_, type);
+}
+
 Status DefaultNetwork::GetForwardMemorySize(int &memory_size) {
     memory_size = blob_manager_->GetAllBlobMemorySize();
     return TNN_OK;
@@ -278,6 +372,11 @@ Status DefaultNetwork::SetForwardMemory(void *memory) {
     return blob_manager_->SetForwardMemory(memory);
 }
 
+Status DefaultNetwork::BindBlobMemory(const std::string &blob_name, void *data, int bytes_size,
+                                      DataFormat data_format) {
+    return blob_manager_->BindExternalBlobMemory(blob_name, data, bytes_size, data_format);
+}
+
 Status DefaultNetwork::GetAllInputBlobs(BlobMap &blobs) {
     blob_manager_->GetAllInputBlobs(blobs);
     return TNN_OK;
@@ -292,28 +391,73 @@ Status DefaultNetwork::GetAllOutputBlobs(BlobMap &blobs) {
     return TNN_OK;
 }
 
+Status DefaultNetwork::GetAllBlobs(BlobMap &blobs) {
+    if (!net_structure_ || !blob_manager_) {
+        return Status(TNNERR_NET_ERR, "DefaultNetwork is not initialized");
+    }
+    for (auto &name : net_structure_->blobs) {
+        blobs[name] = blob_manager_->GetBlob(name);
+    }
+    return TNN_OK;
+}
+
+NetStructure *DefaultNetwork::GetNetStructure() {
+    return net_structure_;
+}
+
+Status DefaultNetwork::GetPackedWeights(std::map<std::string, PackedWeights> &packed_weights) {
+    for (auto layer : layers_) {
+        auto layer_packed_weights = layer->GetPackedWeights();
+        if (!layer_packed_weights.buffers.empty()) {
+            packed_weights[layer->GetLayerName()] = layer_packed_weights;
+        }
+    }
+    return TNN_OK;
+}
+
 /*
  * Reshape function is called when the input shape changes.
  * Memory allocation may be involved in Reshape function.
+ * The shapes are rejected if the memory bound by the user is too small for
+ * them, the network keeps the previous shapes then. The blob memory is planned
+ * again if the shapes change the blob views, SET_FROM_EXTERNAL instances need
+ * to set the forward memory again then.
  */
 Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
+    InputShapesMap previous_inputs;
     for (auto iter : inputs) {
         Blob *blob = blob_manager_->GetBlob(iter.first);
         if (blob == nullptr) {
             LOGE("DefaultNetwork reshape blob is empty\n");
             return Status(TNNERR_PARAM_ERR, "DefaultNetwork reshape blob is empty");
         }
-        blob->GetBlobDesc().dims = iter.second;
+        previous_inputs[iter.first] = blob->GetBlobDesc().dims;
+        blob->GetBlobDesc().dims    = iter.second;
     }
 
-    Status ret = TNN_OK;
+    NumaNodeGuard numa_guard(config_.numa_node);
+    Status ret = ReshapeLayers();
+    if (ret == TNN_OK) {
+        ret = blob_manager_->CheckExternalBlobMemory();
+    }
+    if (ret != TNN_OK && !previous_inputs.empty()) {
+        for (auto iter : previous_inputs) {
+            blob_manager_->GetBlob(iter.first)->GetBlobDesc().dims = iter.second;
+        }
+        ReshapeLayers();
+    }
+    return ret;
+}
+
+Status DefaultNetwork::ReshapeLayers() {
     for (auto cur_layer : layers_) {
-        ret = cur_layer->Reshape();
+        Status ret = cur_layer->Reshape();
         if (ret != TNN_OK) {
             return ret;
         }
     }
-    return ret;
+    // the blob views and their channel offsets depend on the shapes
+    return blob_manager_->ReshapeBlobViews();
 }
 
 Status DefaultNetwork::DeInit() {
@@ -323,6 +467,7 @@ Status DefaultNetwork::DeInit() {
         }
     }
     layers_.clear();
+    partial_layers_cache_.clear();
 
     if (blob_manager_ != NULL) {
         delete blob_manager_;
@@ -352,6 +497,107 @@ Status DefaultNetwork::GetCommandQueue(void **command_queue) {
 }
 
 Status DefaultNetwork::Forward() {
+    if (!planned_layers_.empty()) {
+        LOGE("DefaultNetwork Forward: the memory is planned for partial outputs only\n");
+        return Status(TNNERR_NET_ERR, "DefaultNetwork Forward: the memory is planned for partial outputs only");
+    }
+    return ForwardLayers(layers_);
+}
+
+/*
+ * ForwardPartial runs the ancestors of the given outputs only.
+ * The output names must be output blobs of the network, so their memory is
+ * never reused by other blobs, see BlobManager::GetBlobUseCount.
+ */
+Status DefaultNetwork::ForwardPartial(const std::set<std::string> &output_names) {
+    std::vector<BaseLayer *> *layers = nullptr;
+    Status result                    = GetPartialLayers(output_names, &layers);
+    if (result != TNN_OK) {
+        return result;
+    }
+    if (!planned_layers_.empty()) {
+        for (auto layer : *layers) {
+            if (planned_layers_.count(layer) == 0) {
+                LOGE("DefaultNetwork ForwardPartial: the memory of layer %s is not planned\n",
+                     layer->GetLayerName().c_str());
+                return Status(TNNERR_PARAM_ERR, "DefaultNetwork ForwardPartial: outputs are not in the partial outputs");
+            }
+        }
+    }
+    return ForwardLayers(*layers);
+}
+
+/*
+ * The blob memory is planned for the layers required by the output set only,
+ * the blobs of the pruned layers get no memory and are not counted as users of
+ * the memory shared by the others. An empty set plans all the layers again.
+ */
+Status DefaultNetwork::SetPartialOutputs(const std::set<std::string> &output_names) {
+    std::set<BaseLayer *> planned_layers;
+    std::set<std::string> layer_names;
+    if (!output_names.empty()) {
+        std::vector<BaseLayer *> *layers = nullptr;
+        RETURN_ON_NEQ(GetPartialLayers(output_names, &layers), TNN_OK);
+        for (auto layer : *layers) {
+            planned_layers.insert(layer);
+            layer_names.insert(layer->GetLayerName());
+        }
+    }
+    RETURN_ON_NEQ(blob_manager_->SetActiveLayers(layer_names), TNN_OK);
+    planned_layers_ = planned_layers;
+    return TNN_OK;
+}
+
+/*
+ * The layers required by an output set are collected by walking layers_
+ * backward, a layer is required if any of its outputs is required.
+ * The schedule is cached for each output set.
+ */
+Status DefaultNetwork::GetPartialLayers(const std::set<std::string> &output_names, std::vector<BaseLayer *> **layers) {
+    auto iter = partial_layers_cache_.find(output_names);
+    if (iter != partial_layers_cache_.end()) {
+        *layers = &iter->second;
+        return TNN_OK;
+    }
+
+    BlobMap output_blobs;
+    blob_manager_->GetAllOutputBlobs(output_blobs);
+
+    std::set<Blob *> required_blobs;
+    for (auto name : output_names) {
+        if (output_blobs.find(name) == output_blobs.end()) {
+            LOGE("DefaultNetwork ForwardPartial: %s is not an output blob\n", name.c_str());
+            return Status(TNNERR_PARAM_ERR, "DefaultNetwork ForwardPartial: invalid output name");
+        }
+        required_blobs.insert(output_blobs[name]);
+    }
+
+    std::vector<BaseLayer *> partial_layers;
+    for (auto layer_iter = layers_.rbegin(); layer_iter != layers_.rend(); ++layer_iter) {
+        auto layer    = *layer_iter;
+        bool required = false;
+        for (auto blob : layer->GetOutputBlobs()) {
+            if (required_blobs.count(blob) > 0) {
+                required = true;
+                break;
+            }
+        }
+        if (!required) {
+            continue;
+        }
+        for (auto blob : layer->GetInputBlobs()) {
+            required_blobs.insert(blob);
+        }
+        partial_layers.push_back(layer);
+    }
+    std::reverse(partial_layers.begin(), partial_layers.end());
+
+    LOGD("DefaultNetwork ForwardPartial: run %d of %d layers\n", (int)partial_layers.size(), (int)layers_.size());
+    *layers = &(partial_layers_cache_[output_names] = partial_layers);
+    return TNN_OK;
+}
+
+Status DefaultNetwork::ForwardLayers(std::vector<BaseLayer *> &layers) {
     Status result = TNN_OK;
     result        = blob_manager_->CheckBlobMemoryState();
     if (result != TNN_OK) {
@@ -360,11 +606,9 @@ Status DefaultNetwork::Forward() {
 
     context_->OnInstanceForwardBegin();
     int cnt = 0;
-    for (auto layer : layers_) {
-        std::vector<Blob *> inputs  = layer->GetInputBlobs();
-        std::vector<Blob *> outputs = layer->GetOutputBlobs();
-
+    for (auto layer : layers) {
 #if DUMP_INPUT_BLOB
+        std::vector<Blob *> inputs = layer->GetInputBlobs();
         // InputBlob data in dumped into files in NCHW_FLOAT format as default
         std::string filename = layer->GetLayerName();
         std::replace(filename.begin(), filename.end(), '/', '_');
@@ -392,6 +636,7 @@ Status DefaultNetwork::Forward() {
         }
 
 #if DUMP_OUTPUT_BLOB
+        std::vector<Blob *> outputs = layer->GetOutputBlobs();
         // OutBlob data in dumped into files in NCHW_FLOAT format as default
         std::string out_file_name = layer->GetLayerName();
         std::replace(out_file_name.begin(), out_file_name.end(), '/', '_');
@@ -474,14 +719,12 @@ Status DefaultNetwork::ForwardAsync(Callback call_back) {
     return result;
 }
 
-#if TNN_PROFILE
-void DefaultNetwork::StartProfile() {
-    context_->StartProfile();
+void DefaultNetwork::StartProfile(bool hardware_counters) {
+    context_->StartProfile(hardware_counters);
 }
 
 std::shared_ptr<ProfileResult> DefaultNetwork::FinishProfile() {
     return context_->FinishProfile();
 }
-#endif
 
 }  // namespace TNN_NS
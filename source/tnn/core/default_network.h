@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 #define TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 
+#include <map>
+#include <set>
 #include <vector>
 
 #include "tnn/core/abstract_device.h"
@@ -63,6 +65,12 @@ public:
     // @brief network forward
     virtual Status Forward();
 
+    // @brief network forward with the layers required by output_names
+    virtual Status ForwardPartial(const std::set<std::string> &output_names);
+
+    // @brief plan the blob memory for the layers required by output_names only
+    virtual Status SetPartialOutputs(const std::set<std::string> &output_names);
+
 #ifdef FORWARD_CALLBACK_ENABLE
     // @brief network infer with callbach to statistic blob info
     virtual Status ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after);
@@ -80,6 +88,9 @@ public:
     // @brief set forward memory when share memory mode is set from external
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief bind memory allocated by the user to an input or output blob
+    virtual Status BindBlobMemory(const std::string &blob_name, void *data, int bytes_size, DataFormat data_format);
+
     // @brief get all input blobs
     virtual Status GetAllInputBlobs(BlobMap &blobs);
 
@@ -89,30 +100,49 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
-#if TNN_PROFILE
+    // @brief get all blobs of the network, including the intermediate blobs
+    Status GetAllBlobs(BlobMap &blobs);
+
+    // @brief get the optimized net structure the layers are created from
+    NetStructure *GetNetStructure();
+
+    // @brief get the weights packed by the layer accs, by layer name
+    Status GetPackedWeights(std::map<std::string, PackedWeights> &packed_weights);
+
 public:
-    virtual void StartProfile();
+    virtual void StartProfile(bool hardware_counters = false);
     virtual std::shared_ptr<ProfileResult> FinishProfile();
-#endif
 
 private:
     virtual Status InitLayers(NetStructure *net_structure, NetResource *net_resource);
+    Status InitLayerAccs(std::vector<BaseLayer *> &layers);
     Status GenerateInt8Blob(const std::string &name, NetResource *net_resource, Blob **blob);
     Status UpdateBlobPrecision(std::shared_ptr<LayerInfo> layer_info, bool is_input, bool is_quantized_net,
                                const std::string &name, NetResource *net_resource, Blob **blob);
+    Status ForwardLayers(std::vector<BaseLayer *> &layers);
+    Status ReshapeLayers();
+    Status GetPartialLayers(const std::set<std::string> &output_names, std::vector<BaseLayer *> **layers);
+    bool IsFallbackLayer(LayerType type);
 
     AbstractDevice *device_ = nullptr;
-    Context *context_       = nullptr;
+    // runs the layers not implemented on device_, sharing the host memory of the blobs
+    AbstractDevice *fallback_device_ = nullptr;
+    Context *context_                = nullptr;
 
     std::vector<BaseLayer *> layers_;
 
+    // layers to run for each output set of ForwardPartial, in the order of layers_
+    std::map<std::set<std::string>, std::vector<BaseLayer *>> partial_layers_cache_;
+    // layers whose blob memory is planned, empty if all of them are
+    std::set<BaseLayer *> planned_layers_;
+
     BlobManager *blob_manager_ = nullptr;
 
     NetStructure *net_structure_ = nullptr;
+    // the optimized copy of the interpreted structure, shared with the instances of the same config
+    std::shared_ptr<NetStructure> optimized_structure_;
 
     NetworkConfig config_;
-
-    static std::mutex optimize_mtx_;
 };
 
 }  // namespace TNN_NS
@@ -67,6 +67,10 @@ Status Instance::SetForwardMemory(void *memory) {
     return network_->SetForwardMemory(memory);
 }
 
+Status Instance::BindBlobMemory(const std::string &blob_name, void *data, int bytes_size, DataFormat data_format) {
+    return network_->BindBlobMemory(blob_name, data, bytes_size, data_format);
+}
+
 Status Instance::Reshape(const InputShapesMap &inputs) {
     return (Status)network_->Reshape(inputs);
 }
@@ -80,6 +84,15 @@ Status Instance::Forward() {
     return (Status)network_->Forward();
 }
 
+Status Instance::ForwardPartial(const std::set<std::string> &output_names) {
+    output_mats_convert_status_.clear();
+    return (Status)network_->ForwardPartial(output_names);
+}
+
+Status Instance::SetPartialOutputs(const std::set<std::string> &output_names) {
+    return (Status)network_->SetPartialOutputs(output_names);
+}
+
 #ifdef FORWARD_CALLBACK_ENABLE
 Status Instance::ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after) {
     output_mats_convert_status_.clear();
@@ -223,16 +236,15 @@ Status Instance::GetOutputMat(std::shared_ptr<Mat> &mat, MatConvertParam param,
     return status;
 }
 
-#if TNN_PROFILE
-void Instance::StartProfile() {
-    network_->StartProfile();
+void Instance::StartProfile(bool hardware_counters) {
+    network_->StartProfile(hardware_counters);
 }
 
 std::string Instance::FinishProfile(bool do_print) {
-    std::shared_ptr<ProfileResult> profile_result = network_->FinishProfile();
-    std::string result_str                        = " ";
-    if (profile_result) {
-        result_str = profile_result->GetProfilingDataInfo();
+    profile_result_        = network_->FinishProfile();
+    std::string result_str = " ";
+    if (profile_result_) {
+        result_str = profile_result_->GetProfilingDataInfo();
         if (do_print) {
             printf("%s", result_str.c_str());
         }
@@ -241,6 +253,8 @@ std::string Instance::FinishProfile(bool do_print) {
     return result_str;
 }
 
-#endif
+std::string Instance::GetProfileTrace() {
+    return profile_result_ ? profile_result_->GetTraceJson() : "";
+}
 
 }  // namespace TNN_NS
@@ -0,0 +1,318 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/instance_pool.h"
+
+#include <algorithm>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+static double ElapsedMs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+InstancePool::Lease::Lease() {}
+
+InstancePool::Lease::~Lease() {
+    Release();
+}
+
+InstancePool::Lease::Lease(Lease&& other) : pool_(other.pool_), index_(other.index_) {
+    other.pool_  = nullptr;
+    other.index_ = -1;
+}
+
+InstancePool::Lease& InstancePool::Lease::operator=(Lease&& other) {
+    if (this != &other) {
+        Release();
+        pool_        = other.pool_;
+        index_       = other.index_;
+        other.pool_  = nullptr;
+        other.index_ = -1;
+    }
+    return *this;
+}
+
+void InstancePool::Lease::Release() {
+    if (pool_) {
+        pool_->Release(index_);
+    }
+    pool_  = nullptr;
+    index_ = -1;
+}
+
+bool InstancePool::Lease::IsValid() const {
+    return pool_ != nullptr;
+}
+
+Instance* InstancePool::Lease::operator->() const {
+    return GetInstance().get();
+}
+
+std::shared_ptr<Instance> InstancePool::Lease::GetInstance() const {
+    return pool_ ? pool_->slots_[index_].instance : nullptr;
+}
+
+InstancePool::InstancePool() {}
+
+InstancePool::~InstancePool() {
+    Clear();
+}
+
+Status InstancePool::Init(TNN& tnn, NetworkConfig& config, const InstancePoolConfig& pool_config,
+                          InputShapesMap inputs_shape) {
+    // a pool failed to init is left empty, with no instance or arena kept
+    Clear();
+    const int num_instances = pool_config.num_instances;
+    if (num_instances <= 0) {
+        return Status(TNNERR_PARAM_ERR, "num_instances must be positive");
+    }
+    if (pool_config.cpu_list.size() > 0 && pool_config.cpu_list.size() < num_instances) {
+        return Status(TNNERR_PARAM_ERR, "cpu_list has less cpus than num_instances");
+    }
+    if (pool_config.num_arenas < 0) {
+        return Status(TNNERR_PARAM_ERR, "num_arenas must not be negative");
+    }
+
+    config_ = config;
+    if (pool_config.num_arenas > 0) {
+        config_.share_memory_mode = SHARE_MEMORY_MODE_SET_FROM_EXTERNAL;
+    }
+
+    Status status = CreateInstances(tnn, pool_config, inputs_shape);
+    if (status != TNN_OK) {
+        Clear();
+        return status;
+    }
+
+    for (int i = num_instances - 1; i >= 0; i--) {
+        idle_.push_back(i);
+    }
+    ResetStats();
+    return TNN_OK;
+}
+
+Status InstancePool::CreateInstances(TNN& tnn, const InstancePoolConfig& pool_config, InputShapesMap& inputs_shape) {
+    const int num_instances = pool_config.num_instances;
+    slots_.resize(num_instances);
+    const int cpus_per_instance = (int)pool_config.cpu_list.size() / num_instances;
+    for (int i = 0; i < num_instances; i++) {
+        Status status;
+        auto& slot    = slots_[i];
+        slot.instance = tnn.CreateInst(config_, status, inputs_shape);
+        if (status != TNN_OK || !slot.instance) {
+            LOGE("InstancePool create instance %d failed: %s\n", i, status.description().c_str());
+            return status != TNN_OK ? status : Status(TNNERR_ALLOC_INSTANCE, "create instance failed");
+        }
+        if (cpus_per_instance > 0) {
+            auto begin    = pool_config.cpu_list.begin() + i * cpus_per_instance;
+            slot.cpu_list = std::vector<int>(begin, begin + cpus_per_instance);
+            RETURN_ON_NEQ(slot.instance->SetCpuNumThreads(cpus_per_instance), TNN_OK);
+        }
+    }
+
+    // each arena is as large as the largest forward memory of its instances, like SHARE_ONE_THREAD
+    const int num_arenas = std::min(pool_config.num_arenas, num_instances);
+    if (num_arenas > 0) {
+        std::vector<int> arena_sizes(num_arenas, 0);
+        for (int i = 0; i < num_instances; i++) {
+            int memory_size = 0;
+            RETURN_ON_NEQ(slots_[i].instance->GetForwardMemorySize(memory_size), TNN_OK);
+            int arena          = i % num_arenas;
+            slots_[i].arena    = arena;
+            arena_sizes[arena] = std::max(arena_sizes[arena], memory_size);
+        }
+
+        AbstractDevice* device = GetDevice(config_.device_type);
+        if (!device) {
+            return Status(TNNERR_DEVICE_NOT_SUPPORT, "InstancePool device is not supported");
+        }
+        for (int a = 0; a < num_arenas; a++) {
+            void* arena = nullptr;
+            BlobMemorySizeInfo info;
+            info.dims.push_back(std::max(arena_sizes[a], 1));
+            RETURN_ON_NEQ(device->Allocate(&arena, info), TNN_OK);
+            arenas_.push_back(arena);
+        }
+        for (int i = 0; i < num_instances; i++) {
+            RETURN_ON_NEQ(slots_[i].instance->SetForwardMemory(arenas_[slots_[i].arena]), TNN_OK);
+        }
+    }
+    arena_leased_.assign(arenas_.size(), false);
+    return TNN_OK;
+}
+
+void InstancePool::Clear() {
+    // the instances must be released before their forward memory
+    slots_.clear();
+    idle_.clear();
+    FreeArenas();
+}
+
+void InstancePool::FreeArenas() {
+    if (arenas_.size() > 0) {
+        AbstractDevice* device = GetDevice(config_.device_type);
+        for (auto arena : arenas_) {
+            device->Free(arena);
+        }
+    }
+    arenas_.clear();
+    arena_leased_.clear();
+}
+
+// the position in idle_ of the idle instance last given back whose arena is free, -1 if none
+int InstancePool::FindIdleInstance() {
+    for (int i = (int)idle_.size() - 1; i >= 0; i--) {
+        int arena = slots_[idle_[i]].arena;
+        if (arena < 0 || !arena_leased_[arena]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Status InstancePool::Acquire(Lease& lease, int timeout_ms) {
+    lease.Release();
+    if (slots_.empty()) {
+        return Status(TNNERR_INST_ERR, "InstancePool is not initialized");
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    int index  = -1;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        int position = FindIdleInstance();
+        if (position < 0) {
+            num_waiting_++;
+            auto ready = [&] {
+                position = FindIdleInstance();
+                return position >= 0;
+            };
+            bool found = true;
+            if (timeout_ms < 0) {
+                cond_.wait(lock, ready);
+            } else {
+                found = cond_.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+            }
+            num_waiting_--;
+            if (!found) {
+                num_timeouts_++;
+                return Status(TNNERR_INST_TIMEOUT, "InstancePool acquire timeout");
+            }
+        }
+
+        index = idle_[position];
+        idle_.erase(idle_.begin() + position);
+        auto& slot = slots_[index];
+        if (slot.arena >= 0) {
+            arena_leased_[slot.arena] = true;
+        }
+        slot.leased      = true;
+        slot.lease_start = std::chrono::steady_clock::now();
+
+        double wait_ms = ElapsedMs(begin, slot.lease_start);
+        num_leases_++;
+        total_wait_ms_ += wait_ms;
+        max_wait_ms_ = std::max(max_wait_ms_, wait_ms);
+    }
+
+    lease.pool_  = this;
+    lease.index_ = index;
+    return PinCurrentThread(index);
+}
+
+void InstancePool::Release(int index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = slots_[index];
+        if (!slot.leased) {
+            return;
+        }
+        auto start = std::max(slot.lease_start, stats_start_);
+        slot.busy_ms += ElapsedMs(start, std::chrono::steady_clock::now());
+        slot.leased = false;
+        if (slot.arena >= 0) {
+            arena_leased_[slot.arena] = false;
+        }
+        idle_.push_back(index);
+    }
+    // waiters of an arena need the instance given back, wake all
+    cond_.notify_all();
+}
+
+Status InstancePool::PinCurrentThread(int index) {
+    const auto& cpu_list = slots_[index].cpu_list;
+    if (cpu_list.empty()) {
+        return TNN_OK;
+    }
+    // the layers run on the calling thread and the omp threads it starts, the calling thread is omp thread 0
+    const int num_threads = (int)cpu_list.size();
+    std::vector<int> pinned(num_threads, 1);
+    OMP_SET_THREADS_(num_threads);
+    OMP_PARALLEL_FOR_
+    for (int t = 0; t < num_threads; t++) {
+        pinned[t] = CpuUtils::SetCpuAffinity(cpu_list) == TNN_OK;
+    }
+    for (int t = 0; t < num_threads; t++) {
+        if (!pinned[t]) {
+            return Status(TNNERR_SET_CPU_AFFINITY, "InstancePool set cpu affinity failed");
+        }
+    }
+    return TNN_OK;
+}
+
+InstancePoolStats InstancePool::GetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    InstancePoolStats stats;
+    stats.num_instances = (int)slots_.size();
+    stats.num_waiting   = num_waiting_;
+    stats.num_leases    = num_leases_;
+    stats.num_timeouts  = num_timeouts_;
+    stats.total_wait_ms = total_wait_ms_;
+    stats.max_wait_ms   = max_wait_ms_;
+    stats.avg_wait_ms   = num_leases_ > 0 ? total_wait_ms_ / num_leases_ : 0;
+
+    auto now          = std::chrono::steady_clock::now();
+    double elapsed_ms = ElapsedMs(stats_start_, now);
+    double total_busy = 0;
+    for (auto& slot : slots_) {
+        double busy_ms = slot.busy_ms;
+        if (slot.leased) {
+            stats.num_leased++;
+            busy_ms += ElapsedMs(std::max(slot.lease_start, stats_start_), now);
+        }
+        total_busy += busy_ms;
+        stats.instance_utilisation.push_back(elapsed_ms > 0 ? busy_ms / elapsed_ms : 0);
+    }
+    stats.utilisation = elapsed_ms > 0 && slots_.size() > 0 ? total_busy / elapsed_ms / slots_.size() : 0;
+    return stats;
+}
+
+void InstancePool::ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_leases_    = 0;
+    num_timeouts_  = 0;
+    total_wait_ms_ = 0;
+    max_wait_ms_   = 0;
+    for (auto& slot : slots_) {
+        slot.busy_ms = 0;
+    }
+    stats_start_ = std::chrono::steady_clock::now();
+}
+
+}  // namespace TNN_NS
@@ -13,8 +13,12 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/core/profile.h"
+#include <string.h>
 #include <time.h>
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
+#include <map>
 #include <sstream>
 
 #include "tnn/core/status.h"
@@ -35,6 +39,11 @@ void ProfilingData::Add(ProfilingData* data) {
 
     kernel_time += data->kernel_time;
     count += data->count;
+    cycles += data->cycles;
+    instructions += data->instructions;
+    l1d_misses += data->l1d_misses;
+    llc_misses += data->llc_misses;
+    branch_misses += data->branch_misses;
 
     if (input_dims.size() <= 0) {
         input_dims = data->input_dims;
@@ -61,11 +70,134 @@ void ProfilingData::Add(ProfilingData* data) {
     }
 }
 
-#if TNN_PROFILE
+void ProfilingRecorder::Start(int capacity, bool hardware_counters) {
+    enabled_ = false;
+    spans_.assign(std::max(capacity, 1), ProfilingSpan());
+    worker_spans_.assign(std::max(capacity, 1), ProfilingSpan());
+    counters_.Close();
+    if (hardware_counters) {
+        Status status = counters_.Open();
+        if (status != TNN_OK) {
+            LOGE("hardware counters are not captured: %s\n", status.description().c_str());
+        }
+    }
+    next_span_        = 0;
+    next_worker_span_ = 0;
+    layers_.clear();
+    current_layer_ = -1;
+    session_++;
+    origin_  = Now();
+    enabled_ = true;
+}
+
+void ProfilingRecorder::Stop() {
+    enabled_ = false;
+    counters_.Close();
+}
+
+int ProfilingRecorder::AddLayer(std::shared_ptr<ProfilingData> pdata) {
+    layers_.push_back(pdata);
+    return (int)layers_.size() - 1;
+}
+
+std::vector<std::shared_ptr<ProfilingData>> ProfilingRecorder::GetLayers() {
+    return layers_;
+}
+
+int ProfilingRecorder::GetSession() {
+    return session_;
+}
+
+int ProfilingRecorder::GetCurrentLayer() {
+    return current_layer_.load(std::memory_order_acquire);
+}
+
+ProfilingSpan &ProfilingRecorder::NextSpan(std::vector<ProfilingSpan> &spans,
+                                           std::atomic<unsigned long long> &next_span) {
+    // workers may record concurrently, each of them takes its own slot
+    auto index = next_span.fetch_add(1, std::memory_order_relaxed) % spans.size();
+    return spans[index];
+}
+
+void ProfilingRecorder::BeginLayer(int layer_id) {
+    current_layer_.store(layer_id, std::memory_order_release);
+    if (counters_.IsOpened()) {
+        counters_.Begin();
+    }
+    layer_start_ = Now();
+}
+
+void ProfilingRecorder::EndLayer() {
+    double end = Now();
+    int layer_id = current_layer_.exchange(-1, std::memory_order_acq_rel);
+    if (!IsEnabled()) {
+        return;
+    }
+    auto &span     = NextSpan(spans_, next_span_);
+    span.layer_id  = layer_id;
+    span.thread_id = 0;
+    span.start     = layer_start_ - origin_;
+    span.duration  = end - layer_start_;
+    memset(span.counters, 0, sizeof(span.counters));
+    if (counters_.IsOpened()) {
+        counters_.End(span.counters);
+    }
+}
+
+void ProfilingRecorder::Record(int layer_id, int thread_id, double start, double end) {
+    if (!IsEnabled()) {
+        return;
+    }
+    auto &span     = NextSpan(thread_id == 0 ? spans_ : worker_spans_, thread_id == 0 ? next_span_ : next_worker_span_);
+    span.layer_id  = layer_id;
+    span.thread_id = thread_id;
+    span.start     = start - origin_;
+    span.duration  = end - start;
+    memset(span.counters, 0, sizeof(span.counters));
+}
+
+// the spans left in a ring, oldest first
+static void AppendSpans(const std::vector<ProfilingSpan> &ring, unsigned long long count,
+                        std::vector<ProfilingSpan> &spans) {
+    unsigned long long size  = ring.size();
+    unsigned long long first = count > size ? count - size : 0;
+    for (unsigned long long i = first; i < count; i++) {
+        spans.push_back(ring[i % size]);
+    }
+}
+
+std::vector<ProfilingSpan> ProfilingRecorder::GetSpans() {
+    std::vector<ProfilingSpan> spans;
+    AppendSpans(spans_, next_span_, spans);
+    AppendSpans(worker_spans_, next_worker_span_, spans);
+    return spans;
+}
+
+double ProfilingRecorder::Now() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(now).count();
+}
+
+ProfilingScope::ProfilingScope(ProfilingRecorder *recorder, int thread_id) {
+    if (recorder && recorder->IsEnabled()) {
+        recorder_  = recorder;
+        thread_id_ = thread_id;
+        start_     = ProfilingRecorder::Now();
+    }
+}
+
+ProfilingScope::~ProfilingScope() {
+    if (recorder_) {
+        recorder_->Record(recorder_->GetCurrentLayer(), thread_id_, start_, ProfilingRecorder::Now());
+    }
+}
+
 ProfileResult::~ProfileResult() {}
 
 void ProfileResult::Reset() {
     profiling_data_.clear();
+    spans_.clear();
+    span_layers_.clear();
 }
 
 /*
@@ -97,6 +229,32 @@ void ProfileResult::AddProfileResult(std::shared_ptr<ProfileResult> result) {
     }
 }
 
+/*
+call this function in context, the layer time of devices with own kernel timing is kept
+*/
+void ProfileResult::AddProfilingSpans(const std::vector<ProfilingSpan>& spans,
+                                      const std::vector<std::shared_ptr<ProfilingData>>& layers) {
+    bool has_kernel_time = !profiling_data_.empty();
+    for (auto span : spans) {
+        if (span.layer_id < 0 || span.layer_id >= (int)layers.size()) {
+            continue;
+        }
+        if (span.thread_id == 0 && !has_kernel_time) {
+            auto pdata         = std::make_shared<ProfilingData>(*layers[span.layer_id]);
+            pdata->kernel_time   = span.duration / 1000.0;
+            pdata->count         = 1;
+            pdata->cycles        = span.counters[PERF_COUNTER_CYCLES];
+            pdata->instructions  = span.counters[PERF_COUNTER_INSTRUCTIONS];
+            pdata->l1d_misses    = span.counters[PERF_COUNTER_L1D_MISSES];
+            pdata->llc_misses    = span.counters[PERF_COUNTER_LLC_MISSES];
+            pdata->branch_misses = span.counters[PERF_COUNTER_BRANCH_MISSES];
+            AddProfilingData(pdata);
+        }
+    }
+    spans_       = spans;
+    span_layers_ = layers;
+}
+
 /*
 get profilint data vector
 */
@@ -109,9 +267,18 @@ format print profile info
 */
 std::string ProfileResult::GetProfilingDataInfo() {
     // show the time cost of each layer
-    std::string title                     = "Profiling Data";
-    const std::vector<std::string> header = {"name",         "Op Type", "Kernel(ms)", "Input Dims", "Output Dims",
-                                             "Filter(OIHW)", "Stride",  "Pad",        "Dilation"};
+    std::string title              = "Profiling Data";
+    std::vector<std::string> header = {"name",       "Op Type",     "Kernel(ms)",   "GFLOPS", "GB/s", "B/flop",
+                                       "Input Dims", "Output Dims", "Filter(OIHW)", "Stride", "Pad",  "Dilation"};
+
+    // the counter columns are shown only if the hardware counters are captured
+    bool has_counters = false;
+    for (auto p : profiling_data_) {
+        has_counters = has_counters || p->cycles > 0;
+    }
+    if (has_counters) {
+        header.insert(header.begin() + 6, {"IPC", "L1D Miss(K)", "LLC Miss(K)", "Br Miss(K)", "LLC B/flop"});
+    }
 
     std::vector<std::vector<std::string>> data;
 
@@ -119,11 +286,25 @@ std::string ProfileResult::GetProfilingDataInfo() {
 
     for (auto p : profiling_data_) {
         std::vector<std::string> tuple;
-        tuple.reserve(16);
+        tuple.reserve(20);
 
         tuple.push_back(p->layer_name);
         tuple.push_back(p->op_name);
-        tuple.push_back(DoubleToString(p->kernel_time / p->count));
+        // mflops and mbytes per ms are giga per second
+        double kernel_time = p->kernel_time / p->count;
+        tuple.push_back(DoubleToString(kernel_time));
+        tuple.push_back(DoubleToString(kernel_time > 0 ? p->flops / kernel_time : 0));
+        tuple.push_back(DoubleToString(kernel_time > 0 ? p->bandwidth / kernel_time : 0));
+        tuple.push_back(DoubleToString(p->flops > 0 ? p->bandwidth / p->flops : 0));
+        if (has_counters) {
+            // each llc miss loads one cache line of 64 bytes from memory
+            double flops = p->flops * 1000.0 * 1000.0 * p->count;
+            tuple.push_back(DoubleToString(p->cycles > 0 ? p->instructions / p->cycles : 0));
+            tuple.push_back(DoubleToString(p->l1d_misses / p->count / 1000.0));
+            tuple.push_back(DoubleToString(p->llc_misses / p->count / 1000.0));
+            tuple.push_back(DoubleToString(p->branch_misses / p->count / 1000.0));
+            tuple.push_back(DoubleToString(flops > 0 ? p->llc_misses * 64.0 / flops : 0));
+        }
         tuple.push_back(VectorToString(p->input_dims));
         tuple.push_back(VectorToString(p->output_dims));
         tuple.push_back(VectorToString(p->kernel_shape));
@@ -186,6 +367,60 @@ std::string ProfileResult::GetProfilingDataSummary(bool do_average) {
     std::string show_string_summary = StringFormatter::Table(title_summary, header_summary, data_summary);
     return show_string_summary;
 }
-#endif
+
+static std::string JsonEscape(const std::string& str) {
+    std::ostringstream ostr;
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            ostr << '\\' << c;
+        } else if ((unsigned char)c < 0x20) {
+            ostr << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec;
+        } else {
+            ostr << c;
+        }
+    }
+    return ostr.str();
+}
+
+/*
+chrome trace_event format: one complete event per span, layer spans on tid 0 and worker spans on tid omp id + 1
+*/
+std::string ProfileResult::GetTraceJson() {
+    std::ostringstream ostr;
+    ostr << std::fixed << std::setprecision(3);
+    ostr << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    std::map<int, bool> threads;
+    bool first = true;
+    for (auto span : spans_) {
+        if (span.layer_id < 0 || span.layer_id >= (int)span_layers_.size()) {
+            continue;
+        }
+        auto layer = span_layers_[span.layer_id];
+        threads[span.thread_id] = true;
+        ostr << (first ? "" : ",") << "\n{\"name\":\"" << JsonEscape(layer->layer_name) << "\",\"cat\":\""
+             << (span.thread_id == 0 ? "layer" : "worker") << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << span.thread_id
+             << ",\"ts\":" << span.start << ",\"dur\":" << span.duration << ",\"args\":{\"op\":\""
+             << JsonEscape(layer->op_name) << "\",\"input_dims\":\"" << VectorToString(layer->input_dims)
+             << "\",\"output_dims\":\"" << VectorToString(layer->output_dims) << "\",\"mflops\":" << layer->flops
+             << ",\"mbytes\":" << layer->bandwidth;
+        if (span.counters[PERF_COUNTER_CYCLES] > 0) {
+            ostr << ",\"cycles\":" << span.counters[PERF_COUNTER_CYCLES]
+                 << ",\"instructions\":" << span.counters[PERF_COUNTER_INSTRUCTIONS]
+                 << ",\"l1d_misses\":" << span.counters[PERF_COUNTER_L1D_MISSES]
+                 << ",\"llc_misses\":" << span.counters[PERF_COUNTER_LLC_MISSES]
+                 << ",\"branch_misses\":" << span.counters[PERF_COUNTER_BRANCH_MISSES];
+        }
+        ostr << "}}";
+        first = false;
+    }
+    for (auto thread : threads) {
+        std::string name = thread.first == 0 ? "layers" : "worker " + std::to_string(thread.first - 1);
+        ostr << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread.first
+             << ",\"args\":{\"name\":\"" << name << "\"}}";
+        first = false;
+    }
+    ostr << "\n]}\n";
+    return ostr.str();
+}
 
 }  // namespace TNN_NS
@@ -15,11 +15,13 @@
 #ifndef TNN_INCLUDE_TNN_CORE_PROFILE_H_
 #define TNN_INCLUDE_TNN_CORE_PROFILE_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "tnn/core/macro.h"
+#include "tnn/utils/perf_counter_utils.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -42,6 +44,13 @@ struct ProfilingData {
     double flops     = 0;
     double bandwidth = 0;
 
+    /**hardware counters summed over the threads, 0 if not captured*/
+    double cycles        = 0;
+    double instructions  = 0;
+    double l1d_misses    = 0;
+    double llc_misses    = 0;
+    double branch_misses = 0;
+
     std::vector<int> input_dims     = {};
     std::vector<int> output_dims    = {};
     std::vector<int> kernel_shape   = {};
@@ -55,7 +64,92 @@ struct ProfilingData {
     bool IsSameID(ProfilingData *data);
 };
 
-#if TNN_PROFILE
+// @brief ProfilingSpan is a timed span recorded by ProfilingRecorder
+struct ProfilingSpan {
+    // index of the layer in the recorder, -1 if not inside a layer
+    int layer_id = -1;
+    // 0 for the thread running the layers, omp thread id + 1 for the worker spans
+    int thread_id = 0;
+    // start time and duration in us
+    double start    = 0;
+    double duration = 0;
+    // hardware counters of the layer spans, indexed by PerfCounterType
+    double counters[PERF_COUNTER_NUM] = {0};
+};
+
+// @brief ProfilingRecorder records the spans of layers and of their workers into two ring buffers
+// preallocated by Start, the worker spans never overwrite the layer spans. It costs one flag check
+// per layer when not enabled.
+class ProfilingRecorder {
+public:
+    // @brief start a profiling session, the oldest layer or worker spans are overwritten after capacity
+    // spans of the kind.
+    // hardware counters are captured for each layer if supported by the os
+    void Start(int capacity = 65536, bool hardware_counters = false);
+
+    // @brief stop recording, the spans are kept until next start
+    void Stop();
+
+    bool IsEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // @brief register a layer in the current session, return its layer id
+    int AddLayer(std::shared_ptr<ProfilingData> pdata);
+
+    // @brief layer table of the current session indexed by layer id
+    std::vector<std::shared_ptr<ProfilingData>> GetLayers();
+
+    // @brief session id, increased by each start
+    int GetSession();
+
+    // @brief layer of the worker spans, -1 if not inside a layer
+    int GetCurrentLayer();
+
+    // @brief begin the span of a layer on thread 0, the layer becomes current
+    void BeginLayer(int layer_id);
+
+    // @brief end the span of the current layer
+    void EndLayer();
+
+    void Record(int layer_id, int thread_id, double start, double end);
+
+    // @brief spans of the session, the layer spans oldest first followed by the worker spans oldest first
+    std::vector<ProfilingSpan> GetSpans();
+
+    // @brief current time in us
+    static double Now();
+
+private:
+    ProfilingSpan &NextSpan(std::vector<ProfilingSpan> &spans, std::atomic<unsigned long long> &next_span);
+
+    std::vector<ProfilingSpan> spans_;
+    std::atomic<unsigned long long> next_span_ = {0};
+    std::vector<ProfilingSpan> worker_spans_;
+    std::atomic<unsigned long long> next_worker_span_ = {0};
+    std::atomic<bool> enabled_                 = {false};
+    std::vector<std::shared_ptr<ProfilingData>> layers_;
+    // written by thread 0 and read by the workers of the layer
+    std::atomic<int> current_layer_ = {-1};
+    int session_                    = 0;
+    double origin_                  = 0;
+    double layer_start_             = 0;
+    PerfCounters counters_;
+};
+
+// @brief ProfilingScope records its lifetime as a worker span of the current layer, used once per thread
+// around the parallel loops of a layer acc. nothing is recorded if recorder is null or not enabled.
+class ProfilingScope {
+public:
+    ProfilingScope(ProfilingRecorder *recorder, int thread_id);
+    ~ProfilingScope();
+
+private:
+    ProfilingRecorder *recorder_ = nullptr;
+    int thread_id_               = 0;
+    double start_                = 0;
+};
+
 class ProfileResult {
 public:
     virtual ~ProfileResult();
@@ -69,12 +163,20 @@ public:
     // @brief add profiling result
     void AddProfileResult(std::shared_ptr<ProfileResult> result);
 
+    // @brief add the spans of a recorder, the layer spans are also added as profiling data
+    // if no device has reported its own kernel time
+    void AddProfilingSpans(const std::vector<ProfilingSpan> &spans,
+                           const std::vector<std::shared_ptr<ProfilingData>> &layers);
+
     // @brief get profiling data
     virtual std::vector<std::shared_ptr<ProfilingData>> GetData();
 
     // @brief This function shows the detailed timing for each layer in the model.
     virtual std::string GetProfilingDataInfo();
 
+    // @brief chrome trace_event json of the spans, open it with chrome://tracing or perfetto
+    virtual std::string GetTraceJson();
+
 protected:
     /*
      * This function shows an overview of the timings in the model.
@@ -83,8 +185,9 @@ protected:
     virtual std::string GetProfilingDataSummary(bool do_average);
 
     std::vector<std::shared_ptr<ProfilingData>> profiling_data_ = {};
+    std::vector<ProfilingSpan> spans_                           = {};
+    std::vector<std::shared_ptr<ProfilingData>> span_layers_    = {};
 };
-#endif
 
 }  // namespace TNN_NS
 
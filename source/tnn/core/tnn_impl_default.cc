@@ -15,6 +15,8 @@
 #include "tnn/core/tnn_impl_default.h"
 
 #include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/numa_utils.h"
 
 namespace TNN_NS {
 
@@ -37,11 +39,17 @@ Status TNNImplDefault::Init(ModelConfig& config) {
         return Status(TNNERR_NET_ERR, "interpreter is nil");
     }
     interpreter_ = std::shared_ptr<AbstractModelInterpreter>(interpreter);
+
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter);
+    if (default_interpreter) {
+        default_interpreter->SetLazyLoadResource(config.lazy_load_resource);
+    }
     return interpreter_->Interpret(config.params);
 }
 
 Status TNNImplDefault::DeInit() {
     interpreter_ = nullptr;
+    numa_interpreters_.clear();
     return TNN_OK;
 }
 
@@ -54,9 +62,45 @@ Status TNNImplDefault::AddOutput(const std::string& layer_name, int output_index
     CHECK_PARAM_NULL(default_interpreter);
 
     default_interpreter->GetNetStructure()->outputs.insert(layer_name);
+
+    std::unique_lock<std::mutex> lck(numa_mutex_);
+    for (auto iter : numa_interpreters_) {
+        auto numa_interpreter = dynamic_cast<DefaultModelInterpreter*>(iter.second.get());
+        numa_interpreter->GetNetStructure()->outputs.insert(layer_name);
+    }
     return TNN_OK;
 }
 
+std::shared_ptr<AbstractModelInterpreter> TNNImplDefault::GetInterpreter(int numa_node, Status& status) {
+    status                   = TNN_OK;
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter_.get());
+    if (numa_node < 0 || CpuUtils::GetNumaNodeCount() <= 1 || !default_interpreter) {
+        return interpreter_;
+    }
+
+    std::unique_lock<std::mutex> lck(numa_mutex_);
+    if (numa_interpreters_.count(numa_node) > 0) {
+        return numa_interpreters_[numa_node];
+    }
+
+    // interpret the model again with the memory of the calling thread on the node
+    NumaNodeGuard numa_guard(numa_node);
+    auto interpreter      = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(model_config_.model_type));
+    auto numa_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    if (!numa_interpreter) {
+        status = Status(TNNERR_NET_ERR, "interpreter is nil");
+        return nullptr;
+    }
+    numa_interpreter->SetLazyLoadResource(model_config_.lazy_load_resource);
+    status = numa_interpreter->Interpret(model_config_.params);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+    numa_interpreter->GetNetStructure()->outputs = default_interpreter->GetNetStructure()->outputs;
+    numa_interpreters_[numa_node] = interpreter;
+    return interpreter;
+}
+
 std::shared_ptr<Instance> TNNImplDefault::CreateInst(NetworkConfig& net_config, Status& status,
                                                      InputShapesMap inputs_shape) {
     if (!interpreter_) {
@@ -64,8 +108,13 @@ std::shared_ptr<Instance> TNNImplDefault::CreateInst(NetworkConfig& net_config,
         return nullptr;
     }
 
+    auto interpreter = GetInterpreter(net_config.numa_node, status);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+
     auto instance = std::make_shared<Instance>(net_config, model_config_);
-    status        = instance->Init(interpreter_, inputs_shape);
+    status        = instance->Init(interpreter, inputs_shape);
 
     if (status != TNN_OK) {
         return nullptr;
@@ -15,7 +15,9 @@
 #ifndef TNN_CORE_TNN_IMPL_DEFAULT_H_
 #define TNN_CORE_TNN_IMPL_DEFAULT_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "tnn/core/common.h"
@@ -65,7 +67,13 @@ public:
         InputShapesMap inputs_shape = InputShapesMap());
 
 private:
+    // @brief the interpreter whose weights are on the numa node, interpreter_ if not bound
+    std::shared_ptr<AbstractModelInterpreter> GetInterpreter(int numa_node, Status& status);
+
     std::shared_ptr<AbstractModelInterpreter> interpreter_;
+    // read-only copies of the weights, one for each numa node
+    std::map<int, std::shared_ptr<AbstractModelInterpreter>> numa_interpreters_;
+    std::mutex numa_mutex_;
 };
 
 }  // namespace TNN_NS
@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/arm/acc/arm_add_layer_acc.h"
+#include "tnn/device/arm/acc/arm_binary_layer_acc.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/interpreter/raw_buffer.h"
@@ -24,27 +25,31 @@ namespace TNN_NS {
 enum AddOpType { ADD_SINGLE = 1, ADD_CHANNEL = 2, ADD_ELEMENT = 3 };
 
 template <typename T>
-static void _operator_add(T *output_ptr, T *input0_ptr, T *input1_ptr, DimsVector &dims0, DimsVector &dims1) {
-    DimsVector dims = DimsVectorUtils::Max(dims0, dims1);
-    DimsVector dims_broadcast;
-    AddOpType type = ADD_ELEMENT;
-    auto _input0   = input0_ptr;
-    auto _input1   = input1_ptr;
+static void _operator_add(T *output_ptr, T *input0_ptr, T *input1_ptr, const DimsVector &dims0,
+                          const DimsVector &dims1) {
+    // the max of the input dims as DimsVectorUtils::Max, kept on the stack as it runs for every forward
+    int dims[4];
+    for (int i = 0; i < 4; i++) {
+        dims[i] = std::max(i < dims0.size() ? dims0[i] : 1, i < dims1.size() ? dims1[i] : 1);
+    }
+    const DimsVector *dims_broadcast = nullptr;
+    AddOpType type                   = ADD_ELEMENT;
+    auto _input0                     = input0_ptr;
+    auto _input1                     = input1_ptr;
 
     if (DimsVectorUtils::Equal(dims0, dims1, 2)) {
-        dims_broadcast.clear();
         type = ADD_ELEMENT;
         if (dims0[0] != dims[0] || dims0[1] != dims[1])
             std::swap(_input0, _input1);
-    } else if (DimsVectorUtils::Equal(dims0, dims, 1)) {
-        dims_broadcast = dims1;
+    } else if (dims0[1] == dims[1] && dims0[2] == dims[2] && dims0[3] == dims[3]) {
+        dims_broadcast = &dims1;
     } else {
-        dims_broadcast = dims0;
+        dims_broadcast = &dims0;
         std::swap(_input0, _input1);
     }
 
-    if (dims_broadcast.size()) {
-        type = (dims_broadcast[1] == 1) ? ADD_SINGLE : ADD_CHANNEL;
+    if (dims_broadcast) {
+        type = ((*dims_broadcast)[1] == 1) ? ADD_SINGLE : ADD_CHANNEL;
     }
 
     int count      = ROUND_UP(dims[1], 4) * dims[2] * dims[3];
@@ -110,8 +115,8 @@ Status ArmAddLayerAcc::Init(Context *context, LayerParam *param, LayerResource *
 Status ArmAddLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     // alloc scale buffer, two input scales and output scale
     if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8 && !input0_int_scale_.GetBytesSize()) {
-        auto dims_output    = outputs[0]->GetBlobDesc().dims;
-        int total_byte_size = ROUND_UP(dims_output[1], 4) * sizeof(float);
+        const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+        int total_byte_size     = ROUND_UP(dims_output[1], 4) * sizeof(float);
 
         const float *i0_scale =
             reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource()->scale_handle.force_to<float *>();
@@ -143,7 +148,7 @@ Status ArmAddLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs, co
         auto layer_res = dynamic_cast<EltwiseLayerResource *>(resource_);
         if (layer_res) {
             bias_shape_         = {1, 1, 1, 1};
-            auto dims           = outputs[0]->GetBlobDesc().dims;
+            const auto &dims    = outputs[0]->GetBlobDesc().dims;
             auto layer_res_size = layer_res->element_handle.GetDataCount();
             if (layer_res_size == 1) {
                 // broadcast sigle
@@ -163,9 +168,10 @@ Status ArmAddLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs, co
             } else {
                 return Status(TNNERR_MODEL_ERR, "Error: unsupported broadcast type");
             }
+            bool nhwc        = outputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NHWC;
             auto buffer_size = ROUND_UP(bias_shape_[1], 4) * bias_shape_[2] * bias_shape_[3] * sizeof(float);
             RawBuffer temp(buffer_size);
-            // pack bias from nchw to nc4hw4
+            // pack bias from nchw to nc4hw4, or to nhwc for nhwc blobs
             auto *b_dst              = temp.force_to<float *>();
             RawBuffer element_handle = layer_res->element_handle;
             if (element_handle.GetDataType() == DATA_TYPE_HALF)
@@ -177,7 +183,11 @@ Status ArmAddLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs, co
                 int ci = c % 4;
                 int co = c / 4;
                 for (int cur_hw = 0; cur_hw < hw; cur_hw++) {
-                    b_dst[co * 4 * hw + cur_hw * 4 + ci] = b_src[c * hw + cur_hw];
+                    if (nhwc) {
+                        b_dst[cur_hw * bias_shape_[1] + c] = b_src[c * hw + cur_hw];
+                    } else {
+                        b_dst[co * 4 * hw + cur_hw * 4 + ci] = b_src[c * hw + cur_hw];
+                    }
                 }
             }
             output_bias_ = temp;
@@ -193,26 +203,26 @@ Status ArmAddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
         return Status(TNNERR_LAYER_ERR, "ArmAddLayerAcc invalid inputs count");
     }
 
-    std::vector<void *> input_ptrs;
-    std::vector<DimsVector> input_shapes;
-    input_ptrs.reserve(4);
-    input_shapes.reserve(4);
-    
-    AddOpType type;
-    auto output = outputs[0];
-    auto dims   = output->GetBlobDesc().dims;
+    // the members keep their capacity, the steady state forward does not allocate
+    auto &input_ptrs   = input_ptrs_;
+    auto &input_shapes = input_shapes_;
+    input_ptrs.clear();
+    input_shapes.clear();
+
+    auto output      = outputs[0];
+    const auto &dims = output->GetBlobDesc().dims;
 
     if (inputs.size() == 1) {
         input_ptrs.push_back(GetBlobHandlePtr(inputs[0]->GetHandle()));
-        input_shapes.push_back(dims);
+        input_shapes.push_back(&dims);
         // bias is another input
         input_ptrs.push_back(output_bias_.force_to<void *>());
-        input_shapes.push_back(bias_shape_);
+        input_shapes.push_back(&bias_shape_);
     } else {
         // type = ADD_ELEMENT;
         for (size_t inid = 0; inid < inputs.size(); inid++) {
             input_ptrs.push_back(GetBlobHandlePtr(inputs[inid]->GetHandle()));
-            input_shapes.push_back(inputs[inid]->GetBlobDesc().dims);
+            input_shapes.push_back(&inputs[inid]->GetBlobDesc().dims);
         }
     }
 
@@ -221,18 +231,30 @@ Status ArmAddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
         return Status(TNNERR_LAYER_ERR, "Add layer's inputs size must >= 2");
     }
 
-    if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+    if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT && output->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        auto output_ptr = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
+        auto op         = [](Float4 v1, Float4 v2) -> Float4 { return v1 + v2; };
+
+        RETURN_ON_NEQ(BinaryFuncNHWC(output_ptr, reinterpret_cast<float *>(input_ptrs[0]),
+                                     reinterpret_cast<float *>(input_ptrs[1]), *input_shapes[0], *input_shapes[1], op),
+                      TNN_OK);
+        for (int i = 2; i < input_ptrs.size(); i++) {
+            RETURN_ON_NEQ(BinaryFuncNHWC(output_ptr, output_ptr, reinterpret_cast<float *>(input_ptrs[i]), dims,
+                                         *input_shapes[i], op),
+                          TNN_OK);
+        }
+    } else if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         // int count       = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
         // int count_quad  = UP_DIV(count, 4);
         auto output_ptr = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
         auto input0_ptr = reinterpret_cast<float *>(input_ptrs[0]);
         auto input1_ptr = reinterpret_cast<float *>(input_ptrs[1]);
 
-        _operator_add<float>(output_ptr, input0_ptr, input1_ptr, input_shapes[0], input_shapes[1]);
+        _operator_add<float>(output_ptr, input0_ptr, input1_ptr, *input_shapes[0], *input_shapes[1]);
 
         for (int i = 2; i < input_ptrs.size(); i++) {
             auto input_ptr = reinterpret_cast<float *>(input_ptrs[i]);
-            _operator_add(output_ptr, output_ptr, input_ptr, dims, input_shapes[i]);
+            _operator_add(output_ptr, output_ptr, input_ptr, dims, *input_shapes[i]);
         }
     } else if (output->GetBlobDesc().data_type == DATA_TYPE_INT8) {
         // only support inputs.size() == 2
@@ -252,11 +274,11 @@ Status ArmAddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
         auto input0_ptr = reinterpret_cast<bfp16_t *>(input_ptrs[0]);
         auto input1_ptr = reinterpret_cast<bfp16_t *>(input_ptrs[1]);
 
-        _operator_add<bfp16_t>(output_ptr, input0_ptr, input1_ptr, input_shapes[0], input_shapes[1]);
+        _operator_add<bfp16_t>(output_ptr, input0_ptr, input1_ptr, *input_shapes[0], *input_shapes[1]);
 
         for (int i = 2; i < input_ptrs.size(); i++) {
             auto input_ptr = reinterpret_cast<bfp16_t *>(input_ptrs[i]);
-            _operator_add(output_ptr, output_ptr, input_ptr, dims, input_shapes[i]);
+            _operator_add(output_ptr, output_ptr, input_ptr, dims, *input_shapes[i]);
         }
     } else {
         LOGE("Error: layer acc dont support datatype: %d\n", output->GetBlobDesc().data_type);
@@ -267,5 +289,6 @@ Status ArmAddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
 }
 
 REGISTER_ARM_ACC(Add, LAYER_ADD)
+REGISTER_ARM_LAYOUT(LAYER_ADD, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
@@ -31,12 +31,18 @@ public:
     
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual bool IsInplaceSupported() {
+        return true;
+    }
+
 private:
     RawBuffer input0_int_scale_;
     RawBuffer input1_int_scale_;
     RawBuffer output_int_scale_;
     RawBuffer output_bias_;
     DimsVector bias_shape_;
+    std::vector<void *> input_ptrs_;
+    std::vector<const DimsVector *> input_shapes_;
 };
 
 }  // namespace TNN_NS
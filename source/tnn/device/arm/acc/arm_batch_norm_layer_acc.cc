@@ -33,8 +33,8 @@ Status ArmBatchNormLayerAcc::Init(Context *context, LayerParam *param, LayerReso
 
 Status ArmBatchNormLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs,
                                                  const std::vector<Blob *> &outputs) {
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     BatchNormLayerResource *batch_norm_res = dynamic_cast<BatchNormLayerResource *>(resource_);
     CHECK_PARAM_NULL(batch_norm_res);
@@ -74,10 +74,10 @@ Status ArmBatchNormLayerAcc::allocateBufferParam(const std::vector<Blob *> &inpu
 
 template <typename T>
 Status ArmBatchNormLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     auto input_width = dims_input[3], input_height = dims_input[2], ic = dims_input[1],
          input_slice  = UP_DIV(dims_input[1], 4);
@@ -21,56 +21,122 @@
 
 namespace TNN_NS {
 
-void BroadCastInit(const DimsVector &dims, const DimsVector &dims0, const DimsVector &dims1,
-                   BroadcastType& type, DimsVector &dims_broadcast, bool &swap_flag) {
+// whether dims0 is the max of dims0 and dims1, see DimsVectorUtils::Max
+static bool IsMaxDims(const DimsVector &dims0, const DimsVector &dims1) {
+    if (dims0.size() < dims1.size()) {
+        return false;
+    }
+    for (int i = 0; i < dims1.size(); i++) {
+        if (dims0[i] < dims1[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BroadCastInit(const DimsVector &dims0, const DimsVector &dims1, BroadcastType &type,
+                   const DimsVector *&dims_broadcast, bool &swap_flag) {
+    dims_broadcast = nullptr;
     if (DimsVectorUtils::Equal(dims0, dims1)) {
         type = BroadcastTypeNormal;
-        dims_broadcast.clear();
     } else if (DimsVectorUtils::Equal(dims0, dims1, 1)) {
         type = BroadcastTypeElement;
-        dims_broadcast.clear();
         if (dims0[0] < dims1[0])
             swap_flag = true;
     } else if (DimsVectorUtils::Equal(dims0, dims1, 2)) {
         type = BroadcastTypeHeightWidth;
-        dims_broadcast.clear();
         if (dims0[1] < dims1[1])
             swap_flag = true;
     } else if (DimsVectorUtils::Equal(dims0, dims1, 3)) {
         type = BroadcastTypeWidth;
-        dims_broadcast.clear();
         if (dims0[1] < dims1[1])
             swap_flag = true;
-    } else if (DimsVectorUtils::Equal(dims0, dims)) {
-        dims_broadcast = dims1;
+    } else if (IsMaxDims(dims0, dims1)) {
+        dims_broadcast = &dims1;
     } else {
-        dims_broadcast = dims0;
+        dims_broadcast = &dims0;
         swap_flag      = true;
     }
 }
 
+Status BinaryFuncNHWC(float *output_ptr, const float *input0_ptr, const float *input1_ptr, const DimsVector &dims0,
+                      const DimsVector &dims1, const std::function<Float4(const Float4 &, const Float4 &)> &op) {
+    DimsVector dims = DimsVectorUtils::Max(dims0, dims1);
+    for (int i = 0; i < 4; i++) {
+        if ((dims0[i] != dims[i] && dims0[i] != 1) || (dims1[i] != dims[i] && dims1[i] != 1)) {
+            LOGE("Error: invalid broadcast dims\n");
+            return Status(TNNERR_LAYER_ERR, "Error: Binary layer's unsupported broadcast type");
+        }
+    }
+
+    if (DimsVectorUtils::Equal(dims0, dims1)) {
+        // no broadcast
+        int count    = DimsVectorUtils::Count(dims);
+        int count_r4 = count >> 2 << 2;
+        for (int n = 0; n < count_r4; n += 4) {
+            Float4::save(output_ptr + n, op(Float4::load(input0_ptr + n), Float4::load(input1_ptr + n)));
+        }
+        for (int n = count_r4; n < count; n++) {
+            output_ptr[n] = op(Float4(input0_ptr[n]), Float4(input1_ptr[n]))[0];
+        }
+        return TNN_OK;
+    }
+
+    const int channel = dims[1];
+    const int c_r4    = channel >> 2 << 2;
+    // the channel step is 0 if the channel is broadcast
+    const int c_step0 = dims0[1] == 1 ? 0 : 1;
+    const int c_step1 = dims1[1] == 1 ? 0 : 1;
+
+    for (int n = 0; n < dims[0]; n++) {
+        for (int h = 0; h < dims[2]; h++) {
+            for (int w = 0; w < dims[3]; w++) {
+                auto input0 = input0_ptr + (((dims0[0] == 1 ? 0 : n) * dims0[2] + (dims0[2] == 1 ? 0 : h)) * dims0[3] +
+                                            (dims0[3] == 1 ? 0 : w)) * dims0[1];
+                auto input1 = input1_ptr + (((dims1[0] == 1 ? 0 : n) * dims1[2] + (dims1[2] == 1 ? 0 : h)) * dims1[3] +
+                                            (dims1[3] == 1 ? 0 : w)) * dims1[1];
+                auto output = output_ptr + ((n * dims[2] + h) * dims[3] + w) * channel;
+                for (int c = 0; c < c_r4; c += 4) {
+                    auto v0 = c_step0 ? Float4::load(input0 + c) : Float4(input0[0]);
+                    auto v1 = c_step1 ? Float4::load(input1 + c) : Float4(input1[0]);
+                    Float4::save(output + c, op(v0, v1));
+                }
+                for (int c = c_r4; c < channel; c++) {
+                    output[c] = op(Float4(input0[c * c_step0]), Float4(input1[c * c_step1]))[0];
+                }
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
 /*
 Binary func with different opreator,
 set dims0 full shape, dims1 broadcast shape, so we need to swap input ptrs
 */
 template <typename Tout, typename Tin1, typename Tin2>
-Status ArmBinaryLayerAcc::BinaryFunc(Tout *output_ptr, Tin1 *input0_ptr, Tin2 *input1_ptr, DimsVector &dims0,
-                                     DimsVector &dims1) {
-    DimsVector dims = DimsVectorUtils::Max(dims0, dims1);
-    DimsVector dims_broadcast;
-    BroadcastType type = BroadcastTypeUnknown;
-    auto _input0       = input0_ptr;
-    auto _input1       = input1_ptr;
-    bool swap_flag     = false;
+Status ArmBinaryLayerAcc::BinaryFunc(Tout *output_ptr, Tin1 *input0_ptr, Tin2 *input1_ptr, const DimsVector &dims0,
+                                     const DimsVector &dims1) {
+    // the max of the input dims as DimsVectorUtils::Max, kept on the stack as it runs for every forward
+    int dims[4];
+    for (int i = 0; i < 4; i++) {
+        dims[i] = std::max(i < dims0.size() ? dims0[i] : 1, i < dims1.size() ? dims1[i] : 1);
+    }
+    const DimsVector *dims_broadcast = nullptr;
+    BroadcastType type               = BroadcastTypeUnknown;
+    auto _input0                     = input0_ptr;
+    auto _input1                     = input1_ptr;
+    bool swap_flag                   = false;
 
-    BroadCastInit(dims, dims0, dims1, type, dims_broadcast, swap_flag);
+    BroadCastInit(dims0, dims1, type, dims_broadcast, swap_flag);
 
     if (swap_flag) {
         std::swap(_input0, _input1);
     }
 
-    if (dims_broadcast.size()) {
-        type = (dims_broadcast[1] == 1) ? BroadcastTypeSingle : BroadcastTypeChannel;
+    if (dims_broadcast) {
+        type = ((*dims_broadcast)[1] == 1) ? BroadcastTypeSingle : BroadcastTypeChannel;
     }
 
     int count      = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
@@ -169,6 +235,20 @@ Status ArmBinaryLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs,
                 RawBuffer temp(layer_res_size * data_byte_size);
                 memcpy(temp.force_to<void *>(), layer_data, layer_res_size * data_byte_size);
                 broadcast_ = temp;
+            } else if (outputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+                // pack bias from nchw to nhwc
+                int hw = dims[2] * dims[3];
+                RawBuffer temp(layer_res_size * data_byte_size);
+                auto src = static_cast<float *>(layer_data);
+                auto dst = temp.force_to<float *>();
+                for (int n = 0; n < dims[0]; n++) {
+                    for (int c = 0; c < dims[1]; c++) {
+                        for (int cur_hw = 0; cur_hw < hw; cur_hw++) {
+                            dst[(n * hw + cur_hw) * dims[1] + c] = src[(n * dims[1] + c) * hw + cur_hw];
+                        }
+                    }
+                }
+                broadcast_ = temp;
             } else {
                 // pack bias from nchw to nc4hw4
                 int count = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
@@ -207,40 +287,41 @@ Status ArmBinaryLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vec
         return Status(TNNERR_PARAM_ERR, "Error: layer param is nil");
     }
 
-    std::vector<void *> input_ptrs;
-    std::vector<DimsVector> input_shapes;
-    input_ptrs.reserve(4);
-    input_shapes.reserve(4);
-    auto output = outputs[0];
-    auto dims   = output->GetBlobDesc().dims;
+    // the members keep their capacity, the steady state forward does not allocate
+    auto &input_ptrs   = input_ptrs_;
+    auto &input_shapes = input_shapes_;
+    input_ptrs.clear();
+    input_shapes.clear();
+    auto output      = outputs[0];
+    const auto &dims = output->GetBlobDesc().dims;
 
     if (broadcast_.GetBytesSize() > 0) {
-        DimsVector input_shape0 = inputs[0]->GetBlobDesc().dims;
+        const DimsVector &input_shape0 = inputs[0]->GetBlobDesc().dims;
         // prepare input ptrs and shapes
         if (layer_param->weight_input_index == 0) {
             // bias as another input
             input_ptrs.push_back(broadcast_.force_to<void *>());
-            input_shapes.push_back(layer_res->element_shape);
+            input_shapes.push_back(&layer_res->element_shape);
 
             input_ptrs.push_back(GetBlobHandlePtr(inputs[0]->GetHandle()));
-            input_shapes.push_back(input_shape0);
+            input_shapes.push_back(&input_shape0);
         } else {
             input_ptrs.push_back(GetBlobHandlePtr(inputs[0]->GetHandle()));
-            input_shapes.push_back(input_shape0);
+            input_shapes.push_back(&input_shape0);
 
             input_ptrs.push_back(broadcast_.force_to<void *>());
-            input_shapes.push_back(layer_res->element_shape);
+            input_shapes.push_back(&layer_res->element_shape);
         }
     } else {
         if (inputs.size() == 1) {
             input_ptrs.push_back(GetBlobHandlePtr(inputs[0]->GetHandle()));
             input_ptrs.push_back(GetBlobHandlePtr(inputs[0]->GetHandle()));
-            input_shapes.push_back(inputs[0]->GetBlobDesc().dims);
-            input_shapes.push_back(inputs[0]->GetBlobDesc().dims);
+            input_shapes.push_back(&inputs[0]->GetBlobDesc().dims);
+            input_shapes.push_back(&inputs[0]->GetBlobDesc().dims);
         } else {
             for (size_t inid = 0; inid < inputs.size(); inid++) {
                 input_ptrs.push_back(GetBlobHandlePtr(inputs[inid]->GetHandle()));
-                input_shapes.push_back(inputs[inid]->GetBlobDesc().dims);
+                input_shapes.push_back(&inputs[inid]->GetBlobDesc().dims);
             }
         }
     }
@@ -249,11 +330,26 @@ Status ArmBinaryLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vec
     auto input0_ptr = reinterpret_cast<T *>(input_ptrs[0]);
     auto input1_ptr = reinterpret_cast<T *>(input_ptrs[1]);
 
-    BinaryFunc(output_ptr, input0_ptr, input1_ptr, input_shapes[0], input_shapes[1]);
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        // nhwc blobs are fp32 only, broadcast by index instead of swapping the inputs
+        auto op = [=](const Float4 &v1, const Float4 &v2) -> Float4 { return _Operator(v1, v2, false); };
+        RETURN_ON_NEQ(BinaryFuncNHWC(reinterpret_cast<float *>(output_ptr), reinterpret_cast<float *>(input0_ptr),
+                                     reinterpret_cast<float *>(input1_ptr), *input_shapes[0], *input_shapes[1], op),
+                      TNN_OK);
+        for (int i = 2; i < input_ptrs.size(); i++) {
+            auto input_ptr = reinterpret_cast<float *>(input_ptrs[i]);
+            RETURN_ON_NEQ(BinaryFuncNHWC(reinterpret_cast<float *>(output_ptr), reinterpret_cast<float *>(output_ptr),
+                                         input_ptr, dims, *input_shapes[i], op),
+                          TNN_OK);
+        }
+        return TNN_OK;
+    }
+
+    BinaryFunc(output_ptr, input0_ptr, input1_ptr, *input_shapes[0], *input_shapes[1]);
 
     for (int i = 2; i < input_ptrs.size(); i++) {
         auto input_ptr = reinterpret_cast<T *>(input_ptrs[i]);
-        BinaryFunc(output_ptr, output_ptr, input_ptr, dims, input_shapes[i]);
+        BinaryFunc(output_ptr, output_ptr, input_ptr, dims, *input_shapes[i]);
     }
 
     return TNN_OK;
@@ -20,6 +20,10 @@
 
 namespace TNN_NS {
 
+// @brief binary func on nhwc layout, the inputs are broadcast by index since the channel is not padded
+Status BinaryFuncNHWC(float *output_ptr, const float *input0_ptr, const float *input1_ptr, const DimsVector &dims0,
+                      const DimsVector &dims1, const std::function<Float4(const Float4 &, const Float4 &)> &op);
+
 // @brief conv layer cpu acc
 class ArmBinaryLayerAcc : public ArmLayerAcc {
 public:
@@ -37,7 +41,8 @@ public:
 
 protected:
     template <typename Tout, typename Tin1, typename Tin2>
-    Status BinaryFunc(Tout *output_ptr, Tin1 *input0_ptr, Tin2 *input1_ptr, DimsVector &dims0, DimsVector &dims1);
+    Status BinaryFunc(Tout *output_ptr, Tin1 *input0_ptr, Tin2 *input1_ptr, const DimsVector &dims0,
+                      const DimsVector &dims1);
 
     virtual bool DataTypeSupported(DataType data_type) override;
     
@@ -48,6 +53,8 @@ private:
     RawBuffer input0_int_scale_;
     RawBuffer input1_int_scale_;
     RawBuffer output_int_scale_;
+    std::vector<void *> input_ptrs_;
+    std::vector<const DimsVector *> input_shapes_;
 };
 
 #define DECLARE_ARM_BINARY_ACC(type_string)                                                                            \
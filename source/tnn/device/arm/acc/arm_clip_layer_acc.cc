@@ -20,7 +20,18 @@
 
 namespace TNN_NS {
 
-DECLARE_ARM_ACC(Clip, LAYER_CLIP);
+class ArmClipLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmClipLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual bool IsInplaceSupported() {
+        return true;
+    }
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+};
 
 Status ArmClipLayerAcc::DoForward(const std::vector<Blob *> &input_blobs, const std::vector<Blob *> &output_blobs) {
     auto layer_param = dynamic_cast<ClipLayerParam *>(param_);
@@ -31,7 +42,7 @@ Status ArmClipLayerAcc::DoForward(const std::vector<Blob *> &input_blobs, const
 
     auto input_blob  = input_blobs[0];
     auto output_blob = output_blobs[0];
-    auto dims        = output_blob->GetBlobDesc().dims;
+    const auto &dims = output_blob->GetBlobDesc().dims;
     int count        = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
     int count_quad   = UP_DIV(count, 4);
 
@@ -19,26 +19,37 @@
 
 namespace TNN_NS {
 
-DECLARE_ARM_ACC(Concat, LAYER_CONCAT);
+class ArmConcatLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmConcatLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual bool IsBlobViewSupported() {
+        return true;
+    }
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+};
 
 /*
 directly copy in c4 mode, nc4hw4 format
 */
 template <typename T>
 int concat_channel_c4(Blob *output, const std::vector<Blob *> &inputs) {
-    bool concat_c4     = true;
-    auto dims_output   = output->GetBlobDesc().dims;
-    auto output_stride = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
+    bool concat_c4          = true;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    auto output_stride      = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
 
     auto *output_origin = reinterpret_cast<T *>(GetBlobHandlePtr(output->GetHandle()));
 
     for (int n = 0; n < dims_output[0]; n++) {
         auto *output_ptr = output_origin + n * output_stride;
         for (int b = 0; b < inputs.size(); b++) {
-            auto input        = inputs[b];
-            auto dims_input   = input->GetBlobDesc().dims;
-            auto input_stride = dims_input[2] * dims_input[3] * ROUND_UP(dims_input[1], 4);
-            auto input_ptr    = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle())) + n * input_stride;
+            auto input             = inputs[b];
+            const auto &dims_input = input->GetBlobDesc().dims;
+            auto input_stride      = dims_input[2] * dims_input[3] * ROUND_UP(dims_input[1], 4);
+            auto input_ptr         = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle())) + n * input_stride;
             memcpy(output_ptr, input_ptr, input_stride * sizeof(T));
             output_ptr += input_stride;
         }
@@ -52,10 +63,10 @@ need extra buf to pack and unpack, channel not align with 4, nc4hw4 format
 */
 template <typename T>
 int concat_channel(Blob *output, const std::vector<Blob *> &inputs, T *unpack_buf) {
-    auto dims_output   = output->GetBlobDesc().dims;
-    auto output_stride = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
-    auto output_width  = dims_output[3];
-    auto output_height = dims_output[2];
+    const auto &dims_output = output->GetBlobDesc().dims;
+    auto output_stride      = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
+    auto output_width       = dims_output[3];
+    auto output_height      = dims_output[2];
 
     auto *output_origin = reinterpret_cast<T *>(GetBlobHandlePtr(output->GetHandle()));
 
@@ -64,10 +75,10 @@ int concat_channel(Blob *output, const std::vector<Blob *> &inputs, T *unpack_bu
         auto *unpack_ptr = unpack_buf;
         int area         = output_height * output_width;
         for (int b = 0; b < inputs.size(); b++) {
-            auto input      = inputs[b];
-            auto dims_input = input->GetBlobDesc().dims;
-            auto c_r4       = ROUND_UP(dims_input[1], 4);
-            auto input_ptr  = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle())) + n * c_r4 * area;
+            auto input             = inputs[b];
+            const auto &dims_input = input->GetBlobDesc().dims;
+            auto c_r4              = ROUND_UP(dims_input[1], 4);
+            auto input_ptr         = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle())) + n * c_r4 * area;
             UnpackC4(unpack_ptr, input_ptr, area, dims_input[1]);
             unpack_ptr += dims_input[1] * area;
         }
@@ -81,9 +92,9 @@ int concat_channel(Blob *output, const std::vector<Blob *> &inputs, T *unpack_bu
 concat channel int8, nhwc format
 */
 static int concat_channel_i8(Blob *output, const std::vector<Blob *> &inputs) {
-    auto dims_output = output->GetBlobDesc().dims;
-    int full_hw      = dims_output[2] * dims_output[3];
-    auto oc_c4       = ROUND_UP(dims_output[1], 4);
+    const auto &dims_output = output->GetBlobDesc().dims;
+    int full_hw             = dims_output[2] * dims_output[3];
+    auto oc_c4              = ROUND_UP(dims_output[1], 4);
 
     int8_t *output_origin = reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle()));
     for (int n = 0; n < dims_output[0]; n++) {
@@ -107,7 +118,7 @@ static int concat_channel_i8(Blob *output, const std::vector<Blob *> &inputs) {
 concat common int8, nhwc format
 */
 static int concat_common_i8(Blob *output, const std::vector<Blob *> &inputs, int axis) {
-    auto output_dims             = output->GetBlobDesc().dims;
+    const auto &output_dims      = output->GetBlobDesc().dims;
     DimsVector round_output_dims = {output_dims[0], output_dims[2], output_dims[3], ROUND_UP(output_dims[1], 4)};
     auto slice_count             = DimsVectorUtils::Count(round_output_dims, 0, axis - 1);
     auto output_stride           = DimsVectorUtils::Count(round_output_dims, axis - 1);
@@ -117,7 +128,7 @@ static int concat_common_i8(Blob *output, const std::vector<Blob *> &inputs, int
         auto output_ptr = output_origin + n * output_stride;
         for (int b = 0; b < inputs.size(); b++) {
             auto input                  = inputs[b];
-            auto input_dims             = input->GetBlobDesc().dims;
+            const auto &input_dims             = input->GetBlobDesc().dims;
             DimsVector round_input_dims = {input_dims[0], input_dims[2], input_dims[3], ROUND_UP(input_dims[1], 4)};
             auto input_stride           = DimsVectorUtils::Count(round_input_dims, axis - 1);
             auto input_ptr = reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle())) + n * input_stride;
@@ -134,7 +145,7 @@ concat channel common(float & bf16), nc4hw4 format
 */
 template <typename T>
 static int concat_common(Blob *output, const std::vector<Blob *> &inputs, int axis) {
-    auto output_dims             = output->GetBlobDesc().dims;
+    const auto &output_dims      = output->GetBlobDesc().dims;
     DimsVector round_output_dims = {output_dims[0], UP_DIV(output_dims[1], 4), output_dims[2], output_dims[3], 4};
     auto slice_count             = DimsVectorUtils::Count(round_output_dims, 0, axis);
     auto output_stride           = DimsVectorUtils::Count(round_output_dims, axis);
@@ -144,7 +155,7 @@ static int concat_common(Blob *output, const std::vector<Blob *> &inputs, int ax
         auto output_ptr = output_origin + n * output_stride;
         for (int b = 0; b < inputs.size(); b++) {
             auto input                  = inputs[b];
-            auto input_dims             = input->GetBlobDesc().dims;
+            const auto &input_dims             = input->GetBlobDesc().dims;
             DimsVector round_input_dims = {input_dims[0], UP_DIV(input_dims[1], 4), input_dims[2], input_dims[3], 4};
             auto input_stride           = DimsVectorUtils::Count(round_input_dims, axis);
             auto input_ptr = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle())) + n * input_stride;
@@ -156,6 +167,29 @@ static int concat_common(Blob *output, const std::vector<Blob *> &inputs, int ax
     return 0;
 }
 
+/*
+concat on any axis, nhwc format, channel is not padded
+*/
+static int concat_nhwc(Blob *output, const std::vector<Blob *> &inputs, int axis) {
+    // position of the nchw axis in nhwc dims
+    static const int nhwc_axis[4] = {0, 3, 1, 2};
+    auto dims_output              = DimsVectorUtils::NCHW2NHWC(output->GetBlobDesc().dims);
+    int outer                     = DimsVectorUtils::Count(dims_output, 0, nhwc_axis[axis]);
+
+    auto *output_ptr = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
+    for (int o = 0; o < outer; o++) {
+        for (auto input : inputs) {
+            auto dims_input = DimsVectorUtils::NCHW2NHWC(input->GetBlobDesc().dims);
+            int inner       = DimsVectorUtils::Count(dims_input, nhwc_axis[axis]);
+            auto *input_ptr = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle())) + o * inner;
+            memcpy(output_ptr, input_ptr, inner * sizeof(float));
+            output_ptr += inner;
+        }
+    }
+
+    return 0;
+}
+
 Status ArmConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (inputs.size() < 2) {
         LOGE("Error: invalid inputs count\n");
@@ -165,6 +199,27 @@ Status ArmConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     ConcatLayerParam *concat_param = dynamic_cast<ConcatLayerParam *>(param_);
     CHECK_PARAM_NULL(concat_param);
 
+    if (outputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        if (concat_param->axis < 0 || concat_param->axis > 3) {
+            return Status(TNNERR_LAYER_ERR, "Concat layer's axis is invalid");
+        }
+        concat_nhwc(outputs[0], inputs, concat_param->axis);
+        return TNN_OK;
+    }
+
+    // the inputs are computed in place in the output by the blob manager
+    if (concat_param->axis == 1) {
+        bool in_place      = true;
+        int channel_offset = 0;
+        for (auto input : inputs) {
+            in_place = in_place && IsBlobChannelView(input, outputs[0], channel_offset);
+            channel_offset += input->GetBlobDesc().dims[1];
+        }
+        if (in_place) {
+            return TNN_OK;
+        }
+    }
+
     bool concat_c4 = true;
     for (int i = 0; i < inputs.size() - 1; i++) {
         if (inputs[i]->GetBlobDesc().dims[1] % 4 != 0) {
@@ -179,8 +234,8 @@ Status ArmConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
                 if (concat_c4) {
                     concat_channel_c4<float>(outputs[0], inputs);
                 } else {
-                    auto dims_output   = outputs[0]->GetBlobDesc().dims;
-                    auto output_stride = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
+                    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+                    auto output_stride      = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
                     float *unpack_buf =
                         static_cast<float *>(context_->GetSharedWorkSpace(output_stride * sizeof(float)));
                     concat_channel<float>(outputs[0], inputs, unpack_buf);
@@ -191,8 +246,8 @@ Status ArmConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
                 if (concat_c4) {
                     concat_channel_c4<bfp16_t>(outputs[0], inputs);
                 } else {
-                    auto dims_output   = outputs[0]->GetBlobDesc().dims;
-                    auto output_stride = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
+                    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+                    auto output_stride      = dims_output[2] * dims_output[3] * ROUND_UP(dims_output[1], 4);
                     bfp16_t *unpack_buf =
                         static_cast<bfp16_t *>(context_->GetSharedWorkSpace(output_stride * sizeof(bfp16_t)));
                     concat_channel<bfp16_t>(outputs[0], inputs, unpack_buf);
@@ -222,5 +277,6 @@ Status ArmConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
 }
 
 REGISTER_ARM_ACC(Concat, LAYER_CONCAT)
+REGISTER_ARM_LAYOUT(LAYER_CONCAT, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
@@ -0,0 +1,99 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/Float4.h"
+#include "tnn/device/arm/acc/arm_recurrent_layer_acc.h"
+
+namespace TNN_NS {
+
+/*
+gru with the onnx gates z r h, z and r are multiplied with h in one sgemm per step, then h or r * h with the
+recurrence weights of the hidden gate in another
+*/
+class ArmGRULayerAcc : public ArmRecurrentLayerAcc {
+public:
+    virtual ~ArmGRULayerAcc(){};
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+protected:
+    virtual void Step(const float *xw, int xw_step, int direction, int batch, float *h, float *c, float *work,
+                      float *gemm_buffer);
+
+private:
+    int linear_before_reset_ = 0;
+};
+
+Status ArmGRULayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                            const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<GRULayerParam *>(param);
+    CHECK_PARAM_NULL(layer_param);
+    linear_before_reset_ = layer_param->linear_before_reset;
+
+    gates_    = 3;
+    segments_ = {2, 1};
+    return ArmRecurrentLayerAcc::Init(context, param, resource, inputs, outputs);
+}
+
+void ArmGRULayerAcc::Step(const float *xw, int xw_step, int direction, int batch, float *h, float *c, float *work,
+                          float *gemm_buffer) {
+    const int hidden4_div = hidden4_ / 4;
+    const int gate_step   = hidden4_div * xw_step;
+    const int work_step   = hidden4_div * batch * 4;
+    // the z and r gates, the hidden gate and r * h follow each other in the work space
+    float *zr = work;
+    float *hh = zr + SegmentChannels(0) * batch;
+    float *rh = hh + SegmentChannels(1) * batch;
+
+    RecurrentGemm(zr, h, direction, 0, batch, gemm_buffer);
+    for (int z = 0; z < hidden4_div; z++) {
+        for (int b = 0; b < batch; b++) {
+            const int offset   = (z * batch + b) * 4;
+            const float *x_ptr = xw + z * xw_step + b * 4;
+            float *z_ptr       = zr + offset;
+            float *r_ptr       = zr + work_step + offset;
+
+            Float4 gate_r = Float4::sigmoid(Float4::load(x_ptr + gate_step) + Float4::load(r_ptr));
+            Float4::save(z_ptr, Float4::sigmoid(Float4::load(x_ptr) + Float4::load(z_ptr)));
+            Float4::save(r_ptr, gate_r);
+            if (!linear_before_reset_) {
+                Float4::save(rh + offset, gate_r * Float4::load(h + offset));
+            }
+        }
+    }
+
+    RecurrentGemm(hh, linear_before_reset_ ? h : rh, direction, 1, batch, gemm_buffer);
+    for (int z = 0; z < hidden4_div; z++) {
+        for (int b = 0; b < batch; b++) {
+            const int offset   = (z * batch + b) * 4;
+            const float *x_ptr = xw + z * xw_step + b * 4 + 2 * gate_step;
+
+            Float4 gate_h = Float4::load(hh + offset);
+            if (linear_before_reset_) {
+                gate_h = gate_h * Float4::load(zr + work_step + offset);
+            }
+            gate_h       = Float4::tanh(Float4::load(x_ptr) + gate_h);
+            Float4 gate_z = Float4::load(zr + offset);
+            Float4 state  = Float4::load(h + offset);
+            Float4::mla(gate_h, gate_z, state - gate_h);
+            Float4::save(h + offset, gate_h);
+        }
+    }
+}
+
+REGISTER_ARM_ACC(GRU, LAYER_GRU);
+
+}  // namespace TNN_NS
@@ -53,8 +53,8 @@ Status ArmHardSwishLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
     auto layer_param = dynamic_cast<HardSwishLayerParam *>(param_);
     CHECK_PARAM_NULL(layer_param);
 
-    auto dims = outputs[0]->GetBlobDesc().dims;
-    int count = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
+    const auto &dims = outputs[0]->GetBlobDesc().dims;
+    int count        = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
 
     float *output_data = reinterpret_cast<float *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
     float *input_data  = reinterpret_cast<float *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
@@ -20,11 +20,28 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 
 ArmInnerProductLayerAcc::~ArmInnerProductLayerAcc() {}
 
+bool ArmInnerProductLayerAcc::IsResourceReleasable() {
+    return true;
+}
+
+PackedWeights ArmInnerProductLayerAcc::GetPackedWeights() {
+    if (packed_layout_.empty() || !buffer_weight_.GetBytesSize()) {
+        return PackedWeights();
+    }
+    return {packed_layout_, {buffer_weight_, buffer_bias_}};
+}
+
+Status ArmInnerProductLayerAcc::SetPackedWeights(const PackedWeights &packed_weights) {
+    packed_weights_ = packed_weights;
+    return TNN_OK;
+}
+
 // pack int8 kernel: round up c8, round up oc4
 static void packweight_i8(const int8_t *src, int8_t *dst, const int oc, const int ic) {
     auto dst_step = ROUND_UP(ic, 8);
@@ -77,6 +94,96 @@ static void SGEMV(T *dst, const T *src, T *weight, const int oc_r4, const int ic
     }
 }
 
+// int8 weights dequantized in the kernel, each group_size inputs share one scale of each output
+static void SGEMVWeightInt8(float *dst, const float *src, const int8_t *weight, const float *scale, const int oc_r4,
+                            const int ic_r4, const int group_size) {
+    OMP_PARALLEL_FOR_
+    for (int o = 0; o < oc_r4; o += 4) {
+        auto weight_z = weight + o * ic_r4;
+        Float4 acc(0.f);
+        for (int g = 0; g < ic_r4; g += group_size) {
+            Float4 acc_g(0.f);
+            for (int i = g; i < g + group_size; i += 4) {
+                float w[16];
+                for (int k = 0; k < 16; k++) {
+                    w[k] = weight_z[i * 4 + k];
+                }
+                Float4 v0 = Float4::load(src + i);
+                Float2 v0_0, v0_1;
+                Float4::get_low(v0, v0_0);
+                Float4::get_high(v0, v0_1);
+                Float4::mla_lane0(acc_g, Float4::load(w + 0), v0_0);
+                Float4::mla_lane1(acc_g, Float4::load(w + 4), v0_0);
+                Float4::mla_lane0(acc_g, Float4::load(w + 8), v0_1);
+                Float4::mla_lane1(acc_g, Float4::load(w + 12), v0_1);
+            }
+            Float4::mla(acc, acc_g, Float4::load(scale + g / group_size * oc_r4 + o));
+        }
+        Float4::save(dst + o, acc);
+    }
+}
+
+bool ArmInnerProductLayerAcc::IsQuantizedWeightsSupported(LayerParam *param, LayerResource *resource,
+                                                          const std::vector<Blob *> &inputs) {
+    auto fc_param = dynamic_cast<InnerProductLayerParam *>(param);
+    auto fc_res   = dynamic_cast<InnerProductLayerResource *>(resource);
+    if (!fc_param || !fc_res || inputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return false;
+    }
+    const auto &dims_input = inputs[0]->GetBlobDesc().dims;
+    const int hw    = dims_input[2] * dims_input[3];
+    const int count = fc_res->weight_handle.GetBytesSize();
+    const int scale_count = fc_res->scale_handle.GetDataCount();
+    if (scale_count <= 0 || count % scale_count != 0) {
+        return false;
+    }
+    // a group must cover whole c4 planes of the packed input
+    const int group_size = count / scale_count;
+    return scale_count == fc_param->num_output || group_size % (4 * hw) == 0;
+}
+
+Status ArmInnerProductLayerAcc::allocateBufferQuantizedWeight(const std::vector<Blob *> &inputs,
+                                                              const std::vector<Blob *> &outputs) {
+    InnerProductLayerParam *fc_param = dynamic_cast<InnerProductLayerParam *>(param_);
+    CHECK_PARAM_NULL(fc_param);
+    InnerProductLayerResource *fc_res = dynamic_cast<InnerProductLayerResource *>(resource_);
+    CHECK_PARAM_NULL(fc_res);
+
+    const DimsVector &dims_input = inputs[0]->GetBlobDesc().dims;
+    const int hw                 = dims_input[2] * dims_input[3];
+    const int ic                 = dims_input[1] * hw;
+    const int ic_r4              = hw * ROUND_UP(dims_input[1], 4);
+    const int oc                 = fc_param->num_output;
+    const int oc_r4              = ROUND_UP(oc, 4);
+    const int groups             = fc_res->scale_handle.GetDataCount() / oc;
+
+    RawBuffer w_handle = fc_res->weight_handle;
+    CHECK_PARAM_NULL(w_handle.force_to<void *>());
+    int w_ic = ic;
+    if (hw != 1) {
+        RawBuffer reorder_buffer(ic_r4 * oc);
+        for (int o = 0; o < oc; o++) {
+            PackC4(reorder_buffer.force_to<int8_t *>() + o * ic_r4, w_handle.force_to<int8_t *>() + o * ic, hw,
+                   dims_input[1]);
+        }
+        w_handle = reorder_buffer;
+        w_ic     = ic_r4;
+    }
+    buffer_weight_ = RawBuffer(oc_r4 * ic_r4);
+    PackWeightO4(w_handle.force_to<int8_t *>(), buffer_weight_.force_to<int8_t *>(), oc, w_ic);
+
+    buffer_scale_ = RawBuffer(groups * oc_r4 * sizeof(float));
+    auto w_scale  = fc_res->scale_handle.force_to<float *>();
+    auto scale    = buffer_scale_.force_to<float *>();
+    for (int o = 0; o < oc; o++) {
+        for (int g = 0; g < groups; g++) {
+            scale[g * oc_r4 + o] = w_scale[o * groups + g];
+        }
+    }
+    weight_group_size_ = ic_r4 / groups;
+    return TNN_OK;
+}
+
 Status ArmInnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs,
                                                      const std::vector<Blob *> &outputs) {
     InnerProductLayerParam *fc_param = dynamic_cast<InnerProductLayerParam *>(param_);
@@ -84,9 +191,9 @@ Status ArmInnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
     InnerProductLayerResource *fc_res = dynamic_cast<InnerProductLayerResource *>(resource_);
     CHECK_PARAM_NULL(fc_res);
 
-    if (!buffer_weight_.GetBytesSize()) {
-        DimsVector dims_input  = inputs[0]->GetBlobDesc().dims;
-        DimsVector dims_output = outputs[0]->GetBlobDesc().dims;
+    if (!buffer_weight_.GetBytesSize() && !sparse_weight_.values.GetBytesSize()) {
+        const DimsVector &dims_input  = inputs[0]->GetBlobDesc().dims;
+        const DimsVector &dims_output = outputs[0]->GetBlobDesc().dims;
 
         RawBuffer w_handle = fc_res->weight_handle;
         CHECK_PARAM_NULL(w_handle.force_to<void *>());
@@ -114,6 +221,13 @@ Status ArmInnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
                 w_handle = reorder_buffer;
             }
 
+            // pruned weights skip the zero blocks in the float kernel
+            if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT &&
+                GetBlockSparsityO4(w_handle.force_to<float *>(), oc, ic) >= SPARSE_WEIGHT_THRESHOLD) {
+                PackSparseWeightO4(w_handle.force_to<float *>(), oc, ic, sparse_weight_);
+                return TNN_OK;
+            }
+
             auto weight_count = ROUND_UP(oc, 4) * ROUND_UP(ic, 4);
             buffer_weight_    = RawBuffer(weight_count * data_byte_size);
             PackWeightO4(w_handle.force_to<float *>(), buffer_weight_.force_to<float *>(), oc, ic);
@@ -141,7 +255,7 @@ Status ArmInnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
     CHECK_PARAM_NULL(fc_param);
     InnerProductLayerResource *fc_res = dynamic_cast<InnerProductLayerResource *>(resource_);
     CHECK_PARAM_NULL(fc_res);
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     if (!buffer_bias_.GetBytesSize()) {
         if (fc_param->has_bias) {
@@ -190,7 +304,15 @@ Status ArmInnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
 Status ArmInnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
-    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT &&
+        WeightQuantUtils::IsWeightOnlyQuantized(param, resource)) {
+        RETURN_ON_NEQ(allocateBufferQuantizedWeight(inputs, outputs), TNN_OK);
+    } else {
+        RETURN_ON_NEQ(TakePackedWeights(GetPackedLayout("fc", inputs[0]->GetBlobDesc().data_type),
+                                        {&buffer_weight_, &buffer_bias_}),
+                      TNN_OK);
+        RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    }
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
 
     return TNN_OK;
@@ -208,10 +330,10 @@ Status ArmInnerProductLayerAcc::Exec(const std::vector<Blob *> &inputs, const st
     auto input  = inputs[0];
     auto output = outputs[0];
 
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
-    auto ic          = dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
-    auto oc_r4       = ROUND_UP(dims_output[1], 4);
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    auto ic                 = dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
+    auto oc_r4              = ROUND_UP(dims_output[1], 4);
 
     auto input_origin  = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle()));
     auto output_origin = reinterpret_cast<T *>(GetBlobHandlePtr(output->GetHandle()));
@@ -219,7 +341,14 @@ Status ArmInnerProductLayerAcc::Exec(const std::vector<Blob *> &inputs, const st
         auto input_ptr  = input_origin + n * ic;
         auto output_ptr = output_origin + n * oc_r4;
 
-        SGEMV(output_ptr, input_ptr, buffer_weight_.force_to<T *>(), oc_r4, ic);
+        if (sparse_weight_.values.GetBytesSize() > 0) {
+            SparseGemvO4((float *)output_ptr, (float *)input_ptr, sparse_weight_, oc_r4 / 4);
+        } else if (weight_group_size_ > 0) {
+            SGEMVWeightInt8((float *)output_ptr, (float *)input_ptr, buffer_weight_.force_to<int8_t *>(),
+                            buffer_scale_.force_to<float *>(), oc_r4, ic, weight_group_size_);
+        } else {
+            SGEMV(output_ptr, input_ptr, buffer_weight_.force_to<T *>(), oc_r4, ic);
+        }
 
         if (fc_param->has_bias) {
             PostAddBias<T>(output_ptr, buffer_bias_.force_to<float *>(), 1, oc_r4 / 4);
@@ -236,8 +365,8 @@ in int8 mode, weight has been packed to oc8
 template <>
 Status ArmInnerProductLayerAcc::Exec<int8_t>(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     InnerProductLayerParam *fc_param = dynamic_cast<InnerProductLayerParam *>(param_);
-    auto dims_input                  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output                 = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input           = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output          = outputs[0]->GetBlobDesc().dims;
     auto ic                          = dims_input[3] * dims_input[2] * ROUND_UP(dims_input[1], 4);
     auto ic_r4                       = ROUND_UP(ic, 4);
     auto oc_r4                       = ROUND_UP(dims_output[1], 4);
@@ -16,6 +16,7 @@
 #define TNN_SOURCE_TNN_DEVICE_ARM_ARM_INNER_PRODUCT_LAYER_ACC_H_
 
 #include "tnn/device/arm/acc/arm_layer_acc.h"
+#include "tnn/device/arm/acc/compute/sparse_function.h"
 
 namespace TNN_NS {
 
@@ -28,7 +29,20 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
-    // alloc for fc weights and pack GOIHW16
+    // weights, bias and scale are packed in init
+    virtual bool IsResourceReleasable();
+
+    // the packed dense float weight and bias, the sparse and quantized weights are always packed at init
+    virtual PackedWeights GetPackedWeights();
+
+    // taken in Init if they are in the dense float layout
+    virtual Status SetPackedWeights(const PackedWeights &packed_weights);
+
+    // float input with one weight scale per output channel, or groups of whole c4 planes
+    virtual bool IsQuantizedWeightsSupported(LayerParam *param, LayerResource *resource,
+                                             const std::vector<Blob *> &inputs);
+
+    // alloc for fc weights and pack GOIHW16, or block sparse if the float weights are pruned
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
     template <typename T>
@@ -37,10 +51,19 @@ public:
     // alloc for fc bias and pack c4
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    // alloc for weight only quantized int8 weights packed like the float ones, scales packed [group][oc4]
+    Status allocateBufferQuantizedWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
 protected:
     RawBuffer buffer_weight_;
     RawBuffer buffer_bias_;
     RawBuffer buffer_scale_;
+
+    // weight only quantized: number of packed input values sharing one scale, 0 for float weights
+    int weight_group_size_ = 0;
+
+    // pruned float weights, empty if the weights are dense
+    SparseWeightO4 sparse_weight_;
 };
 
 }  // namespace TNN_NS
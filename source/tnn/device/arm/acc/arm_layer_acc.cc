@@ -26,7 +26,7 @@ namespace TNN_NS {
 
 Status ArmLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                          const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    AbstractLayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(AbstractLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
     context_ = reinterpret_cast<ArmContext *>(context);
 
     param_    = param;
@@ -34,14 +34,14 @@ Status ArmLayerAcc::Init(Context *context, LayerParam *param, LayerResource *res
     k_param_  = std::make_shared<ArmKernelParam>();
 
     // init base k_param_
-    auto input_dim  = inputs[0]->GetBlobDesc().dims;
-    auto output_dim = outputs[0]->GetBlobDesc().dims;
-    k_param_->ic_r4 = ROUND_UP(input_dim[1], 4);
-    k_param_->ih    = input_dim[2];
-    k_param_->iw    = input_dim[3];
-    k_param_->oc_r4 = ROUND_UP(output_dim[1], 4);
-    k_param_->oh    = output_dim[2];
-    k_param_->ow    = output_dim[3];
+    const auto &input_dim  = inputs[0]->GetBlobDesc().dims;
+    const auto &output_dim = outputs[0]->GetBlobDesc().dims;
+    k_param_->ic_r4        = ROUND_UP(input_dim[1], 4);
+    k_param_->ih           = input_dim[2];
+    k_param_->iw           = input_dim[3];
+    k_param_->oc_r4        = ROUND_UP(output_dim[1], 4);
+    k_param_->oh           = output_dim[2];
+    k_param_->ow           = output_dim[3];
 
     return TNN_OK;
 }
@@ -53,22 +53,69 @@ std::vector<DataFormat> ArmLayerAcc::SupportDataFormat(DataType data_type, int d
             support_list.push_back(DATA_FORMAT_NC4HW4);
         else if (data_type == DATA_TYPE_INT8)
             support_list.push_back(DATA_FORMAT_NHWC4);
+        // extra layouts are fp32 only, NC4HW4 stays the default one
+        if (data_type == DATA_TYPE_FLOAT && implemented_layout_) {
+            for (auto layout : implemented_layout_->layouts) {
+                support_list.push_back(layout);
+            }
+        }
     }
     return support_list;
 }
 
+void ArmLayerAcc::SetImplementedLayout(std::shared_ptr<const ImplementedLayout> implemented_layout) {
+    implemented_layout_ = implemented_layout;
+}
+
+std::string ArmLayerAcc::GetPackedLayout(const std::string &impl, DataType data_type) {
+#if defined(__aarch64__)
+    const std::string arch = "arm64";
+#elif defined(__arm__)
+    const std::string arch = "armv7";
+#else
+    const std::string arch = "generic";
+#endif
+    return impl + "/" + arch + "/" + std::to_string((int)data_type);
+}
+
+Status ArmLayerAcc::TakePackedWeights(const std::string &layout, const std::vector<RawBuffer *> &buffers) {
+    packed_layout_ = layout;
+    if (packed_weights_.buffers.empty()) {
+        return TNN_OK;
+    }
+    PackedWeights packed_weights = packed_weights_;
+    packed_weights_              = PackedWeights();
+    if (!layout.empty() && packed_weights.layout == layout && packed_weights.buffers.size() == buffers.size()) {
+        for (size_t i = 0; i < buffers.size(); i++) {
+            *buffers[i] = packed_weights.buffers[i];
+        }
+        return TNN_OK;
+    }
+    if (!packed_weights.repackable) {
+        LOGE("packed weights in %s, the layer packs them in %s without the raw weights\n",
+             packed_weights.layout.c_str(), layout.c_str());
+        return Status(TNNERR_LAYER_ERR, "packed weights in another layout and no raw weights to pack");
+    }
+    LOGD("packed weights in %s, packing them in %s\n", packed_weights.layout.c_str(), layout.c_str());
+    return TNN_OK;
+}
+
+void ArmLayerAcc::ReleaseResource() {
+    resource_ = nullptr;
+}
+
 ArmLayerAcc::~ArmLayerAcc() {}
 
 Status ArmLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     // reinit k_param_ h,w
-    auto input_dim  = inputs[0]->GetBlobDesc().dims;
-    auto output_dim = outputs[0]->GetBlobDesc().dims;
-    k_param_->ic_r4 = ROUND_UP(input_dim[1], 4);
-    k_param_->ih    = input_dim[2];
-    k_param_->iw    = input_dim[3];
-    k_param_->oc_r4 = ROUND_UP(output_dim[1], 4);
-    k_param_->oh    = output_dim[2];
-    k_param_->ow    = output_dim[3];
+    const auto &input_dim  = inputs[0]->GetBlobDesc().dims;
+    const auto &output_dim = outputs[0]->GetBlobDesc().dims;
+    k_param_->ic_r4        = ROUND_UP(input_dim[1], 4);
+    k_param_->ih           = input_dim[2];
+    k_param_->iw           = input_dim[3];
+    k_param_->oc_r4        = ROUND_UP(output_dim[1], 4);
+    k_param_->oh           = output_dim[2];
+    k_param_->ow           = output_dim[3];
     return TNN_OK;
 }
 
@@ -82,12 +129,6 @@ bool ArmLayerAcc::DataTypeSupported(DataType data_type) {
 
 Status ArmLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Status status;
-#if TNN_PROFILE
-    auto pdata = std::make_shared<ProfilingData>();
-    UpdateProfilingData(pdata.get(), param_, inputs[0]->GetBlobDesc().dims, outputs[0]->GetBlobDesc().dims);
-    timer.Start();
-#endif
-
     auto in_data_type = inputs[0]->GetBlobDesc().data_type;
     if (DataTypeSupported(in_data_type)) {
         status = this->DoForward(inputs, outputs);
@@ -96,11 +137,6 @@ Status ArmLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector
         return Status(TNNERR_LAYER_ERR, "Error: arm layer acc got unsupported data type.");
     }
 
-#if TNN_PROFILE
-    pdata->kernel_time = timer.TimeEclapsed();
-    context_->AddProfilingData(pdata);
-#endif
-
     RETURN_ON_NEQ(status, TNN_OK);
 
     return TNN_OK;
@@ -58,9 +58,10 @@ public:
      */
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
-#if TNN_PROFILE
-    Timer timer;
-#endif
+    // @brief set the layouts implemented by the layer acc besides NC4HW4
+    void SetImplementedLayout(std::shared_ptr<const ImplementedLayout> implemented_layout);
+
+    virtual void ReleaseResource();
 
 protected:
     LayerParam *param_       = nullptr;
@@ -69,8 +70,23 @@ protected:
     ArmContext *context_                     = nullptr;
     std::shared_ptr<ArmKernelParam> k_param_ = nullptr;
 
+    std::shared_ptr<const ImplementedLayout> implemented_layout_ = nullptr;
+
+    // weights packed ahead of time, set before Init
+    PackedWeights packed_weights_;
+    // layout of the weights packed in Init, empty if they are not handed out
+    std::string packed_layout_;
+
     virtual bool DataTypeSupported(DataType data_type);
 
+    // @brief layout of the weights packed by impl, the packing also differs by arch and data type
+    static std::string GetPackedLayout(const std::string &impl, DataType data_type);
+
+    // @brief set the layout the weights are packed in by Init, the weights packed ahead of time are moved to
+    // buffers if they are in the same layout. otherwise buffers are left empty and the weights are packed again,
+    // an error if they are not repackable. the buffers taken are read only.
+    Status TakePackedWeights(const std::string &layout, const std::vector<RawBuffer *> &buffers);
+
 private:
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
@@ -106,6 +122,9 @@ public:
     ArmTypeLayerPrecisionRegister g_arm_##layer_type##_fp16_precision_register(layer_type,                             \
         ArmTypeLayerFp16PrecisionCreator::UpdateImplementedPrecision(layer_type));
 
+#define REGISTER_ARM_LAYOUT(layer_type, layout)                                                                        \
+    ArmTypeLayerLayoutRegister g_arm_##layer_type##_##layout##_layout_register(layer_type, layout);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_LAYER_ACC_H_
@@ -0,0 +1,70 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/Float4.h"
+#include "tnn/device/arm/acc/arm_recurrent_layer_acc.h"
+
+namespace TNN_NS {
+
+// @brief lstm with the onnx gates i o f c, all the gates are multiplied with h in one sgemm per step
+class ArmLSTMLayerAcc : public ArmRecurrentLayerAcc {
+public:
+    virtual ~ArmLSTMLayerAcc(){};
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+protected:
+    virtual void Step(const float *xw, int xw_step, int direction, int batch, float *h, float *c, float *work,
+                      float *gemm_buffer);
+};
+
+Status ArmLSTMLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                             const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    gates_    = 4;
+    segments_ = {4};
+    return ArmRecurrentLayerAcc::Init(context, param, resource, inputs, outputs);
+}
+
+void ArmLSTMLayerAcc::Step(const float *xw, int xw_step, int direction, int batch, float *h, float *c, float *work,
+                           float *gemm_buffer) {
+    RecurrentGemm(work, h, direction, 0, batch, gemm_buffer);
+
+    const int hidden4_div = hidden4_ / 4;
+    const int gate_step   = hidden4_div * xw_step;
+    const int work_step   = hidden4_div * batch * 4;
+    for (int z = 0; z < hidden4_div; z++) {
+        for (int b = 0; b < batch; b++) {
+            const float *x_ptr = xw + z * xw_step + b * 4;
+            const float *r_ptr = work + (z * batch + b) * 4;
+            float *h_ptr       = h + (z * batch + b) * 4;
+            float *c_ptr       = c + (z * batch + b) * 4;
+
+            Float4 gate_i = Float4::sigmoid(Float4::load(x_ptr) + Float4::load(r_ptr));
+            Float4 gate_o = Float4::sigmoid(Float4::load(x_ptr + gate_step) + Float4::load(r_ptr + work_step));
+            Float4 gate_f = Float4::sigmoid(Float4::load(x_ptr + 2 * gate_step) + Float4::load(r_ptr + 2 * work_step));
+            Float4 gate_c = Float4::tanh(Float4::load(x_ptr + 3 * gate_step) + Float4::load(r_ptr + 3 * work_step));
+
+            Float4 cell = gate_f * Float4::load(c_ptr);
+            Float4::mla(cell, gate_i, gate_c);
+            Float4::save(c_ptr, cell);
+            Float4::save(h_ptr, gate_o * Float4::tanh(cell));
+        }
+    }
+}
+
+REGISTER_ARM_ACC(LSTM, LAYER_LSTM);
+
+}  // namespace TNN_NS
@@ -24,7 +24,7 @@ ArmNchwLayerAcc::~ArmNchwLayerAcc(){};
 
 Status ArmNchwLayerAcc::UnPackInputs(const std::vector<Blob *> &inputs) {
     for (int i = 0; i < inputs.size(); i++) {
-        auto input_dims = inputs[i]->GetBlobDesc().dims;
+        const auto &input_dims = inputs[i]->GetBlobDesc().dims;
         for (int n = 0; n < input_dims[0]; ++n) {
             auto in_count     = input_dims[3] * input_dims[2] * ROUND_UP(input_dims[1], 4);
             auto out_count    = input_dims[3] * input_dims[2] * input_dims[1];
@@ -37,7 +37,7 @@ Status ArmNchwLayerAcc::UnPackInputs(const std::vector<Blob *> &inputs) {
 }
 Status ArmNchwLayerAcc::PackOutputs(const std::vector<Blob *> &outputs) {
     for (int i = 0; i < outputs.size(); i++) {
-        auto out_dims = nchw_blob_out[i]->GetBlobDesc().dims;
+        const auto &out_dims = nchw_blob_out[i]->GetBlobDesc().dims;
         outputs[i]->GetBlobDesc().dims = out_dims;
         for (int n = 0; n < out_dims[0]; ++n) {
             auto in_count  = out_dims[3] * out_dims[2] * out_dims[1];
@@ -96,12 +96,12 @@ Status ArmNormalizeLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
     float epsilon      = layer_param->epsilon;
     int channel_shared = layer_param->channel_shared;
 
-    Blob *input_blob  = inputs[0];
-    Blob *output_blob = outputs[0];
-    auto output_dims  = output_blob->GetBlobDesc().dims;
-    int batch         = output_dims[0];
-    int channel       = output_dims[1];
-    int plane_num     = DimsVectorUtils::Count(output_blob->GetBlobDesc().dims, 2);
+    Blob *input_blob        = inputs[0];
+    Blob *output_blob       = outputs[0];
+    const auto &output_dims = output_blob->GetBlobDesc().dims;
+    int batch               = output_dims[0];
+    int channel             = output_dims[1];
+    int plane_num           = DimsVectorUtils::Count(output_blob->GetBlobDesc().dims, 2);
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         float *input_data  = reinterpret_cast<float *>(GetBlobHandlePtr(input_blob->GetHandle()));
         float *output_data = reinterpret_cast<float *>(GetBlobHandlePtr(output_blob->GetHandle()));
@@ -228,8 +228,8 @@ Status ArmPadLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
     auto input_blob  = inputs[0];
     auto output_blob = outputs[0];
 
-    auto input_dims  = input_blob->GetBlobDesc().dims;
-    auto output_dims = output_blob->GetBlobDesc().dims;
+    const auto &input_dims  = input_blob->GetBlobDesc().dims;
+    const auto &output_dims = output_blob->GetBlobDesc().dims;
 
     int batch          = output_dims[0];
     int c_r4           = ROUND_UP(output_dims[1], 4);
@@ -27,8 +27,8 @@ Status ArmPermuteLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     AllocConvertBuffer(inputs, outputs);
 
     UnPackInputs(inputs);
-    auto input_dims     = nchw_blob_in[0]->GetBlobDesc().dims;
-    auto output_dims    = nchw_blob_out[0]->GetBlobDesc().dims;
+    const auto &input_dims  = nchw_blob_in[0]->GetBlobDesc().dims;
+    const auto &output_dims = nchw_blob_out[0]->GetBlobDesc().dims;
 
     std::vector<int> input_step;
     std::vector<int> output_step;
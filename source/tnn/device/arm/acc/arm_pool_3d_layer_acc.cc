@@ -0,0 +1,123 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <cfloat>
+
+#include "tnn/device/arm/acc/Float4.h"
+#include "tnn/device/arm/acc/arm_layer_acc.h"
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// @brief 3d max and average pooling on 5 dims NC4HW4 blobs, the channels are packed in front of d, h and w
+class ArmPool3DLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmPool3DLayerAcc(){};
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
+};
+
+std::vector<DataFormat> ArmPool3DLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size == 5 && (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16)) {
+        support_list.push_back(DATA_FORMAT_NC4HW4);
+    }
+    return support_list;
+}
+
+template <typename T>
+Status ArmPool3DLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<PoolingLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int c4 = UP_DIV(dims_output[1], 4);
+    const int id = dims_input[2], ih = dims_input[3], iw = dims_input[4];
+    const int od = dims_output[2], oh = dims_output[3], ow = dims_output[4];
+    const int kd = param->kernels[2], kh = param->kernels[1], kw = param->kernels[0];
+    const int sd = param->strides[2], sh = param->strides[1], sw = param->strides[0];
+    const int pd = param->pads[4], ph = param->pads[2], pw = param->pads[0];
+    const bool is_max = param->pool_type == 0;
+
+    T *src_origin = reinterpret_cast<T *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
+    T *dst_origin = reinterpret_cast<T *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
+
+    for (int b = 0; b < dims_output[0]; b++) {
+        T *src_b = src_origin + b * c4 * id * ih * iw * 4;
+        T *dst_b = dst_origin + b * c4 * od * oh * ow * 4;
+
+        OMP_PARALLEL_FOR_
+        for (int zo = 0; zo < c4 * od; zo++) {
+            const int z = zo / od, oz = zo % od;
+            const T *src_z = src_b + z * id * ih * iw * 4;
+            T *dst_z       = dst_b + (z * od + oz) * oh * ow * 4;
+
+            const int ds = MAX(oz * sd - pd, 0);
+            const int de = MIN(oz * sd - pd + kd, id);
+            for (int oy = 0; oy < oh; oy++) {
+                const int hs = MAX(oy * sh - ph, 0);
+                const int he = MIN(oy * sh - ph + kh, ih);
+                for (int ox = 0; ox < ow; ox++) {
+                    const int ws = MAX(ox * sw - pw, 0);
+                    const int we = MIN(ox * sw - pw + kw, iw);
+
+                    Float4 acc(is_max ? -FLT_MAX : 0.f);
+                    for (int d = ds; d < de; d++) {
+                        for (int h = hs; h < he; h++) {
+                            const T *src_h = src_z + (d * ih + h) * iw * 4;
+                            for (int w = ws; w < we; w++) {
+                                if (is_max) {
+                                    acc = Float4::max(acc, Float4::load(src_h + w * 4));
+                                } else {
+                                    acc = acc + Float4::load(src_h + w * 4);
+                                }
+                            }
+                        }
+                    }
+                    // average over the valid window, the same as the naive pooling
+                    const int count = (de - ds) * (he - hs) * (we - ws);
+                    if (!is_max && count > 0) {
+                        acc = acc * Float4(1.0f / count);
+                    }
+                    Float4::save(dst_z + (oy * ow + ox) * 4, acc);
+                }
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+Status ArmPool3DLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        return Exec<float>(inputs, outputs);
+    } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+        return Exec<bfp16_t>(inputs, outputs);
+    }
+    return Status(TNNERR_LAYER_ERR, "data type not support in pooling 3d");
+}
+
+REGISTER_ARM_ACC(Pool3D, LAYER_POOLING_3D)
+
+}  // namespace TNN_NS
@@ -50,8 +50,8 @@ Status ArmPoolingLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     auto input  = inputs[0];
     auto output = outputs[0];
 
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     auto oc_4       = UP_DIV(dims_output[1], 4);
     auto batch      = dims_output[0];
@@ -59,7 +59,25 @@ Status ArmPoolingLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     auto output_ptr = GetBlobHandlePtr(output->GetHandle());
 
     // run
-    if (input->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+    if (input->GetBlobDesc().data_type == DATA_TYPE_FLOAT && input->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        auto channel             = dims_output[1];
+        auto input_batch_stride  = channel * k_param_->iw * k_param_->ih;
+        auto output_batch_stride = channel * k_param_->ow * k_param_->oh;
+        OMP_PARALLEL_FOR_
+        for (int n = 0; n < batch; n++) {
+            if (param->pool_type == 0) {
+                MaxPoolingNHWC(reinterpret_cast<float *>(input_ptr) + n * input_batch_stride, k_param_->iw,
+                               k_param_->ih, reinterpret_cast<float *>(output_ptr) + n * output_batch_stride,
+                               k_param_->ow, k_param_->oh, channel, param->kernels[0], param->kernels[1],
+                               param->strides[0], param->strides[1], param->pads[0], param->pads[2]);
+            } else {
+                AvgPoolingNHWC(reinterpret_cast<float *>(input_ptr) + n * input_batch_stride, k_param_->iw,
+                               k_param_->ih, reinterpret_cast<float *>(output_ptr) + n * output_batch_stride,
+                               k_param_->ow, k_param_->oh, channel, param->kernels[0], param->kernels[1],
+                               param->strides[0], param->strides[1], param->pads[0], param->pads[2]);
+            }
+        }
+    } else if (input->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         auto input_plane_stride  = 4 * k_param_->iw * k_param_->ih;
         auto output_plane_stride = 4 * k_param_->ow * k_param_->oh;
         OMP_PARALLEL_FOR_
@@ -118,5 +136,6 @@ Status ArmPoolingLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
 }
 
 REGISTER_ARM_ACC(Pooling, LAYER_POOLING)
+REGISTER_ARM_LAYOUT(LAYER_POOLING, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
@@ -28,7 +28,7 @@ Status ArmPowLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
     CHECK_PARAM_NULL(layer_param);
 
     Blob *output_blob = outputs[0];
-    auto dims         = output_blob->GetBlobDesc().dims;
+    const auto &dims  = output_blob->GetBlobDesc().dims;
     int count         = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
     int count_quad    = UP_DIV(count, 4);
 
@@ -36,7 +36,7 @@ Status ArmPReluLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vect
 
     Blob *input_blob       = inputs[0];
     Blob *output_blob      = outputs[0];
-    auto dims              = input_blob->GetBlobDesc().dims;
+    const auto &dims       = input_blob->GetBlobDesc().dims;
     const int channel      = dims[1];
     const int height       = dims[2];
     const int width        = dims[3];
@@ -0,0 +1,346 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/arm_recurrent_layer_acc.h"
+
+#include "tnn/device/arm/acc/compute/gemm_function.h"
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_context.h"
+#include "tnn/device/arm/arm_util.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+ArmRecurrentLayerAcc::~ArmRecurrentLayerAcc() {}
+
+bool ArmRecurrentLayerAcc::IsResourceReleasable() {
+    return true;
+}
+
+PackedWeights ArmRecurrentLayerAcc::GetPackedWeights() {
+    if (packed_layout_.empty()) {
+        return PackedWeights();
+    }
+    return {packed_layout_, {buffer_weight_, buffer_recurrence_, buffer_bias_}};
+}
+
+Status ArmRecurrentLayerAcc::SetPackedWeights(const PackedWeights &packed_weights) {
+    packed_weights_ = packed_weights;
+    return TNN_OK;
+}
+
+std::vector<DataFormat> ArmRecurrentLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size == 4 && (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16)) {
+        support_list.push_back(DATA_FORMAT_NC4HW4);
+    }
+    return support_list;
+}
+
+// the output channels of the input sgemm, the gates of all the directions
+int ArmRecurrentLayerAcc::InputChannels() {
+    return ROUND_UP(directions_ * gates_ * hidden4_, ARM_SGEMM_TILE_N);
+}
+
+int ArmRecurrentLayerAcc::SegmentChannels(int segment) {
+    return ROUND_UP(segments_[segment] * hidden4_, ARM_SGEMM_TILE_N);
+}
+
+int ArmRecurrentLayerAcc::SegmentOffset(int segment) {
+    int offset = 0;
+    for (int k = 0; k < segment; k++) {
+        offset += SegmentChannels(k);
+    }
+    return offset;
+}
+
+int ArmRecurrentLayerAcc::DirectionChannels() {
+    return SegmentOffset((int)segments_.size());
+}
+
+/*
+the input weights are packed to [direction * gates * hidden4 / N][input / 4][4N], the recurrence weights to
+[direction][segment][segment gates * hidden4 / N][hidden4 / 4][4N], the rows of the padded hidden units are zeros
+*/
+Status ArmRecurrentLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs) {
+    auto layer_res = dynamic_cast<RecurrentLayerResource *>(resource_);
+    CHECK_PARAM_NULL(layer_res);
+
+    const int input = DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims, 2);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        RawBuffer w_handle = ConvertHalfHandle(layer_res->weight_handle);
+        if (w_handle.GetDataCount() != directions_ * gates_ * hidden_ * input) {
+            LOGE("Error: recurrent layer got %d input weights\n", w_handle.GetDataCount());
+            return Status(TNNERR_MODEL_ERR, "Error: recurrent layer got invalid input weights");
+        }
+        const int oc = InputChannels();
+        RawBuffer rows(oc * input * sizeof(float));
+        const float *src = w_handle.force_to<float *>();
+        float *dst       = rows.force_to<float *>();
+        for (int g = 0; g < directions_ * gates_; g++) {
+            memcpy(dst + g * hidden4_ * input, src + g * hidden_ * input, hidden_ * input * sizeof(float));
+        }
+
+        RawBuffer temp_buffer(oc * ROUND_UP(input, 4) * sizeof(float) + NEON_KERNEL_EXTRA_LOAD);
+        ConvertWeightsFromGOIHWToGOIHW16(dst, temp_buffer.force_to<float *>(), 1, input, oc, 1, 1);
+        if (ARM_SGEMM_TILE_N == 8) {
+            ConvertWeightsC4ToC8(temp_buffer.force_to<float *>(), ROUND_UP(input, 4), oc);
+        }
+        buffer_weight_ = temp_buffer;
+    }
+
+    if (!buffer_recurrence_.GetBytesSize()) {
+        RawBuffer r_handle = ConvertHalfHandle(layer_res->recurrence_handle);
+        if (r_handle.GetDataCount() != directions_ * gates_ * hidden_ * hidden_) {
+            LOGE("Error: recurrent layer got %d recurrence weights\n", r_handle.GetDataCount());
+            return Status(TNNERR_MODEL_ERR, "Error: recurrent layer got invalid recurrence weights");
+        }
+        RawBuffer temp_buffer(directions_ * DirectionChannels() * hidden4_ * sizeof(float) + NEON_KERNEL_EXTRA_LOAD);
+        const float *src = r_handle.force_to<float *>();
+        for (int d = 0; d < directions_; d++) {
+            for (int k = 0, gate = 0; k < segments_.size(); gate += segments_[k++]) {
+                const int oc = SegmentChannels(k);
+                RawBuffer rows(oc * hidden_ * sizeof(float));
+                float *rows_ptr = rows.force_to<float *>();
+                for (int g = 0; g < segments_[k]; g++) {
+                    memcpy(rows_ptr + g * hidden4_ * hidden_, src + ((d * gates_ + gate + g) * hidden_) * hidden_,
+                           hidden_ * hidden_ * sizeof(float));
+                }
+                float *dst = temp_buffer.force_to<float *>() + (d * DirectionChannels() + SegmentOffset(k)) * hidden4_;
+                ConvertWeightsFromGOIHWToGOIHW16(rows_ptr, dst, 1, hidden_, oc, 1, 1);
+                if (ARM_SGEMM_TILE_N == 8) {
+                    ConvertWeightsC4ToC8(dst, hidden4_, oc);
+                }
+            }
+        }
+        buffer_recurrence_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+/*
+the input bias [direction * gates * hidden4] adds the recurrence bias of the first segment, the recurrence bias of
+the other segments [direction][segment][segment gates * hidden4] follow it
+*/
+Status ArmRecurrentLayerAcc::allocateBufferBias() {
+    auto layer_res = dynamic_cast<RecurrentLayerResource *>(resource_);
+    CHECK_PARAM_NULL(layer_res);
+
+    if (!buffer_bias_.GetBytesSize()) {
+        RawBuffer b_handle = ConvertHalfHandle(layer_res->bias_handle);
+        if (b_handle.GetDataCount() != directions_ * 2 * gates_ * hidden_) {
+            LOGE("Error: recurrent layer got %d bias\n", b_handle.GetDataCount());
+            return Status(TNNERR_MODEL_ERR, "Error: recurrent layer got invalid bias");
+        }
+        const int input_channels = InputChannels();
+        RawBuffer temp_buffer((input_channels + directions_ * DirectionChannels()) * sizeof(float));
+        const float *src = b_handle.force_to<float *>();
+        float *dst       = temp_buffer.force_to<float *>();
+        for (int d = 0; d < directions_; d++) {
+            const float *wb = src + d * 2 * gates_ * hidden_;
+            const float *rb = wb + gates_ * hidden_;
+            for (int g = 0; g < gates_; g++) {
+                float *dst_g = dst + (d * gates_ + g) * hidden4_;
+                for (int j = 0; j < hidden_; j++) {
+                    dst_g[j] = wb[g * hidden_ + j] + (g < segments_[0] ? rb[g * hidden_ + j] : 0.0f);
+                }
+            }
+            for (int k = 1, gate = segments_[0]; k < segments_.size(); gate += segments_[k++]) {
+                float *dst_k = dst + input_channels + d * DirectionChannels() + SegmentOffset(k);
+                for (int g = 0; g < segments_[k]; g++) {
+                    memcpy(dst_k + g * hidden4_, rb + (gate + g) * hidden_, hidden_ * sizeof(float));
+                }
+            }
+        }
+        buffer_bias_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status ArmRecurrentLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                  const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+
+    auto layer_param = dynamic_cast<RecurrentLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    hidden_     = layer_param->hidden_size;
+    hidden4_    = ROUND_UP(hidden_, 4);
+    direction_  = layer_param->direction;
+    directions_ = direction_ == 2 ? 2 : 1;
+
+    // the weights are packed by the gates of each segment
+    std::string impl = "recurrent_g" + std::to_string(gates_);
+    for (auto segment : segments_) {
+        impl += "_" + std::to_string(segment);
+    }
+    RETURN_ON_NEQ(TakePackedWeights(GetPackedLayout(impl, inputs[0]->GetBlobDesc().data_type),
+                                    {&buffer_weight_, &buffer_recurrence_, &buffer_bias_}),
+                  TNN_OK);
+    RETURN_ON_NEQ(allocateBufferWeight(inputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(), TNN_OK);
+    return TNN_OK;
+}
+
+void ArmRecurrentLayerAcc::RecurrentGemm(float *dst, float *src, int direction, int segment, int batch,
+                                         float *gemm_buffer) {
+    const int oc = SegmentChannels(segment);
+    int a_block, b_block;
+    set_block_size(a_block, b_block, 512 * 1024 / sizeof(float), batch, oc, hidden4_, sizeof(float));
+
+    const int offset = direction * DirectionChannels() + SegmentOffset(segment);
+    float *weight    = buffer_recurrence_.force_to<float *>() + offset * hidden4_;
+    float *bias      = buffer_bias_.force_to<float *>() + InputChannels() + offset;
+    if (batch > oc) {
+        sgemm_repack_lhs(dst, src, weight, hidden4_ / 4, oc / 4, batch, batch * 4, a_block, b_block, gemm_buffer, bias,
+                         ActivationType_None);
+    } else {
+        sgemm_repack_rhs(dst, src, weight, hidden4_ / 4, oc / 4, batch, batch * 4, a_block, b_block, gemm_buffer, bias,
+                         ActivationType_None);
+    }
+}
+
+Status ArmRecurrentLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        return Exec<float>(inputs, outputs);
+    } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+        return Exec<bfp16_t>(inputs, outputs);
+    }
+    return TNNERR_LAYER_ERR;
+}
+
+template <typename T>
+Status ArmRecurrentLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    const auto &dims_input = inputs[0]->GetBlobDesc().dims;
+
+    const int seq     = dims_input[0];
+    const int batch   = dims_input[1];
+    const int input   = DimsVectorUtils::Count(dims_input, 2);
+    const int batch4  = UP_DIV(batch, 4);
+    const int input4  = UP_DIV(input, 4);
+    const int plane   = seq * batch;
+    const int oc      = InputChannels();
+    const int hidden  = hidden_;
+    const int l2_size = 512 * 1024 / sizeof(float);
+
+    // the sgemm work space of the input projections and of the largest recurrence segment
+    int a_block, b_block;
+    set_block_size(a_block, b_block, l2_size, plane, oc, input4 * 4, sizeof(float));
+    const bool use_lhs = plane > oc;
+    int gemm_size      = a_block * input4 * 4 * (use_lhs ? OMP_MAX_THREADS_NUM_ : 1);
+    for (int k = 0; k < segments_.size(); k++) {
+        int seg_a_block, seg_b_block;
+        const int seg_oc = SegmentChannels(k);
+        set_block_size(seg_a_block, seg_b_block, l2_size, batch, seg_oc, hidden4_, sizeof(float));
+        gemm_size = MAX(gemm_size, seg_a_block * hidden4_ * (batch > seg_oc ? OMP_MAX_THREADS_NUM_ : 1));
+    }
+
+    const int x_size     = input4 * 4 * plane;
+    const int xw_size    = oc * plane;
+    const int state_size = hidden4_ * batch;
+    const int work_size  = (DirectionChannels() + hidden4_) * batch;
+    const int total_size = x_size + xw_size + 2 * state_size + work_size + gemm_size;
+
+    float *x_packed = reinterpret_cast<float *>(
+        context_->GetSharedWorkSpace(total_size * sizeof(float) + NEON_KERNEL_EXTRA_LOAD));
+    float *xw          = x_packed + x_size;
+    float *h           = xw + xw_size;
+    float *c           = h + state_size;
+    float *work        = c + state_size;
+    float *gemm_buffer = work + work_size;
+
+    // x [seq][batch/4][input][4] to [input/4][seq * batch][4]
+    T *src = reinterpret_cast<T *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
+    OMP_PARALLEL_FOR_
+    for (int p = 0; p < plane; p++) {
+        const int t = p / batch, b = p % batch;
+        const T *src_p = src + (t * batch4 + b / 4) * input * 4 + b % 4;
+        for (int i = 0; i < input4 * 4; i++) {
+            x_packed[((i / 4) * plane + p) * 4 + i % 4] = i < input ? float(src_p[i * 4]) : 0.0f;
+        }
+    }
+
+    // the input projections of all the timesteps, [direction][gate][hidden4 / 4][seq * batch][4]
+    float *weight = buffer_weight_.force_to<float *>();
+    float *bias   = buffer_bias_.force_to<float *>();
+    if (use_lhs) {
+        sgemm_repack_lhs(xw, x_packed, weight, input4, oc / 4, plane, plane * 4, a_block, b_block, gemm_buffer, bias,
+                         ActivationType_None);
+    } else {
+        sgemm_repack_rhs(xw, x_packed, weight, input4, oc / 4, plane, plane * 4, a_block, b_block, gemm_buffer, bias,
+                         ActivationType_None);
+    }
+
+    T *y   = reinterpret_cast<T *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
+    T *y_h = outputs.size() > 1 ? reinterpret_cast<T *>(GetBlobHandlePtr(outputs[1]->GetHandle())) : nullptr;
+    T *y_c = outputs.size() > 2 ? reinterpret_cast<T *>(GetBlobHandlePtr(outputs[2]->GetHandle())) : nullptr;
+    T *h0  = inputs.size() > 1 ? reinterpret_cast<T *>(GetBlobHandlePtr(inputs[1]->GetHandle())) : nullptr;
+    T *c0  = inputs.size() > 2 ? reinterpret_cast<T *>(GetBlobHandlePtr(inputs[2]->GetHandle())) : nullptr;
+    const int state_blob_size = directions_ * batch4 * hidden * 4;
+
+    // y is [seq][1][batch][hidden][4] with the directions in the lanes
+    memset(y, 0, plane * hidden * 4 * sizeof(T));
+    if (y_h) {
+        memset(y_h, 0, state_blob_size * sizeof(T));
+    }
+    if (y_c) {
+        memset(y_c, 0, state_blob_size * sizeof(T));
+    }
+
+    for (int d = 0; d < directions_; d++) {
+        // the states [direction][batch/4][hidden][4] to [hidden4 / 4][batch][4]
+        for (int b = 0; b < batch; b++) {
+            for (int j = 0; j < hidden4_; j++) {
+                const int s = ((d * batch4 + b / 4) * hidden + j) * 4 + b % 4;
+                const int i = ((j / 4) * batch + b) * 4 + j % 4;
+                h[i]        = h0 && j < hidden ? float(h0[s]) : 0.0f;
+                c[i]        = c0 && j < hidden ? float(c0[s]) : 0.0f;
+            }
+        }
+
+        const bool reverse = direction_ == 1 || d == 1;
+        for (int step = 0; step < seq; step++) {
+            const int t = reverse ? seq - 1 - step : step;
+            Step(xw + (d * gates_ * hidden4_ / 4 * plane + t * batch) * 4, plane * 4, d, batch, h, c, work,
+                 gemm_buffer);
+
+            T *y_t = y + t * batch * hidden * 4 + d;
+            for (int b = 0; b < batch; b++) {
+                for (int j = 0; j < hidden; j++) {
+                    y_t[(b * hidden + j) * 4] = T(h[((j / 4) * batch + b) * 4 + j % 4]);
+                }
+            }
+        }
+
+        for (int b = 0; b < batch; b++) {
+            for (int j = 0; j < hidden; j++) {
+                const int s = ((d * batch4 + b / 4) * hidden + j) * 4 + b % 4;
+                const int i = ((j / 4) * batch + b) * 4 + j % 4;
+                if (y_h) {
+                    y_h[s] = T(h[i]);
+                }
+                if (y_c) {
+                    y_c[s] = T(c[i]);
+                }
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,93 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_ARM_ARM_RECURRENT_LAYER_ACC_H_
+#define TNN_SOURCE_TNN_DEVICE_ARM_ARM_RECURRENT_LAYER_ACC_H_
+
+#include <vector>
+
+#include "tnn/device/arm/acc/arm_layer_acc.h"
+
+namespace TNN_NS {
+
+/*
+lstm and gru on the 4 dims blobs of the recurrent layers, x [seq][batch][input][1] and
+y [seq][direction][batch][hidden]. the input projections of all the timesteps and directions are computed by one
+sgemm before the recurrence, each step then multiplies the state with the recurrence weights by a small sgemm and
+applies the gates in place. the gates are padded to a multiple of 4 hidden units, the states are kept in float as
+[hidden/4][batch][4].
+*/
+class ArmRecurrentLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmRecurrentLayerAcc();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // weights and bias are packed in init
+    virtual bool IsResourceReleasable();
+
+    virtual PackedWeights GetPackedWeights();
+
+    // taken in Init if they are packed for the same gates and segments
+    virtual Status SetPackedWeights(const PackedWeights &packed_weights);
+
+protected:
+    /*
+    one step of the direction, xw points to the input projection of the first gate at the step, xw_step is the
+    distance between two packed channels of it. h and c are the states updated in place.
+    */
+    virtual void Step(const float *xw, int xw_step, int direction, int batch, float *h, float *c, float *work,
+                      float *gemm_buffer) = 0;
+
+    // multiply the state src [hidden/4][batch][4] with the recurrence weights of a segment, plus its bias
+    void RecurrentGemm(float *dst, float *src, int direction, int segment, int batch, float *gemm_buffer);
+
+    // the output channels of the recurrence sgemm of a segment
+    int SegmentChannels(int segment);
+
+    // the number of gates, and the gates multiplied with the same state in each step
+    int gates_ = 0;
+    std::vector<int> segments_;
+
+    int hidden_     = 0;
+    int hidden4_    = 0;
+    int direction_  = 0;
+    int directions_ = 1;
+
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_recurrence_;
+    RawBuffer buffer_bias_;
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    Status allocateBufferWeight(const std::vector<Blob *> &inputs);
+
+    Status allocateBufferBias();
+
+    int InputChannels();
+    int SegmentOffset(int segment);
+    int DirectionChannels();
+
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_RECURRENT_LAYER_ACC_H_
@@ -29,7 +29,7 @@ Status ArmReduceLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
 }
 
 void ArmReduceLayerAcc::ReduceChannel(
-        float* input_data, float* output_data, DimsVector& dims_in,
+        float* input_data, float* output_data, const DimsVector& dims_in,
         const int c4n, const int c4r, const Float4 axis_n, const int hw_r, const int hw_c, const int hw) {
     float reduce_c = dims_in[1];
     for (int n = 0; n < dims_in[0]; n++) {
@@ -85,10 +85,10 @@ Status ArmReduceLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     auto param = dynamic_cast<ReduceLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
 
-    auto input    = inputs[0];
-    auto output   = outputs[0];
-    auto dims_in  = input->GetBlobDesc().dims;
-    auto dims_out = output->GetBlobDesc().dims;
+    auto input           = inputs[0];
+    auto output          = outputs[0];
+    const auto &dims_in  = input->GetBlobDesc().dims;
+    const auto &dims_out = output->GetBlobDesc().dims;
 
     int out_count = dims_out[0] * ROUND_UP(dims_out[1], 4) * dims_out[2] * dims_out[3];
 
@@ -100,8 +100,8 @@ Status ArmReduceLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     int inner_dim = DimsVectorUtils::Count(dims_in, axis + 1);
 
     if (input->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
-        auto input_data  = reinterpret_cast<float *>(input->GetHandle().base);
-        auto output_data = reinterpret_cast<float *>(output->GetHandle().base);
+        auto input_data  = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
+        auto output_data = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
 
         int c4u  = ROUND_UP(dims_in[1], 4);
         int c4n  = UP_DIV(dims_in[1], 4);
@@ -16,6 +16,7 @@
 
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
@@ -26,7 +27,23 @@ Status ArmReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResou
     auto reformat_param = dynamic_cast<ReformatLayerParam *>(param);
     CHECK_PARAM_NULL(reformat_param);
 
-    if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
+    if (reformat_param->src_format == DATA_FORMAT_NCHW || reformat_param->dst_format == DATA_FORMAT_NCHW) {
+        // blobs of the layers falling back to the naive device, the nchw side is fp32
+        if (reformat_param->src_format == DATA_FORMAT_NC4HW4 && reformat_param->dst_format == DATA_FORMAT_NCHW) {
+            reformat_param->type = NC4HW4_2_NCHW;
+        } else if (reformat_param->src_format == DATA_FORMAT_NCHW &&
+                   reformat_param->dst_format == DATA_FORMAT_NC4HW4) {
+            reformat_param->type = NCHW_2_NC4HW4;
+        } else {
+            return Status(TNNERR_MODEL_ERR, "unsupport reformat layout");
+        }
+        auto nchw_blob = reformat_param->type == NC4HW4_2_NCHW ? outputs[0] : inputs[0];
+        if (nchw_blob->GetBlobDesc().data_format != DATA_FORMAT_NCHW ||
+            nchw_blob->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+            return Status(TNNERR_MODEL_ERR, "reformat nchw blob must be fp32");
+        }
+        return TNN_OK;
+    } else if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
         reformat_param->type = DEQUANT_ONLY;
         for (auto blob : outputs) {
             blob->GetBlobDesc().data_format = DATA_FORMAT_NC4HW4;
@@ -36,6 +53,21 @@ Status ArmReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResou
         for (auto blob : outputs) {
             blob->GetBlobDesc().data_format = DATA_FORMAT_NHWC4;
         }
+    } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_FLOAT) {
+        // layout only, the blob formats are assigned by the optimizer
+        if (reformat_param->src_format == DATA_FORMAT_NC4HW4 && reformat_param->dst_format == DATA_FORMAT_NHWC) {
+            reformat_param->type = NC4HW4_2_NHWC;
+        } else if (reformat_param->src_format == DATA_FORMAT_NHWC &&
+                   reformat_param->dst_format == DATA_FORMAT_NC4HW4) {
+            reformat_param->type = NHWC_2_NC4HW4;
+        } else {
+            return Status(TNNERR_MODEL_ERR, "unsupport reformat layout");
+        }
+        if (inputs[0]->GetBlobDesc().data_format != reformat_param->src_format ||
+            outputs[0]->GetBlobDesc().data_format != reformat_param->dst_format) {
+            return Status(TNNERR_MODEL_ERR, "reformat layout mismatch with blob data format");
+        }
+        return TNN_OK;
     } else {
         if (reformat_param->src_type == DATA_TYPE_BFP16 || reformat_param->dst_type == DATA_TYPE_BFP16) {
             LOGE("unsupport precision mode, please dont use precision = low for int8");
@@ -52,8 +84,8 @@ Status ArmReformatLayerAcc::allocateBufferParam(const std::vector<Blob *> &input
     CHECK_PARAM_NULL(param);
 
     if (param->src_type != param->dst_type && !scale_buffer_.GetBytesSize()) {
-        auto dims_output    = outputs[0]->GetBlobDesc().dims;
-        int total_byte_size = ROUND_UP(dims_output[1], 4) * sizeof(float);
+        const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+        int total_byte_size     = ROUND_UP(dims_output[1], 4) * sizeof(float);
         IntScaleResource *reformat_scale;
         if (param->src_type == DATA_TYPE_INT8) {
             reformat_scale = reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource();
@@ -77,8 +109,26 @@ Status ArmReformatLayerAcc::allocateBufferParam(const std::vector<Blob *> &input
     return TNN_OK;
 }
 
+// the nc4hw4 blob is of type T, the nchw blob is fp32
+template <typename T>
+static void ReformatNCHW(ReformatType type, char *dst, char *src, DimsVector dims) {
+    int channel     = dims[1];
+    int hw          = DimsVectorUtils::Count(dims, 2);
+    int nchw_step   = hw * channel;
+    int nc4hw4_step = hw * ROUND_UP(channel, 4);
+    for (int n = 0; n < dims[0]; n++) {
+        if (type == NC4HW4_2_NCHW) {
+            UnpackC4(reinterpret_cast<float *>(dst) + n * nchw_step, reinterpret_cast<T *>(src) + n * nc4hw4_step, hw,
+                     channel);
+        } else {
+            PackC4(reinterpret_cast<T *>(dst) + n * nc4hw4_step, reinterpret_cast<float *>(src) + n * nchw_step, hw,
+                   channel);
+        }
+    }
+}
+
 Status ArmReformatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    auto dims = outputs[0]->GetBlobDesc().dims;
+    const auto &dims = outputs[0]->GetBlobDesc().dims;
 
     auto param = dynamic_cast<ReformatLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
@@ -91,10 +141,35 @@ Status ArmReformatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
         FloatToInt8(reinterpret_cast<int8_t *>(GetBlobHandlePtr(outputs[0]->GetHandle())),
                     reinterpret_cast<float *>(GetBlobHandlePtr(inputs[0]->GetHandle())), 
                     scale_buffer_.force_to<float *>(), dims[0], dims[1], dims[2] * dims[3]);
+    } else if (param->type == NC4HW4_2_NHWC || param->type == NHWC_2_NC4HW4) {
+        auto src_ptr    = reinterpret_cast<float *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
+        auto dst_ptr    = reinterpret_cast<float *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
+        int hw          = dims[2] * dims[3];
+        int nhwc_step   = hw * dims[1];
+        int nc4hw4_step = hw * ROUND_UP(dims[1], 4);
+        for (int n = 0; n < dims[0]; n++) {
+            if (param->type == NC4HW4_2_NHWC) {
+                UnpackC4ToNHWC(dst_ptr + n * nhwc_step, src_ptr + n * nc4hw4_step, hw, dims[1]);
+            } else {
+                PackC4FromNHWC(dst_ptr + n * nc4hw4_step, src_ptr + n * nhwc_step, hw, dims[1]);
+            }
+        }
+    } else if (param->type == NC4HW4_2_NCHW || param->type == NCHW_2_NC4HW4) {
+        auto src_ptr     = GetBlobHandlePtr(inputs[0]->GetHandle());
+        auto dst_ptr     = GetBlobHandlePtr(outputs[0]->GetHandle());
+        auto nc4hw4_blob = param->type == NC4HW4_2_NCHW ? inputs[0] : outputs[0];
+        // dispatch on the blob, the nc4hw4 inputs of the net keep their own data type
+        if (nc4hw4_blob->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+            ReformatNCHW<bfp16_t>(param->type, dst_ptr, src_ptr, dims);
+        } else {
+            ReformatNCHW<float>(param->type, dst_ptr, src_ptr, dims);
+        }
     }
     return TNN_OK;
 }
 
 ArmTypeLayerAccRegister<TypeLayerAccCreator<ArmReformatLayerAcc>> g_arm_reformat_layer_acc_register(LAYER_REFORMAT);
+REGISTER_ARM_LAYOUT(LAYER_REFORMAT, DATA_FORMAT_NHWC)
+REGISTER_ARM_LAYOUT(LAYER_REFORMAT, DATA_FORMAT_NCHW)
 
 }  // namespace TNN_NS
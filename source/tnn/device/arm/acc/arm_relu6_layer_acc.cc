@@ -22,7 +22,7 @@ namespace TNN_NS {
 //     auto input  = inputs[0];
 //     auto output = outputs[0];
 
-//     auto dims = output->GetBlobDesc().dims;
+//     const auto &dims = output->GetBlobDesc().dims;
 
 //     int count      = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
 //     int count_quad = UP_DIV(count, 4);
@@ -53,4 +53,5 @@ typedef struct arm_relu6_operator : arm_unary_operator {
 DECLARE_ARM_UNARY_ACC(Relu6, ARM_RELU6_OP);
 
 REGISTER_ARM_ACC(Relu6, LAYER_RELU6);
+REGISTER_ARM_LAYOUT(LAYER_RELU6, DATA_FORMAT_NHWC);
 }  // namespace TNN_NS
@@ -16,16 +16,28 @@
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
-DECLARE_ARM_ACC(Relu, LAYER_RELU);
+class ArmReluLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmReluLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual bool IsInplaceSupported() {
+        return true;
+    }
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+};
 
 Status ArmReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto input  = inputs[0];
     auto output = outputs[0];
 
-    auto dims = output->GetBlobDesc().dims;
+    const auto &dims = output->GetBlobDesc().dims;
 
     int count = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
 
@@ -33,6 +45,19 @@ Status ArmReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     if (data_type == DATA_TYPE_INT8) {
         ReluInt8(reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle())),
                  reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle())), count);
+    } else if (data_type == DATA_TYPE_FLOAT && output->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        // nhwc blobs are not padded, handle the tail without writing past the blob
+        auto dst  = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
+        auto src  = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
+        count     = DimsVectorUtils::Count(dims);
+        int count_r4 = count >> 2 << 2;
+        Float4 vzero(0);
+        for (int i = 0; i < count_r4; i += 4) {
+            Float4::save(dst + i, Float4::max(Float4::load(src + i), vzero));
+        }
+        for (int i = count_r4; i < count; i++) {
+            dst[i] = std::max(src[i], 0.f);
+        }
     } else if (data_type == DATA_TYPE_FLOAT) {
         auto dst = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
         auto src = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
@@ -55,5 +80,6 @@ Status ArmReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
 }
 
 REGISTER_ARM_ACC(Relu, LAYER_RELU)
+REGISTER_ARM_LAYOUT(LAYER_RELU, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
@@ -25,11 +25,11 @@ DECLARE_ARM_NCHW_ACC(Reorg, LAYER_REORG);
 Status ArmReorgLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<ReorgLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
-    DataType data_type = inputs[0]->GetBlobDesc().data_type;
-    auto input_dims    = inputs[0]->GetBlobDesc().dims;
-    auto output_dims   = outputs[0]->GetBlobDesc().dims;
-    auto in_count      = input_dims[3] * input_dims[2] * input_dims[1];
-    auto out_count     = output_dims[3] * output_dims[2] * output_dims[1];
+    DataType data_type      = inputs[0]->GetBlobDesc().data_type;
+    const auto &input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto &output_dims = outputs[0]->GetBlobDesc().dims;
+    auto in_count           = input_dims[3] * input_dims[2] * input_dims[1];
+    auto out_count          = output_dims[3] * output_dims[2] * output_dims[1];
 
     AllocConvertBuffer(inputs, outputs);
 
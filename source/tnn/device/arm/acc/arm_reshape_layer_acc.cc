@@ -33,6 +33,25 @@ Status ArmReshapeLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
     auto output = outputs[0];
 
     int data_byte_size = DataTypeUtils::GetBytesSize(output->GetBlobDesc().data_type);
+
+    // nc4hw4 data is unchanged by a reshape keeping the batch, the channels and the plane size,
+    // nothing to do when the output is computed in place
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    if (input->GetBlobDesc().data_format == DATA_FORMAT_NC4HW4 &&
+        output->GetBlobDesc().data_format == DATA_FORMAT_NC4HW4 && dims_input.size() >= 2 &&
+        dims_output.size() >= 2 && dims_input[0] == dims_output[0] && dims_input[1] == dims_output[1] &&
+        DimsVectorUtils::Count(dims_input, 2) == DimsVectorUtils::Count(dims_output, 2)) {
+        char *input_data  = GetBlobHandlePtr(input->GetHandle());
+        char *output_data = GetBlobHandlePtr(output->GetHandle());
+        if (input_data != output_data) {
+            int bytes_size = dims_input[0] * ROUND_UP(dims_input[1], 4) * DimsVectorUtils::Count(dims_input, 2) *
+                             data_byte_size;
+            memcpy(output_data, input_data, bytes_size);
+        }
+        return TNN_OK;
+    }
+
     auto size_in_bytes = DimsVectorUtils::Count(input->GetBlobDesc().dims) * data_byte_size;
     workspace_         = context_->GetSharedWorkSpace(size_in_bytes);
 
@@ -54,8 +73,8 @@ Status ArmReshapeLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
 
 template <typename T>
 Status ArmReshapeLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    auto dims_input   = inputs[0]->GetBlobDesc().dims;
-    auto dims_output  = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     char *input_origin  = GetBlobHandlePtr(inputs[0]->GetHandle());
     char *output_origin = GetBlobHandlePtr(outputs[0]->GetHandle());
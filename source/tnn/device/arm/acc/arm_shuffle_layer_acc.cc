@@ -65,7 +65,7 @@ Status ArmShuffleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const st
 
     auto input         = inputs[0];
     auto output        = outputs[0];
-    auto dims          = input->GetBlobDesc().dims;
+    const auto &dims   = input->GetBlobDesc().dims;
     DataType data_type = output->GetBlobDesc().data_type;
     const int area     = DimsVectorUtils::Count(dims, 2);
 
@@ -25,5 +25,6 @@ typedef struct arm_sigmoid_operator : arm_unary_operator {
 DECLARE_ARM_UNARY_ACC(Sigmoid, ARM_SIGMOID_OP);
 
 REGISTER_ARM_ACC(Sigmoid, LAYER_SIGMOID)
+REGISTER_ARM_LAYOUT(LAYER_SIGMOID, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
@@ -47,11 +47,11 @@ Status ArmSoftmaxLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::ve
 
     int data_byte_size = sizeof(float);
 
-    auto dims    = output->GetBlobDesc().dims;
-    auto width   = dims[3];
-    auto height  = dims[2];
-    auto batch   = dims[0];
-    size_t count = width * height * batch * dims[1];
+    const auto &dims = output->GetBlobDesc().dims;
+    auto width       = dims[3];
+    auto height      = dims[2];
+    auto batch       = dims[0];
+    size_t count     = width * height * batch * dims[1];
 
     int inside  = 1;
     int outside = 1;
@@ -14,22 +14,34 @@
 
 #include "tnn/device/arm/acc/arm_layer_acc.h"
 #include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_util.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
-DECLARE_ARM_ACC(SplitV, LAYER_SPLITV);
+class ArmSplitVLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmSplitVLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual bool IsBlobViewSupported() {
+        return true;
+    }
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+};
 
 // batch || height || width, no channel
 static int splitv_common(Blob *input, const std::vector<Blob *> &outputs, SplitVLayerParam *param) {
-    const int axis        = param->axis;
-    auto input_dims       = input->GetBlobDesc().dims;
-    auto round_input_dims = {input_dims[0], UP_DIV(input_dims[1], 4), input_dims[2], input_dims[3], 4};  // 5 dims
-    const int batch       = DimsVectorUtils::Count(round_input_dims, 0, axis);
-    const int slice_size  = DimsVectorUtils::Count(round_input_dims, axis + 1);
-    const int slice_input = input_dims[axis];
-    auto input_data       = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
+    const int axis         = param->axis;
+    const auto &input_dims = input->GetBlobDesc().dims;
+    auto round_input_dims  = {input_dims[0], UP_DIV(input_dims[1], 4), input_dims[2], input_dims[3], 4};  // 5 dims
+    const int batch        = DimsVectorUtils::Count(round_input_dims, 0, axis);
+    const int slice_size   = DimsVectorUtils::Count(round_input_dims, axis + 1);
+    const int slice_input  = input_dims[axis];
+    auto input_data        = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
 
     for (int b = 0; b < batch; b++) {
         int slice_input_offset = 0;
@@ -50,14 +62,14 @@ static int splitv_common(Blob *input, const std::vector<Blob *> &outputs, SplitV
 
 static int splitv_channel(Blob *input, const std::vector<Blob *> &outputs, SplitVLayerParam *param) {
     const int axis              = param->axis;
-    auto input_dims             = input->GetBlobDesc().dims;
+    const auto &input_dims      = input->GetBlobDesc().dims;
     auto input_data             = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
     DimsVector round_input_dims = {input_dims[0], UP_DIV(input_dims[1], 4), input_dims[2], input_dims[3], 4};
 
     int slice_offset = 0;
     for (int i = 0; i < outputs.size(); i++) {
         auto output                  = outputs[i];
-        auto output_dims             = output->GetBlobDesc().dims;
+        const auto &output_dims      = output->GetBlobDesc().dims;
         DimsVector round_output_dims = {output_dims[0], UP_DIV(output_dims[1], 4), output_dims[2], output_dims[3], 4};
         auto output_data             = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
         const int slice              = output_dims[axis];
@@ -98,11 +110,11 @@ static int splitv_channel(Blob *input, const std::vector<Blob *> &outputs, Split
 }
 
 static int splitv_channel_c4(Blob *input, const std::vector<Blob *> &outputs, SplitVLayerParam *param) {
-    const int axis        = param->axis;
-    auto input_dims       = input->GetBlobDesc().dims;
-    auto round_input_dims = {input_dims[0], UP_DIV(input_dims[1], 4), input_dims[2], input_dims[3], 4};  // 5 dims
-    const int batch       = DimsVectorUtils::Count(round_input_dims, 0, axis);
-    const int slice_size  = DimsVectorUtils::Count(round_input_dims, axis + 1);
+    const int axis         = param->axis;
+    const auto &input_dims = input->GetBlobDesc().dims;
+    auto round_input_dims  = {input_dims[0], UP_DIV(input_dims[1], 4), input_dims[2], input_dims[3], 4};  // 5 dims
+    const int batch        = DimsVectorUtils::Count(round_input_dims, 0, axis);
+    const int slice_size   = DimsVectorUtils::Count(round_input_dims, axis + 1);
     // different from split common, treat 4 element in channel as one
     const int slice_input = UP_DIV(input_dims[axis], 4);
     auto input_data       = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
@@ -133,11 +145,24 @@ Status ArmSplitVLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
 
     const int axis    = layer_param->axis;
     auto input_blob   = inputs[0];
+
+    // the outputs are placed in the input by the blob manager
+    if (axis == 1) {
+        bool in_place      = true;
+        int channel_offset = 0;
+        for (auto output : outputs) {
+            in_place = in_place && IsBlobChannelView(output, input_blob, channel_offset);
+            channel_offset += output->GetBlobDesc().dims[1];
+        }
+        if (in_place) {
+            return TNN_OK;
+        }
+    }
     bool is_chanel_c4 = false;
     if (axis == 1) {
         is_chanel_c4 = true;
         for (int i = 0; i < outputs.size() - 1; i++) {
-            auto output_dims = outputs[i]->GetBlobDesc().dims;
+            const auto &output_dims = outputs[i]->GetBlobDesc().dims;
             if (output_dims[1] % 4) {
                 is_chanel_c4 = false;
                 break;
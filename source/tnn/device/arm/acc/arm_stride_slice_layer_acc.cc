@@ -15,11 +15,23 @@
 #include <algorithm>
 #include <cmath>
 #include "tnn/device/arm/acc/arm_layer_acc.h"
+#include "tnn/device/arm/arm_util.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
-DECLARE_ARM_ACC(StrideSlice, LAYER_STRIDED_SLICE);
+class ArmStrideSliceLayerAcc : public ArmLayerAcc {
+public:
+    virtual ~ArmStrideSliceLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual bool IsBlobViewSupported() {
+        return true;
+    }
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+};
 
 Status ArmStrideSliceLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto layer_param = dynamic_cast<StrideSliceLayerParam *>(param_);
@@ -28,15 +40,15 @@ Status ArmStrideSliceLayerAcc::DoForward(const std::vector<Blob *> &inputs, cons
         return Status(TNNERR_MODEL_ERR, "Error: StrideSliceLayerParam is nil");
     }
 
-    Blob *input_blob  = inputs[0];
-    Blob *output_blob = outputs[0];
-    auto dims_input   = input_blob->GetBlobDesc().dims;
-    auto dims_output  = output_blob->GetBlobDesc().dims;
-    int input_channel = dims_input[1];
-    int input_height  = dims_input[2];
-    int input_width   = dims_input[3];
-    int output_height = dims_output[2];
-    int output_width  = dims_output[3];
+    Blob *input_blob        = inputs[0];
+    Blob *output_blob       = outputs[0];
+    const auto &dims_input  = input_blob->GetBlobDesc().dims;
+    const auto &dims_output = output_blob->GetBlobDesc().dims;
+    int input_channel       = dims_input[1];
+    int input_height        = dims_input[2];
+    int input_width         = dims_input[3];
+    int output_height       = dims_output[2];
+    int output_width        = dims_output[3];
 
     int input_slice  = UP_DIV(dims_input[1], 4);
     int output_slice = UP_DIV(dims_output[1], 4);
@@ -48,11 +60,24 @@ Status ArmStrideSliceLayerAcc::DoForward(const std::vector<Blob *> &inputs, cons
     std::reverse(ends.begin(), ends.end());
     std::reverse(strides.begin(), strides.end());
 
+    // negative begins and ends count from the end of the dims
     for (int i = 0; i < ends.size(); ++i) {
+        if (begins[i] < 0) {
+            begins[i] += dims_input[i];
+        }
         if (ends[i] == 0) {
-            ends[i] = input_blob->GetBlobDesc().dims[i];
+            ends[i] = dims_input[i];
+        } else if (ends[i] < 0) {
+            ends[i] += dims_input[i];
         }
     }
+
+    // the output is placed in the input by the blob manager
+    if (std::all_of(strides.begin(), strides.end(), [](int s) { return s == 1; }) &&
+        IsBlobChannelView(output_blob, input_blob, begins[1])) {
+        return TNN_OK;
+    }
+
     int nn = 0, nc = 0, nh = 0, nw = 0;
 
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
@@ -15,6 +15,7 @@
 #include "tnn/device/arm/acc/arm_unary_layer_acc.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
@@ -49,7 +50,7 @@ Status ArmUnaryLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vect
     auto input  = inputs[0];
     auto output = outputs[0];
 
-    auto dims = output->GetBlobDesc().dims;
+    const auto &dims = output->GetBlobDesc().dims;
 
     int count      = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
     int count_quad = UP_DIV(count, 4);
@@ -57,6 +58,23 @@ Status ArmUnaryLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vect
     auto input_ptr  = reinterpret_cast<T *>(GetBlobHandlePtr(input->GetHandle()));
     auto output_ptr = reinterpret_cast<T *>(GetBlobHandlePtr(output->GetHandle()));
 
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        // nhwc blobs are not padded, handle the tail without writing past the blob
+        count      = DimsVectorUtils::Count(dims);
+        count_quad = count / 4;
+        int remain = count % 4;
+        if (remain) {
+            T buffer[4] = {T(0.f), T(0.f), T(0.f), T(0.f)};
+            for (int i = 0; i < remain; i++) {
+                buffer[i] = input_ptr[count_quad * 4 + i];
+            }
+            Float4::save(buffer, (*op_)(Float4::load(buffer)));
+            for (int i = 0; i < remain; i++) {
+                output_ptr[count_quad * 4 + i] = buffer[i];
+            }
+        }
+    }
+
     OMP_PARALLEL_FOR_
     for (int n = 0; n < count_quad; n++) {
         Float4::save(output_ptr + n * 4, (*op_)(Float4::load(input_ptr + n * 4)));
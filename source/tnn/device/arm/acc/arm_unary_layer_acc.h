@@ -44,6 +44,10 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+    virtual bool IsInplaceSupported() override {
+        return true;
+    }
+
 protected:
     virtual bool DataTypeSupported(DataType data_type) override;
 
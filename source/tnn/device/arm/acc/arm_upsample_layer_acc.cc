@@ -112,18 +112,126 @@ static inline int upsample_bilinear2d(float *output_data, const float *input_dat
     return 0;
 }
 
+static inline int upsample_nearest2d_nhwc(float *output_data, const float *input_data, int ih, int iw, int oh, int ow,
+                                          int c) {
+    const float height_scale = (float)ih / (float)oh;
+    const float width_scale  = (float)iw / (float)ow;
+
+    OMP_PARALLEL_FOR_
+    for (int h = 0; h < oh; h++) {
+        int scale_h = h * height_scale;
+        auto dst_y  = output_data + h * ow * c;
+        auto src_y  = input_data + scale_h * iw * c;
+        for (int w = 0; w < ow; w++) {
+            int scale_w = w * width_scale;
+            memcpy(dst_y + w * c, src_y + scale_w * c, c * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+static inline int upsample_bilinear2d_nhwc(float *output_data, const float *input_data, int ih, int iw, int oh, int ow,
+                                           int c, bool align_corners) {
+    auto src_y_step = iw * c;
+
+    RawBuffer h_coeffs(oh * sizeof(float));
+    RawBuffer w_coeffs(ow * sizeof(float));
+    auto h_coeffs_ptr = h_coeffs.force_to<float *>();
+    auto w_coeffs_ptr = w_coeffs.force_to<float *>();
+
+    if (align_corners) {
+        const float rheight = (oh > 1) ? (float)(ih - 1) / (oh - 1) : 0.f;
+        const float rwidth  = (ow > 1) ? (float)(iw - 1) / (ow - 1) : 0.f;
+        for (int h = 0; h < oh; ++h) {
+            h_coeffs_ptr[h] = h * rheight;
+        }
+        for (int w = 0; w < ow; ++w) {
+            w_coeffs_ptr[w] = w * rwidth;
+        }
+    } else {
+        const float rheight = (oh > 1) ? (float)(ih) / (oh) : 0.f;
+        const float rwidth  = (ow > 1) ? (float)(iw) / (ow) : 0.f;
+        for (int h = 0; h < oh; ++h) {
+            h_coeffs_ptr[h] = rheight * (h + 0.5) - 0.5;
+            h_coeffs_ptr[h] = h_coeffs_ptr[h] >= 0 ? h_coeffs_ptr[h] : 0;
+        }
+        for (int w = 0; w < ow; ++w) {
+            w_coeffs_ptr[w] = rwidth * (w + 0.5) - 0.5;
+            w_coeffs_ptr[w] = w_coeffs_ptr[w] >= 0 ? w_coeffs_ptr[w] : 0;
+        }
+    }
+
+    OMP_PARALLEL_FOR_
+    for (int h2 = 0; h2 < oh; ++h2) {
+        const float h1r      = h_coeffs_ptr[h2];
+        const int h1         = h1r;
+        const int h1p        = (h1 < ih - 1) ? 1 : 0;
+        const float h1lambda = h1r - h1;
+        const float h0lambda = (float)1. - h1lambda;
+        for (int w2 = 0; w2 < ow; ++w2) {
+            const float w1r      = w_coeffs_ptr[w2];
+            const int w1         = w1r;
+            const int w1p        = (w1 < iw - 1) ? 1 : 0;
+            const float w1lambda = w1r - w1;
+            const float w0lambda = (float)1. - w1lambda;
+            const float *Xdata   = &(input_data[h1 * src_y_step + w1 * c]);
+            float *Ydata         = &(output_data[h2 * ow * c + w2 * c]);
+            for (int z = 0; z < c; z++) {
+                Ydata[z] = (Xdata[z] * w0lambda + Xdata[w1p * c + z] * w1lambda) * h0lambda +
+                           (Xdata[h1p * src_y_step + z] * w0lambda + Xdata[h1p * src_y_step + w1p * c + z] * w1lambda) *
+                               h1lambda;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static Status upsample_nhwc(UpsampleLayerParam *param, float *output_data, const float *input_data,
+                            DimsVector dims_input, DimsVector dims_output) {
+    int c               = dims_output[1];
+    int input_plane     = c * dims_input[2] * dims_input[3];
+    int output_plane    = c * dims_output[2] * dims_output[3];
+
+    for (int n = 0; n < dims_output[0]; n++) {
+        auto input_batch  = input_data + n * input_plane;
+        auto output_batch = output_data + n * output_plane;
+        if (dims_input[2] == dims_output[2] && dims_input[3] == dims_output[3]) {
+            if (output_batch != input_batch) {
+                memcpy(output_batch, input_batch, input_plane * sizeof(float));
+            }
+        } else if (param->mode == 1) {  // nearest
+            upsample_nearest2d_nhwc(output_batch, input_batch, dims_input[2], dims_input[3], dims_output[2],
+                                    dims_output[3], c);
+        } else if (param->mode == 2) {  // bilinear/linear
+            upsample_bilinear2d_nhwc(output_batch, input_batch, dims_input[2], dims_input[3], dims_output[2],
+                                     dims_output[3], c, (bool)param->align_corners);
+        } else {
+            LOGE("Error: Upsample dont support resize mode\n");
+            return Status(TNNERR_MODEL_ERR, "Error: Upsample dont support resize mode");
+        }
+    }
+
+    return TNN_OK;
+}
+
 // ArmUpsampleLayerAcc now only support nearest bilinear interpolation
 
 Status ArmUpsampleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<UpsampleLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
 
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     float *input_data  = reinterpret_cast<float *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
     float *output_data = reinterpret_cast<float *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
 
+    if (outputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+        return upsample_nhwc(param, output_data, input_data, dims_input, dims_output);
+    }
+
     auto oc_4 = UP_DIV(dims_output[1], 4);
 
     if (dims_input[2] == dims_output[2] && dims_input[3] == dims_output[3]) {
@@ -145,5 +253,6 @@ Status ArmUpsampleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
 }
 
 REGISTER_ARM_ACC(Upsample, LAYER_UPSAMPLE)
+REGISTER_ARM_LAYOUT(LAYER_UPSAMPLE, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
@@ -572,6 +572,89 @@ template void AvgPooling(const float* src, long iw, long ih, float* dst, long ow
 template void AvgPooling(const bfp16_t* src, long iw, long ih, bfp16_t* dst, long ow, long oh, long kw, long kh,
                          long stride_w, long stride_h, long pad_w, long pad_h);
 
+/*
+max pooling func on nhwc layout, channel is not padded to 4
+*/
+void MaxPoolingNHWC(const float* src, long iw, long ih, float* dst, long ow, long oh, long c, long kw, long kh,
+                    long stride_w, long stride_h, long pad_w, long pad_h) {
+    const long c_r4 = c >> 2 << 2;
+    for (long oy = 0; oy < oh; ++oy) {
+        for (long ox = 0; ox < ow; ++ox) {
+            const long srcOriginX = ox * stride_w - pad_w;
+            const long srcOriginY = oy * stride_h - pad_h;
+            const long kxs        = MAX(0, -srcOriginX);
+            const long kxe        = MIN(kw, iw - srcOriginX);
+            const long kys        = MAX(0, -srcOriginY);
+            const long kye        = MIN(kh, ih - srcOriginY);
+            const auto src_ptr    = src + (srcOriginY * iw + srcOriginX) * c;
+            auto dst_ptr          = dst + (oy * ow + ox) * c;
+
+            for (long z = 0; z < c_r4; z += 4) {
+                Float4 vmax(-FLT_MAX);
+                for (long ky = kys; ky < kye; ++ky) {
+                    const auto src_ptr_h = src_ptr + ky * iw * c + z;
+                    for (long kx = kxs; kx < kxe; kx++) {
+                        vmax = Float4::max(vmax, Float4::load(src_ptr_h + kx * c));
+                    }
+                }
+                Float4::save(dst_ptr + z, vmax);
+            }
+            for (long z = c_r4; z < c; z++) {
+                float vmax = -FLT_MAX;
+                for (long ky = kys; ky < kye; ++ky) {
+                    const auto src_ptr_h = src_ptr + ky * iw * c + z;
+                    for (long kx = kxs; kx < kxe; kx++) {
+                        vmax = std::max(vmax, src_ptr_h[kx * c]);
+                    }
+                }
+                dst_ptr[z] = vmax;
+            }
+        }
+    }
+}
+
+/*
+avg pooling func on nhwc layout, channel is not padded to 4
+*/
+void AvgPoolingNHWC(const float* src, long iw, long ih, float* dst, long ow, long oh, long c, long kw, long kh,
+                    long stride_w, long stride_h, long pad_w, long pad_h) {
+    const long c_r4 = c >> 2 << 2;
+    for (long oy = 0; oy < oh; ++oy) {
+        for (long ox = 0; ox < ow; ++ox) {
+            const long srcOriginX    = ox * stride_w - pad_w;
+            const long srcOriginY    = oy * stride_h - pad_h;
+            const long kxs           = MAX(0, -srcOriginX);
+            const long kxe           = MIN(kw, iw - srcOriginX);
+            const long kys           = MAX(0, -srcOriginY);
+            const long kye           = MIN(kh, ih - srcOriginY);
+            const float kernel_count = 1.0 / ((kxe - kxs) * (kye - kys));
+            const auto src_ptr       = src + (srcOriginY * iw + srcOriginX) * c;
+            auto dst_ptr             = dst + (oy * ow + ox) * c;
+
+            for (long z = 0; z < c_r4; z += 4) {
+                Float4 vavg(0.f);
+                for (long ky = kys; ky < kye; ++ky) {
+                    const auto src_ptr_h = src_ptr + ky * iw * c + z;
+                    for (long kx = kxs; kx < kxe; kx++) {
+                        vavg = vavg + Float4::load(src_ptr_h + kx * c);
+                    }
+                }
+                Float4::save(dst_ptr + z, vavg * Float4(kernel_count));
+            }
+            for (long z = c_r4; z < c; z++) {
+                float vavg = 0.f;
+                for (long ky = kys; ky < kye; ++ky) {
+                    const auto src_ptr_h = src_ptr + ky * iw * c + z;
+                    for (long kx = kxs; kx < kxe; kx++) {
+                        vavg += src_ptr_h[kx * c];
+                    }
+                }
+                dst_ptr[z] = vavg * kernel_count;
+            }
+        }
+    }
+}
+
 /*
 convdw unit, used in four cornels calc
 */
@@ -0,0 +1,143 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/compute/sparse_function.h"
+
+#include <algorithm>
+
+#include "tnn/device/arm/acc/Float4.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// pixels of one tile, the src tile is reused by all the output c4
+#define SPARSE_CONV_TILE_PLANE 64
+
+static bool IsZeroBlock(const float *weight, int oc, int ic, int oz, int i) {
+    for (int o = oz * 4; o < std::min(oz * 4 + 4, oc); o++) {
+        if (weight[o * ic + i] != 0.f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float GetBlockSparsityO4(const float *weight, int oc, int ic) {
+    const int oc4 = UP_DIV(oc, 4);
+    if (oc4 * ic == 0) {
+        return 0.f;
+    }
+    long zero_blocks = 0;
+    for (int oz = 0; oz < oc4; oz++) {
+        for (int i = 0; i < ic; i++) {
+            zero_blocks += IsZeroBlock(weight, oc, ic, oz, i);
+        }
+    }
+    return (float)zero_blocks / (oc4 * ic);
+}
+
+void PackSparseWeightO4(const float *weight, int oc, int ic, SparseWeightO4 &sparse_weight) {
+    const int oc4 = UP_DIV(oc, 4);
+    int blocks    = 0;
+    for (int oz = 0; oz < oc4; oz++) {
+        for (int i = 0; i < ic; i++) {
+            blocks += !IsZeroBlock(weight, oc, ic, oz, i);
+        }
+    }
+
+    sparse_weight.values      = RawBuffer(std::max(blocks, 1) * 4 * sizeof(float));
+    sparse_weight.row_offsets = RawBuffer((oc4 + 1) * sizeof(int));
+    sparse_weight.col_index   = RawBuffer(std::max(blocks, 1) * sizeof(int));
+    auto values               = sparse_weight.values.force_to<float *>();
+    auto row_offsets          = sparse_weight.row_offsets.force_to<int *>();
+    auto col_index            = sparse_weight.col_index.force_to<int *>();
+
+    int k = 0;
+    for (int oz = 0; oz < oc4; oz++) {
+        row_offsets[oz] = k;
+        for (int i = 0; i < ic; i++) {
+            if (IsZeroBlock(weight, oc, ic, oz, i)) {
+                continue;
+            }
+            for (int r = 0; r < 4; r++) {
+                int o             = oz * 4 + r;
+                values[k * 4 + r] = o < oc ? weight[o * ic + i] : 0.f;
+            }
+            col_index[k++] = i;
+        }
+    }
+    row_offsets[oc4] = k;
+}
+
+void SparseGemvO4(float *dst, const float *src, SparseWeightO4 &sparse_weight, long oc4) {
+    auto values      = sparse_weight.values.force_to<float *>();
+    auto row_offsets = sparse_weight.row_offsets.force_to<int *>();
+    auto col_index   = sparse_weight.col_index.force_to<int *>();
+
+    OMP_PARALLEL_FOR_
+    for (long oz = 0; oz < oc4; oz++) {
+        Float4 acc(0.f);
+        for (int k = row_offsets[oz]; k < row_offsets[oz + 1]; k++) {
+            Float4::mla(acc, Float4::load(values + k * 4), Float4(src[col_index[k]]));
+        }
+        Float4::save(dst + oz * 4, acc);
+    }
+}
+
+void SparseConv1x1O4(float *dst, const float *src, SparseWeightO4 &sparse_weight, long oc4, long plane) {
+    auto values       = sparse_weight.values.force_to<float *>();
+    auto row_offsets  = sparse_weight.row_offsets.force_to<int *>();
+    auto col_index    = sparse_weight.col_index.force_to<int *>();
+    const long z_step = plane * 4;
+    const long tiles  = UP_DIV(plane, SPARSE_CONV_TILE_PLANE);
+
+    OMP_PARALLEL_FOR_
+    for (long t = 0; t < tiles * oc4; t++) {
+        long oz      = t % oc4;
+        long p_begin = t / oc4 * SPARSE_CONV_TILE_PLANE;
+        long p_end   = std::min(p_begin + SPARSE_CONV_TILE_PLANE, plane);
+        auto dst_z   = dst + oz * z_step;
+        int k_begin  = row_offsets[oz];
+        int k_end    = row_offsets[oz + 1];
+
+        long p = p_begin;
+        for (; p + 3 < p_end; p += 4) {
+            Float4 acc0(0.f), acc1(0.f), acc2(0.f), acc3(0.f);
+            for (int k = k_begin; k < k_end; k++) {
+                Float4 w   = Float4::load(values + k * 4);
+                int c      = col_index[k];
+                auto src_p = src + (c >> 2) * z_step + p * 4 + (c & 3);
+                Float4::mla(acc0, w, Float4(src_p[0]));
+                Float4::mla(acc1, w, Float4(src_p[4]));
+                Float4::mla(acc2, w, Float4(src_p[8]));
+                Float4::mla(acc3, w, Float4(src_p[12]));
+            }
+            Float4::save(dst_z + p * 4 + 0, acc0);
+            Float4::save(dst_z + p * 4 + 4, acc1);
+            Float4::save(dst_z + p * 4 + 8, acc2);
+            Float4::save(dst_z + p * 4 + 12, acc3);
+        }
+        for (; p < p_end; p++) {
+            Float4 acc(0.f);
+            for (int k = k_begin; k < k_end; k++) {
+                int c = col_index[k];
+                Float4::mla(acc, Float4::load(values + k * 4), Float4(src[(c >> 2) * z_step + p * 4 + (c & 3)]));
+            }
+            Float4::save(dst_z + p * 4, acc);
+        }
+    }
+}
+
+}  // namespace TNN_NS
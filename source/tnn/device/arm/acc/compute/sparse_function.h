@@ -0,0 +1,52 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_ARM_SPARSE_FUNCTION_H_
+#define TNN_ARM_SPARSE_FUNCTION_H_
+
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// weights are packed block sparse if at least this ratio of their 4x1 blocks is zero
+#define SPARSE_WEIGHT_THRESHOLD 0.7f
+
+/*
+block sparse weights, a block is 4 output channels x 1 input channel, the 4 outputs of a block are one c4 plane of
+the NC4HW4 output. blocks of output c4 z are values[row_offsets[z] * 4, row_offsets[z + 1] * 4), col_index holds the
+input channel of each block.
+*/
+struct SparseWeightO4 {
+    RawBuffer values;
+    RawBuffer row_offsets;
+    RawBuffer col_index;
+};
+
+// ratio of the zero 4x1 blocks of weight [oc][ic]
+float GetBlockSparsityO4(const float *weight, int oc, int ic);
+
+// pack weight [oc][ic] to block sparse
+void PackSparseWeightO4(const float *weight, int oc, int ic, SparseWeightO4 &sparse_weight);
+
+// dst[oc4][4] = weight x src[ic], no bias
+void SparseGemvO4(float *dst, const float *src, SparseWeightO4 &sparse_weight, long oc4);
+
+// 1x1 conv with stride 1 and no pads, src and dst are NC4HW4 of plane pixels, no bias
+void SparseConv1x1O4(float *dst, const float *src, SparseWeightO4 &sparse_weight, long oc4, long plane);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_ARM_SPARSE_FUNCTION_H_
@@ -0,0 +1,123 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/convolution/arm_conv3d_layer_acc.h"
+
+#include <memory>
+
+#include "tnn/device/arm/acc/convolution/arm_conv3d_layer_common.h"
+#include "tnn/device/arm/acc/convolution/arm_conv3d_layer_depthwise.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+static std::shared_ptr<LayerResource> CreateFp32Conv3DResource(ConvLayerResource *conv_f16) {
+    ConvLayerResource *conv_f32 = new ConvLayerResource();
+
+    conv_f32->filter_handle = ConvertHalfHandle(conv_f16->filter_handle);
+    conv_f32->scale_handle  = ConvertHalfHandle(conv_f16->scale_handle);
+    conv_f32->bias_handle   = ConvertHalfHandle(conv_f16->bias_handle);
+
+    return std::shared_ptr<LayerResource>(conv_f32);
+}
+
+Status ArmConv3DLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                               const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    Status ret;
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (conv_res->filter_handle.GetDataType() == DATA_TYPE_HALF) {
+        conv_acc_f32_resource_ = CreateFp32Conv3DResource(conv_res);
+        ret                    = ArmLayerAcc::Init(context, param, conv_acc_f32_resource_.get(), inputs, outputs);
+    } else {
+        ret = ArmLayerAcc::Init(context, param, resource, inputs, outputs);
+    }
+    if (ret != TNN_OK)
+        return ret;
+
+    if (ArmConv3DLayerDepthwise::isPrefered(conv_param, inputs, outputs)) {
+        conv_acc_impl_ = std::make_shared<ArmConv3DLayerDepthwise>();
+    } else {
+        conv_acc_impl_ = std::make_shared<ArmConv3DLayerCommon>();
+    }
+
+    if (!packed_weights_.buffers.empty()) {
+        // the impl packs the weights at init instead
+        Status status = conv_acc_impl_->SetPackedWeights(packed_weights_);
+        if (status != TNN_OK && !packed_weights_.repackable) {
+            return status;
+        } else if (status != TNN_OK) {
+            LOGD("the conv3d impl does not take the packed weights in %s\n", packed_weights_.layout.c_str());
+        }
+        packed_weights_ = PackedWeights();
+    }
+    RETURN_ON_NEQ(conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs), TNN_OK);
+
+    // fp32 copy of half weights is useless once the impl has packed them
+    if (conv_acc_impl_->IsResourceReleasable()) {
+        conv_acc_f32_resource_ = nullptr;
+    }
+    return TNN_OK;
+}
+
+ArmConv3DLayerAcc::~ArmConv3DLayerAcc() {}
+
+std::vector<DataFormat> ArmConv3DLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    // NC4HW4 of 5 dims packs the channels in front of the depth, height and width
+    if (dims_size == 5 && (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16)) {
+        support_list.push_back(DATA_FORMAT_NC4HW4);
+    }
+    return support_list;
+}
+
+Status ArmConv3DLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return conv_acc_impl_->Reshape(inputs, outputs);
+}
+
+Status ArmConv3DLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (conv_acc_impl_) {
+        return conv_acc_impl_->DoForward(inputs, outputs);
+    } else {
+        return Status(TNNERR_CONTEXT_ERR, "conv3d_acc_impl_ is nil");
+    }
+}
+
+bool ArmConv3DLayerAcc::IsResourceReleasable() {
+    return conv_acc_impl_ && conv_acc_impl_->IsResourceReleasable();
+}
+
+void ArmConv3DLayerAcc::ReleaseResource() {
+    ArmLayerAcc::ReleaseResource();
+    if (conv_acc_impl_) {
+        conv_acc_impl_->ReleaseResource();
+    }
+}
+
+PackedWeights ArmConv3DLayerAcc::GetPackedWeights() {
+    return conv_acc_impl_ ? conv_acc_impl_->GetPackedWeights() : PackedWeights();
+}
+
+Status ArmConv3DLayerAcc::SetPackedWeights(const PackedWeights &packed_weights) {
+    packed_weights_ = packed_weights;
+    return TNN_OK;
+}
+
+REGISTER_ARM_ACC(Conv3D, LAYER_CONVOLUTION_3D)
+
+}  // namespace TNN_NS
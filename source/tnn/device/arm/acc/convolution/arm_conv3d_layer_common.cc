@@ -0,0 +1,325 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/convolution/arm_conv3d_layer_common.h"
+
+#include "tnn/device/arm/acc/compute/gemm_function.h"
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_context.h"
+#include "tnn/device/arm/arm_util.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+/*
+gather the input of the output positions [p_begin, p_begin + width) to [ic/4][kd][kh][kw][width][4]
+*/
+template <typename T>
+static void Vol2Col(T *dst, const T *src, ConvLayerParam *param, const DimsVector &dims_input,
+                    const DimsVector &dims_output, int ic4, int p_begin, int width) {
+    const int id = dims_input[2], ih = dims_input[3], iw = dims_input[4];
+    const int oh = dims_output[3], ow = dims_output[4];
+    const int kd = param->kernels[2], kh = param->kernels[1], kw = param->kernels[0];
+    const int kvol = kd * kh * kw;
+
+    OMP_PARALLEL_FOR_
+    for (int q = 0; q < ic4 * kvol; q++) {
+        const int zi = q / kvol, k = q % kvol;
+        const int kx = k % kw, ky = (k / kw) % kh, kz = k / (kw * kh);
+        const int off_d = kz * param->dialations[2] - param->pads[4];
+        const int off_h = ky * param->dialations[1] - param->pads[2];
+        const int off_w = kx * param->dialations[0] - param->pads[0];
+        const T *src_z  = src + zi * id * ih * iw * 4;
+        T *dst_q        = dst + q * width * 4;
+
+        int ox = p_begin % ow, oy = (p_begin / ow) % oh, oz = p_begin / (ow * oh);
+        for (int i = 0; i < width; i++) {
+            const int sz = oz * param->strides[2] + off_d;
+            const int sy = oy * param->strides[1] + off_h;
+            const int sx = ox * param->strides[0] + off_w;
+            if (sz >= 0 && sz < id && sy >= 0 && sy < ih && sx >= 0 && sx < iw) {
+                memcpy(dst_q + i * 4, src_z + ((sz * ih + sy) * iw + sx) * 4, 4 * sizeof(T));
+            } else {
+                memset(dst_q + i * 4, 0, 4 * sizeof(T));
+            }
+            if (++ox == ow) {
+                ox = 0;
+                if (++oy == oh) {
+                    oy = 0;
+                    oz++;
+                }
+            }
+        }
+    }
+}
+
+/*
+copy count channels between two channel packed buffers, used to align the groups to 4 channels
+*/
+template <typename T>
+static void CopyChannels(T *dst, int dst_c, const T *src, int src_c, int count, int plane) {
+    for (int c = 0; c < count; c++) {
+        T *dst_c_ptr       = dst + ((dst_c + c) / 4) * plane * 4 + (dst_c + c) % 4;
+        const T *src_c_ptr = src + ((src_c + c) / 4) * plane * 4 + (src_c + c) % 4;
+        for (int p = 0; p < plane; p++) {
+            dst_c_ptr[p * 4] = src_c_ptr[p * 4];
+        }
+    }
+}
+
+ArmConv3DLayerCommon::~ArmConv3DLayerCommon() {}
+
+bool ArmConv3DLayerCommon::IsResourceReleasable() {
+    return true;
+}
+
+PackedWeights ArmConv3DLayerCommon::GetPackedWeights() {
+    if (packed_layout_.empty()) {
+        return PackedWeights();
+    }
+    return {packed_layout_, {buffer_weight_, buffer_bias_}};
+}
+
+Status ArmConv3DLayerCommon::SetPackedWeights(const PackedWeights &packed_weights) {
+    packed_weights_ = packed_weights;
+    return TNN_OK;
+}
+
+std::string ArmConv3DLayerCommon::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                      const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("conv3d_common", inputs[0]->GetBlobDesc().data_type);
+}
+
+std::vector<DataFormat> ArmConv3DLayerCommon::SupportDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size == 5 && (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16)) {
+        support_list.push_back(DATA_FORMAT_NC4HW4);
+    }
+    return support_list;
+}
+
+/*
+weights of each group are packed to [oc/N][ic/4][kd][kh][kw][4N] for the sgemm kernel, the output channels of a
+group are padded to ARM_SGEMM_TILE_N with zeros
+*/
+Status ArmConv3DLayerCommon::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                  const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const int group = conv_param->group;
+        const int gic   = inputs[0]->GetBlobDesc().dims[1] / group;
+        const int goc   = outputs[0]->GetBlobDesc().dims[1] / group;
+        const int kvol  = conv_param->kernels[0] * conv_param->kernels[1] * conv_param->kernels[2];
+        const int gic4  = UP_DIV(gic, 4);
+        const int goc_n = ROUND_UP(goc, ARM_SGEMM_TILE_N);
+
+        const int group_count = goc_n * gic4 * 4 * kvol;
+        RawBuffer temp_buffer(group * group_count * sizeof(float) + NEON_KERNEL_EXTRA_LOAD);
+
+        float *src = conv_res->filter_handle.force_to<float *>();
+        float *dst = temp_buffer.force_to<float *>();
+        for (int g = 0; g < group; g++) {
+            auto dst_g = dst + g * group_count;
+            ConvertWeightsFromGOIHWToGOIHW16(src + g * goc * gic * kvol, dst_g, 1, gic, goc,
+                                             conv_param->kernels[2] * conv_param->kernels[1], conv_param->kernels[0]);
+            if (ARM_SGEMM_TILE_N == 8) {
+                ConvertWeightsC4ToC8(dst_g, gic4 * kvol * 4, goc_n);
+            }
+        }
+        buffer_weight_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status ArmConv3DLayerCommon::allocateBufferBias(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_bias_.GetBytesSize()) {
+        const int group = conv_param->group;
+        const int goc   = outputs[0]->GetBlobDesc().dims[1] / group;
+        const int goc_n = ROUND_UP(goc, ARM_SGEMM_TILE_N);
+
+        RawBuffer temp_buffer(group * goc_n * sizeof(float));
+        if (conv_param->bias) {
+            const float *src = conv_res->bias_handle.force_to<float *>();
+            float *dst       = temp_buffer.force_to<float *>();
+            for (int g = 0; g < group; g++) {
+                memcpy(dst + g * goc_n, src + g * goc, goc * sizeof(float));
+            }
+        }
+        buffer_bias_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status ArmConv3DLayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                  const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    if (conv_param->activation_type != ActivationType_None && conv_param->activation_type != ActivationType_ReLU &&
+        conv_param->activation_type != ActivationType_ReLU6) {
+        LOGE("Error: Conv3D layer acc dont support activation type: %d\n", conv_param->activation_type);
+        return Status(TNNERR_LAYER_ERR, "Error: Conv3D layer acc dont support the activation type");
+    }
+
+    RETURN_ON_NEQ(TakePackedWeights(GetImplPackedLayout(inputs, outputs), {&buffer_weight_, &buffer_bias_}),
+                  TNN_OK);
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+    return TNN_OK;
+}
+
+Status ArmConv3DLayerCommon::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        return Exec<float>(inputs, outputs);
+    } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+        return Exec<bfp16_t>(inputs, outputs);
+    }
+    return TNNERR_LAYER_ERR;
+}
+
+template <typename T>
+Status ArmConv3DLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int group     = conv_param->group;
+    const int ic        = dims_input[1];
+    const int oc        = dims_output[1];
+    const int gic       = ic / group;
+    const int goc       = oc / group;
+    const int gic4      = UP_DIV(gic, 4);
+    const int goc4      = UP_DIV(goc, 4);
+    const int goc_n     = ROUND_UP(goc, ARM_SGEMM_TILE_N);
+    const int in_plane  = DimsVectorUtils::Count(dims_input, 2);
+    const int out_plane = DimsVectorUtils::Count(dims_output, 2);
+    const int kvol      = conv_param->kernels[0] * conv_param->kernels[1] * conv_param->kernels[2];
+    const int k4        = gic4 * kvol;
+    const int data_byte_size = sizeof(T);
+
+    // the groups are not aligned to 4 channels in the blobs, regroup them in the work space
+    const bool regroup_input  = group != 1 && gic % 4 != 0;
+    const bool regroup_output = group != 1 && goc % 4 != 0;
+    // 1x1x1 kernels without strides and pads read the input in place
+    const bool skip_vol2col = kvol == 1 && conv_param->strides[0] == 1 && conv_param->strides[1] == 1 &&
+                              conv_param->strides[2] == 1 && conv_param->pads[0] == 0 && conv_param->pads[2] == 0 &&
+                              conv_param->pads[4] == 0;
+
+    /*
+    the output positions are computed in chunks, the vol2col buffer of a chunk stays around the l2 cache size
+    */
+    int chunk = out_plane;
+    if (!skip_vol2col) {
+        chunk = (512 * 1024 / data_byte_size) / (k4 * 4);
+        chunk = MIN(out_plane, MAX(ARM_SGEMM_TILE_M, chunk / ARM_SGEMM_TILE_M * ARM_SGEMM_TILE_M));
+    }
+    const bool direct_output = chunk == out_plane && goc_n == goc4 * 4;
+
+    int a_block, b_block;
+    set_block_size(a_block, b_block, 512 * 1024 / data_byte_size, chunk, goc_n, k4 * 4, data_byte_size);
+    const bool use_lhs      = chunk > goc_n;
+    const int threadbuf_num = use_lhs ? OMP_MAX_THREADS_NUM_ : 1;
+
+    const int input_group_size  = regroup_input ? group * gic4 * in_plane * 4 : 0;
+    const int output_group_size = regroup_output ? group * goc4 * out_plane * 4 : 0;
+    const int col_size          = skip_vol2col ? 0 : k4 * chunk * 4;
+    const int tile_size         = direct_output ? 0 : goc_n * chunk;
+    const int gemm_size         = a_block * k4 * 4 * threadbuf_num;
+    const int work_space_size   = input_group_size + output_group_size + col_size + tile_size + gemm_size;
+
+    T *work_space = reinterpret_cast<T *>(
+        context_->GetSharedWorkSpace(work_space_size * data_byte_size + NEON_KERNEL_EXTRA_LOAD));
+    T *input_group  = work_space;
+    T *output_group = input_group + input_group_size;
+    T *col_buffer   = output_group + output_group_size;
+    T *tile_buffer  = col_buffer + col_size;
+    T *gemm_buffer  = tile_buffer + tile_size;
+
+    T *src_origin  = reinterpret_cast<T *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
+    T *dst_origin  = reinterpret_cast<T *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
+    float *weights = buffer_weight_.force_to<float *>();
+    float *bias    = buffer_bias_.force_to<float *>();
+
+    for (int b = 0; b < dims_output[0]; b++) {
+        T *src_b = src_origin + b * ROUND_UP(ic, 4) * in_plane;
+        T *dst_b = dst_origin + b * ROUND_UP(oc, 4) * out_plane;
+
+        T *input_b = src_b;
+        if (regroup_input) {
+            memset(input_group, 0, input_group_size * data_byte_size);
+            for (int g = 0; g < group; g++) {
+                CopyChannels(input_group + g * gic4 * in_plane * 4, 0, src_b, g * gic, gic, in_plane);
+            }
+            input_b = input_group;
+        }
+        T *output_b = regroup_output ? output_group : dst_b;
+
+        for (int g = 0; g < group; g++) {
+            T *input_g       = input_b + g * gic4 * in_plane * 4;
+            T *output_g      = output_b + g * goc4 * out_plane * 4;
+            float *weights_g = weights + g * goc_n * k4 * 4;
+            float *bias_g    = bias + g * goc_n;
+
+            for (int p = 0; p < out_plane; p += chunk) {
+                const int width = MIN(chunk, out_plane - p);
+                T *col          = input_g;
+                if (!skip_vol2col) {
+                    Vol2Col(col_buffer, input_g, conv_param, dims_input, dims_output, gic4, p, width);
+                    col = col_buffer;
+                }
+                T *gemm_dst = direct_output ? output_g : tile_buffer;
+                if (use_lhs) {
+                    sgemm_repack_lhs(gemm_dst, col, weights_g, k4, goc_n / 4, width, width * 4, a_block, b_block,
+                                     gemm_buffer, bias_g, conv_param->activation_type);
+                } else {
+                    sgemm_repack_rhs(gemm_dst, col, weights_g, k4, goc_n / 4, width, width * 4, a_block, b_block,
+                                     gemm_buffer, bias_g, conv_param->activation_type);
+                }
+                if (!direct_output) {
+                    for (int z = 0; z < goc4; z++) {
+                        memcpy(output_g + (z * out_plane + p) * 4, tile_buffer + z * width * 4,
+                               width * 4 * data_byte_size);
+                    }
+                }
+            }
+        }
+
+        if (regroup_output) {
+            memset(dst_b, 0, ROUND_UP(oc, 4) * out_plane * data_byte_size);
+            for (int g = 0; g < group; g++) {
+                CopyChannels(dst_b, g * goc, output_group + g * goc4 * out_plane * 4, 0, goc, out_plane);
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,66 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV3D_LAYER_COMMON_H_
+#define TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV3D_LAYER_COMMON_H_
+
+#include "tnn/device/arm/acc/arm_layer_acc.h"
+
+namespace TNN_NS {
+
+/*
+3d convolution on 5 dims NC4HW4 blobs, the channels are packed by 4 in front of the flattened depth, height and
+width (NC4DHW4). vol2col gathers the input of a chunk of output positions, the existing packed sgemm multiplies it
+with the weights packed in [g][oc/N][ic/4][kd][kh][kw][4N].
+*/
+class ArmConv3DLayerCommon : public ArmLayerAcc {
+public:
+    virtual ~ArmConv3DLayerCommon();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // weights and bias are packed in init
+    virtual bool IsResourceReleasable();
+
+    // the packed weight and bias in the layout of the impl
+    virtual PackedWeights GetPackedWeights();
+
+    // taken in Init if they are in the layout of the impl
+    virtual Status SetPackedWeights(const PackedWeights &packed_weights);
+
+    // the layout of the weights packed by allocateBufferWeight
+    virtual std::string GetImplPackedLayout(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_bias_;
+
+private:
+    template <typename T>
+    Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV3D_LAYER_COMMON_H_
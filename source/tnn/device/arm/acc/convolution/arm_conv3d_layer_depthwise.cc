@@ -0,0 +1,163 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/convolution/arm_conv3d_layer_depthwise.h"
+
+#include "tnn/device/arm/acc/Float4.h"
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+bool ArmConv3DLayerDepthwise::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                         const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+    const int channel = inputs[0]->GetBlobDesc().dims[1];
+    return param->group == channel && outputs[0]->GetBlobDesc().dims[1] == channel;
+}
+
+ArmConv3DLayerDepthwise::~ArmConv3DLayerDepthwise() {}
+
+std::string ArmConv3DLayerDepthwise::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                         const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("conv3d_depthwise", inputs[0]->GetBlobDesc().data_type);
+}
+
+Status ArmConv3DLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                     const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const int channel = outputs[0]->GetBlobDesc().dims[1];
+        const int kvol    = conv_param->kernels[0] * conv_param->kernels[1] * conv_param->kernels[2];
+
+        RawBuffer temp_buffer(ROUND_UP(channel, 4) * kvol * sizeof(float));
+        const float *src = conv_res->filter_handle.force_to<float *>();
+        float *dst       = temp_buffer.force_to<float *>();
+        for (int c = 0; c < channel; c++) {
+            for (int k = 0; k < kvol; k++) {
+                dst[((c / 4) * kvol + k) * 4 + c % 4] = src[c * kvol + k];
+            }
+        }
+        buffer_weight_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status ArmConv3DLayerDepthwise::allocateBufferBias(const std::vector<Blob *> &inputs,
+                                                   const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_bias_.GetBytesSize()) {
+        const int channel = outputs[0]->GetBlobDesc().dims[1];
+        RawBuffer temp_buffer(ROUND_UP(channel, 4) * sizeof(float));
+        if (conv_param->bias) {
+            memcpy(temp_buffer.force_to<float *>(), conv_res->bias_handle.force_to<float *>(),
+                   channel * sizeof(float));
+        }
+        buffer_bias_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status ArmConv3DLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        return Exec<float>(inputs, outputs);
+    } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+        return Exec<bfp16_t>(inputs, outputs);
+    }
+    return TNNERR_LAYER_ERR;
+}
+
+template <typename T>
+Status ArmConv3DLayerDepthwise::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int c4 = UP_DIV(dims_output[1], 4);
+    const int id = dims_input[2], ih = dims_input[3], iw = dims_input[4];
+    const int od = dims_output[2], oh = dims_output[3], ow = dims_output[4];
+    const int kd = conv_param->kernels[2], kh = conv_param->kernels[1], kw = conv_param->kernels[0];
+    const int sd = conv_param->strides[2], sh = conv_param->strides[1], sw = conv_param->strides[0];
+    const int dd = conv_param->dialations[2], dh = conv_param->dialations[1], dw = conv_param->dialations[0];
+    const int pd = conv_param->pads[4], ph = conv_param->pads[2], pw = conv_param->pads[0];
+    const int kvol = kd * kh * kw;
+    const int act  = conv_param->activation_type;
+
+    const float *weights = buffer_weight_.force_to<float *>();
+    const float *bias    = buffer_bias_.force_to<float *>();
+    T *src_origin        = reinterpret_cast<T *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
+    T *dst_origin        = reinterpret_cast<T *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
+
+    for (int b = 0; b < dims_output[0]; b++) {
+        T *src_b = src_origin + b * c4 * id * ih * iw * 4;
+        T *dst_b = dst_origin + b * c4 * od * oh * ow * 4;
+
+        OMP_PARALLEL_FOR_
+        for (int zo = 0; zo < c4 * od; zo++) {
+            const int z = zo / od, oz = zo % od;
+            const T *src_z   = src_b + z * id * ih * iw * 4;
+            T *dst_z         = dst_b + (z * od + oz) * oh * ow * 4;
+            const float *w_z = weights + z * kvol * 4;
+            Float4 bias4     = Float4::load(bias + z * 4);
+
+            const int sz0  = oz * sd - pd;
+            const int kz_s = MAX(0, UP_DIV(-sz0, dd));
+            const int kz_e = MIN(kd, UP_DIV(id - sz0, dd));
+            for (int oy = 0; oy < oh; oy++) {
+                const int sy0  = oy * sh - ph;
+                const int ky_s = MAX(0, UP_DIV(-sy0, dh));
+                const int ky_e = MIN(kh, UP_DIV(ih - sy0, dh));
+                for (int ox = 0; ox < ow; ox++) {
+                    const int sx0  = ox * sw - pw;
+                    const int kx_s = MAX(0, UP_DIV(-sx0, dw));
+                    const int kx_e = MIN(kw, UP_DIV(iw - sx0, dw));
+
+                    Float4 acc = bias4;
+                    for (int kz = kz_s; kz < kz_e; kz++) {
+                        for (int ky = ky_s; ky < ky_e; ky++) {
+                            const T *src_y   = src_z + ((sz0 + kz * dd) * ih + sy0 + ky * dh) * iw * 4;
+                            const float *w_y = w_z + (kz * kh + ky) * kw * 4;
+                            for (int kx = kx_s; kx < kx_e; kx++) {
+                                Float4::mla(acc, Float4::load(src_y + (sx0 + kx * dw) * 4), Float4::load(w_y + kx * 4));
+                            }
+                        }
+                    }
+                    if (act == ActivationType_ReLU) {
+                        acc = Float4::max(acc, Float4(0.f));
+                    } else if (act == ActivationType_ReLU6) {
+                        acc = Float4::min(Float4::max(acc, Float4(0.f)), Float4(6.f));
+                    }
+                    Float4::save(dst_z + (oy * ow + ox) * 4, acc);
+                }
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -30,7 +30,7 @@ bool ArmConvInt8Layer1x1::isPrefered(ConvLayerParam *param, const std::vector<Bl
         param->pads[3] != 0) {
         return false;
     }
-    auto dims_input         = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
     const int input_channel = dims_input[1];
     const int h             = dims_input[2];
     const int w             = dims_input[3];
@@ -79,8 +79,8 @@ Status ArmConvInt8Layer1x1::allocateBufferWeightBias(const std::vector<Blob *> &
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
     CHECK_PARAM_NULL(conv_res);
 
-    auto dims_input           = inputs[0]->GetBlobDesc().dims;
-    auto dims_output          = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input    = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output   = outputs[0]->GetBlobDesc().dims;
     const int input_channels  = dims_input[1];
     const int output_channels = dims_output[1];
 
@@ -126,15 +126,15 @@ Status ArmConvInt8Layer1x1::DoForward(const std::vector<Blob *> &inputs, const s
 #else
     const int mr        = 4;
 #endif
-    const int nr        = 8;
-    const int kr        = 1;
-    auto dims_input     = input->GetBlobDesc().dims;
-    auto dims_output    = output->GetBlobDesc().dims;
-    const int batch     = dims_output[0];
-    int ic              = dims_input[1];
-    int oc              = dims_output[1];
-    int8_t *input_data  = reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle()));
-    int8_t *output_data = reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle()));
+    const int nr            = 8;
+    const int kr            = 1;
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    const int batch         = dims_output[0];
+    int ic                  = dims_input[1];
+    int oc                  = dims_output[1];
+    int8_t *input_data      = reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle()));
+    int8_t *output_data     = reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle()));
 
     struct Q8GemmContext context = {.k        = ic,
                                     .k_stride = ic,
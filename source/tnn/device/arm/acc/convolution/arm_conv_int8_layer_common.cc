@@ -40,8 +40,8 @@ Status ArmConvInt8LayerCommon::allocateBufferWeight(const std::vector<Blob *> &i
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
     CHECK_PARAM_NULL(conv_res);
 
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     if (!buffer_weight_.GetBytesSize()) {
         const int input_channel  = dims_input[1];
@@ -84,7 +84,7 @@ Status ArmConvInt8LayerCommon::allocateBufferBias(const std::vector<Blob *> &inp
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
     CHECK_PARAM_NULL(conv_res);
 
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
     if (!buffer_bias_.GetBytesSize()) {
         if (conv_param->bias) {
             int total_byte_size =
@@ -113,7 +113,7 @@ Status ArmConvInt8LayerCommon::allocateBufferScale(const std::vector<Blob *> &in
 
     // alloc scale buffer
     if (!buffer_scale_.GetBytesSize()) {
-        auto dims_output = outputs[0]->GetBlobDesc().dims;
+        const auto &dims_output = outputs[0]->GetBlobDesc().dims;
         int total_byte_size =
             ROUND_UP(dims_output[1], 4) * DataTypeUtils::GetBytesSize(conv_res->scale_handle.GetDataType());
 
@@ -147,8 +147,8 @@ Status ArmConvInt8LayerCommon::allocateBufferParam(const std::vector<Blob *> &in
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto dims_input          = inputs[0]->GetBlobDesc().dims;
-    auto dims_output         = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input   = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output  = outputs[0]->GetBlobDesc().dims;
     const int input_channel  = dims_input[1];
     const int output_channel = dims_output[1];
 
@@ -262,13 +262,13 @@ Status ArmConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerRe
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto dims_input = inputs[0]->GetBlobDesc().dims;
-    int kernel_x    = conv_param->kernels[0];
-    int kernel_y    = conv_param->kernels[1];
-    int stride_x    = conv_param->strides[0];
-    int stride_y    = conv_param->strides[1];
-    int pad_x       = conv_param->pads[0];
-    int pad_y       = conv_param->pads[2];
+    const auto &dims_input = inputs[0]->GetBlobDesc().dims;
+    int kernel_x           = conv_param->kernels[0];
+    int kernel_y           = conv_param->kernels[1];
+    int stride_x           = conv_param->strides[0];
+    int stride_y           = conv_param->strides[1];
+    int pad_x              = conv_param->pads[0];
+    int pad_y              = conv_param->pads[2];
 
     // fast mode
     bool no_im2col = kernel_x == 1 && kernel_y == 1 && k_param_->ic_r4 % 8 == 0 && stride_x == 1 && stride_y == 1 &&
@@ -296,11 +296,11 @@ Status ArmConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
     DataType data_type = output->GetBlobDesc().data_type;
     int data_byte_size = DataTypeUtils::GetBytesSize(data_type);
 
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
-    const int batch  = dims_output[0];
-    auto ic          = dims_input[1];
-    auto ic_calc     = ic < 4 ? ic : k_param_->ic_r4;
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    const int batch         = dims_output[0];
+    auto ic                 = dims_input[1];
+    auto ic_calc            = ic < 4 ? ic : k_param_->ic_r4;
 
     int8_t *input_data  = reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle()));
     int8_t *output_data = reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle()));
@@ -30,8 +30,8 @@ bool ArmConvInt8LayerDepthwise::isPrefered(ConvLayerParam *param, const std::vec
         return false;
     }
 
-    auto dims_input          = inputs[0]->GetBlobDesc().dims;
-    auto dims_output         = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input   = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output  = outputs[0]->GetBlobDesc().dims;
     const int input_channel  = dims_input[1];
     const int output_channel = dims_output[1];
 
@@ -75,10 +75,10 @@ Status ArmConvInt8LayerDepthwise::DoForward(const std::vector<Blob *> &inputs, c
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     const int batch  = dims_output[0];
     const int group  = conv_param->group;
@@ -79,8 +79,8 @@ bool ArmConvLayer1x1::isPrefered(ConvLayerParam *param, const std::vector<Blob *
         return false;
     }
 
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     return param->kernels[0] == 1 && param->kernels[1] == 1 && param->group == 1 &&
            dims_output[1] % ARM_SGEMM_TILE_N == 0;
@@ -88,6 +88,11 @@ bool ArmConvLayer1x1::isPrefered(ConvLayerParam *param, const std::vector<Blob *
 
 ArmConvLayer1x1::~ArmConvLayer1x1() {}
 
+std::string ArmConvLayer1x1::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                 const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("conv_1x1", inputs[0]->GetBlobDesc().data_type);
+}
+
 Status ArmConvLayer1x1::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (!buffer_weight_.GetBytesSize()) {
         RETURN_ON_NEQ(ArmConvLayerCommon::allocateBufferWeight(inputs, outputs), TNN_OK);
@@ -113,10 +118,10 @@ Status ArmConvLayer1x1::Exec(const std::vector<Blob *> &inputs, const std::vecto
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     DataType data_type = output->GetBlobDesc().data_type;
     int data_byte_size = DataTypeUtils::GetBytesSize(data_type);
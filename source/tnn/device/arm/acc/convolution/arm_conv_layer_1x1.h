@@ -35,6 +35,8 @@ public:
 
     // copy and pack to c4 or c8
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual std::string GetImplPackedLayout(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 };
 
 }  // namespace TNN_NS
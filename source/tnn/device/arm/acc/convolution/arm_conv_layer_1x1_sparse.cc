@@ -0,0 +1,86 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/convolution/arm_conv_layer_1x1_sparse.h"
+
+#include "tnn/device/arm/arm_common.h"
+
+namespace TNN_NS {
+
+bool ArmConvLayer1x1Sparse::isPrefered(ConvLayerParam *param, LayerResource *resource,
+                                       const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto conv_res = dynamic_cast<ConvLayerResource *>(resource);
+    if (!param || !conv_res || inputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT ||
+        conv_res->filter_handle.GetDataType() != DATA_TYPE_FLOAT) {
+        return false;
+    }
+    if (param->kernels[0] != 1 || param->kernels[1] != 1 || param->group != 1 || param->strides[0] != 1 ||
+        param->strides[1] != 1 || param->pads[0] != 0 || param->pads[1] != 0 || param->pads[2] != 0 ||
+        param->pads[3] != 0) {
+        return false;
+    }
+
+    const int ic = inputs[0]->GetBlobDesc().dims[1];
+    const int oc = outputs[0]->GetBlobDesc().dims[1];
+    if (conv_res->filter_handle.GetDataCount() != ic * oc) {
+        return false;
+    }
+    return GetBlockSparsityO4(conv_res->filter_handle.force_to<float *>(), oc, ic) >= SPARSE_WEIGHT_THRESHOLD;
+}
+
+ArmConvLayer1x1Sparse::~ArmConvLayer1x1Sparse() {}
+
+Status ArmConvLayer1x1Sparse::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                   const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!sparse_weight_.values.GetBytesSize()) {
+        const int ic = inputs[0]->GetBlobDesc().dims[1];
+        const int oc = outputs[0]->GetBlobDesc().dims[1];
+        PackSparseWeightO4(conv_res->filter_handle.force_to<float *>(), oc, ic, sparse_weight_);
+    }
+    return TNN_OK;
+}
+
+std::string ArmConvLayer1x1Sparse::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                       const std::vector<Blob *> &outputs) {
+    return "";
+}
+
+Status ArmConvLayer1x1Sparse::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_LAYER_ERR, "sparse conv only supports float");
+    }
+
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+    const int batch         = dims_output[0];
+    const int plane         = dims_output[2] * dims_output[3];
+
+    auto src_origin = reinterpret_cast<float *>(GetBlobHandlePtr(inputs[0]->GetHandle()));
+    auto dst_origin = reinterpret_cast<float *>(GetBlobHandlePtr(outputs[0]->GetHandle()));
+    for (int batch_idx = 0; batch_idx < batch; batch_idx++) {
+        auto src_ptr = src_origin + batch_idx * plane * ROUND_UP(dims_input[1], 4);
+        auto dst_ptr = dst_origin + batch_idx * plane * ROUND_UP(dims_output[1], 4);
+        SparseConv1x1O4(dst_ptr, src_ptr, sparse_weight_, UP_DIV(dims_output[1], 4), plane);
+    }
+
+    // bias and activation
+    PostExec<float>(outputs);
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
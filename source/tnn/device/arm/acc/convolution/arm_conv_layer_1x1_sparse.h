@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_ACC_1X1_SPARSE_H_
+#define TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_ACC_1X1_SPARSE_H_
+
+#include "tnn/device/arm/acc/compute/sparse_function.h"
+#include "tnn/device/arm/acc/convolution/arm_conv_layer_common.h"
+
+namespace TNN_NS {
+
+// @brief 1x1 conv of pruned weights, the zero 4x1 weight blocks are skipped
+class ArmConvLayer1x1Sparse : public ArmConvLayerCommon {
+public:
+    virtual ~ArmConvLayer1x1Sparse();
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // preferred for float 1x1 convs of stride 1 without pads whose weight block sparsity reaches
+    // SPARSE_WEIGHT_THRESHOLD
+    static bool isPrefered(ConvLayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                           const std::vector<Blob *> &outputs);
+
+    // pack block sparse weights
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // the sparse weights are always packed at init
+    virtual std::string GetImplPackedLayout(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    SparseWeightO4 sparse_weight_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_ACC_1X1_SPARSE_H_
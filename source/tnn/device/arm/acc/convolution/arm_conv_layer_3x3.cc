@@ -208,18 +208,27 @@ static void load_repack(T *dst_b, T *src_b, int width, int src_stride) {
     }
 }
 
-bool ArmConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
-                                 const std::vector<Blob *> &outputs) {
+bool ArmConvLayer3x3::isSupported(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                  const std::vector<Blob *> &outputs) {
     if (!param) {
         return false;
     }
 
     if (param->group != 1 || param->dialations[0] != 1 || param->dialations[1] != 1 || param->strides[0] != 1 ||
-        param->kernels[0] != param->kernels[1] || param->strides[1] != 1 ||
+        param->kernels[0] != param->kernels[1] || param->strides[1] != 1 || param->kernels[0] != 3 ||
         ROUND_UP(outputs[0]->GetBlobDesc().dims[1], 4) % ARM_SGEMM_TILE_N != 0) {
         return false;
     }
 
+    return true;
+}
+
+bool ArmConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                 const std::vector<Blob *> &outputs) {
+    if (!isSupported(param, inputs, outputs)) {
+        return false;
+    }
+
     if (!SelectWinograd(param, inputs, outputs)) {
         return false;
     }
@@ -275,14 +284,31 @@ int ArmConvLayer3x3::SelectWinograd(ConvLayerParam *param, const std::vector<Blo
 
 ArmConvLayer3x3::~ArmConvLayer3x3() {}
 
+// F(2x2, 3x3) if forced by the factory against the cost model
+static int GetDstUnit(ConvLayerParam *param, const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    int dst_unit = ArmConvLayer3x3::SelectWinograd(param, inputs, outputs);
+    return dst_unit ? dst_unit : 2;
+}
+
+// the weights are transformed for the winograd unit
+std::string ArmConvLayer3x3::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                 const std::vector<Blob *> &outputs) {
+    int dst_unit = GetDstUnit(dynamic_cast<ConvLayerParam *>(param_), inputs, outputs);
+    return GetPackedLayout("conv_3x3_f" + std::to_string(dst_unit), inputs[0]->GetBlobDesc().data_type);
+}
+
 Status ArmConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
     CHECK_PARAM_NULL(conv_res);
 
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
+
+    // the units are selected even if the weights have been packed ahead of time
+    dst_unit_ = GetDstUnit(conv_param, inputs, outputs);
+    src_unit_ = dst_unit_ + conv_param->kernels[0] - 1;
 
     if (!buffer_weight_.GetBytesSize()) {
         const int input_channel  = dims_input[1];
@@ -295,9 +321,6 @@ Status ArmConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
         const float *src             = conv_res->filter_handle.force_to<float *>();
         int data_byte_size           = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
-        dst_unit_ = SelectWinograd(conv_param, inputs, outputs);
-        src_unit_ = dst_unit_ + kw - 1;
-
         const int weight_count = src_unit_ * src_unit_ * k_param_->oc_r4 * k_param_->ic_r4;
         RawBuffer pack_weight(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
 
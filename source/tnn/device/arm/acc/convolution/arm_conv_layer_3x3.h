@@ -33,6 +33,10 @@ public:
     template <typename T>
     Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    // @brief the winograd kernels can run the conv, regardless of the cost
+    static bool isSupported(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                            const std::vector<Blob *> &outputs);
+
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
 
@@ -41,6 +45,8 @@ public:
                               
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual std::string GetImplPackedLayout(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
 protected:
     int src_unit_;
     int dst_unit_;
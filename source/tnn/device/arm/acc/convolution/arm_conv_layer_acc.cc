@@ -18,6 +18,7 @@
 
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_acc_factory.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_group.h"
+#include "tnn/device/arm/acc/convolution/arm_conv_layer_nhwc.h"
 #include "tnn/interpreter/raw_buffer.h"
 
 namespace TNN_NS {
@@ -50,20 +51,39 @@ Status ArmConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
         return ret;
 
     auto data_type = inputs[0]->GetBlobDesc().data_type;
-    if (conv_param->group != 1 && conv_param->group != inputs[0]->GetBlobDesc().dims[1]) {
+    if (ArmConvLayerNhwc::isPrefered(conv_param, inputs, outputs)) {
+        conv_acc_impl_ = std::make_shared<ArmConvLayerNhwc>();
+    } else if (conv_param->group != 1 && conv_param->group != inputs[0]->GetBlobDesc().dims[1]) {
         conv_acc_impl_ = std::make_shared<ArmConvLayerGroup>();
     } else {
         if (data_type == DATA_TYPE_INT8) {
             ArmConvLayerAccFactory::CreateImpInt8(inputs, outputs, param_, conv_acc_impl_);
         } else {
-            ArmConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
+            ArmConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_, resource_);
         }
     }
 
     if (!conv_acc_impl_) {
         return Status(TNNERR_NET_ERR, "Could not create conv impl_");
     }
-    return conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
+    conv_acc_impl_->SetImplementedLayout(implemented_layout_);
+    if (!packed_weights_.buffers.empty()) {
+        // the impl packs the weights at init instead
+        Status status = conv_acc_impl_->SetPackedWeights(packed_weights_);
+        if (status != TNN_OK && !packed_weights_.repackable) {
+            return status;
+        } else if (status != TNN_OK) {
+            LOGD("the conv impl does not take the packed weights in %s\n", packed_weights_.layout.c_str());
+        }
+        packed_weights_ = PackedWeights();
+    }
+    RETURN_ON_NEQ(conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs), TNN_OK);
+
+    // fp32 copy of half weights is useless once the impl has packed them
+    if (conv_acc_impl_->IsResourceReleasable()) {
+        conv_acc_f32_resource_ = nullptr;
+    }
+    return TNN_OK;
 }
 
 ArmConvLayerAcc::~ArmConvLayerAcc() {}
@@ -80,6 +100,27 @@ Status ArmConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+bool ArmConvLayerAcc::IsResourceReleasable() {
+    return conv_acc_impl_ && conv_acc_impl_->IsResourceReleasable();
+}
+
+void ArmConvLayerAcc::ReleaseResource() {
+    ArmLayerAcc::ReleaseResource();
+    if (conv_acc_impl_) {
+        conv_acc_impl_->ReleaseResource();
+    }
+}
+
+PackedWeights ArmConvLayerAcc::GetPackedWeights() {
+    return conv_acc_impl_ ? conv_acc_impl_->GetPackedWeights() : PackedWeights();
+}
+
+Status ArmConvLayerAcc::SetPackedWeights(const PackedWeights &packed_weights) {
+    packed_weights_ = packed_weights;
+    return TNN_OK;
+}
+
 REGISTER_ARM_ACC(Conv, LAYER_CONVOLUTION)
+REGISTER_ARM_LAYOUT(LAYER_CONVOLUTION, DATA_FORMAT_NHWC)
 
 }  // namespace TNN_NS
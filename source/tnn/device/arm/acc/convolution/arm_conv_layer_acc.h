@@ -32,6 +32,15 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual bool IsResourceReleasable();
+
+    virtual void ReleaseResource();
+
+    virtual PackedWeights GetPackedWeights();
+
+    // the packed weights are handed to the conv impl created in Init, which checks their layout
+    virtual Status SetPackedWeights(const PackedWeights &packed_weights);
+
 private:
     void GetImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
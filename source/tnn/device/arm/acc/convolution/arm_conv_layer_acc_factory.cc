@@ -14,6 +14,9 @@
 
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_acc_factory.h"
 
+#include <algorithm>
+#include <typeinfo>
+
 namespace TNN_NS {
 
 /*
@@ -37,36 +40,112 @@ void ArmConvLayerAccFactory::CreateImpInt8(const std::vector<Blob *> &inputs, co
     }
 }
 
+std::atomic<ArmConvImpType> ArmConvLayerAccFactory::forced_imp_fp_(ARM_CONV_IMP_AUTO);
+
+std::vector<ArmConvImpType> ArmConvLayerAccFactory::GetCandidatesFP(const std::vector<Blob *> &inputs,
+                                                                    const std::vector<Blob *> &outputs,
+                                                                    LayerParam *param, LayerResource *resource) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param);
+    // winograd is a candidate even if the cost model rejects it, it goes last then
+    bool winograd          = ArmConvLayer3x3::isSupported(conv_param, inputs, outputs);
+    bool winograd_prefered = winograd && ArmConvLayer3x3::isPrefered(conv_param, inputs, outputs);
+
+    std::vector<ArmConvImpType> candidates;
+    if (ArmConvLayer1x1Sparse::isPrefered(conv_param, resource, inputs, outputs)) {
+        candidates.push_back(ARM_CONV_IMP_1X1_SPARSE);
+    }
+    if (ArmConvLayerC3::isPrefered(conv_param, inputs, outputs)) {
+        candidates.push_back(ARM_CONV_IMP_C3);
+    }
+    if (winograd_prefered) {
+        candidates.push_back(ARM_CONV_IMP_3X3);
+    }
+    if (ArmConvLayer1x1::isPrefered(conv_param, inputs, outputs)) {
+        candidates.push_back(ARM_CONV_IMP_1X1);
+    }
+    if (ArmConvLayerDepthwise::isPrefered(conv_param, inputs, outputs)) {
+        if (ArmConvLayerDepthwiseS1::isPrefered(conv_param, inputs, outputs)) {
+            candidates.push_back(ARM_CONV_IMP_DEPTHWISE_S1);
+        }
+        candidates.push_back(ARM_CONV_IMP_DEPTHWISE);
+    }
+    if (winograd && !winograd_prefered) {
+        candidates.push_back(ARM_CONV_IMP_3X3);
+    }
+    candidates.push_back(ARM_CONV_IMP_COMMON);
+    return candidates;
+}
+
+void ArmConvLayerAccFactory::SetForcedImpFP(ArmConvImpType type) {
+    forced_imp_fp_ = type;
+}
+
+std::string ArmConvLayerAccFactory::GetImpName(ArmConvImpType type) {
+    switch (type) {
+        case ARM_CONV_IMP_C3:
+            return "C3";
+        case ARM_CONV_IMP_3X3:
+            return "3x3";
+        case ARM_CONV_IMP_1X1:
+            return "1x1";
+        case ARM_CONV_IMP_DEPTHWISE:
+            return "Depthwise";
+        case ARM_CONV_IMP_DEPTHWISE_S1:
+            return "DepthwiseS1";
+        case ARM_CONV_IMP_COMMON:
+            return "Common";
+        case ARM_CONV_IMP_1X1_SPARSE:
+            return "1x1Sparse";
+        default:
+            return "Auto";
+    }
+}
+
+template <typename T>
+static void CreateImp(std::shared_ptr<ArmLayerAcc> &conv_acc_impl) {
+    // the impl is reused if the conv is created again with the same type
+    if (!conv_acc_impl || typeid(*conv_acc_impl) != typeid(T)) {
+        conv_acc_impl = std::make_shared<T>();
+    }
+}
+
 /*
 get different impl based on conv params
 ArmConvLayerCommon always as the last solution
 bfp16 impl included in fp impl
 */
 void ArmConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
-                                         LayerParam *param, std::shared_ptr<ArmLayerAcc> &conv_acc_impl) {
-    if (ArmConvLayerC3::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
-        if (!dynamic_cast<ArmConvLayerC3 *>(conv_acc_impl.get())) {
-            conv_acc_impl = std::make_shared<ArmConvLayerC3>();
-        }
-    } else if (ArmConvLayer3x3::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
-        if (!dynamic_cast<ArmConvLayer3x3 *>(conv_acc_impl.get())) {
-            conv_acc_impl = std::make_shared<ArmConvLayer3x3>();
-        }
-    } else if (ArmConvLayer1x1::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
-        if (!dynamic_cast<ArmConvLayer1x1 *>(conv_acc_impl.get())) {
-            conv_acc_impl = std::make_shared<ArmConvLayer1x1>();
-        }
-    } else if (ArmConvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
-        if (ArmConvLayerDepthwiseS1::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
-            if (!dynamic_cast<ArmConvLayerDepthwiseS1 *>(conv_acc_impl.get())) {
-                conv_acc_impl = std::make_shared<ArmConvLayerDepthwiseS1>();
-            }
-        } else if (!dynamic_cast<ArmConvLayerDepthwise *>(conv_acc_impl.get())) {
-            conv_acc_impl = std::make_shared<ArmConvLayerDepthwise>();
-        }
+                                         LayerParam *param, std::shared_ptr<ArmLayerAcc> &conv_acc_impl,
+                                         LayerResource *resource) {
+    auto candidates = GetCandidatesFP(inputs, outputs, param, resource);
+    auto type       = candidates[0];
+    auto forced     = forced_imp_fp_.load();
+    if (forced != ARM_CONV_IMP_AUTO && std::find(candidates.begin(), candidates.end(), forced) != candidates.end()) {
+        type = forced;
     }
-    if (!conv_acc_impl) {
-        conv_acc_impl = std::make_shared<ArmConvLayerCommon>();
+
+    switch (type) {
+        case ARM_CONV_IMP_C3:
+            CreateImp<ArmConvLayerC3>(conv_acc_impl);
+            break;
+        case ARM_CONV_IMP_3X3:
+            CreateImp<ArmConvLayer3x3>(conv_acc_impl);
+            break;
+        case ARM_CONV_IMP_1X1:
+            CreateImp<ArmConvLayer1x1>(conv_acc_impl);
+            break;
+        case ARM_CONV_IMP_1X1_SPARSE:
+            CreateImp<ArmConvLayer1x1Sparse>(conv_acc_impl);
+            break;
+        case ARM_CONV_IMP_DEPTHWISE_S1:
+            CreateImp<ArmConvLayerDepthwiseS1>(conv_acc_impl);
+            break;
+        case ARM_CONV_IMP_DEPTHWISE:
+            CreateImp<ArmConvLayerDepthwise>(conv_acc_impl);
+            break;
+        default:
+            CreateImp<ArmConvLayerCommon>(conv_acc_impl);
+            break;
     }
 }
 
@@ -15,11 +15,16 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_ACC_FACTORY_H_
 #define TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_ACC_FACTORY_H_
 
+#include <atomic>
+#include <string>
+#include <vector>
+
 #include "tnn/device/arm/acc/arm_layer_acc.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_1x1.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_common.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_depthwise.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_1x1.h"
+#include "tnn/device/arm/acc/convolution/arm_conv_layer_1x1_sparse.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_3x3.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_c3.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_common.h"
@@ -28,18 +33,46 @@
 
 namespace TNN_NS {
 
+typedef enum {
+    ARM_CONV_IMP_AUTO         = 0,
+    ARM_CONV_IMP_C3           = 1,
+    ARM_CONV_IMP_3X3          = 2,
+    ARM_CONV_IMP_1X1          = 3,
+    ARM_CONV_IMP_DEPTHWISE    = 4,
+    ARM_CONV_IMP_DEPTHWISE_S1 = 5,
+    ARM_CONV_IMP_COMMON       = 6,
+    ARM_CONV_IMP_1X1_SPARSE   = 7,
+} ArmConvImpType;
+
 class ArmConvLayerAccFactory {
 public:
+    // @brief fp impls able to run the conv, ordered by priority. The first one is chosen by CreateImpFP.
+    // the sparse impls are candidates only if the resource is given
+    static std::vector<ArmConvImpType> GetCandidatesFP(const std::vector<Blob *> &inputs,
+                                                       const std::vector<Blob *> &outputs, LayerParam *param,
+                                                       LayerResource *resource = nullptr);
+
+    // @brief force CreateImpFP to create the impl of type if it is a candidate of the conv, used by the layer
+    // benchmark to time the impls not chosen by the heuristics. ARM_CONV_IMP_AUTO restores the heuristics.
+    // It affects all the convs created after the call, on any thread.
+    static void SetForcedImpFP(ArmConvImpType type);
+
+    static std::string GetImpName(ArmConvImpType type);
+
     static void CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
                               std::shared_ptr<ArmLayerAcc> &conv_acc_impl);
 
     static void CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
-                            std::shared_ptr<ArmLayerAcc> &conv_acc_impl);
+                            std::shared_ptr<ArmLayerAcc> &conv_acc_impl, LayerResource *resource = nullptr);
 
     static void CreateImpHalf(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, LayerParam *param,
                               std::shared_ptr<ArmLayerAcc> &conv_acc_impl);
+
+private:
+    // read by the threads initializing the layer accs
+    static std::atomic<ArmConvImpType> forced_imp_fp_;
 };
 
 }  // namespace TNN_NS
 
-#endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_GROUP_H_
+#endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_ACC_FACTORY_H_
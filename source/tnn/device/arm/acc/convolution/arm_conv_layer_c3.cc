@@ -31,14 +31,19 @@ bool ArmConvLayerC3::isPrefered(ConvLayerParam *param, const std::vector<Blob *>
 
 ArmConvLayerC3::~ArmConvLayerC3() {}
 
+std::string ArmConvLayerC3::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("conv_c3", inputs[0]->GetBlobDesc().data_type);
+}
+
 Status ArmConvLayerC3::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
     CHECK_PARAM_NULL(conv_res);
 
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     if (!buffer_weight_.GetBytesSize()) {
         const int input_channel  = dims_input[1];
@@ -81,12 +86,12 @@ void GemmSlidewC3(bfp16_t *dst, const bfp16_t *src, const float *weight, int wid
 
 template <typename T>
 Status ArmConvLayerC3::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    auto input         = inputs[0];
-    auto output        = outputs[0];
-    auto dims_input    = input->GetBlobDesc().dims;
-    auto dims_output   = output->GetBlobDesc().dims;
-    DataType data_type = output->GetBlobDesc().data_type;
-    int data_byte_size = DataTypeUtils::GetBytesSize(data_type);
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    DataType data_type      = output->GetBlobDesc().data_type;
+    int data_byte_size      = DataTypeUtils::GetBytesSize(data_type);
 
     const int batch = dims_output[0];
 
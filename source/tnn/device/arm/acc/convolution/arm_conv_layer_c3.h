@@ -33,6 +33,8 @@ public:
     Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual std::string GetImplPackedLayout(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 };
 
 }  // namespace TNN_NS
@@ -14,7 +14,10 @@
 
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_common.h"
 
+#include <algorithm>
+
 #include "tnn/device/arm/arm_common.h"
+#include "tnn/core/profile.h"
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
@@ -38,14 +41,35 @@ bool ArmConvLayerCommon::isPrefered(ConvLayerParam *param, const std::vector<Blo
 
 ArmConvLayerCommon::~ArmConvLayerCommon() {}
 
+bool ArmConvLayerCommon::IsResourceReleasable() {
+    return true;
+}
+
+PackedWeights ArmConvLayerCommon::GetPackedWeights() {
+    if (packed_layout_.empty()) {
+        return PackedWeights();
+    }
+    return {packed_layout_, {buffer_weight_, buffer_bias_}};
+}
+
+Status ArmConvLayerCommon::SetPackedWeights(const PackedWeights &packed_weights) {
+    packed_weights_ = packed_weights;
+    return TNN_OK;
+}
+
+std::string ArmConvLayerCommon::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                    const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("conv_common", inputs[0]->GetBlobDesc().data_type);
+}
+
 Status ArmConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
     CHECK_PARAM_NULL(conv_res);
 
-    auto dims_input  = inputs[0]->GetBlobDesc().dims;
-    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input  = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output = outputs[0]->GetBlobDesc().dims;
 
     if (!buffer_weight_.GetBytesSize()) {
         int kw = conv_param->kernels[0];
@@ -86,7 +110,7 @@ Status ArmConvLayerCommon::allocateBufferBias(const std::vector<Blob *> &inputs,
     CHECK_PARAM_NULL(conv_res);
 
     if (!buffer_bias_.GetBytesSize()) {
-        auto dims_output = outputs[0]->GetBlobDesc().dims;
+        const auto &dims_output = outputs[0]->GetBlobDesc().dims;
         int total_byte_size =
             ROUND_UP(dims_output[1], 4) * DataTypeUtils::GetBytesSize(conv_res->bias_handle.GetDataType());
         RawBuffer temp_buffer(total_byte_size);
@@ -109,6 +133,8 @@ Status ArmConvLayerCommon::Init(Context *context, LayerParam *param, LayerResour
                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
 
+    RETURN_ON_NEQ(TakePackedWeights(GetImplPackedLayout(inputs, outputs), {&buffer_weight_, &buffer_bias_}),
+                  TNN_OK);
     RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
 
@@ -156,10 +182,10 @@ Status ArmConvLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::ve
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     DataType data_type = output->GetBlobDesc().data_type;
     int data_byte_size = DataTypeUtils::GetBytesSize(data_type);
@@ -191,10 +217,23 @@ Status ArmConvLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::ve
     int src_xc  = 1 + (CONVOLUTION_TILED_NUMBER - 1) * conv_param->strides[0] +
                 conv_param->dialations[0] * (conv_param->kernels[0] - 1);
     int workspace_per_thread = src_xc * conv_param->kernels[1] * ROUND_UP(dims_input[1], 4) * data_byte_size;
-    RawBuffer i_buffer;
-    RawBuffer o_buffer;
 
-    T *work_space = reinterpret_cast<T *>(context_->GetSharedWorkSpace(max_num_threads * workspace_per_thread));
+    // the channels of each group are repacked to be 4 aligned, the buffers are in the shared workspace after
+    // the one of the threads, so that the forward does not allocate
+    const bool pack_input_group  = gic_4 != (gic / 4) && group != 1;
+    const bool pack_output_group = goc_4 != (goc / 4) && group != 1;
+    size_t group_input_bytes     = pack_input_group ? group * input_bytes_per_group : 0;
+    size_t group_output_bytes    = pack_output_group ? group * output_bytes_per_group : 0;
+    size_t transform_bytes       = std::max(group_input_bytes, group_output_bytes);
+    size_t work_space_bytes      = max_num_threads * workspace_per_thread;
+
+    char *shared_work_space = reinterpret_cast<char *>(
+        context_->GetSharedWorkSpace(work_space_bytes + group_input_bytes + group_output_bytes + transform_bytes));
+    T *work_space      = reinterpret_cast<T *>(shared_work_space);
+    T *group_input     = reinterpret_cast<T *>(shared_work_space + work_space_bytes);
+    T *group_output    = reinterpret_cast<T *>(shared_work_space + work_space_bytes + group_input_bytes);
+    T *group_transform = reinterpret_cast<T *>(shared_work_space + work_space_bytes + group_input_bytes +
+                                               group_output_bytes);
 
     for (int batch_idx = 0; batch_idx < batch; batch_idx++) {
         T *input_ptr;
@@ -204,28 +243,21 @@ Status ArmConvLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::ve
         first unpack input tensor to nchw data format
         pack data to make sure every group chanel algin4
         */
-        if (gic_4 != (gic / 4) && group != 1) {
-            RawBuffer i_temp_buffer_(group * input_bytes_per_group);
-            RawBuffer temp_buffer(group * input_bytes_per_group);
-            i_buffer  = i_temp_buffer_;
-            input_ptr = i_buffer.force_to<T *>();
-
-            UnpackC4(temp_buffer.force_to<T *>(),
-                     input_orign + batch_idx * k_param_->iw * k_param_->ih * ROUND_UP(ic, 4),
+        if (pack_input_group) {
+            input_ptr = group_input;
+
+            UnpackC4(group_transform, input_orign + batch_idx * k_param_->iw * k_param_->ih * ROUND_UP(ic, 4),
                      k_param_->iw * k_param_->ih, ic);
             for (int g = 0; g < group; g++) {
                 PackC4(input_ptr + g * input_bytes_per_group / 4,
-                       temp_buffer.force_to<T *>() + g * k_param_->iw * k_param_->ih * gic, k_param_->iw * k_param_->ih,
-                       gic);
+                       group_transform + g * k_param_->iw * k_param_->ih * gic, k_param_->iw * k_param_->ih, gic);
             }
         } else {
             input_ptr = input_orign + batch_idx * k_param_->iw * k_param_->ih * ROUND_UP(ic, 4);
         }
 
-        if (goc_4 != (goc / 4) && group != 1) {
-            RawBuffer o_temp_buffer_(group * output_bytes_per_group);
-            o_buffer   = o_temp_buffer_;
-            output_ptr = o_buffer.force_to<T *>();
+        if (pack_output_group) {
+            output_ptr = group_output;
         } else {
             output_ptr = dst_origin + batch_idx * k_param_->ow * k_param_->oh * ROUND_UP(oc, 4);
         }
@@ -234,59 +266,65 @@ Status ArmConvLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::ve
             auto input_g_ptr  = input_ptr + g * k_param_->iw * k_param_->ih * gic_4 * 4;
             auto output_g_ptr = output_ptr + g * k_param_->ow * k_param_->oh * goc_4 * 4;
             auto w_g_offset   = g * goc_4 * weight_z_step;
-            OMP_PARALLEL_FOR_
-            for (int x = 0; x < x_count; x++) {
-                int thread_id = OMP_TID_;
-
-                auto work_space_t = work_space + thread_id * workspace_per_thread / sizeof(T);
-
-                int x_idx    = (int)x * CONVOLUTION_TILED_NUMBER;
-                int x_remain = k_param_->ow - x_idx;
-                int x_c      = x_remain > CONVOLUTION_TILED_NUMBER ? CONVOLUTION_TILED_NUMBER : x_remain;
-                int src_xc =
-                    1 + (x_c - 1) * conv_param->strides[0] + conv_param->dialations[0] * (conv_param->kernels[0] - 1);
-                int d_x         = x_idx;
-                int src_start_x = d_x * conv_param->strides[0] - conv_param->pads[0];
-                int src_end_x   = src_start_x + src_xc >= k_param_->iw ? k_param_->iw : src_start_x + src_xc;
-
-                int dst_offset = 0;
-                if (src_start_x < 0) {
-                    dst_offset  = -src_start_x;
-                    src_start_x = 0;
-                }
-                int copy_count = src_end_x - src_start_x;
-                auto src_x     = input_g_ptr + 4 * src_start_x;
-
-                for (int dy = 0; dy < k_param_->oh; dy++) {
-                    /*
-                    copy make board, data in workspace are dirty, should be clear first
-                    */
-                    memset(work_space_t, 0, workspace_per_thread);
-                    int src_start_y = dy * conv_param->strides[1] - conv_param->pads[2];
-                    int sfy         = MAX(0, (UP_DIV(-src_start_y, conv_param->dialations[1])));
-                    int efy =
-                        MIN(conv_param->kernels[1], UP_DIV(k_param_->ih - src_start_y, conv_param->dialations[1]));
-
-                    for (int sz = 0; sz < gic_4; sz++) {
-                        auto dst_z = work_space_t + sz * src_xc * conv_param->kernels[1] * 4;
-                        auto src_z = src_x + sz * src_z_step;
-                        for (int ky = sfy; ky < efy; ky++) {
-                            int sy     = src_start_y + ky * conv_param->dialations[1];
-                            auto src_y = src_z + 4 * sy * k_param_->iw;
-                            auto dst_y = dst_z + (ky * src_xc + dst_offset) * 4;
-                            memcpy(dst_y, src_y, copy_count * 4 * sizeof(T));
-                        }
+            OMP_PARALLEL_
+            {
+                // one worker span per thread, the iterations are not timed one by one
+                ProfilingScope scope(context_->GetProfilingRecorder(), OMP_TID_ + 1);
+                OMP_FOR_NOWAIT_
+                for (int x = 0; x < x_count; x++) {
+                    int thread_id = OMP_TID_;
+
+                    auto work_space_t = work_space + thread_id * workspace_per_thread / sizeof(T);
+
+                    int x_idx    = (int)x * CONVOLUTION_TILED_NUMBER;
+                    int x_remain = k_param_->ow - x_idx;
+                    int x_c      = x_remain > CONVOLUTION_TILED_NUMBER ? CONVOLUTION_TILED_NUMBER : x_remain;
+                    int src_xc   = 1 + (x_c - 1) * conv_param->strides[0] +
+                                 conv_param->dialations[0] * (conv_param->kernels[0] - 1);
+                    int d_x         = x_idx;
+                    int src_start_x = d_x * conv_param->strides[0] - conv_param->pads[0];
+                    int src_end_x   = src_start_x + src_xc >= k_param_->iw ? k_param_->iw : src_start_x + src_xc;
+
+                    int dst_offset = 0;
+                    if (src_start_x < 0) {
+                        dst_offset  = -src_start_x;
+                        src_start_x = 0;
                     }
+                    int copy_count = src_end_x - src_start_x;
+                    auto src_x     = input_g_ptr + 4 * src_start_x;
+
+                    for (int dy = 0; dy < k_param_->oh; dy++) {
+                        /*
+                        copy make board, data in workspace are dirty, should be clear first
+                        */
+                        memset(work_space_t, 0, workspace_per_thread);
+                        int src_start_y = dy * conv_param->strides[1] - conv_param->pads[2];
+                        int sfy         = MAX(0, (UP_DIV(-src_start_y, conv_param->dialations[1])));
+                        int efy =
+                            MIN(conv_param->kernels[1], UP_DIV(k_param_->ih - src_start_y, conv_param->dialations[1]));
+
+                        for (int sz = 0; sz < gic_4; sz++) {
+                            auto dst_z = work_space_t + sz * src_xc * conv_param->kernels[1] * 4;
+                            auto src_z = src_x + sz * src_z_step;
+                            for (int ky = sfy; ky < efy; ky++) {
+                                int sy     = src_start_y + ky * conv_param->dialations[1];
+                                auto src_y = src_z + 4 * sy * k_param_->iw;
+                                auto dst_y = dst_z + (ky * src_xc + dst_offset) * 4;
+                                memcpy(dst_y, src_y, copy_count * 4 * sizeof(T));
+                            }
+                        }
 
-                    // output: tile x oc
-                    for (int dz = 0; dz < goc_4; dz++) {
-                        auto dst_z =
-                            output_g_ptr + dz * k_param_->ow * k_param_->oh * 4 + x_idx * 4 + k_param_->ow * 4 * dy;
-                        auto weight_dz = reinterpret_cast<float *>(k_param_->fil_ptr) + w_g_offset + dz * weight_z_step;
+                        // output: tile x oc
+                        for (int dz = 0; dz < goc_4; dz++) {
+                            auto dst_z =
+                                output_g_ptr + dz * k_param_->ow * k_param_->oh * 4 + x_idx * 4 + k_param_->ow * 4 * dy;
+                            auto weight_dz =
+                                reinterpret_cast<float *>(k_param_->fil_ptr) + w_g_offset + dz * weight_z_step;
 
-                        ConvCommonO4(dst_z, work_space_t, weight_dz, x_c, conv_param->strides[0] * 4, gic_4,
-                                     src_xc * 4 * conv_param->kernels[1], conv_param->kernels[0],
-                                     conv_param->kernels[1], dilate_x_step, src_xc * 4);
+                            ConvCommonO4(dst_z, work_space_t, weight_dz, x_c, conv_param->strides[0] * 4, gic_4,
+                                         src_xc * 4 * conv_param->kernels[1], conv_param->kernels[0],
+                                         conv_param->kernels[1], dilate_x_step, src_xc * 4);
+                        }
                     }
                 }
             }
@@ -296,13 +334,12 @@ Status ArmConvLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::ve
         first unpack every group output data to get nchw data format
         pack data to make sure output tensor channel algin4 and continuously
         */
-        if (goc_4 != (goc / 4) && group != 1) {
-            RawBuffer temp_buffer(group * output_bytes_per_group);
+        if (pack_output_group) {
             for (int g = 0; g < group; g++) {
-                UnpackC4(temp_buffer.force_to<T *>() + g * k_param_->ow * k_param_->oh * goc,
+                UnpackC4(group_transform + g * k_param_->ow * k_param_->oh * goc,
                          output_ptr + g * k_param_->ow * k_param_->oh * goc_4 * 4, k_param_->ow * k_param_->oh, goc);
             }
-            PackC4(dst_origin + batch_idx * k_param_->ow * k_param_->oh * ROUND_UP(oc, 4), temp_buffer.force_to<T *>(),
+            PackC4(dst_origin + batch_idx * k_param_->ow * k_param_->oh * ROUND_UP(oc, 4), group_transform,
                    k_param_->ow * k_param_->oh, oc);
         }
     }
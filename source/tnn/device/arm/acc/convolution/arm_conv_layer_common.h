@@ -29,6 +29,18 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    // weights and bias are packed in init
+    virtual bool IsResourceReleasable();
+
+    // the packed weight and bias in the layout of the impl
+    virtual PackedWeights GetPackedWeights();
+
+    // taken in Init if they are in the layout of the impl
+    virtual Status SetPackedWeights(const PackedWeights &packed_weights);
+
+    // the layout of the weights packed by allocateBufferWeight, empty if they are not handed out
+    virtual std::string GetImplPackedLayout(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     // always true as last solution
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_depthwise.h"
+#include "tnn/core/profile.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/interpreter/raw_buffer.h"
@@ -37,6 +38,11 @@ bool ArmConvLayerDepthwise::isPrefered(ConvLayerParam *param, const std::vector<
 
 ArmConvLayerDepthwise::~ArmConvLayerDepthwise() {}
 
+std::string ArmConvLayerDepthwise::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                       const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("conv_depthwise", inputs[0]->GetBlobDesc().data_type);
+}
+
 Status ArmConvLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &inputs,
                                                    const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
@@ -95,10 +101,10 @@ template <typename T>
 Status ArmConvLayerDepthwise::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
 
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     const int batch    = dims_output[0];
     int dst_depth_quad = UP_DIV(dims_output[1], 4);
@@ -156,24 +162,30 @@ Status ArmConvLayerDepthwise::Exec(const std::vector<Blob *> &inputs, const std:
         auto src_ptr = src_origin + batch_idx * k_param_->iw * k_param_->ih * k_param_->ic_r4;
         auto dst_ptr = dst_origin + batch_idx * k_param_->ow * k_param_->oh * k_param_->oc_r4;
 
-        OMP_PARALLEL_FOR_
-        for (int dz = 0; dz < k_param_->oc_r4; dz += 4) {
-            auto *dst_z     = dst_ptr + dst_z_step * dz;
-            auto *src_z     = src_ptr + src_z_step * dz;
-            auto *weight_dz = reinterpret_cast<float *>(k_param_->fil_ptr) + dz * weight_z_step;
-            auto *bias_z    = reinterpret_cast<T *>(k_param_->bias) + dz;
-
-            RunCorner(dst_z, src_z, weight_dz, 0, 0, k_param_->ow, t);
-            RunCorner(dst_z, src_z, weight_dz, 0, b, k_param_->ow, k_param_->oh);
-            RunCorner(dst_z, src_z, weight_dz, 0, t, l, b);
-            RunCorner(dst_z, src_z, weight_dz, r, t, k_param_->ow, b);
-
-            if (r > l && b > t) {
-                dw_full(dst_z + t * k_param_->ow * 4 + l * 4,
-                        src_z + (t * param->strides[1] - param->pads[2]) * k_param_->iw * 4 +
-                            (l * param->strides[0] - param->pads[0]) * 4,
-                        weight_dz, r - l, param->strides[0] * 4, param->kernels[0], param->kernels[1], dilate_x_step,
-                        dilate_y_step, b - t, k_param_->iw * 4 * param->strides[1], k_param_->ow * 4);
+        OMP_PARALLEL_
+        {
+            // one worker span per thread, the iterations are not timed one by one
+            ProfilingScope scope(context_->GetProfilingRecorder(), OMP_TID_ + 1);
+            OMP_FOR_NOWAIT_
+            for (int dz = 0; dz < k_param_->oc_r4; dz += 4) {
+                auto *dst_z     = dst_ptr + dst_z_step * dz;
+                auto *src_z     = src_ptr + src_z_step * dz;
+                auto *weight_dz = reinterpret_cast<float *>(k_param_->fil_ptr) + dz * weight_z_step;
+                auto *bias_z    = reinterpret_cast<T *>(k_param_->bias) + dz;
+
+                RunCorner(dst_z, src_z, weight_dz, 0, 0, k_param_->ow, t);
+                RunCorner(dst_z, src_z, weight_dz, 0, b, k_param_->ow, k_param_->oh);
+                RunCorner(dst_z, src_z, weight_dz, 0, t, l, b);
+                RunCorner(dst_z, src_z, weight_dz, r, t, k_param_->ow, b);
+
+                if (r > l && b > t) {
+                    dw_full(dst_z + t * k_param_->ow * 4 + l * 4,
+                            src_z + (t * param->strides[1] - param->pads[2]) * k_param_->iw * 4 +
+                                (l * param->strides[0] - param->pads[0]) * 4,
+                            weight_dz, r - l, param->strides[0] * 4, param->kernels[0], param->kernels[1],
+                            dilate_x_step, dilate_y_step, b - t, k_param_->iw * 4 * param->strides[1],
+                            k_param_->ow * 4);
+                }
             }
         }
     }
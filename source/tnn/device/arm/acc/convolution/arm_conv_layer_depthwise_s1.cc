@@ -39,8 +39,8 @@ bool ArmConvLayerDepthwiseS1::isPrefered(ConvLayerParam *param, const std::vecto
         return false;
     }
 
-    auto dims_input          = inputs[0]->GetBlobDesc().dims;
-    auto dims_output         = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input   = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output  = outputs[0]->GetBlobDesc().dims;
     const int input_channel  = dims_input[1];
     const int output_channel = dims_output[1];
 
@@ -97,10 +97,10 @@ Status ArmConvLayerDepthwiseS1::Exec(const std::vector<Blob *> &inputs, const st
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     DataType data_type = output->GetBlobDesc().data_type;
     int data_byte_size = DataTypeUtils::GetBytesSize(data_type);
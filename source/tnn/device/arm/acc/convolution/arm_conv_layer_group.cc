@@ -14,6 +14,7 @@
 
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_group.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "tnn/interpreter/raw_buffer.h"
@@ -59,11 +60,15 @@ Status ArmConvLayerGroup::Init(Context *context, LayerParam *param, LayerResourc
     RETURN_ON_NEQ(SetSplitBlobScale(inputs[0], group_inputs_), TNN_OK);
     RETURN_ON_NEQ(SetSplitBlobScale(outputs[0], group_outputs_), TNN_OK);
 
+    RETURN_ON_NEQ(SetSplitBlobs(inputs, outputs), TNN_OK);
+
+    group_input_lists_.clear();
+    group_output_lists_.clear();
     for (int g = 0; g < group_; g++) {
-        std::vector<Blob *> local_inputs;
-        std::vector<Blob *> local_outputs;
-        local_inputs.emplace_back(group_inputs_[g].get());
-        local_outputs.emplace_back(group_outputs_[g].get());
+        group_input_lists_.push_back({group_inputs_[g].get()});
+        group_output_lists_.push_back({group_outputs_[g].get()});
+        const auto &local_inputs             = group_input_lists_[g];
+        const auto &local_outputs            = group_output_lists_[g];
         std::shared_ptr<ArmLayerAcc> tmp_acc = nullptr;
         if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
             // CreateImpInt8(local_inputs, local_outputs, group_conv_param_.get(), tmp_acc);
@@ -84,18 +89,33 @@ Status ArmConvLayerGroup::Init(Context *context, LayerParam *param, LayerResourc
 
 ArmConvLayerGroup::~ArmConvLayerGroup() {}
 
+// resource is split into group resources in init
+bool ArmConvLayerGroup::IsResourceReleasable() {
+    if (conv_acc_impls_.empty()) {
+        return false;
+    }
+    for (auto &impl : conv_acc_impls_) {
+        if (!impl->IsResourceReleasable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ArmConvLayerGroup::ReleaseResource() {
+    ArmLayerAcc::ReleaseResource();
+    for (auto &impl : conv_acc_impls_) {
+        impl->ReleaseResource();
+    }
+}
+
 Status ArmConvLayerGroup::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (conv_acc_impls_.size() == 0) {
         return Status(TNNERR_LAYER_ERR, "Error: group conv impl is nil");
     } else {
-        RETURN_ON_NEQ(SetSplitBlobDesc(inputs[0], group_inputs_), TNN_OK);
-        RETURN_ON_NEQ(SetSplitBlobDesc(outputs[0], group_outputs_), TNN_OK);
+        RETURN_ON_NEQ(SetSplitBlobs(inputs, outputs), TNN_OK);
         for (int g = 0; g < group_; g++) {
-            std::vector<Blob *> local_inputs;
-            std::vector<Blob *> local_outputs;
-            local_inputs.emplace_back(group_inputs_[g].get());
-            local_outputs.emplace_back(group_outputs_[g].get());
-            RETURN_ON_NEQ(conv_acc_impls_[g]->Reshape(local_inputs, local_outputs), TNN_OK);
+            RETURN_ON_NEQ(conv_acc_impls_[g]->Reshape(group_input_lists_[g], group_output_lists_[g]), TNN_OK);
         }
     }
 
@@ -103,27 +123,15 @@ Status ArmConvLayerGroup::Reshape(const std::vector<Blob *> &inputs, const std::
 }
 
 Status ArmConvLayerGroup::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    Status ret;
-    RawBuffer input_buf;
-    RawBuffer output_buf;
-
-    RETURN_ON_NEQ(SetSplitBlobDesc(inputs[0], group_inputs_), TNN_OK);
-    RETURN_ON_NEQ(SetSplitBlobDesc(outputs[0], group_outputs_), TNN_OK);
-    RETURN_ON_NEQ(SetSplitBlobHandle(group_inputs_, input_buf), TNN_OK);
-    RETURN_ON_NEQ(SetSplitBlobHandle(group_outputs_, output_buf), TNN_OK);
-
+    // the split blobs are bound in init and reshape
     // step 1 : split inputs to group inputs
     CopyInputSplitBlob(inputs[0]);
 
     // step 2 : group forward
     if (conv_acc_impls_.size()) {
         for (int i = 0; i < conv_acc_impls_.size(); i++) {
-            std::vector<Blob *> local_inputs;
-            std::vector<Blob *> local_outputs;
-            local_inputs.emplace_back(group_inputs_[i].get());
-            local_outputs.emplace_back(group_outputs_[i].get());
             CHECK_PARAM_NULL(conv_acc_impls_[i].get());
-            RETURN_ON_NEQ(conv_acc_impls_[i]->DoForward(local_inputs, local_outputs), TNN_OK);
+            RETURN_ON_NEQ(conv_acc_impls_[i]->DoForward(group_input_lists_[i], group_output_lists_[i]), TNN_OK);
         }
     } else {
         return Status(TNNERR_LAYER_ERR, "conv_acc_impl_ is nil");
@@ -163,24 +171,25 @@ Status ArmConvLayerGroup::SetSplitBlobDesc(Blob *blob, std::vector<std::shared_p
 }
 
 Status ArmConvLayerGroup::SetSplitBlobHandle(std::vector<std::shared_ptr<Blob>> &blobs, RawBuffer &buf) {
-    auto dims      = blobs[0]->GetBlobDesc().dims;
-    auto batch     = dims[0];
-    auto data_type = blobs[0]->GetBlobDesc().data_type;
+    const auto &dims = blobs[0]->GetBlobDesc().dims;
+    auto batch       = dims[0];
+    auto data_type   = blobs[0]->GetBlobDesc().data_type;
 
     if (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16 || data_type == DATA_TYPE_INT8) {
         auto r_split_data_count_per_batch = ROUND_UP(dims[1], 4) * dims[2] * dims[3];
         auto element_size                 = DataTypeUtils::GetBytesSize(data_type);
-        RawBuffer temp(group_ * batch * r_split_data_count_per_batch * element_size);
+        int bytes_size                    = group_ * batch * r_split_data_count_per_batch * element_size;
+        if (buf.GetBytesSize() < bytes_size) {
+            buf = RawBuffer(bytes_size);
+        }
 
         for (int g = 0; g < group_; g++) {
             BlobHandle handle;
             handle.base = reinterpret_cast<void *>(
-                (temp.force_to<char *>() + g * r_split_data_count_per_batch * batch * element_size));
+                (buf.force_to<char *>() + g * r_split_data_count_per_batch * batch * element_size));
             handle.bytes_offset = 0;
             blobs[g].get()->SetHandle(handle);
         }
-
-        buf = temp;
     } else {
         return Status(TNNERR_LAYER_ERR, "split int8 resource not supported");
     }
@@ -188,6 +197,27 @@ Status ArmConvLayerGroup::SetSplitBlobHandle(std::vector<std::shared_ptr<Blob>>
     return TNN_OK;
 }
 
+Status ArmConvLayerGroup::SetSplitBlobs(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(SetSplitBlobDesc(inputs[0], group_inputs_), TNN_OK);
+    RETURN_ON_NEQ(SetSplitBlobDesc(outputs[0], group_outputs_), TNN_OK);
+    RETURN_ON_NEQ(SetSplitBlobHandle(group_inputs_, group_input_buf_), TNN_OK);
+    RETURN_ON_NEQ(SetSplitBlobHandle(group_outputs_, group_output_buf_), TNN_OK);
+
+    // one batch of the input or the output unpacked by TransformInput and TransformOutput
+    int transform_bytes_size = 0;
+    for (auto blob : {inputs[0], outputs[0]}) {
+        const auto &dims = blob->GetBlobDesc().dims;
+        int bytes_size   = group_ * ROUND_UP(dims[1] / group_, 4) * dims[2] * dims[3] *
+                         DataTypeUtils::GetBytesSize(blob->GetBlobDesc().data_type);
+        transform_bytes_size = std::max(transform_bytes_size, bytes_size);
+    }
+    if (transform_buf_.GetBytesSize() < transform_bytes_size) {
+        transform_buf_ = RawBuffer(transform_bytes_size);
+    }
+
+    return TNN_OK;
+}
+
 Status ArmConvLayerGroup::SetSplitBlobScale(Blob *blob, std::vector<std::shared_ptr<Blob>> &blobs) {
     auto data_type = blob->GetBlobDesc().data_type;
 
@@ -237,9 +267,9 @@ Status ArmConvLayerGroup::SetSplitBlobScale(Blob *blob, std::vector<std::shared_
 
 template <typename T>
 void ArmConvLayerGroup::TransformInput(Blob *input) {
-    auto dims       = input->GetBlobDesc().dims;
-    auto group_dims = group_inputs_[0]->GetBlobDesc().dims;
-    auto batch      = dims[0];
+    const auto &dims       = input->GetBlobDesc().dims;
+    const auto &group_dims = group_inputs_[0]->GetBlobDesc().dims;
+    auto batch             = dims[0];
 
     auto r_split_data_count_per_batch = ROUND_UP(dims[1] / group_, 4) * dims[2] * dims[3];
     auto r_ori_data_count_per_batch   = ROUND_UP(dims[1], 4) * dims[2] * dims[3];
@@ -248,12 +278,12 @@ void ArmConvLayerGroup::TransformInput(Blob *input) {
 
     for (int b = 0; b < batch; b++) {
         auto input_ptr = input_origin + b * r_ori_data_count_per_batch;
-        RawBuffer temp(group_ * r_split_data_count_per_batch * sizeof(T));
-        UnpackC4(temp.force_to<T *>(), input_ptr, dims[2] * dims[3], dims[1]);
+        auto temp = transform_buf_.force_to<T *>();
+        UnpackC4(temp, input_ptr, dims[2] * dims[3], dims[1]);
         for (int g = 0; g < group_; g++) {
             auto group_input_ptr = reinterpret_cast<T *>(GetBlobHandlePtr(group_inputs_[g]->GetHandle()));
             PackC4(group_input_ptr + b * r_split_data_count_per_batch,
-                   temp.force_to<T *>() + g * DimsVectorUtils::Count(group_dims, 1, 4),
+                   temp + g * DimsVectorUtils::Count(group_dims, 1, 4),
                    DimsVectorUtils::Count(group_dims, 2, 4), group_dims[1]);
         }
     }
@@ -269,9 +299,9 @@ template <>
 void ArmConvLayerGroup::TransformInput<int8_t>(Blob *input) {
     auto input_int8 = reinterpret_cast<BlobInt8 *>(input);
 
-    auto dims       = input_int8->GetBlobDesc().dims;
-    auto group_dims = group_inputs_[0]->GetBlobDesc().dims;
-    auto batch      = dims[0];
+    const auto &dims       = input_int8->GetBlobDesc().dims;
+    const auto &group_dims = group_inputs_[0]->GetBlobDesc().dims;
+    auto batch             = dims[0];
 
     auto src_stride   = ROUND_UP(dims[1], 4);
     auto dst_stride   = ROUND_UP(group_dims[1], 4);
@@ -305,9 +335,9 @@ float and bfp16 layout: NC4HW4
 */
 template <typename T>
 void ArmConvLayerGroup::TransformOutput(Blob *output) {
-    auto dims       = output->GetBlobDesc().dims;
-    auto group_dims = group_outputs_[0]->GetBlobDesc().dims;
-    auto batch      = dims[0];
+    const auto &dims       = output->GetBlobDesc().dims;
+    const auto &group_dims = group_outputs_[0]->GetBlobDesc().dims;
+    auto batch             = dims[0];
 
     auto r_split_data_count_per_batch = ROUND_UP(dims[1] / group_, 4) * dims[2] * dims[3];
     auto r_ori_data_count_per_batch   = ROUND_UP(dims[1], 4) * dims[2] * dims[3];
@@ -316,14 +346,14 @@ void ArmConvLayerGroup::TransformOutput(Blob *output) {
 
     for (int b = 0; b < batch; b++) {
         auto output_ptr = output_origin + b * r_ori_data_count_per_batch;
-        RawBuffer temp(group_ * r_split_data_count_per_batch * sizeof(T));
+        auto temp = transform_buf_.force_to<T *>();
         for (int g = 0; g < group_; g++) {
             auto group_output_ptr = reinterpret_cast<T *>(GetBlobHandlePtr(group_outputs_[g]->GetHandle()));
-            UnpackC4(temp.force_to<T *>() + g * DimsVectorUtils::Count(group_dims, 1, 4),
+            UnpackC4(temp + g * DimsVectorUtils::Count(group_dims, 1, 4),
                      group_output_ptr + b * r_split_data_count_per_batch, DimsVectorUtils::Count(group_dims, 2, 4),
                      group_dims[1]);
         }
-        PackC4(output_ptr, temp.force_to<T *>(), dims[2] * dims[3], dims[1]);
+        PackC4(output_ptr, temp, dims[2] * dims[3], dims[1]);
     }
 }
 
@@ -334,9 +364,9 @@ template <>
 void ArmConvLayerGroup::TransformOutput<int8_t>(Blob *output) {
     auto output_int8 = reinterpret_cast<BlobInt8 *>(output);
 
-    auto dims       = output_int8->GetBlobDesc().dims;
-    auto group_dims = group_inputs_[0]->GetBlobDesc().dims;
-    auto batch      = dims[0];
+    const auto &dims       = output_int8->GetBlobDesc().dims;
+    const auto &group_dims = group_inputs_[0]->GetBlobDesc().dims;
+    auto batch             = dims[0];
 
     auto src_stride    = ROUND_UP(group_dims[1], 4);
     auto dst_stride    = ROUND_UP(dims[1], 4);
@@ -32,6 +32,10 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual bool IsResourceReleasable();
+
+    virtual void ReleaseResource();
+
 private:
     Status SetGroupParam(std::shared_ptr<LayerParam> &group_param);
 
@@ -39,6 +43,7 @@ private:
 
     Status SetSplitBlobDesc(Blob *blob, std::vector<std::shared_ptr<Blob>> &blobs);
     Status SetSplitBlobHandle(std::vector<std::shared_ptr<Blob>> &blobs, RawBuffer &buf);
+    Status SetSplitBlobs(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     Status SetSplitBlobScale(Blob *blob, std::vector<std::shared_ptr<Blob>> &blobs);
 
     Status CopyInputSplitBlob(Blob *input);
@@ -53,6 +58,14 @@ private:
     std::vector<std::shared_ptr<ArmLayerAcc>> conv_acc_impls_;
     std::vector<std::shared_ptr<Blob>> group_inputs_;
     std::vector<std::shared_ptr<Blob>> group_outputs_;
+    // the blob lists passed to each impl, built once in init
+    std::vector<std::vector<Blob *>> group_input_lists_;
+    std::vector<std::vector<Blob *>> group_output_lists_;
+
+    // memory of the split blobs and of the channel transform, they only grow in reshape
+    RawBuffer group_input_buf_;
+    RawBuffer group_output_buf_;
+    RawBuffer transform_buf_;
 
     std::shared_ptr<LayerParam> group_conv_param_ = nullptr;
     std::vector<std::shared_ptr<IntScaleResource>> group_scale_res_;
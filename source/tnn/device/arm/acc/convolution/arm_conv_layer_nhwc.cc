@@ -0,0 +1,304 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/arm/acc/convolution/arm_conv_layer_nhwc.h"
+
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+bool ArmConvLayerNhwc::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                  const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+    auto &input_desc  = inputs[0]->GetBlobDesc();
+    auto &output_desc = outputs[0]->GetBlobDesc();
+    if (input_desc.data_type != DATA_TYPE_FLOAT) {
+        return false;
+    }
+    return input_desc.data_format == DATA_FORMAT_NHWC || output_desc.data_format == DATA_FORMAT_NHWC;
+}
+
+ArmConvLayerNhwc::~ArmConvLayerNhwc() {}
+
+bool ArmConvLayerNhwc::IsResourceReleasable() {
+    return true;
+}
+
+Status ArmConvLayerNhwc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                              const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+
+    auto input_channel  = inputs[0]->GetBlobDesc().dims[1];
+    auto output_channel = outputs[0]->GetBlobDesc().dims[1];
+    depthwise_ = conv_param->group == input_channel && conv_param->group == output_channel;
+
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+
+    return TNN_OK;
+}
+
+/*
+depthwise weights are packed as [kh][kw][c_r4],
+other weights are packed as [group][kh][kw][gic][goc_r4] so that output channels can be vectorized
+*/
+Status ArmConvLayerNhwc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const int kw     = conv_param->kernels[0];
+        const int kh     = conv_param->kernels[1];
+        const int group  = conv_param->group;
+        const int ic     = inputs[0]->GetBlobDesc().dims[1];
+        const int oc     = outputs[0]->GetBlobDesc().dims[1];
+        const int gic    = ic / group;
+        const int goc    = oc / group;
+        const int goc_r4 = ROUND_UP(goc, 4);
+        const float *src = conv_res->filter_handle.force_to<float *>();
+
+        if (depthwise_) {
+            const int c_r4 = ROUND_UP(oc, 4);
+            RawBuffer temp_buffer(kh * kw * c_r4 * sizeof(float));
+            float *dst = temp_buffer.force_to<float *>();
+            for (int c = 0; c < oc; c++) {
+                for (int k = 0; k < kh * kw; k++) {
+                    dst[k * c_r4 + c] = src[c * kh * kw + k];
+                }
+            }
+            buffer_weight_ = temp_buffer;
+        } else {
+            RawBuffer temp_buffer(group * kh * kw * gic * goc_r4 * sizeof(float));
+            float *dst = temp_buffer.force_to<float *>();
+            for (int g = 0; g < group; g++) {
+                for (int o = 0; o < goc; o++) {
+                    for (int i = 0; i < gic; i++) {
+                        for (int k = 0; k < kh * kw; k++) {
+                            int src_idx  = ((g * goc + o) * gic + i) * kh * kw + k;
+                            int dst_idx  = (((g * kh * kw) + k) * gic + i) * goc_r4 + o;
+                            dst[dst_idx] = src[src_idx];
+                        }
+                    }
+                }
+            }
+            buffer_weight_ = temp_buffer;
+        }
+    }
+    return TNN_OK;
+}
+
+Status ArmConvLayerNhwc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_bias_.GetBytesSize()) {
+        const int oc   = outputs[0]->GetBlobDesc().dims[1];
+        const int goc  = depthwise_ ? oc : oc / conv_param->group;
+        const int gnum = depthwise_ ? 1 : conv_param->group;
+        // bias of each group is padded to 4
+        const int goc_r4 = ROUND_UP(goc, 4);
+        RawBuffer temp_buffer(gnum * goc_r4 * sizeof(float));
+        if (conv_param->bias) {
+            const float *src = conv_res->bias_handle.force_to<float *>();
+            float *dst       = temp_buffer.force_to<float *>();
+            for (int g = 0; g < gnum; g++) {
+                memcpy(dst + g * goc_r4, src + g * goc, goc * sizeof(float));
+            }
+        }
+        buffer_bias_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+static inline void ValidKernelRange(int origin, int kernel, int dilate, int size, int &ks, int &ke) {
+    ks = origin < 0 ? UP_DIV(-origin, dilate) : 0;
+    ke = size - origin > 0 ? MIN(kernel, UP_DIV(size - origin, dilate)) : 0;
+}
+
+static inline Float4 Activate(Float4 v, int activation_type) {
+    if (activation_type == ActivationType_ReLU) {
+        return Float4::max(v, Float4(0.f));
+    } else if (activation_type == ActivationType_ReLU6) {
+        return Float4::min(Float4::max(v, Float4(0.f)), Float4(6.f));
+    }
+    return v;
+}
+
+// stores at most four values, nhwc blobs are not padded on channel
+static inline void SaveTail(float *dst, const Float4 &v, int count) {
+    if (count >= 4) {
+        Float4::save(dst, v);
+    } else {
+        float buffer[4];
+        Float4::save(buffer, v);
+        for (int i = 0; i < count; i++) {
+            dst[i] = buffer[i];
+        }
+    }
+}
+
+void ArmConvLayerNhwc::ConvGroup(float *dst, const float *src, int ic, int oc) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+
+    const int kw = conv_param->kernels[0], kh = conv_param->kernels[1];
+    const int sw = conv_param->strides[0], sh = conv_param->strides[1];
+    const int pw = conv_param->pads[0], ph = conv_param->pads[2];
+    const int dw = conv_param->dialations[0], dh = conv_param->dialations[1];
+    const int iw = k_param_->iw, ih = k_param_->ih;
+    const int ow = k_param_->ow, oh = k_param_->oh;
+
+    const int group  = conv_param->group;
+    const int gic    = ic / group;
+    const int goc    = oc / group;
+    const int goc_r4 = ROUND_UP(goc, 4);
+    const int act    = conv_param->activation_type;
+
+    const float *weight = buffer_weight_.force_to<float *>();
+    const float *bias   = buffer_bias_.force_to<float *>();
+
+    OMP_PARALLEL_FOR_
+    for (int oy = 0; oy < oh; oy++) {
+        const int sy = oy * sh - ph;
+        int kys, kye;
+        ValidKernelRange(sy, kh, dh, ih, kys, kye);
+        for (int ox = 0; ox < ow; ox++) {
+            const int sx = ox * sw - pw;
+            int kxs, kxe;
+            ValidKernelRange(sx, kw, dw, iw, kxs, kxe);
+            auto dst_x = dst + (oy * ow + ox) * oc;
+            for (int g = 0; g < group; g++) {
+                for (int oz = 0; oz < goc; oz += 4) {
+                    Float4 acc = Float4::load(bias + g * goc_r4 + oz);
+                    for (int ky = kys; ky < kye; ky++) {
+                        for (int kx = kxs; kx < kxe; kx++) {
+                            auto src_k = src + ((sy + ky * dh) * iw + sx + kx * dw) * ic + g * gic;
+                            auto w_k   = weight + ((g * kh + ky) * kw + kx) * gic * goc_r4 + oz;
+                            for (int ci = 0; ci < gic; ci++) {
+                                Float4::mla(acc, Float4(src_k[ci]), Float4::load(w_k + ci * goc_r4));
+                            }
+                        }
+                    }
+                    SaveTail(dst_x + g * goc + oz, Activate(acc, act), goc - oz);
+                }
+            }
+        }
+    }
+}
+
+void ArmConvLayerNhwc::ConvDepthwise(float *dst, const float *src, int channel) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+
+    const int kw = conv_param->kernels[0], kh = conv_param->kernels[1];
+    const int sw = conv_param->strides[0], sh = conv_param->strides[1];
+    const int pw = conv_param->pads[0], ph = conv_param->pads[2];
+    const int dw = conv_param->dialations[0], dh = conv_param->dialations[1];
+    const int iw = k_param_->iw, ih = k_param_->ih;
+    const int ow = k_param_->ow, oh = k_param_->oh;
+
+    const int c_r4 = ROUND_UP(channel, 4);
+    const int act  = conv_param->activation_type;
+
+    const float *weight = buffer_weight_.force_to<float *>();
+    const float *bias   = buffer_bias_.force_to<float *>();
+
+    OMP_PARALLEL_FOR_
+    for (int oy = 0; oy < oh; oy++) {
+        const int sy = oy * sh - ph;
+        int kys, kye;
+        ValidKernelRange(sy, kh, dh, ih, kys, kye);
+        for (int ox = 0; ox < ow; ox++) {
+            const int sx = ox * sw - pw;
+            int kxs, kxe;
+            ValidKernelRange(sx, kw, dw, iw, kxs, kxe);
+            auto dst_x = dst + (oy * ow + ox) * channel;
+            for (int c = 0; c < channel; c += 4) {
+                Float4 acc = Float4::load(bias + c);
+                for (int ky = kys; ky < kye; ky++) {
+                    for (int kx = kxs; kx < kxe; kx++) {
+                        auto src_k = src + ((sy + ky * dh) * iw + sx + kx * dw) * channel + c;
+                        auto w_k   = weight + (ky * kw + kx) * c_r4 + c;
+                        // lanes past the channel read the next pixel, their weights are zero
+                        Float4::mla(acc, Float4::load(src_k), Float4::load(w_k));
+                    }
+                }
+                SaveTail(dst_x + c, Activate(acc, act), channel - c);
+            }
+        }
+    }
+}
+
+Status ArmConvLayerNhwc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto input  = inputs[0];
+    auto output = outputs[0];
+
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
+    const int batch         = dims_output[0];
+    const int ic            = dims_input[1];
+    const int oc            = dims_output[1];
+    const int src_hw        = dims_input[2] * dims_input[3];
+    const int dst_hw        = dims_output[2] * dims_output[3];
+
+    bool src_nhwc = input->GetBlobDesc().data_format == DATA_FORMAT_NHWC;
+    bool dst_nhwc = output->GetBlobDesc().data_format == DATA_FORMAT_NHWC;
+
+    auto input_ptr  = reinterpret_cast<float *>(GetBlobHandlePtr(input->GetHandle()));
+    auto output_ptr = reinterpret_cast<float *>(GetBlobHandlePtr(output->GetHandle()));
+
+    // nc4hw4 blobs are converted per batch in the workspace
+    int src_size    = src_nhwc ? 0 : ROUND_UP(src_hw * ic, 4);
+    int dst_size    = dst_nhwc ? 0 : ROUND_UP(dst_hw * oc, 4);
+    float *workspace = nullptr;
+    if (src_size + dst_size > 0) {
+        workspace = reinterpret_cast<float *>(
+            context_->GetSharedWorkSpace((src_size + dst_size) * sizeof(float) + NEON_KERNEL_EXTRA_LOAD));
+    }
+
+    for (int n = 0; n < batch; n++) {
+        const float *src = nullptr;
+        float *dst       = nullptr;
+        if (src_nhwc) {
+            src = input_ptr + n * src_hw * ic;
+        } else {
+            UnpackC4ToNHWC(workspace, input_ptr + n * src_hw * ROUND_UP(ic, 4), src_hw, ic);
+            src = workspace;
+        }
+        dst = dst_nhwc ? output_ptr + n * dst_hw * oc : workspace + src_size;
+
+        if (depthwise_) {
+            ConvDepthwise(dst, src, oc);
+        } else {
+            ConvGroup(dst, src, ic, oc);
+        }
+
+        if (!dst_nhwc) {
+            PackC4FromNHWC(output_ptr + n * dst_hw * ROUND_UP(oc, 4), dst, dst_hw, oc);
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,58 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_NHWC_H_
+#define TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_NHWC_H_
+
+#include "tnn/device/arm/acc/arm_layer_acc.h"
+
+namespace TNN_NS {
+
+/*
+fp32 direct conv for nhwc blobs, used for low channel layers where nc4hw4 padding wastes most of the work.
+input and output may be nhwc or nc4hw4 independently, so the conv can also serve as the layout boundary.
+*/
+class ArmConvLayerNhwc : public ArmLayerAcc {
+public:
+    virtual ~ArmConvLayerNhwc();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs);
+
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // weights and bias are packed in init
+    virtual bool IsResourceReleasable();
+
+    // fp32 only, input or output blob is nhwc
+    static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                           const std::vector<Blob *> &outputs);
+
+private:
+    Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    void ConvGroup(float *dst, const float *src, int ic, int oc);
+
+    void ConvDepthwise(float *dst, const float *src, int channel);
+
+    RawBuffer buffer_weight_;
+    RawBuffer buffer_bias_;
+    bool depthwise_ = false;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_CONV_LAYER_NHWC_H_
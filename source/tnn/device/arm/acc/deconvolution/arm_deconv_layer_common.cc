@@ -39,6 +39,11 @@ bool ArmDeconvLayerCommon::isPrefered(ConvLayerParam *param, const std::vector<B
 
 ArmDeconvLayerCommon::~ArmDeconvLayerCommon() {}
 
+std::string ArmDeconvLayerCommon::GetImplPackedLayout(const std::vector<Blob *> &inputs,
+                                                      const std::vector<Blob *> &outputs) {
+    return GetPackedLayout("deconv_common", inputs[0]->GetBlobDesc().data_type);
+}
+
 Status ArmDeconvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &inputs,
                                                   const std::vector<Blob *> &outputs) {
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
@@ -98,10 +103,10 @@ Status ArmDeconvLayerCommon::Exec(const std::vector<Blob *> &inputs, const std::
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto input       = inputs[0];
-    auto output      = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto input              = inputs[0];
+    auto output             = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     DataType data_type       = output->GetBlobDesc().data_type;
     const int data_byte_size = 4;
@@ -26,8 +26,8 @@ bool ArmDeconvLayerDepthwise::isPrefered(ConvLayerParam *param, const std::vecto
         return false;
     }
 
-    auto dims_input          = inputs[0]->GetBlobDesc().dims;
-    auto dims_output         = outputs[0]->GetBlobDesc().dims;
+    const auto &dims_input   = inputs[0]->GetBlobDesc().dims;
+    const auto &dims_output  = outputs[0]->GetBlobDesc().dims;
     const int input_channel  = dims_input[1];
     const int output_channel = dims_output[1];
 
@@ -50,10 +50,10 @@ Status ArmDeconvLayerDepthwise::Exec(const std::vector<Blob *> &inputs, const st
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
-    auto output      = inputs[0];
-    auto input       = outputs[0];
-    auto dims_input  = input->GetBlobDesc().dims;
-    auto dims_output = output->GetBlobDesc().dims;
+    auto output             = inputs[0];
+    auto input              = outputs[0];
+    const auto &dims_input  = input->GetBlobDesc().dims;
+    const auto &dims_output = output->GetBlobDesc().dims;
 
     const int batch    = dims_output[0];
     int src_width      = dims_input[3];
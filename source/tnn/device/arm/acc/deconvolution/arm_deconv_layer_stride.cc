@@ -174,8 +174,8 @@ Status ArmDeconvLayerStride::SetSplitBlobHandle(Blob *blob, RawBuffer &buf) {
     auto element_size = DataTypeUtils::GetBytesSize(data_type);
 
     for (auto &unit : conv_units_) {
-        auto dims       = unit.blob->GetBlobDesc().dims;
-        auto data_count = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
+        const auto &dims = unit.blob->GetBlobDesc().dims;
+        auto data_count  = dims[0] * ROUND_UP(dims[1], 4) * dims[2] * dims[3];
         total_count += data_count;
         blob_data_offset.push_back(offset);
         offset += data_count;
@@ -197,7 +197,7 @@ Status ArmDeconvLayerStride::SetSplitBlobHandle(Blob *blob, RawBuffer &buf) {
 template <typename T>
 void ArmDeconvLayerStride::CopyWithStride(ConvUnit &unit, Blob *output) {
     auto param                = reinterpret_cast<ConvLayerParam *>(param_);
-    auto dims                 = output->GetBlobDesc().dims;
+    const auto &dims          = output->GetBlobDesc().dims;
     auto pad_y                = param->pads[2];
     auto pad_x                = param->pads[0];
     auto stride_y             = param->strides[1];
@@ -206,7 +206,7 @@ void ArmDeconvLayerStride::CopyWithStride(ConvUnit &unit, Blob *output) {
     auto oh                   = dims[2];
     auto ow                   = dims[3];
     auto output_origin        = reinterpret_cast<T *>(GetBlobHandlePtr(output->GetHandle()));
-    auto stride_dims          = unit.blob->GetBlobDesc().dims;
+    const auto &stride_dims   = unit.blob->GetBlobDesc().dims;
     auto stride_oh            = stride_dims[2];
     auto stride_ow            = stride_dims[3];
     auto stride_output_origin = reinterpret_cast<T *>(GetBlobHandlePtr(unit.blob->GetHandle()));
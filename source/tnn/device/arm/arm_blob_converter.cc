@@ -880,7 +880,7 @@ Status ArmBlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param,
     }
     auto desc       = blob_->GetBlobDesc();
     auto dims       = desc.dims;
-    auto hw         = dims[2] * dims[3];
+    auto hw         = DimsVectorUtils::Count(dims, 2);
     auto c_r4       = ROUND_UP(dims[1], 4);
     auto handle_ptr = GetBlobHandlePtr(blob_->GetHandle());
     if (desc.data_type == DATA_TYPE_INT8) {
@@ -953,7 +953,7 @@ Status ArmBlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam para
     }
     auto desc       = blob_->GetBlobDesc();
     auto dims       = desc.dims;
-    auto hw         = dims[2] * dims[3];
+    auto hw         = DimsVectorUtils::Count(dims, 2);
     auto handle_ptr = GetBlobHandlePtr(blob_->GetHandle());
     auto c_r4       = ROUND_UP(dims[1], 4);
     if (desc.data_type == DATA_TYPE_INT8) {
@@ -15,6 +15,7 @@
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/numa_utils.h"
 #include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
@@ -29,6 +30,9 @@ Status ArmContext::GetCommandQueue(void** command_queue) {
 
 Status ArmContext::OnInstanceForwardBegin() {
     Context::OnInstanceForwardBegin();
+    if (!numa_cpu_mask_.empty()) {
+        RETURN_ON_NEQ(NumaUtils::PinThreads(numa_cpu_mask_, GetNumThreads()), TNN_OK);
+    }
     OMP_SET_THREADS_(GetNumThreads());
     return TNN_OK;
 }
@@ -16,27 +16,16 @@
 
 #include <stdlib.h>
 
+#include "tnn/device/arm/acc/arm_layer_acc.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/device/arm/arm_context.h"
+#include "tnn/memory_manager/memory_allocator.h"
 #include "tnn/utils/blob_memory_size_utils.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
-static inline void *armMalloc(size_t size) {
-#if _POSIX_C_SOURCE >= 200112L || (__ANDROID__ && __ANDROID_API__ >= 17)
-    void *ptr = 0;
-    if (posix_memalign(&ptr, 32, size))
-        ptr = 0;
-    return ptr;
-#elif __ANDROID__ && __ANDROID_API__ < 17
-    return memalign(32, size);
-#else
-    return malloc(size);
-#endif
-}
-
 ArmDevice::ArmDevice(DeviceType device_type) : AbstractDevice(device_type) {}
 
 ArmDevice::~ArmDevice() {}
@@ -44,7 +33,14 @@ ArmDevice::~ArmDevice() {}
 BlobMemorySizeInfo ArmDevice::Calculate1DMemorySize(BlobDesc &desc) {
     BlobMemorySizeInfo info;
     info.data_type = desc.data_type;
-    int count      = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * desc.dims[2] * desc.dims[3];
+    int count      = 0;
+    if (desc.data_format == DATA_FORMAT_NHWC) {
+        // nhwc blobs are not padded on channel
+        count = DimsVectorUtils::Count(desc.dims);
+    } else {
+        // 5 dims blobs pack the channels the same way in front of the depth, height and width
+        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * DimsVectorUtils::Count(desc.dims, 2);
+    }
     info.dims.push_back(count);
     return info;
 }
@@ -70,16 +66,29 @@ Status ArmDevice::Allocate(void **handle, MatType mat_type, DimsVector dims) {
 Status ArmDevice::Allocate(void **handle, BlobMemorySizeInfo &size_info) {
     if (handle) {
         int bytes_size = GetBlobMemoryBytesSize(size_info);
-        *handle        = armMalloc(bytes_size + NEON_KERNEL_EXTRA_LOAD);
+        // memory allocated while an instance of a numa node is initialized is bound to the node by the allocator
+        RETURN_ON_NEQ(MemoryAllocator::GetHostAllocator()->Allocate(handle, bytes_size + NEON_KERNEL_EXTRA_LOAD),
+                      TNN_OK);
     }
     return TNN_OK;
 }
 
-Status ArmDevice::Free(void *handle) {
-    if (handle) {
-        free(handle);
+/*
+ * External memory must satisfy the same constraints as Allocate: 32 bytes
+ * aligned, with NEON_KERNEL_EXTRA_LOAD bytes readable past the blob data.
+ */
+Status ArmDevice::CheckExternalMemory(BlobDesc &desc, void *handle, int bytes_size) {
+    if (desc.data_format != DATA_FORMAT_NC4HW4 && desc.data_format != DATA_FORMAT_NHWC4) {
+        return Status(TNNERR_INVALID_EXTERNAL_MEMORY, "arm external memory only supports NC4HW4 and NHWC4 blob");
     }
-    return TNN_OK;
+    if (((uintptr_t)handle) % 32 != 0) {
+        return Status(TNNERR_INVALID_EXTERNAL_MEMORY, "arm external memory must be 32 bytes aligned");
+    }
+    return AbstractDevice::CheckExternalMemory(desc, handle, bytes_size - NEON_KERNEL_EXTRA_LOAD);
+}
+
+Status ArmDevice::Free(void *handle) {
+    return MemoryAllocator::FreeHostMemory(handle);
 }
 
 Status ArmDevice::CopyToDevice(BlobHandle *dst, const BlobHandle *src, BlobDesc &desc, void *command_queue) {
@@ -103,7 +112,12 @@ Status ArmDevice::CopyFromDevice(BlobHandle *dst, const BlobHandle *src, BlobDes
 AbstractLayerAcc *ArmDevice::CreateLayerAcc(LayerType type) {
     auto &layer_creator_map = GetLayerCreatorMap();
     if (layer_creator_map.count(type) > 0) {
-        return layer_creator_map[type]->CreateLayerAcc(type);
+        auto layer_acc = layer_creator_map[type]->CreateLayerAcc(type);
+        auto arm_acc   = dynamic_cast<ArmLayerAcc *>(layer_acc);
+        if (arm_acc) {
+            arm_acc->SetImplementedLayout(GetImplementedLayout(type));
+        }
+        return layer_acc;
     }
     return NULL;
 }
@@ -116,6 +130,18 @@ std::shared_ptr<const ImplementedPrecision> ArmDevice::GetImplementedPrecision(L
     return std::make_shared<ImplementedPrecision>();
 }
 
+std::shared_ptr<const ImplementedLayout> ArmDevice::GetImplementedLayout(LayerType type) {
+    auto &layer_layout_map = GetLayerLayoutMap();
+    if (layer_layout_map.count(type) > 0) {
+        return layer_layout_map[type];
+    }
+    return std::make_shared<ImplementedLayout>();
+}
+
+bool ArmDevice::IsLayerAccImplemented(LayerType type) {
+    return GetLayerCreatorMap().count(type) > 0;
+}
+
 Context *ArmDevice::CreateContext(int device_id) {
     return new ArmContext();
 }
@@ -140,6 +166,20 @@ std::map<LayerType, std::shared_ptr<ImplementedPrecision>> &ArmDevice::GetLayerP
     return layer_precision_map;
 };
 
+Status ArmDevice::RegisterLayerLayout(LayerType type, DataFormat layout) {
+    auto &layer_layout_map = GetLayerLayoutMap();
+    if (layer_layout_map.count(type) == 0) {
+        layer_layout_map[type] = std::make_shared<ImplementedLayout>();
+    }
+    layer_layout_map[type]->layouts.push_back(layout);
+    return TNN_OK;
+}
+
+std::map<LayerType, std::shared_ptr<ImplementedLayout>> &ArmDevice::GetLayerLayoutMap() {
+    static std::map<LayerType, std::shared_ptr<ImplementedLayout>> layer_layout_map;
+    return layer_layout_map;
+}
+
 TypeDeviceRegister<ArmDevice> g_arm_device_register(DEVICE_ARM);
 
 }  // namespace TNN_NS
@@ -33,6 +33,8 @@ public:
 
     virtual Status Allocate(void** handle, MatType mat_type, DimsVector dims);
 
+    virtual Status CheckExternalMemory(BlobDesc& desc, void* handle, int bytes_size);
+
     virtual Status Free(void* handle);
 
     virtual Status CopyToDevice(BlobHandle* dst, const BlobHandle* src, BlobDesc& desc, void* command_queue);
@@ -41,18 +43,25 @@ public:
 
     virtual AbstractLayerAcc* CreateLayerAcc(LayerType type);
 
+    virtual bool IsLayerAccImplemented(LayerType type);
+
     virtual Context* CreateContext(int device_id);
 
     virtual std::shared_ptr<const ImplementedPrecision> GetImplementedPrecision(LayerType type);
 
+    virtual std::shared_ptr<const ImplementedLayout> GetImplementedLayout(LayerType type);
+
     static Status RegisterLayerAccCreator(LayerType type, LayerAccCreator* creator);
 
     static Status RegisterLayerPrecision(LayerType type, std::shared_ptr<ImplementedPrecision> precision);
 
+    static Status RegisterLayerLayout(LayerType type, DataFormat layout);
+
 private:
     BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc);
     static std::map<LayerType, std::shared_ptr<LayerAccCreator>>& GetLayerCreatorMap();
     static std::map<LayerType, std::shared_ptr<ImplementedPrecision>>& GetLayerPrecisionMap();
+    static std::map<LayerType, std::shared_ptr<ImplementedLayout>>& GetLayerLayoutMap();
 };
 
 //@brief ArmTypeLayerAccRegister register ArmTypeLayerAccCreator
@@ -71,6 +80,13 @@ public:
     }
 };
 
+class ArmTypeLayerLayoutRegister {
+public:
+    explicit ArmTypeLayerLayoutRegister(LayerType type, DataFormat layout) {
+        ArmDevice::RegisterLayerLayout(type, layout);
+    }
+};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_DEVICE_ARM_ARM_DEVICE_FACTORY_H_
@@ -23,6 +23,8 @@
 #include "tnn/core/macro.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
@@ -150,6 +152,17 @@ char* GetBlobHandlePtr(BlobHandle handle) {
     return reinterpret_cast<char *>(handle.base) + handle.bytes_offset; 
 }
 
+bool IsBlobChannelView(Blob *blob, Blob *parent, int channel_offset) {
+    auto &desc = parent->GetBlobDesc();
+    if (desc.dims.size() < 2 || desc.dims[0] != 1 || desc.data_format != DATA_FORMAT_NC4HW4 ||
+        blob->GetBlobDesc().data_format != DATA_FORMAT_NC4HW4 || channel_offset % 4 != 0) {
+        return false;
+    }
+    int bytes_offset =
+        channel_offset * DimsVectorUtils::Count(desc.dims, 2) * DataTypeUtils::GetBytesSize(desc.data_type);
+    return GetBlobHandlePtr(blob->GetHandle()) == GetBlobHandlePtr(parent->GetHandle()) + bytes_offset;
+}
+
 template <typename Tin, typename Tout>
 int PackC4(Tout *dst, const Tin *src, size_t hw, size_t channel) {
 #ifdef TNN_USE_NEON
@@ -180,6 +193,7 @@ template int PackC4(float *dst, const float *src, size_t hw, size_t channel);
 template int PackC4(bfp16_t *dst, const float *src, size_t hw, size_t channel);
 template int PackC4(float *dst, const bfp16_t *src, size_t hw, size_t channel);
 template int PackC4(bfp16_t *dst, const bfp16_t *src, size_t hw, size_t channel);
+template int PackC4(int8_t *dst, const int8_t *src, size_t hw, size_t channel);
 
 template <typename Tin, typename Tout>
 int PackC4FromNHWC(Tout *dst, const Tin *src, size_t hw, size_t channel) {
@@ -17,33 +17,18 @@
 
 #include <string.h>
 #include <cstdlib>
-#include <sys/time.h>
 
 #include "tnn/core/blob.h"
 #include "tnn/core/macro.h"
 #include "tnn/utils/bfp16.h"
 
 namespace TNN_NS {
-#if TNN_PROFILE
-struct Timer {
-public:
-    void Start() {
-        gettimeofday(&start, NULL);
-    }
-    float TimeEclapsed() {
-        struct timeval end;
-        gettimeofday(&end, NULL);
-        float delta = (end.tv_sec - start.tv_sec) * 1000.f + (end.tv_usec - start.tv_usec) / 1000.f;
-        gettimeofday(&start, NULL);
-        return delta;
-    }
-private:
-    struct timeval start;
-};
-#endif
 
 char* GetBlobHandlePtr(BlobHandle handle);
 
+// @brief whether blob is placed by the blob manager on the channels of parent starting from channel_offset
+bool IsBlobChannelView(Blob *blob, Blob *parent, int channel_offset);
+
 template <typename Tin, typename Tout>
 int PackC4(Tout *dst, const Tin *src, size_t hw, size_t channel);
 
@@ -0,0 +1,85 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/naive_compute.h"
+
+namespace TNN_NS {
+
+// @brief conv3d layer cpu acc, the reference of the 3d convolution
+class CpuConv3DLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuConv3DLayerAcc(){};
+
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
+};
+
+std::vector<DataFormat> CpuConv3DLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size == 5) {
+        support_list.push_back(DATA_FORMAT_NCDHW);
+    }
+    return support_list;
+}
+
+Status CpuConv3DLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuConv3DLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<ConvLayerParam *>(param_);
+    auto resource = dynamic_cast<ConvLayerResource *>(resource_);
+    if (!param || !resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: ConvLayerParam or ConvLayerResource is empty");
+    }
+
+    Blob *input_blob   = inputs[0];
+    Blob *output_blob  = outputs[0];
+    void *input_ptr    = input_blob->GetHandle().base;
+    void *output_ptr   = output_blob->GetHandle().base;
+    void *weight_ptr   = resource->filter_handle.force_to<void *>();
+    void *bias_ptr     = param->bias ? resource->bias_handle.force_to<void *>() : nullptr;
+    DataType data_type = output_blob->GetBlobDesc().data_type;
+
+    DimsVector output_dims = output_blob->GetBlobDesc().dims;
+    DimsVector input_dims  = input_blob->GetBlobDesc().dims;
+
+    // kernels, strides and dialations are in [w, h, d], pads in [w_begin, w_end, h_begin, h_end, d_begin, d_end]
+    if (data_type == DATA_TYPE_FLOAT) {
+        NaiveConv3D<float, float, float, float>(
+            input_ptr, output_ptr, weight_ptr, bias_ptr, input_dims, output_dims, param->strides[2], param->strides[1],
+            param->strides[0], param->kernels[2], param->kernels[1], param->kernels[0], param->pads[4], param->pads[2],
+            param->pads[0], param->group, param->dialations[2], param->dialations[1], param->dialations[0],
+            param->activation_type);
+    } else if (data_type == DATA_TYPE_BFP16) {
+        NaiveConv3D<bfp16_t, float, float, bfp16_t>(
+            input_ptr, output_ptr, weight_ptr, bias_ptr, input_dims, output_dims, param->strides[2], param->strides[1],
+            param->strides[0], param->kernels[2], param->kernels[1], param->kernels[0], param->pads[4], param->pads[2],
+            param->pads[0], param->group, param->dialations[2], param->dialations[1], param->dialations[0],
+            param->activation_type);
+    } else {
+        return Status(TNNERR_LAYER_ERR, "data type not support in conv3d");
+    }
+    return TNN_OK;
+}
+
+CpuTypeLayerAccRegister<TypeLayerAccCreator<CpuConv3DLayerAcc>> g_cpu_conv_3d_layer_acc_register(LAYER_CONVOLUTION_3D);
+
+}  // namespace TNN_NS
@@ -0,0 +1,144 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <cmath>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/bfp16.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(GRU, LAYER_GRU);
+
+static inline float Sigmoid(float x) {
+    return 1.0f / (1.0f + std::exp(-x));
+}
+
+/*
+ * the reference of onnx gru with the gates z r h:
+ *  z = sigmoid(Wz x + Rz h + Wbz + Rbz), r = sigmoid(Wr x + Rr h + Wbr + Rbr)
+ *  h~ = tanh(Wh x + Rh (r * h) + Rbh + Wbh), or tanh(Wh x + r * (Rh h + Rbh) + Wbh) if linear_before_reset
+ *  h = (1 - z) * h~ + z * h
+ */
+template <typename T>
+static void NaiveGRU(const T *x, const T *h0, T *y, T *y_h, const float *weight, const float *recurrence,
+                     const float *bias, int seq, int batch, int input, int hidden, int direction,
+                     int linear_before_reset) {
+    const int directions = direction == 2 ? 2 : 1;
+    std::vector<float> h(batch * hidden), gates(3 * hidden), rh(hidden);
+
+    for (int d = 0; d < directions; d++) {
+        const bool reverse = direction == 1 || d == 1;
+        const float *w     = weight + d * 3 * hidden * input;
+        const float *r     = recurrence + d * 3 * hidden * hidden;
+        const float *wb    = bias + d * 6 * hidden;
+        const float *rb    = wb + 3 * hidden;
+        for (int i = 0; i < batch * hidden; i++) {
+            h[i] = h0 ? float(h0[d * batch * hidden + i]) : 0.0f;
+        }
+
+        for (int s = 0; s < seq; s++) {
+            const int t = reverse ? seq - 1 - s : s;
+            for (int b = 0; b < batch; b++) {
+                const T *x_t = x + (t * batch + b) * input;
+                float *h_b   = h.data() + b * hidden;
+                for (int g = 0; g < 3 * hidden; g++) {
+                    float sum = wb[g];
+                    for (int i = 0; i < input; i++) {
+                        sum += w[g * input + i] * float(x_t[i]);
+                    }
+                    gates[g] = sum;
+                }
+                // z and r
+                for (int g = 0; g < 2 * hidden; g++) {
+                    float sum = gates[g] + rb[g];
+                    for (int j = 0; j < hidden; j++) {
+                        sum += r[g * hidden + j] * h_b[j];
+                    }
+                    gates[g] = Sigmoid(sum);
+                }
+                // h~
+                const float *gate_r = gates.data() + hidden;
+                for (int j = 0; j < hidden; j++) {
+                    rh[j] = linear_before_reset ? h_b[j] : gate_r[j] * h_b[j];
+                }
+                for (int k = 0; k < hidden; k++) {
+                    const int g = 2 * hidden + k;
+                    float sum   = rb[g];
+                    for (int j = 0; j < hidden; j++) {
+                        sum += r[g * hidden + j] * rh[j];
+                    }
+                    gates[g] = std::tanh(gates[g] + (linear_before_reset ? gate_r[k] * sum : sum));
+                }
+                T *y_t = y + ((t * directions + d) * batch + b) * hidden;
+                for (int j = 0; j < hidden; j++) {
+                    const float gate_z = gates[j];
+                    h_b[j]             = (1.0f - gate_z) * gates[2 * hidden + j] + gate_z * h_b[j];
+                    y_t[j]             = T(h_b[j]);
+                }
+            }
+        }
+
+        if (y_h) {
+            for (int i = 0; i < batch * hidden; i++) {
+                y_h[d * batch * hidden + i] = T(h[i]);
+            }
+        }
+    }
+}
+
+Status CpuGRULayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuGRULayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<GRULayerParam *>(param_);
+    auto resource = dynamic_cast<RecurrentLayerResource *>(resource_);
+    if (!param || !resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: GRULayerParam or RecurrentLayerResource is nil");
+    }
+
+    RawBuffer weight     = ConvertHalfHandle(resource->weight_handle);
+    RawBuffer recurrence = ConvertHalfHandle(resource->recurrence_handle);
+    RawBuffer bias       = ConvertHalfHandle(resource->bias_handle);
+
+    auto dims_input = inputs[0]->GetBlobDesc().dims;
+    const int seq   = dims_input[0];
+    const int batch = dims_input[1];
+    const int input = DimsVectorUtils::Count(dims_input, 2);
+
+    void *h0  = inputs.size() > 1 ? inputs[1]->GetHandle().base : nullptr;
+    void *y   = outputs[0]->GetHandle().base;
+    void *y_h = outputs.size() > 1 ? outputs[1]->GetHandle().base : nullptr;
+
+    DataType data_type = outputs[0]->GetBlobDesc().data_type;
+    if (data_type == DATA_TYPE_FLOAT) {
+        NaiveGRU<float>((float *)inputs[0]->GetHandle().base, (float *)h0, (float *)y, (float *)y_h,
+                        weight.force_to<float *>(), recurrence.force_to<float *>(), bias.force_to<float *>(), seq,
+                        batch, input, param->hidden_size, param->direction, param->linear_before_reset);
+    } else if (data_type == DATA_TYPE_BFP16) {
+        NaiveGRU<bfp16_t>((bfp16_t *)inputs[0]->GetHandle().base, (bfp16_t *)h0, (bfp16_t *)y, (bfp16_t *)y_h,
+                          weight.force_to<float *>(), recurrence.force_to<float *>(), bias.force_to<float *>(), seq,
+                          batch, input, param->hidden_size, param->direction, param->linear_before_reset);
+    } else {
+        return Status(TNNERR_LAYER_ERR, "data type not support in gru");
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(GRU, LAYER_GRU);
+
+}  // namespace TNN_NS
@@ -20,7 +20,8 @@ CpuLayerAcc::~CpuLayerAcc() {}
 
 Status CpuLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                          const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    AbstractLayerAcc::Init(context, param, resource, inputs, outputs);
+    Status ret = AbstractLayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(ret, TNN_OK);
 
     param_    = param;
     resource_ = resource;
@@ -28,10 +29,12 @@ Status CpuLayerAcc::Init(Context *context, LayerParam *param, LayerResource *res
 }
 
 std::vector<DataFormat> CpuLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    // the naive accs compute on the plain layout of any dims
     std::vector<DataFormat> support_list;
-    if (dims_size == 4) {
-        support_list.push_back(DATA_FORMAT_NCHW);
+    if (dims_size == 5) {
+        support_list.push_back(DATA_FORMAT_NCDHW);
     }
+    support_list.push_back(DATA_FORMAT_NCHW);
     return support_list;
 }
 
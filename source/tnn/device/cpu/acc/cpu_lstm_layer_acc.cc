@@ -0,0 +1,136 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <cmath>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/bfp16.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(LSTM, LAYER_LSTM);
+
+static inline float Sigmoid(float x) {
+    return 1.0f / (1.0f + std::exp(-x));
+}
+
+/*
+ * the reference of onnx lstm with the gates i o f c:
+ *  i = sigmoid(Wi x + Ri h + Wbi + Rbi), o = ..., f = ..., c~ = tanh(Wc x + Rc h + Wbc + Rbc)
+ *  c = f * c + i * c~, h = o * tanh(c)
+ */
+template <typename T>
+static void NaiveLSTM(const T *x, const T *h0, const T *c0, T *y, T *y_h, T *y_c, const float *weight,
+                      const float *recurrence, const float *bias, int seq, int batch, int input, int hidden,
+                      int direction) {
+    const int directions = direction == 2 ? 2 : 1;
+    std::vector<float> h(batch * hidden), c(batch * hidden), gates(4 * hidden);
+
+    for (int d = 0; d < directions; d++) {
+        const bool reverse = direction == 1 || d == 1;
+        const float *w     = weight + d * 4 * hidden * input;
+        const float *r     = recurrence + d * 4 * hidden * hidden;
+        const float *wb    = bias + d * 8 * hidden;
+        const float *rb    = wb + 4 * hidden;
+        for (int i = 0; i < batch * hidden; i++) {
+            h[i] = h0 ? float(h0[d * batch * hidden + i]) : 0.0f;
+            c[i] = c0 ? float(c0[d * batch * hidden + i]) : 0.0f;
+        }
+
+        for (int s = 0; s < seq; s++) {
+            const int t = reverse ? seq - 1 - s : s;
+            for (int b = 0; b < batch; b++) {
+                const T *x_t = x + (t * batch + b) * input;
+                float *h_b   = h.data() + b * hidden;
+                float *c_b   = c.data() + b * hidden;
+                for (int g = 0; g < 4 * hidden; g++) {
+                    float sum = wb[g] + rb[g];
+                    for (int i = 0; i < input; i++) {
+                        sum += w[g * input + i] * float(x_t[i]);
+                    }
+                    for (int j = 0; j < hidden; j++) {
+                        sum += r[g * hidden + j] * h_b[j];
+                    }
+                    gates[g] = sum;
+                }
+                T *y_t = y + ((t * directions + d) * batch + b) * hidden;
+                for (int j = 0; j < hidden; j++) {
+                    const float gate_i = Sigmoid(gates[j]);
+                    const float gate_o = Sigmoid(gates[hidden + j]);
+                    const float gate_f = Sigmoid(gates[2 * hidden + j]);
+                    const float gate_c = std::tanh(gates[3 * hidden + j]);
+                    c_b[j]             = gate_f * c_b[j] + gate_i * gate_c;
+                    h_b[j]             = gate_o * std::tanh(c_b[j]);
+                    y_t[j]             = T(h_b[j]);
+                }
+            }
+        }
+
+        for (int i = 0; i < batch * hidden; i++) {
+            if (y_h) {
+                y_h[d * batch * hidden + i] = T(h[i]);
+            }
+            if (y_c) {
+                y_c[d * batch * hidden + i] = T(c[i]);
+            }
+        }
+    }
+}
+
+Status CpuLSTMLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuLSTMLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<LSTMLayerParam *>(param_);
+    auto resource = dynamic_cast<RecurrentLayerResource *>(resource_);
+    if (!param || !resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: LSTMLayerParam or RecurrentLayerResource is nil");
+    }
+
+    RawBuffer weight     = ConvertHalfHandle(resource->weight_handle);
+    RawBuffer recurrence = ConvertHalfHandle(resource->recurrence_handle);
+    RawBuffer bias       = ConvertHalfHandle(resource->bias_handle);
+
+    auto dims_input = inputs[0]->GetBlobDesc().dims;
+    const int seq   = dims_input[0];
+    const int batch = dims_input[1];
+    const int input = DimsVectorUtils::Count(dims_input, 2);
+
+    void *h0  = inputs.size() > 1 ? inputs[1]->GetHandle().base : nullptr;
+    void *c0  = inputs.size() > 2 ? inputs[2]->GetHandle().base : nullptr;
+    void *y   = outputs[0]->GetHandle().base;
+    void *y_h = outputs.size() > 1 ? outputs[1]->GetHandle().base : nullptr;
+    void *y_c = outputs.size() > 2 ? outputs[2]->GetHandle().base : nullptr;
+
+    DataType data_type = outputs[0]->GetBlobDesc().data_type;
+    if (data_type == DATA_TYPE_FLOAT) {
+        NaiveLSTM<float>((float *)inputs[0]->GetHandle().base, (float *)h0, (float *)c0, (float *)y, (float *)y_h,
+                         (float *)y_c, weight.force_to<float *>(), recurrence.force_to<float *>(),
+                         bias.force_to<float *>(), seq, batch, input, param->hidden_size, param->direction);
+    } else if (data_type == DATA_TYPE_BFP16) {
+        NaiveLSTM<bfp16_t>((bfp16_t *)inputs[0]->GetHandle().base, (bfp16_t *)h0, (bfp16_t *)c0, (bfp16_t *)y,
+                           (bfp16_t *)y_h, (bfp16_t *)y_c, weight.force_to<float *>(), recurrence.force_to<float *>(),
+                           bias.force_to<float *>(), seq, batch, input, param->hidden_size, param->direction);
+    } else {
+        return Status(TNNERR_LAYER_ERR, "data type not support in lstm");
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(LSTM, LAYER_LSTM);
+
+}  // namespace TNN_NS
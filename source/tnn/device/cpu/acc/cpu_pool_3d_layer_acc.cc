@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/naive_compute.h"
+
+namespace TNN_NS {
+
+// @brief pooling 3d layer cpu acc, the reference of the 3d pooling
+class CpuPool3DLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuPool3DLayerAcc(){};
+
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
+};
+
+std::vector<DataFormat> CpuPool3DLayerAcc::SupportDataFormat(DataType data_type, int dims_size) {
+    std::vector<DataFormat> support_list;
+    if (dims_size == 5) {
+        support_list.push_back(DATA_FORMAT_NCDHW);
+    }
+    return support_list;
+}
+
+Status CpuPool3DLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuPool3DLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<PoolingLayerParam *>(param_);
+    if (!param) {
+        return Status(TNNERR_MODEL_ERR, "Error: PoolingLayerParam is nil");
+    }
+
+    auto input  = inputs[0];
+    auto output = outputs[0];
+
+    auto dims_input  = input->GetBlobDesc().dims;
+    auto dims_output = output->GetBlobDesc().dims;
+
+    if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+        NaivePooling3D<float, float>(reinterpret_cast<float *>(input->GetHandle().base),
+                                     reinterpret_cast<float *>(output->GetHandle().base), dims_input, dims_output,
+                                     param->strides[2], param->strides[1], param->strides[0], param->kernels[2],
+                                     param->kernels[1], param->kernels[0], param->pads[4], param->pads[2],
+                                     param->pads[0], param->pool_type);
+    } else if (output->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+        NaivePooling3D<bfp16_t, float>(reinterpret_cast<bfp16_t *>(input->GetHandle().base),
+                                       reinterpret_cast<bfp16_t *>(output->GetHandle().base), dims_input, dims_output,
+                                       param->strides[2], param->strides[1], param->strides[0], param->kernels[2],
+                                       param->kernels[1], param->kernels[0], param->pads[4], param->pads[2],
+                                       param->pads[0], param->pool_type);
+    } else {
+        return Status(TNNERR_LAYER_ERR, "data type not support in pooling 3d");
+    }
+
+    return TNN_OK;
+}
+
+CpuTypeLayerAccRegister<TypeLayerAccCreator<CpuPool3DLayerAcc>> g_cpu_pool_3d_layer_acc_register(LAYER_POOLING_3D);
+
+}  // namespace TNN_NS
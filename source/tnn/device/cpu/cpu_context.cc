@@ -14,6 +14,8 @@
 
 #include "tnn/device/cpu/cpu_context.h"
 
+#include "tnn/utils/numa_utils.h"
+
 namespace TNN_NS {
 
 Status CpuContext::LoadLibrary(std::vector<std::string> path) {
@@ -25,6 +27,9 @@ Status CpuContext::GetCommandQueue(void** command_queue) {
 }
 
 Status CpuContext::OnInstanceForwardBegin() {
+    if (!numa_cpu_mask_.empty()) {
+        return NumaUtils::PinThreads(numa_cpu_mask_, 1);
+    }
     return TNN_OK;
 }
 
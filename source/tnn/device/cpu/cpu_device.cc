@@ -14,6 +14,7 @@
 
 #include "tnn/device/cpu/cpu_device.h"
 #include "tnn/device/cpu/cpu_context.h"
+#include "tnn/memory_manager/memory_allocator.h"
 #include "tnn/utils/blob_memory_size_utils.h"
 
 namespace TNN_NS {
@@ -54,16 +55,15 @@ Status CpuDevice::Allocate(void** handle, MatType mat_type, DimsVector dims) {
 
 Status CpuDevice::Allocate(void** handle, BlobMemorySizeInfo& size_info) {
     if (handle) {
-        *handle = malloc(GetBlobMemoryBytesSize(size_info));
+        int bytes_size = GetBlobMemoryBytesSize(size_info);
+        // memory allocated while an instance of a numa node is initialized is bound to the node by the allocator
+        RETURN_ON_NEQ(MemoryAllocator::GetHostAllocator()->Allocate(handle, bytes_size), TNN_OK);
     }
     return TNN_OK;
 }
 
 Status CpuDevice::Free(void* handle) {
-    if (handle) {
-        free(handle);
-    }
-    return TNN_OK;
+    return MemoryAllocator::FreeHostMemory(handle);
 }
 
 Status CpuDevice::CopyToDevice(BlobHandle* dst, const BlobHandle* src, BlobDesc& desc, void* command_queue) {
@@ -93,6 +93,10 @@ AbstractLayerAcc* CpuDevice::CreateLayerAcc(LayerType type) {
     return NULL;
 }
 
+bool CpuDevice::IsLayerAccImplemented(LayerType type) {
+    return GetLayerCreatorMap().count(type) > 0;
+}
+
 Context* CpuDevice::CreateContext(int device_id) {
     return new CpuContext();
 }
@@ -48,6 +48,8 @@ class CpuDevice : public AbstractDevice {
 
   virtual AbstractLayerAcc *CreateLayerAcc(LayerType type);
 
+  virtual bool IsLayerAccImplemented(LayerType type);
+
   virtual Context *CreateContext(int device_id);
 
   static Status RegisterLayerAccCreator(LayerType type,
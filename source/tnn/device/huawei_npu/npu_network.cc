@@ -621,10 +621,10 @@ Status NpuNetwork::ForwardAsync(Callback call_back) {
 }
 
 #if TNN_PROFILE
-void NpuNetwork::StartProfile() {
-    context_->StartProfile();
+void NpuNetwork::StartProfile(bool hardware_counters) {
+    context_->StartProfile(hardware_counters);
     if (nullptr != sub_network_) {
-        sub_network_->StartProfile();
+        sub_network_->StartProfile(hardware_counters);
     }
 }
 
@@ -98,7 +98,7 @@ public:
 
 #if TNN_PROFILE
 public:
-    virtual void StartProfile();
+    virtual void StartProfile(bool hardware_counters = false);
     virtual std::shared_ptr<ProfileResult> FinishProfile();
 #endif
 
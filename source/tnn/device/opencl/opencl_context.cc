@@ -42,8 +42,8 @@ cl::CommandQueue* OpenCLContext::CommandQueue() {
 }
 
 #if TNN_PROFILE
-void OpenCLContext::StartProfile() {
-    Context::StartProfile();
+void OpenCLContext::StartProfile(bool hardware_counters) {
+    Context::StartProfile(hardware_counters);
     profiling_result_ = std::make_shared<OpenCLProfileResult>();
 }
 
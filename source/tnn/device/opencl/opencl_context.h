@@ -77,7 +77,7 @@ public:
 
 #if TNN_PROFILE
 public:
-    virtual void StartProfile() override;
+    virtual void StartProfile(bool hardware_counters = false) override;
 #endif
 
 public:
@@ -14,6 +14,8 @@
 
 #include "tnn/interpreter/default_model_interpreter.h"
 
+#include "tnn/core/macro.h"
+
 namespace TNN_NS {
 
 DefaultModelInterpreter::DefaultModelInterpreter() {
@@ -34,4 +36,36 @@ NetResource *DefaultModelInterpreter::GetNetResource() {
     return net_resource_;
 }
 
+void DefaultModelInterpreter::SetLazyLoadResource(bool lazy_load_resource) {
+    lazy_load_resource_ = lazy_load_resource;
+}
+
+/*
+ * The copy is optimized without holding the lock, so the instances of different keys are optimized
+ * concurrently. Two instances of a new key may both optimize it, the first copy cached is kept.
+ */
+Status DefaultModelInterpreter::GetOptimizedNetStructure(const std::string &key,
+                                                         std::function<Status(NetStructure *)> optimize_func,
+                                                         std::shared_ptr<NetStructure> &structure) {
+    // outputs may be added after the model is interpreted
+    std::string outputs_key = key;
+    {
+        std::lock_guard<std::mutex> lock(optimized_mutex_);
+        for (auto output : net_structure_->outputs) {
+            outputs_key += "|" + output;
+        }
+        if (optimized_structures_.count(outputs_key) > 0) {
+            structure = optimized_structures_[outputs_key];
+            return TNN_OK;
+        }
+    }
+
+    auto optimized = CopyNetStructure(net_structure_);
+    RETURN_ON_NEQ(optimize_func(optimized.get()), TNN_OK);
+
+    std::lock_guard<std::mutex> lock(optimized_mutex_);
+    structure = optimized_structures_.insert(std::make_pair(outputs_key, optimized)).first->second;
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
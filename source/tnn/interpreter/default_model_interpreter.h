@@ -15,6 +15,12 @@
 #ifndef TNN_SOURCE_TNN_INTERPRETER_DEFAULT_MODEL_INTERPRETER_H_
 #define TNN_SOURCE_TNN_INTERPRETER_DEFAULT_MODEL_INTERPRETER_H_
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "tnn/core/status.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/net_resource.h"
@@ -41,9 +47,25 @@ public:
     //@brief GetNetResource return network weights data
     virtual NetResource *GetNetResource();
 
+    //@brief SetLazyLoadResource defer layer resource deserialization to layer
+    // init, it must be called before Interpret
+    virtual void SetLazyLoadResource(bool lazy_load_resource);
+
+    //@brief GetOptimizedNetStructure return a copy of the net structure optimized by optimize_func, it is
+    // created once per key and the net outputs, and shared by the instances asking for the same key.
+    // the interpreted net structure is left unchanged.
+    Status GetOptimizedNetStructure(const std::string &key, std::function<Status(NetStructure *)> optimize_func,
+                                    std::shared_ptr<NetStructure> &structure);
+
+protected:
+    bool lazy_load_resource_ = false;
+
 private:
     NetStructure *net_structure_;
     NetResource *net_resource_;
+
+    std::map<std::string, std::shared_ptr<NetStructure>> optimized_structures_;
+    std::mutex optimized_mutex_;
 };
 
 }  // namespace TNN_NS
@@ -264,7 +264,13 @@ typedef enum {
     DEQUANT_ONLY = 1,
     // data_type + layout for arm
     QUANT_NCHW4_2_NHWC   = 2,
-    DEQUANT_NHWC_2_NCHW4 = 3
+    DEQUANT_NHWC_2_NCHW4 = 3,
+    // only layout for arm
+    NC4HW4_2_NHWC = 4,
+    NHWC_2_NC4HW4 = 5,
+    // layout and optional bfp16 for the layers falling back to the naive device
+    NC4HW4_2_NCHW = 6,
+    NCHW_2_NC4HW4 = 7
     // to be continued
 } ReformatType;
 
@@ -366,6 +372,19 @@ struct PixelShuffleLayerParam : public LayerParam {
     int upscale_factor;
 };
 
+// the gates follow onnx, lstm: i o f c, gru: z r h
+struct RecurrentLayerParam : public LayerParam {
+    int hidden_size = 0;
+    // 0: forward, 1: reverse, 2: bidirectional
+    int direction = 0;
+};
+
+struct LSTMLayerParam : public RecurrentLayerParam {};
+
+struct GRULayerParam : public RecurrentLayerParam {
+    int linear_before_reset = 0;
+};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_LAYER_PARAM_H
@@ -110,6 +110,17 @@ struct DetectionPostProcessLayerResource : public LayerResource {
     RawBuffer anchors_handle;
 };
 
+struct RecurrentLayerResource : public LayerResource {
+    // input weights [direction][gates * hidden][input]
+    RawBuffer weight_handle;
+
+    // recurrence weights [direction][gates * hidden][hidden]
+    RawBuffer recurrence_handle;
+
+    // input and recurrence bias [direction][2 * gates * hidden]
+    RawBuffer bias_handle;
+};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_LAYER_RESOURCE_H_
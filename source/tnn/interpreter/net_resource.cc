@@ -19,6 +19,9 @@ DataType GetNetResourceDataType(NetResource* resource) {
     if (!resource) {
         return DATA_TYPE_FLOAT;
     }
+    if (resource->lazy_loader) {
+        return resource->lazy_loader->GetDataType();
+    }
     for (auto iter : resource->resource_map) {
         ConvLayerResource* conv_resource = dynamic_cast<ConvLayerResource*>(iter.second.get());
         if (conv_resource) {
@@ -30,4 +33,42 @@ DataType GetNetResourceDataType(NetResource* resource) {
     return DATA_TYPE_FLOAT;
 }
 
+std::shared_ptr<LayerResource> GetLayerResource(NetResource *resource, const std::string &name) {
+    if (!resource) {
+        return nullptr;
+    }
+    auto loader = resource->lazy_loader;
+    if (!loader) {
+        auto iter = resource->resource_map.find(name);
+        return iter != resource->resource_map.end() ? iter->second : nullptr;
+    }
+
+    std::unique_lock<std::mutex> lck(loader->GetMutex());
+    auto iter = resource->resource_map.find(name);
+    if (iter != resource->resource_map.end()) {
+        return iter->second;
+    }
+    if (!loader->Contains(name)) {
+        return nullptr;
+    }
+
+    LayerResource *layer_resource = nullptr;
+    Status status                 = loader->Load(name, &layer_resource);
+    if (status != TNN_OK || !layer_resource) {
+        LOGE("Error: load layer resource %s failed: %s\n", name.c_str(), status.description().c_str());
+        return nullptr;
+    }
+    auto layer_resource_ptr      = std::shared_ptr<LayerResource>(layer_resource);
+    resource->resource_map[name] = layer_resource_ptr;
+    return layer_resource_ptr;
+}
+
+void ReleaseLayerResource(NetResource *resource, const std::string &name) {
+    if (!resource || !resource->lazy_loader) {
+        return;
+    }
+    std::unique_lock<std::mutex> lck(resource->lazy_loader->GetMutex());
+    resource->resource_map.erase(name);
+}
+
 }  // namespace TNN_NS
@@ -16,16 +16,56 @@
 #define TNN_SOURCE_TNN_INTERPRETER_NET_RESOURCE_H_
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "tnn/core/status.h"
 #include "tnn/interpreter/layer_resource.h"
 
 namespace TNN_NS {
 
+// @brief LayerResourceLoader deserialize layer resource on demand, it is
+// created by the model interpreter when resources are loaded lazily.
+class LayerResourceLoader {
+public:
+    virtual ~LayerResourceLoader() {}
+
+    // @brief whether the resource of the layer is recorded in the model
+    virtual bool Contains(const std::string &name) = 0;
+
+    // @brief deserialize the resource of the layer from the model content
+    virtual Status Load(const std::string &name, LayerResource **resource) = 0;
+
+    // @brief data type of the model weights, see GetNetResourceDataType
+    virtual DataType GetDataType() = 0;
+
+    // @brief mutex to protect resource_map of the net resource
+    std::mutex &GetMutex() {
+        return mutex_;
+    }
+
+private:
+    std::mutex mutex_;
+};
+
 struct NetResource {
     std::map<std::string, std::shared_ptr<LayerResource>> resource_map;
+
+    // not null if layer resources are loaded lazily
+    std::shared_ptr<LayerResourceLoader> lazy_loader = nullptr;
 };
 
 DataType GetNetResourceDataType(NetResource *resource);
 
+// @brief get the resource of the layer, it is loaded into resource_map first if
+// the net resource is loaded lazily. return nullptr if the layer has no resource.
+std::shared_ptr<LayerResource> GetLayerResource(NetResource *resource, const std::string &name);
+
+// @brief remove the resource of the layer from resource_map, only valid if the
+// net resource is loaded lazily, so it can be loaded again when needed.
+void ReleaseLayerResource(NetResource *resource, const std::string &name);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_NET_RESOURCE_H_
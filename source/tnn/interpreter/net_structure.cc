@@ -38,4 +38,12 @@ bool GetQuantizedInfoFromNetStructure(NetStructure* net_struct) {
     return quantize_layer != layers.end();
 }
 
+std::shared_ptr<NetStructure> CopyNetStructure(NetStructure* net_struct) {
+    auto structure = std::make_shared<NetStructure>(*net_struct);
+    for (auto& layer : structure->layers) {
+        layer = std::make_shared<LayerInfo>(*layer);
+    }
+    return structure;
+}
+
 }  // namespace TNN_NS
@@ -47,6 +47,8 @@ struct NetStructure {
     std::set<std::string> outputs;
     std::vector<std::shared_ptr<LayerInfo>> layers;
     std::set<std::string> blobs;
+    // blob layouts assigned by the optimizer, blobs not listed are decided by the layer acc
+    std::map<std::string, DataFormat> blobs_format;
     ModelType source_model_type = MODEL_TYPE_TNN;
 };
 
@@ -54,6 +56,10 @@ std::shared_ptr<LayerInfo> GetLayerInfoFromName(NetStructure* net_struct, std::s
 
 bool GetQuantizedInfoFromNetStructure(NetStructure* net_struct);
 
+// @brief copy the net structure with copies of the layer infos, the layer params are shared
+// and must be copied before they are modified
+std::shared_ptr<NetStructure> CopyNetStructure(NetStructure* net_struct);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_SOURCE_TNN_INTERPRETER_NET_STRUCTURE_H_
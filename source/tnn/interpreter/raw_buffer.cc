@@ -16,6 +16,7 @@
 #include <fstream>
 #include <string>
 #include <typeinfo>
+#include "tnn/memory_manager/memory_allocator.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/data_type_utils.h"
@@ -23,6 +24,15 @@
 using namespace TNN_NS;
 
 namespace TNN_NS {
+// weights, packed weights and workspaces share the host allocator with the blob memory
+static shared_ptr<char> AllocateBuffer(int bytes_size) {
+    void *data = nullptr;
+    if (MemoryAllocator::GetHostAllocator()->Allocate(&data, bytes_size) != TNN_OK) {
+        return shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
+    }
+    return shared_ptr<char>((char *)data, [](char *p) { MemoryAllocator::FreeHostMemory(p); });
+}
+
 RawBuffer::~RawBuffer() {
     buff_ = nullptr;
 }
@@ -33,13 +43,13 @@ RawBuffer::RawBuffer() {
 }
 
 RawBuffer::RawBuffer(int bytes_size) {
-    buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
+    buff_ = AllocateBuffer(bytes_size);
     memset(buff_.get(), 0, bytes_size);
     bytes_size_ = bytes_size;
 }
 
-RawBuffer::RawBuffer(int bytes_size, char *buffer) {
-    buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
+RawBuffer::RawBuffer(int bytes_size, const char *buffer) {
+    buff_ = AllocateBuffer(bytes_size);
     memcpy(buff_.get(), buffer, bytes_size);
     bytes_size_ = bytes_size;
 }
@@ -48,6 +58,16 @@ RawBuffer::RawBuffer(const RawBuffer &buf) {
     this->bytes_size_ = buf.bytes_size_;
     this->data_type_  = buf.data_type_;
     this->buff_       = buf.buff_;
+    this->read_only_  = buf.read_only_;
+}
+
+RawBuffer RawBuffer::ReadOnlyView(int bytes_size, const char *buffer) {
+    RawBuffer view;
+    // the data is not owned, the deleter does nothing
+    view.buff_       = shared_ptr<char>(const_cast<char *>(buffer), [](char *) {});
+    view.bytes_size_ = bytes_size;
+    view.read_only_  = true;
+    return view;
 }
 
 template <typename T>
@@ -77,7 +97,8 @@ void RawBuffer::Permute(size_t outter, size_t inner) {
             break;
     }
 
-    buff_ = tmp.buff_;
+    buff_      = tmp.buff_;
+    read_only_ = false;
     return;
 }
 
@@ -85,6 +106,7 @@ RawBuffer &RawBuffer::operator=(RawBuffer buf) {
     this->bytes_size_ = buf.bytes_size_;
     this->data_type_  = buf.data_type_;
     this->buff_       = buf.buff_;
+    this->read_only_  = buf.read_only_;
     return *this;
 }
 
@@ -93,7 +115,13 @@ void RawBuffer::buffer(char *buf, int bytes_size) {
         return;
     }
     if (!buff_) {
-        buff_ = shared_ptr<char>(new char[bytes_size_], [](char *p) { delete[] p; });
+        buff_ = AllocateBuffer(bytes_size_);
+    } else if (read_only_) {
+        // the view is copied before it is written
+        auto copy = AllocateBuffer(bytes_size_);
+        memcpy(copy.get(), buff_.get(), bytes_size_);
+        buff_      = copy;
+        read_only_ = false;
     }
     memcpy(buff_.get(), buf, bytes_size);
     // buff_ = buf;
@@ -116,6 +144,10 @@ int RawBuffer::GetDataCount() {
     return elem_size > 0 ? bytes_size_ / elem_size : 0;
 }
 
+bool RawBuffer::IsReadOnly() {
+    return read_only_;
+}
+
 /*
  * Convert the data handle form half to Float32
  */
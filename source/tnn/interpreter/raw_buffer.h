@@ -32,8 +32,11 @@ class RawBuffer {
 public:
     RawBuffer();
     explicit RawBuffer(int bytes_size);
-    RawBuffer(int bytes_size, char *buffer);
+    RawBuffer(int bytes_size, const char *buffer);
     RawBuffer(const RawBuffer &buf);
+    // @brief view of read only data without a copy, e.g. weights embedded in the binary. the data is neither
+    // freed nor written, it must outlive the buffer
+    static RawBuffer ReadOnlyView(int bytes_size, const char *buffer);
     RawBuffer &operator=(RawBuffer buf);
     ~RawBuffer();
 
@@ -44,6 +47,8 @@ public:
     DataType GetDataType();
     int GetBytesSize();
     int GetDataCount();
+    // @brief true if the buffer is a read only view, its data must not be written through force_to
+    bool IsReadOnly();
 
     void Permute(size_t outter, size_t inner);
 
@@ -56,6 +61,7 @@ private:
     shared_ptr<char> buff_ = nullptr;
     int bytes_size_        = 0;
     DataType data_type_    = DATA_TYPE_FLOAT;
+    bool read_only_        = false;
 };
 
 RawBuffer ConvertHalfHandle(RawBuffer &buf);
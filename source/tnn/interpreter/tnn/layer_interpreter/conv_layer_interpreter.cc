@@ -14,6 +14,7 @@
 
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/layer_interpreter/layer_interpreter_macro.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 #include <stdlib.h>
 
@@ -112,13 +113,20 @@ Status ConvLayerInterpreter::SaveResource(Serializer& serializer, LayerParam* pa
     CAST_OR_RET_ERROR(layer_param, ConvLayerParam, "invalid layer param", param);
     CAST_OR_RET_ERROR(layer_res, ConvLayerResource, "invalid layer res to save", resource);
 
+    // weight only quantized weights keep their scale, int4 values are packed
+    bool weight_only_quantized = WeightQuantUtils::IsWeightOnlyQuantized(layer_param, layer_res);
+
     serializer.PutString(layer_param->name);
     serializer.PutInt(layer_param->bias);
-    serializer.PutRaw(layer_res->filter_handle);
+    if (weight_only_quantized && WeightQuantUtils::IsInt4Weights(layer_res->filter_handle)) {
+        serializer.PutRawInt4(layer_res->filter_handle);
+    } else {
+        serializer.PutRaw(layer_res->filter_handle);
+    }
     if (layer_param->bias) {
         serializer.PutRaw(layer_res->bias_handle);
     }
-    if (layer_param->quantized) {
+    if (layer_param->quantized || weight_only_quantized) {
         serializer.PutRaw(layer_res->scale_handle);
     }
 
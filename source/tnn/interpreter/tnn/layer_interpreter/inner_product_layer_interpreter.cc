@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 #include <stdlib.h>
 
@@ -84,11 +85,18 @@ Status InnerProductLayerInterpreter::SaveResource(Serializer& serializer, LayerP
         return Status(TNNERR_NULL_PARAM, "invalid layer res to save");
     }
 
+    // weight only quantized weights keep their scale, int4 values are packed
+    bool weight_only_quantized = WeightQuantUtils::IsWeightOnlyQuantized(layer_param, layer_res);
+
     serializer.PutString(layer_param->name);
-    serializer.PutRaw(layer_res->weight_handle);
+    if (weight_only_quantized && WeightQuantUtils::IsInt4Weights(layer_res->weight_handle)) {
+        serializer.PutRawInt4(layer_res->weight_handle);
+    } else {
+        serializer.PutRaw(layer_res->weight_handle);
+    }
     serializer.PutRaw(layer_res->bias_handle);
 
-    if (layer_param->quantized) {
+    if (layer_param->quantized || weight_only_quantized) {
         serializer.PutRaw(layer_res->scale_handle);
     }
 
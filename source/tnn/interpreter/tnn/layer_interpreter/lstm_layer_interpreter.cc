@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+
+namespace TNN_NS {
+
+DECLARE_LAYER_INTERPRETER(LSTM, LAYER_LSTM);
+
+Status LSTMLayerInterpreter::InterpretProto(str_arr layer_cfg_arr, int start_index, LayerParam** param) {
+    auto layer_param = new LSTMLayerParam();
+    *param           = layer_param;
+    int index        = start_index;
+
+    layer_param->hidden_size = atoi(layer_cfg_arr[index++].c_str());
+    layer_param->direction   = atoi(layer_cfg_arr[index++].c_str());
+
+    return TNN_OK;
+}
+
+Status LSTMLayerInterpreter::InterpretResource(Deserializer& deserializer, LayerResource** resource) {
+    auto layer_res = new RecurrentLayerResource();
+    *resource      = layer_res;
+
+    std::string layer_name = deserializer.GetString();
+
+    RawBuffer weights;
+    deserializer.GetRaw(weights);
+    layer_res->weight_handle = weights;
+
+    RawBuffer recurrence;
+    deserializer.GetRaw(recurrence);
+    layer_res->recurrence_handle = recurrence;
+
+    RawBuffer bias;
+    deserializer.GetRaw(bias);
+    layer_res->bias_handle = bias;
+
+    return TNN_OK;
+}
+
+Status LSTMLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerParam* param) {
+    auto layer_param = dynamic_cast<LSTMLayerParam*>(param);
+    if (nullptr == layer_param) {
+        LOGE("invalid layer param to save\n");
+        return Status(TNNERR_NULL_PARAM, "invalid layer param to save");
+    }
+
+    output_stream << layer_param->hidden_size << " ";
+    output_stream << layer_param->direction << " ";
+
+    return TNN_OK;
+}
+
+Status LSTMLayerInterpreter::SaveResource(Serializer& serializer, LayerParam* param, LayerResource* resource) {
+    auto layer_param = dynamic_cast<LSTMLayerParam*>(param);
+    if (nullptr == layer_param) {
+        LOGE("invalid layer param to save\n");
+        return Status(TNNERR_NULL_PARAM, "invalid layer param to save");
+    }
+    auto layer_res = dynamic_cast<RecurrentLayerResource*>(resource);
+    if (nullptr == layer_res) {
+        LOGE("invalid layer res to save\n");
+        return Status(TNNERR_NULL_PARAM, "invalid layer res to save");
+    }
+
+    serializer.PutString(layer_param->name);
+    serializer.PutRaw(layer_res->weight_handle);
+    serializer.PutRaw(layer_res->recurrence_handle);
+    serializer.PutRaw(layer_res->bias_handle);
+
+    return TNN_OK;
+}
+
+REGISTER_LAYER_INTERPRETER(LSTM, LAYER_LSTM);
+
+}  // namespace TNN_NS
@@ -14,6 +14,7 @@
 
 #include "tnn/interpreter/tnn/model_interpreter.h"
 #include <stdlib.h>
+#include <fstream>
 #include <sstream>
 
 #include "tnn/core/common.h"
@@ -25,6 +26,93 @@ namespace TNN_NS {
 TypeModelInterpreterRegister<TypeModelInterpreterCreator<ModelInterpreter>> g_tnn_model_interpreter_register(
     MODEL_TYPE_TNN);
 
+// @brief IndexDeserializer skips the data of raw buffers, only the data type
+// is kept, so the layout of layer resources can be indexed without copying.
+class IndexDeserializer : public Deserializer {
+public:
+    explicit IndexDeserializer(std::istream &is) : Deserializer(is) {}
+
+    virtual void GetRaw(TNN_NS::RawBuffer &value) {
+        auto magic_number = GetInt();
+        auto data_type    = (TNN_NS::DataType)GetInt();
+        int length        = GetInt();
+        if (length <= 0) {
+            return;
+        }
+
+        value = TNN_NS::RawBuffer();
+        value.SetDataType(data_type);
+        if ((uint32_t)magic_number == g_packed_int4_magic_number) {
+            length = GetPackedInt4BytesSize(length);
+        }
+        _istream.seekg(length, std::ios::cur);
+    }
+};
+
+// @brief ModelResourceLoader keeps the model file open and the position of each
+// layer resource in it, the resource is read from the file when it is required.
+// Load is called with the loader mutex held, so the file stream is not shared.
+class ModelResourceLoader : public LayerResourceLoader {
+public:
+    struct ResourceIndex {
+        LayerType type;
+        std::streamoff begin;
+        std::streamoff end;
+    };
+
+    explicit ModelResourceLoader(ModelInterpreter *interpreter) : interpreter_(interpreter) {}
+
+    Status Open(const std::string &model_path) {
+        model_stream_.open(model_path, std::ios::in | std::ios::binary);
+        if (!model_stream_.is_open()) {
+            LOGE("Error: open model file %s failed\n", model_path.c_str());
+            return Status(TNNERR_INVALID_MODEL, "Error: open model file failed");
+        }
+        return TNN_OK;
+    }
+
+    virtual bool Contains(const std::string &name) {
+        return index_map_.find(name) != index_map_.end();
+    }
+
+    virtual Status Load(const std::string &name, LayerResource **resource) {
+        auto iter = index_map_.find(name);
+        if (iter == index_map_.end()) {
+            return Status(TNNERR_LOAD_MODEL, "Error: layer resource is not indexed");
+        }
+
+        auto &index                 = iter->second;
+        auto &layer_interpreter_map = ModelInterpreter::GetLayerInterpreterMap();
+        auto layer_interpreter      = layer_interpreter_map.find(index.type);
+        if (layer_interpreter == layer_interpreter_map.end() || layer_interpreter->second == NULL) {
+            return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+        }
+
+        model_stream_.clear();
+        model_stream_.seekg(index.begin, std::ios::beg);
+        auto deserializer = interpreter_->GetDeserializer(model_stream_);
+        Status status     = layer_interpreter->second->InterpretResource(*deserializer, resource);
+        if (status != TNN_OK) {
+            return status;
+        }
+        if (model_stream_.fail() || model_stream_.tellg() != index.end) {
+            return Status(TNNERR_INVALID_MODEL, "Error: model file has changed since it was indexed");
+        }
+        return TNN_OK;
+    }
+
+    virtual DataType GetDataType() {
+        return data_type_;
+    }
+
+    std::ifstream model_stream_;
+    std::map<std::string, ResourceIndex> index_map_;
+    DataType data_type_ = DATA_TYPE_FLOAT;
+
+private:
+    ModelInterpreter *interpreter_;
+};
+
 std::string ModelInterpreter::Transfer(std::string content) {
     return content;
 }
@@ -38,6 +126,10 @@ std::shared_ptr<Deserializer> ModelInterpreter::GetDeserializer(std::istream &is
     return std::make_shared<Deserializer>(is);
 }
 
+std::shared_ptr<Deserializer> ModelInterpreter::GetIndexDeserializer(std::istream &is) {
+    return std::make_shared<IndexDeserializer>(is);
+}
+
 // Interpret the proto and model.
 Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
     std::string empty_content = "";
@@ -48,8 +140,13 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
         return status;
     }
 
+    // params[1] is the path of the model file if the resources are loaded lazily
     auto &model_content = params.size() > 1 ? params[1] : empty_content;
-    status              = InterpretModel(model_content);
+    if (lazy_load_resource_ && !model_content.empty()) {
+        status = IndexModel(model_content);
+    } else {
+        status = InterpretModel(model_content);
+    }
     return status;
 }
 
@@ -304,6 +401,71 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
     return TNN_OK;
 }
 
+/*
+ * IndexModel walks through the model file like InterpretModel, but the data
+ * of raw buffers is skipped. The position of each layer resource is recorded,
+ * and the resource is read from the file by the loader when the layer is initialized.
+ */
+Status ModelInterpreter::IndexModel(std::string &model_path) {
+    NetResource *net_resource = GetNetResource();
+    auto loader               = std::make_shared<ModelResourceLoader>(this);
+    RETURN_ON_NEQ(loader->Open(model_path), TNN_OK);
+    auto &content_stream = loader->model_stream_;
+
+    uint32_t magic_version_number = 0;
+    content_stream.read(reinterpret_cast<char *>(&magic_version_number), sizeof(g_version_magic_number));
+    if (!IsValidVersionNumber(magic_version_number)) {
+        content_stream.seekg(0, std::ios::beg);
+    }
+
+    res_header header;
+    auto deserializer = GetIndexDeserializer(content_stream);
+    header.deserialize(*deserializer);
+    if (header.layer_cnt_ <= 0 || header.layer_cnt_ >= 10000) {
+        return Status(TNNERR_INVALID_MODEL, "Error: model is illegal");
+    }
+
+    auto &layer_interpreter_map = GetLayerInterpreterMap();
+    for (int index = 0; index < header.layer_cnt_; ++index) {
+        layer_header ly_head;
+        ly_head.deserialize(*deserializer);
+
+        auto layer_interpreter = layer_interpreter_map[ly_head.type_];
+        if (layer_interpreter == NULL) {
+            LOGE(
+                "Error: layer_interpreter nil name:%s type_from_str:%s "
+                "type:%d\n",
+                ly_head.name_.c_str(), ly_head.type_str_.c_str(), ly_head.type_);
+            return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+        }
+
+        ModelResourceLoader::ResourceIndex resource_index;
+        resource_index.type  = ly_head.type_;
+        resource_index.begin = content_stream.tellg();
+
+        LayerResource *layer_resource = NULL;
+        Status result                 = layer_interpreter->InterpretResource(*deserializer, &layer_resource);
+        std::shared_ptr<LayerResource> layer_resource_ptr(layer_resource);
+        if (result != TNN_OK) {
+            return result;
+        }
+        if (content_stream.fail()) {
+            return Status(TNNERR_INVALID_MODEL, "Error: model is truncated");
+        }
+        resource_index.end = content_stream.tellg();
+
+        // same rule as GetNetResourceDataType
+        auto conv_resource = dynamic_cast<ConvLayerResource *>(layer_resource);
+        if (conv_resource && conv_resource->filter_handle.GetDataType() == DATA_TYPE_HALF) {
+            loader->data_type_ = DATA_TYPE_HALF;
+        }
+        loader->index_map_[ly_head.name_] = resource_index;
+    }
+
+    net_resource->lazy_loader = loader;
+    return TNN_OK;
+}
+
 Status ModelInterpreter::RegisterLayerInterpreter(LayerType type, AbstractLayerInterpreter *interpreter) {
     std::map<LayerType, std::shared_ptr<AbstractLayerInterpreter>> &layer_interpreter_map = GetLayerInterpreterMap();
     layer_interpreter_map[type] = std::shared_ptr<AbstractLayerInterpreter>(interpreter);
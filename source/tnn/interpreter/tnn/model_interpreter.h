@@ -96,6 +96,7 @@ public:
 protected:
     virtual Status InterpretProto(std::string &content);
     virtual Status InterpretModel(std::string &model_content);
+    virtual Status IndexModel(std::string &model_path);
     virtual Status InterpretInput(const std::string& inputs_content);
     virtual Status InterpretOutput(const std::string& outputs_content);
     virtual Status InterpretLayer(const std::string& layer_str);
@@ -104,10 +105,13 @@ protected:
     virtual std::string Transfer(std::string content);
     virtual bool IsValidVersionNumber(uint32_t number);
     virtual std::shared_ptr<Deserializer> GetDeserializer(std::istream& is);
-    ;
+    // @brief deserializer used by IndexModel, it skips the raw buffer data
+    virtual std::shared_ptr<Deserializer> GetIndexDeserializer(std::istream& is);
 
 protected:
     uint32_t version_magic_number = 0;
+
+    friend class ModelResourceLoader;
 };
 
 }  // namespace TNN_NS
@@ -27,6 +27,13 @@
 
 namespace TNN_NS {
     static const uint32_t g_version_magic_number = 0x0FABC0002;
+    // int8 raw buffer with values in [-8, 7] stored as two int4 per byte, the length is the number of values
+    static const uint32_t g_packed_int4_magic_number = 0x0FABC0003;
+
+    // the number of bytes of packed int4 values
+    inline int GetPackedInt4BytesSize(int count) {
+        return (count + 1) / 2;
+    }
 
     class Serializer {
     public:
@@ -64,6 +71,26 @@ namespace TNN_NS {
             return;
         }
 
+        // @brief put an int8 raw buffer whose values are all in [-8, 7], the low 4 bits of
+        // each byte keep the even value.
+        virtual void PutRawInt4(TNN_NS::RawBuffer &value) {
+            int count = value.GetBytesSize();
+            auto data = value.force_to<int8_t *>();
+
+            PutInt(g_packed_int4_magic_number);
+            PutInt(DATA_TYPE_INT8);
+            PutInt(count);
+            if (count <= 0) {
+                return;
+            }
+
+            std::string packed(GetPackedInt4BytesSize(count), 0);
+            for (int i = 0; i < count; i++) {
+                packed[i / 2] |= static_cast<char>((data[i] & 0x0F) << (i % 2 * 4));
+            }
+            _ostream.write(&packed[0], static_cast<std::streamsize>(packed.size()));
+        }
+
     protected:
         std::ostream &_ostream;
         
@@ -128,6 +155,16 @@ namespace TNN_NS {
             if (_istream.eof())
                 return;
             
+            if ((uint32_t)magic_number == g_packed_int4_magic_number) {
+                std::string packed(GetPackedInt4BytesSize(length), 0);
+                _istream.read(&packed[0], static_cast<std::streamsize>(packed.size()));
+                for (int i = 0; i < length; i++) {
+                    // sign extend the 4 bits
+                    int8_t nibble = (packed[i / 2] >> (i % 2 * 4)) & 0x0F;
+                    buffer[i]     = nibble >= 8 ? nibble - 16 : nibble;
+                }
+                return;
+            }
             _istream.read(buffer, static_cast<std::streamsize>(length));
             return;
         }
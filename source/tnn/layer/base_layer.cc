@@ -17,6 +17,9 @@
 #include <mutex>
 
 #include "tnn/core/macro.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 BaseLayer::BaseLayer(LayerType type) {
@@ -35,8 +38,16 @@ BaseLayer::~BaseLayer() {
 
 Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resource, std::vector<Blob*>& input_blobs,
                        std::vector<Blob*>& output_blobs, AbstractDevice* device) {
+    RETURN_ON_NEQ(PrepareInit(context, param, resource, input_blobs, output_blobs, device), TNN_OK);
+    return InitLayerAcc();
+}
+
+Status BaseLayer::PrepareInit(Context* context, LayerParam* param, LayerResource* resource,
+                              std::vector<Blob*>& input_blobs, std::vector<Blob*>& output_blobs,
+                              AbstractDevice* device) {
     input_blobs_  = input_blobs;
     output_blobs_ = output_blobs;
+    context_      = context;
 
     param_    = param;
     resource_ = resource;
@@ -64,12 +75,29 @@ Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resou
     }
 
     layer_acc_ = device->CreateLayerAcc(type_);
-    if (layer_acc_ != NULL) {
-        return layer_acc_->Init(context, param, resource, input_blobs_, output_blobs_);
-    } else {
+    if (layer_acc_ == NULL) {
         LOGE("layer acc of type(%d) is nil\n", type_);
         return Status(TNNERR_LAYER_ERR, "layer acc is nil");
     }
+    // the formats are decided before the next layers are prepared, the accs may init later
+    return layer_acc_->ResolveBlobDataFormats(input_blobs_, output_blobs_);
+}
+
+Status BaseLayer::InitLayerAcc() {
+    if (layer_acc_ == NULL) {
+        LOGE("layer acc is nil\n");
+        return Status(TNNERR_LAYER_ERR, "layer acc is nil");
+    }
+    // the layer accs compute with float weights unless they take the quantized ones, int8 layers keep
+    // their int8 weights
+    bool int8_layer = input_blobs_.size() > 0 && input_blobs_[0]->GetBlobDesc().data_type == DATA_TYPE_INT8;
+    if (!int8_layer && WeightQuantUtils::IsWeightOnlyQuantized(param_, resource_) &&
+        !(context_->GetKeepQuantizedWeights() &&
+          layer_acc_->IsQuantizedWeightsSupported(param_, resource_, input_blobs_))) {
+        RETURN_ON_NEQ(WeightQuantUtils::DequantizeLayerResource(param_, resource_, dequantized_resource_), TNN_OK);
+        resource_ = dequantized_resource_.get();
+    }
+    return layer_acc_->Init(context_, param_, resource_, input_blobs_, output_blobs_);
 }
 
 Status BaseLayer::InferOutputDataType() {
@@ -101,13 +129,95 @@ Status BaseLayer::Reshape() {
 
 Status BaseLayer::Forward() {
     if (layer_acc_ != NULL) {
-        return layer_acc_->Forward(input_blobs_, output_blobs_);
+        auto recorder = context_ ? context_->GetProfilingRecorder() : nullptr;
+        if (!recorder || !recorder->IsEnabled()) {
+            return layer_acc_->Forward(input_blobs_, output_blobs_);
+        }
+
+        // register the layer once per profiling session, the spans refer to it by id
+        if (profiling_session_ != recorder->GetSession()) {
+            profiling_session_ = recorder->GetSession();
+            profiling_id_      = recorder->AddLayer(GetProfilingData());
+        }
+        recorder->BeginLayer(profiling_id_);
+        Status ret = layer_acc_->Forward(input_blobs_, output_blobs_);
+        recorder->EndLayer();
+        return ret;
     } else {
         LOGE("layer acc is nil\n");
         return Status(TNNERR_LAYER_ERR, "layer acc is nil");
     }
 }
 
+static double GetBlobsBytes(const std::vector<Blob*>& blobs) {
+    double bytes = 0;
+    for (auto blob : blobs) {
+        auto desc = blob->GetBlobDesc();
+        bytes += 1.0 * DimsVectorUtils::Count(desc.dims) * DataTypeUtils::GetBytesSize(desc.data_type);
+    }
+    return bytes;
+}
+
+/*
+ * Estimate the mflops and mbytes from the param and shapes if the layer acc does not report them:
+ * 2 flops per mac for conv, deconv and inner product, one per kernel element for pooling
+ * and one per output element for the others. mbytes counts all blobs plus the fp32 weights.
+ */
+std::shared_ptr<ProfilingData> BaseLayer::GetProfilingData() {
+    auto pdata = std::make_shared<ProfilingData>();
+    if (input_blobs_.empty() || output_blobs_.empty()) {
+        pdata->layer_name = layer_name_;
+        return pdata;
+    }
+
+    auto input_dims  = input_blobs_[0]->GetBlobDesc().dims;
+    auto output_dims = output_blobs_[0]->GetBlobDesc().dims;
+    if (layer_acc_) {
+        layer_acc_->UpdateProfilingData(pdata.get(), param_, input_dims, output_dims);
+    }
+    pdata->layer_name = layer_name_;
+
+    double input_count  = DimsVectorUtils::Count(input_dims);
+    double output_count = DimsVectorUtils::Count(output_dims);
+    double macs         = 0;
+    double weights      = 0;
+    auto conv_param     = dynamic_cast<ConvLayerParam*>(param_);
+    auto pool_param     = dynamic_cast<PoolingLayerParam*>(param_);
+    auto ip_param       = dynamic_cast<InnerProductLayerParam*>(param_);
+    if (conv_param && input_dims.size() > 1 && output_dims.size() > 1 && conv_param->group > 0) {
+        double kernel_size = DimsVectorUtils::Count(conv_param->kernels);
+        weights            = 1.0 * input_dims[1] * output_dims[1] / conv_param->group * kernel_size;
+        if (type_ == LAYER_DECONVOLUTION) {
+            macs = input_count * output_dims[1] / conv_param->group * kernel_size;
+        } else {
+            macs = output_count * input_dims[1] / conv_param->group * kernel_size;
+        }
+    } else if (ip_param && input_dims.size() > 0 && input_dims[0] > 0) {
+        weights = input_count / input_dims[0] * output_count / input_dims[0];
+        macs    = output_count * input_count / input_dims[0];
+    }
+
+    if (pdata->flops <= 0) {
+        if (macs > 0) {
+            pdata->flops = 2.0 * macs / 1000.0 / 1000.0;
+        } else if (pool_param && input_dims.size() > 3) {
+            double kernel_size = DimsVectorUtils::Count(pool_param->kernels);
+            // global pooling has no kernel size
+            if (pool_param->kernels.empty() || kernel_size <= 0) {
+                kernel_size = 1.0 * input_dims[2] * input_dims[3];
+            }
+            pdata->flops = output_count * kernel_size / 1000.0 / 1000.0;
+        } else {
+            pdata->flops = output_count / 1000.0 / 1000.0;
+        }
+    }
+    if (pdata->bandwidth <= 0) {
+        pdata->bandwidth = (GetBlobsBytes(input_blobs_) + GetBlobsBytes(output_blobs_) + weights * sizeof(float)) /
+                           1000.0 / 1000.0;
+    }
+    return pdata;
+}
+
 void BaseLayer::SetLayerName(std::string layer_name) {
     layer_name_ = layer_name;
 }
@@ -126,6 +236,38 @@ std::vector<Blob*> BaseLayer::GetOutputBlobs() {
     return output_blobs_;
 }
 
+bool BaseLayer::IsResourceReleasable() {
+    return layer_acc_ != nullptr && layer_acc_->IsResourceReleasable();
+}
+
+void BaseLayer::ReleaseResource() {
+    if (layer_acc_ != nullptr) {
+        layer_acc_->ReleaseResource();
+    }
+    resource_             = nullptr;
+    dequantized_resource_ = nullptr;
+}
+
+PackedWeights BaseLayer::GetPackedWeights() {
+    return layer_acc_ != nullptr ? layer_acc_->GetPackedWeights() : PackedWeights();
+}
+
+Status BaseLayer::SetPackedWeights(const PackedWeights& packed_weights) {
+    if (layer_acc_ == NULL) {
+        LOGE("layer acc is nil\n");
+        return Status(TNNERR_LAYER_ERR, "layer acc is nil");
+    }
+    return layer_acc_->SetPackedWeights(packed_weights);
+}
+
+bool BaseLayer::IsBlobViewSupported() {
+    return layer_acc_ != nullptr && layer_acc_->IsBlobViewSupported();
+}
+
+bool BaseLayer::IsInplaceSupported() {
+    return layer_acc_ != nullptr && layer_acc_->IsInplaceSupported();
+}
+
 Status BaseLayer::InferShapeAhead(std::vector<Blob*>& input_blobs, std::vector<Blob*>& output_blobs, LayerParam* param,
                                   LayerResource* resource) {
     input_blobs_  = input_blobs;
@@ -43,6 +43,15 @@ public:
     Status Init(Context* context, LayerParam* param, LayerResource* resource, std::vector<Blob*>& inputs,
                 std::vector<Blob*>& outputs, AbstractDevice* device);
 
+    // @brief first step of Init: infer the output data types and shapes, create the layer acc and resolve
+    // the blob data formats. layers are prepared in order, on the blobs of the layers before them.
+    Status PrepareInit(Context* context, LayerParam* param, LayerResource* resource, std::vector<Blob*>& inputs,
+                       std::vector<Blob*>& outputs, AbstractDevice* device);
+
+    // @brief second step of Init: init the layer acc, which prepares the weights. it only touches the
+    // layer itself, the prepared layers can be initialized concurrently.
+    Status InitLayerAcc();
+
     //@brief Reshape recalculate the output tensor dims
     virtual Status Reshape();
 
@@ -61,6 +70,27 @@ public:
     //@brief get all output blobs
     virtual std::vector<Blob*> GetOutputBlobs();
 
+    //@brief whether the layer resource can be released after init
+    virtual bool IsResourceReleasable();
+
+    //@brief drop the pointers to the layer resource before it is released
+    void ReleaseResource();
+
+    //@brief the weights packed by the layer acc at init
+    PackedWeights GetPackedWeights();
+
+    //@brief set the weights packed ahead of time, between PrepareInit and InitLayerAcc
+    Status SetPackedWeights(const PackedWeights& packed_weights);
+
+    //@brief whether the layer acc runs with its blobs placed as channel views of each other
+    virtual bool IsBlobViewSupported();
+
+    //@brief whether the layer acc can write the output over a dying input
+    virtual bool IsInplaceSupported();
+
+    //@brief name, shapes, mflops and mbytes of the layer with its current blobs
+    virtual std::shared_ptr<ProfilingData> GetProfilingData();
+
     //@brief infer shape ahead for generate resource
     virtual Status InferShapeAhead(std::vector<Blob*>& input_blobs, std::vector<Blob*>& output_blobs, LayerParam* param,
                                    LayerResource* resource);
@@ -76,6 +106,12 @@ protected:
 
     LayerParam* param_;
     LayerResource* resource_;
+    // float copy of a weight only quantized resource
+    std::shared_ptr<LayerResource> dequantized_resource_;
+
+    Context* context_       = nullptr;
+    int profiling_session_ = 0;
+    int profiling_id_      = -1;
 
     //@brief calculate the output tensor dims
     virtual Status InferOutputShape() = 0;
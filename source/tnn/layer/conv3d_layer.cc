@@ -27,9 +27,10 @@ Status Conv3DLayer::InferOutputDataType() {
 Status Conv3DLayer::InferOutputShape() {
     Blob* input_blob  = input_blobs_[0];
     Blob* output_blob = output_blobs_[0];
-    if (input_blob->GetBlobDesc().data_format != DATA_FORMAT_NCDHW) {
-        LOGE("Error: Conv3D layer only support NCDHW data format\n");
-        return Status(TNNERR_LAYER_ERR, "Error: Conv3D layer only support NCDHW data format");
+    // the format is decided by the layer acc, NCDHW on naive and channel packed NC4HW4 of 5 dims on arm
+    if (input_blob->GetBlobDesc().dims.size() != 5) {
+        LOGE("Error: Conv3D layer only support 5 dims input\n");
+        return Status(TNNERR_LAYER_ERR, "Error: Conv3D layer only support 5 dims input");
     }
 
     ConvLayerParam* conv_param = dynamic_cast<ConvLayerParam*>(param_);
@@ -142,8 +143,7 @@ Status Conv3DLayer::InferOutputShape() {
     output_dims.push_back(depth_out);
     output_dims.push_back(height_out);
     output_dims.push_back(width_out);
-    output_blob->GetBlobDesc().dims        = output_dims;
-    output_blob->GetBlobDesc().data_format = DATA_FORMAT_NCDHW;
+    output_blob->GetBlobDesc().dims = output_dims;
 
     return TNN_OK;
 }
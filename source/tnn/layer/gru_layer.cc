@@ -0,0 +1,61 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_LAYER(GRU, LAYER_GRU);
+
+Status GRULayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+/*
+ * input:   x [seq][batch][input], the initial h [direction][batch][hidden] are optional
+ * outputs: y [seq][direction][batch][hidden], the last h [direction][batch][hidden]
+ * the 3 dims tensors of onnx are 4 dims blobs with a trailing 1
+ */
+Status GRULayer::InferOutputShape() {
+    auto layer_param = dynamic_cast<GRULayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    const auto& dims_input = input_blobs_[0]->GetBlobDesc().dims;
+    if (dims_input.size() < 3 || layer_param->hidden_size <= 0 || layer_param->direction < 0 ||
+        layer_param->direction > 2) {
+        LOGE("Error: GRU layer got invalid input or param\n");
+        return Status(TNNERR_LAYER_ERR, "Error: GRU layer got invalid input or param");
+    }
+    if (input_blobs_.size() > 2 || output_blobs_.size() > 2) {
+        LOGE("Error: GRU layer got %d inputs and %d outputs\n", (int)input_blobs_.size(), (int)output_blobs_.size());
+        return Status(TNNERR_LAYER_ERR, "Error: GRU layer got invalid inputs or outputs");
+    }
+
+    const int seq        = dims_input[0];
+    const int batch      = dims_input[1];
+    const int hidden     = layer_param->hidden_size;
+    const int directions = layer_param->direction == 2 ? 2 : 1;
+
+    output_blobs_[0]->GetBlobDesc().dims = {seq, directions, batch, hidden};
+    for (int i = 1; i < output_blobs_.size(); i++) {
+        output_blobs_[i]->GetBlobDesc().dims = {directions, batch, hidden, 1};
+    }
+    return TNN_OK;
+}
+
+REGISTER_LAYER(GRU, LAYER_GRU);
+
+}  // namespace TNN_NS
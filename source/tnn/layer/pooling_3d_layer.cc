@@ -128,11 +128,11 @@ Status Pooling3DLayer::InferOutputShape() {
             if (pool_param->ceil_mode == 1) {
                 rectify_height_out = int(std::ceil(float(height + pad_h + pad_down - kernel_h) / (float)stride_h + 1));
                 rectify_width_out  = int(std::ceil(float(width + pad_w + pad_right - kernel_w) / (float)stride_w + 1));
-                rectify_depth_out  = int(std::ceil(float(depth + pad_d + pad_back - stride_d) / (float)stride_d + 1));
+                rectify_depth_out  = int(std::ceil(float(depth + pad_d + pad_back - kernel_d) / (float)stride_d + 1));
             } else {
                 rectify_height_out = int(std::floor(float(height + pad_h + pad_down - kernel_h) / (float)stride_h + 1));
                 rectify_width_out  = int(std::floor(float(width + pad_w + pad_right - kernel_w) / (float)stride_w + 1));
-                rectify_depth_out  = int(std::floor(float(depth + pad_d + pad_back - stride_d) / (float)stride_d + 1));
+                rectify_depth_out  = int(std::floor(float(depth + pad_d + pad_back - kernel_d) / (float)stride_d + 1));
             }
 
             if (rectify_height_out != height_out || rectify_width_out != width_out || rectify_depth_out != depth_out) {
@@ -174,8 +174,8 @@ Status Pooling3DLayer::InferOutputShape() {
 
         // align with pytorch in ceil mode.
         int pad_top   = int(std::ceil(float(pad_along_height) / float(stride_h)));
-        int pad_left  = int(std::ceil(float(pad_along_width) / float(stride_h)));
-        int pad_front = int(std::ceil(float(pad_along_depth) / float(stride_h)));
+        int pad_left  = int(std::ceil(float(pad_along_width) / float(stride_w)));
+        int pad_front = int(std::ceil(float(pad_along_depth) / float(stride_d)));
 
         int pad_down  = pad_along_height - pad_top;
         int pad_right = pad_along_width - pad_left;
@@ -60,6 +60,11 @@ Status BlobMemory::AllocateHandle() {
 }
 
 void BlobMemory::SetHandleFromExternal(BlobHandle handle) {
+    // the naive accs read the base of the handle only, give them the offset memory as a plain pointer
+    if (device_->GetDeviceType() == DEVICE_NAIVE && handle.base) {
+        handle.base         = static_cast<char*>(handle.base) + handle.bytes_offset;
+        handle.bytes_offset = 0;
+    }
     handle_              = handle;
     need_release_memory_ = false;
 }
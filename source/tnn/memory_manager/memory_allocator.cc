@@ -0,0 +1,370 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/memory_manager/memory_allocator.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/numa_utils.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <sys/mman.h>
+#include <sys/resource.h>
+#define TNN_HUGE_PAGE_SUPPORTED 1
+#endif
+
+#ifdef __ANDROID__
+#include <malloc.h>
+#endif
+
+namespace TNN_NS {
+
+static const size_t kAlignment    = 64;
+static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+static inline size_t RoundUpSize(size_t size, size_t unit) {
+    return (size + unit - 1) / unit * unit;
+}
+
+static inline void *SystemMalloc(size_t size) {
+#if _POSIX_C_SOURCE >= 200112L || (__ANDROID__ && __ANDROID_API__ >= 17)
+    void *ptr = 0;
+    if (posix_memalign(&ptr, kAlignment, size))
+        ptr = 0;
+    return ptr;
+#elif __ANDROID__ && __ANDROID_API__ < 17
+    return memalign(kAlignment, size);
+#else
+    return malloc(size);
+#endif
+}
+
+#ifdef TNN_HUGE_PAGE_SUPPORTED
+// map size bytes aligned to the huge page size, so that all of them can be backed by transparent huge pages
+static void *MapHugePages(size_t size, bool use_hugetlb) {
+    void *ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (use_hugetlb) {
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            return ptr;
+        }
+    }
+#endif
+    ptr = mmap(nullptr, size + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+    uintptr_t begin   = (uintptr_t)ptr;
+    uintptr_t aligned = RoundUpSize(begin, kHugePageSize);
+    if (aligned > begin) {
+        munmap(ptr, aligned - begin);
+    }
+    munmap((void *)(aligned + size), begin + kHugePageSize - aligned);
+#ifdef MADV_HUGEPAGE
+    madvise((void *)aligned, size, MADV_HUGEPAGE);
+#endif
+    return (void *)aligned;
+}
+#endif
+
+// header before a malloc block, within the alignment padding
+struct BlockHeader {
+    const void *owner;
+    size_t size;
+    int node;
+};
+static_assert(sizeof(BlockHeader) <= kAlignment, "the block header must fit in the alignment");
+
+static inline BlockHeader *GetBlockHeader(void *data) {
+    return (BlockHeader *)((char *)data - kAlignment);
+}
+
+#ifdef TNN_HUGE_PAGE_SUPPORTED
+struct MappedBlock {
+    const void *owner;
+    size_t size;
+    size_t mapped_size;
+    bool huge_page;
+    int node;
+};
+
+/*
+ * The blocks mapped with mmap by all the allocators. They are page aligned and have no header, a malloc block
+ * is page aligned only by chance, so the lock is taken only to free the mapped and the page aligned blocks.
+ */
+struct MappedBlocks {
+    std::mutex mutex;
+    std::unordered_map<void *, MappedBlock> blocks;
+};
+
+// never destroyed, memory may be freed by static objects at exit
+static MappedBlocks &GetMappedBlocks() {
+    static MappedBlocks *mapped_blocks = new MappedBlocks();
+    return *mapped_blocks;
+}
+
+static inline bool IsPageAligned(void *data) {
+    return (uintptr_t)data % NumaUtils::GetPageSize() == 0;
+}
+#endif
+
+SystemMemoryAllocator::SystemMemoryAllocator(const AllocatorConfig &config)
+    : config_(config),
+      bytes_reserved_(0),
+      bytes_in_use_(0),
+      bytes_huge_page_(0),
+      num_allocations_(0),
+      num_pool_hits_(0) {}
+
+SystemMemoryAllocator::~SystemMemoryAllocator() {}
+
+Status SystemMemoryAllocator::AllocateBlock(void **data, size_t size, Block &block) {
+    *data             = nullptr;
+    block.size        = size;
+    block.mapped_size = 0;
+    block.huge_page   = false;
+    block.node        = NumaUtils::GetThreadNode();
+#ifdef TNN_HUGE_PAGE_SUPPORTED
+    if (config_.huge_page_threshold > 0 && size >= config_.huge_page_threshold) {
+        size_t mapped_size = RoundUpSize(size, kHugePageSize);
+        *data              = MapHugePages(mapped_size, config_.use_hugetlb);
+        if (*data) {
+            block.mapped_size = mapped_size;
+            block.huge_page   = true;
+            bytes_huge_page_ += mapped_size;
+        }
+    }
+    // malloc may share the pages of a block with other memory, a block of a numa node gets its own pages
+    if (!*data && block.node >= 0) {
+        size_t mapped_size = RoundUpSize(size, NumaUtils::GetPageSize());
+        void *ptr          = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr != MAP_FAILED) {
+            *data             = ptr;
+            block.mapped_size = mapped_size;
+        }
+    }
+    if (*data && block.node >= 0) {
+        // the pages are not touched yet, they are placed on the node whichever thread writes them first
+        Status status = NumaUtils::BindMemory(*data, block.mapped_size, block.node);
+        if (status != TNN_OK) {
+            LOGD("bind memory to numa node %d failed: %s\n", block.node, status.description().c_str());
+        }
+    }
+    if (*data) {
+        auto &mapped_blocks = GetMappedBlocks();
+        std::lock_guard<std::mutex> lock(mapped_blocks.mutex);
+        mapped_blocks.blocks[*data] = {this, block.size, block.mapped_size, block.huge_page, block.node};
+    }
+#endif
+    if (!*data) {
+        char *ptr = (char *)SystemMalloc(size + kAlignment);
+        if (ptr) {
+            *data               = ptr + kAlignment;
+            BlockHeader *header = GetBlockHeader(*data);
+            header->owner       = this;
+            header->size        = size;
+            header->node        = block.node;
+        }
+    }
+    if (!*data) {
+        LOGE("allocate %zu bytes failed\n", size);
+        return Status(TNNERR_OUTOFMEMORY, "allocate host memory failed");
+    }
+    bytes_reserved_ += size;
+    return TNN_OK;
+}
+
+void SystemMemoryAllocator::FreeBlock(void *data, const Block &block) {
+    bytes_reserved_ -= block.size;
+#ifdef TNN_HUGE_PAGE_SUPPORTED
+    if (block.mapped_size > 0) {
+        {
+            auto &mapped_blocks = GetMappedBlocks();
+            std::lock_guard<std::mutex> lock(mapped_blocks.mutex);
+            mapped_blocks.blocks.erase(data);
+        }
+        munmap(data, block.mapped_size);
+        if (block.huge_page) {
+            bytes_huge_page_ -= block.mapped_size;
+        }
+        return;
+    }
+#endif
+    GetBlockHeader(data)->owner = nullptr;
+    free((char *)data - kAlignment);
+}
+
+bool SystemMemoryAllocator::FindBlock(void *data, Block &block) {
+#ifdef TNN_HUGE_PAGE_SUPPORTED
+    if (IsPageAligned(data)) {
+        auto &mapped_blocks = GetMappedBlocks();
+        std::lock_guard<std::mutex> lock(mapped_blocks.mutex);
+        auto iter = mapped_blocks.blocks.find(data);
+        if (iter != mapped_blocks.blocks.end()) {
+            const MappedBlock &mapped = iter->second;
+            block.size                = mapped.size;
+            block.mapped_size         = mapped.mapped_size;
+            block.huge_page           = mapped.huge_page;
+            block.node                = mapped.node;
+            return mapped.owner == this;
+        }
+    }
+#endif
+    // all the host memory is allocated by the allocators of tnn, the header of a malloc block is readable
+    const BlockHeader *header = GetBlockHeader(data);
+    if (header->owner != this) {
+        return false;
+    }
+    block.size        = header->size;
+    block.mapped_size = 0;
+    block.huge_page   = false;
+    block.node        = header->node;
+    return true;
+}
+
+Status SystemMemoryAllocator::Allocate(void **data, size_t size) {
+    Block block;
+    RETURN_ON_NEQ(AllocateBlock(data, size > 0 ? size : 1, block), TNN_OK);
+    bytes_in_use_ += block.size;
+    num_allocations_++;
+    return TNN_OK;
+}
+
+Status SystemMemoryAllocator::Free(void *data) {
+    Block block;
+    if (!FindBlock(data, block)) {
+        return Status(TNNERR_PARAM_ERR, "memory is not allocated by this allocator");
+    }
+    bytes_in_use_ -= block.size;
+    FreeBlock(data, block);
+    return TNN_OK;
+}
+
+AllocatorStats SystemMemoryAllocator::GetStats() {
+    AllocatorStats stats;
+    stats.bytes_reserved  = bytes_reserved_;
+    stats.bytes_in_use    = bytes_in_use_;
+    stats.bytes_huge_page = bytes_huge_page_;
+    stats.num_allocations = num_allocations_;
+    stats.num_pool_hits   = num_pool_hits_;
+    return stats;
+}
+
+/*
+ * The current allocator is read and replaced atomically, so that allocating and freeing through it take no
+ * lock other than the one of a pool allocator. The mutex only guards the replaced allocators, which are
+ * searched when the current one does not own the freed memory.
+ */
+struct HostAllocators {
+    HostAllocators() : current(std::make_shared<SystemMemoryAllocator>(AllocatorConfig())) {}
+
+    std::shared_ptr<MemoryAllocator> current;
+    std::mutex mutex;
+    // replaced allocators with memory in use
+    std::vector<std::shared_ptr<MemoryAllocator>> previous;
+};
+
+// never destroyed, memory may be freed by static objects at exit
+static HostAllocators &GetHostAllocators() {
+    static HostAllocators *allocators = new HostAllocators();
+    return *allocators;
+}
+
+std::shared_ptr<MemoryAllocator> MemoryAllocator::GetHostAllocator() {
+    return std::atomic_load(&GetHostAllocators().current);
+}
+
+void MemoryAllocator::SetHostAllocator(std::shared_ptr<MemoryAllocator> allocator) {
+    if (!allocator) {
+        allocator = std::make_shared<SystemMemoryAllocator>(AllocatorConfig());
+    }
+    auto &allocators = GetHostAllocators();
+    std::lock_guard<std::mutex> lock(allocators.mutex);
+    // other threads may still allocate from the replaced allocator, it is kept until its memory is freed
+    auto last = std::atomic_load(&allocators.current);
+    allocators.previous.erase(std::remove_if(allocators.previous.begin(), allocators.previous.end(),
+                                             [](const std::shared_ptr<MemoryAllocator> &previous) {
+                                                 return previous->GetStats().bytes_in_use == 0;
+                                             }),
+                              allocators.previous.end());
+    allocators.previous.push_back(last);
+    std::atomic_store(&allocators.current, allocator);
+}
+
+Status MemoryAllocator::FreeHostMemory(void *data) {
+    if (!data) {
+        return TNN_OK;
+    }
+    auto &allocators = GetHostAllocators();
+    if (std::atomic_load(&allocators.current)->Free(data) == TNN_OK) {
+        return TNN_OK;
+    }
+
+    // memory of a replaced allocator
+    std::lock_guard<std::mutex> lock(allocators.mutex);
+    for (auto iter = allocators.previous.begin(); iter != allocators.previous.end(); iter++) {
+        if ((*iter)->Free(data) == TNN_OK) {
+            if ((*iter)->GetStats().bytes_in_use == 0) {
+                allocators.previous.erase(iter);
+            }
+            return TNN_OK;
+        }
+    }
+    // the allocator may have been replaced after the first try
+    if (std::atomic_load(&allocators.current)->Free(data) == TNN_OK) {
+        return TNN_OK;
+    }
+    LOGE("free host memory %p not allocated by tnn\n", data);
+    return Status(TNNERR_PARAM_ERR, "memory is not allocated by the host allocators");
+}
+
+AllocatorStats MemoryAllocator::GetHostStats() {
+    AllocatorStats stats;
+    {
+        auto &allocators = GetHostAllocators();
+        std::vector<std::shared_ptr<MemoryAllocator>> all;
+        {
+            std::lock_guard<std::mutex> lock(allocators.mutex);
+            all = allocators.previous;
+        }
+        all.push_back(std::atomic_load(&allocators.current));
+        for (auto allocator : all) {
+            auto allocator_stats = allocator->GetStats();
+            stats.bytes_reserved += allocator_stats.bytes_reserved;
+            stats.bytes_in_use += allocator_stats.bytes_in_use;
+            stats.bytes_huge_page += allocator_stats.bytes_huge_page;
+            stats.num_allocations += allocator_stats.num_allocations;
+            stats.num_pool_hits += allocator_stats.num_pool_hits;
+        }
+    }
+#ifdef TNN_HUGE_PAGE_SUPPORTED
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        stats.minor_page_faults = usage.ru_minflt;
+        stats.major_page_faults = usage.ru_majflt;
+    }
+#endif
+    return stats;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,93 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_ALLOCATOR_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_ALLOCATOR_H_
+
+#include <atomic>
+#include <memory>
+
+#include "tnn/core/status.h"
+#include "tnn/utils/allocator_utils.h"
+
+namespace TNN_NS {
+
+// @brief allocator of host memory. The host allocator is used by the ARM and NAIVE devices and by RawBuffer,
+// it can be replaced while memory is in use, the memory is then freed to the allocator it came from.
+class MemoryAllocator {
+public:
+    virtual ~MemoryAllocator() {}
+
+    // @brief allocate at least size bytes, 64 bytes aligned
+    virtual Status Allocate(void **data, size_t size) = 0;
+
+    // @brief free memory of this allocator, TNNERR_PARAM_ERR if it is not allocated by this allocator
+    virtual Status Free(void *data) = 0;
+
+    // @brief bytes and allocation counts, without the page faults
+    virtual AllocatorStats GetStats() = 0;
+
+    // @brief release the cached memory to the system
+    virtual void Trim() {}
+
+    static std::shared_ptr<MemoryAllocator> GetHostAllocator();
+
+    static void SetHostAllocator(std::shared_ptr<MemoryAllocator> allocator);
+
+    // @brief free host memory to the allocator it came from, the current or a previous one
+    static Status FreeHostMemory(void *data);
+
+    // @brief stats of the current and the previous allocators still in use
+    static AllocatorStats GetHostStats();
+};
+
+// @brief SystemMemoryAllocator allocates from the system, with mmap for the memory above the huge page threshold.
+// The memory allocated inside a NumaNodeGuard is mapped on its own pages and bound to the numa node.
+// Allocating and freeing a malloc block takes no lock, its size and owner are kept in a header before the block.
+class SystemMemoryAllocator : public MemoryAllocator {
+public:
+    explicit SystemMemoryAllocator(const AllocatorConfig &config);
+    virtual ~SystemMemoryAllocator();
+
+    virtual Status Allocate(void **data, size_t size) override;
+    virtual Status Free(void *data) override;
+    virtual AllocatorStats GetStats() override;
+
+protected:
+    struct Block {
+        size_t size = 0;
+        // bytes mapped with mmap, 0 if the block is from malloc
+        size_t mapped_size = 0;
+        bool huge_page     = false;
+        // numa node the block is bound to, -1 if none
+        int node = -1;
+    };
+
+    // allocate a block from the system and add it to bytes_reserved
+    Status AllocateBlock(void **data, size_t size, Block &block);
+    void FreeBlock(void *data, const Block &block);
+    // false if the block is not allocated by this allocator
+    bool FindBlock(void *data, Block &block);
+
+    AllocatorConfig config_;
+    std::atomic<size_t> bytes_reserved_;
+    std::atomic<size_t> bytes_in_use_;
+    std::atomic<size_t> bytes_huge_page_;
+    std::atomic<long long> num_allocations_;
+    std::atomic<long long> num_pool_hits_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_ALLOCATOR_H_
@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/memory_manager/pool_memory_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "tnn/utils/numa_utils.h"
+
+namespace TNN_NS {
+
+PoolMemoryAllocator::PoolMemoryAllocator(const AllocatorConfig &config) : SystemMemoryAllocator(config) {}
+
+PoolMemoryAllocator::~PoolMemoryAllocator() {
+    TrimLocked();
+}
+
+size_t PoolMemoryAllocator::GetSizeClass(size_t size) {
+    if (size <= 256) {
+        return 256;
+    }
+    size_t power = 256;
+    while (power <= size / 2) {
+        power *= 2;
+    }
+    // at most 25% of a block is unused
+    size_t step = power / 4;
+    return (size + step - 1) / step * step;
+}
+
+Status PoolMemoryAllocator::Allocate(void **data, size_t size) {
+    size_t size_class = GetSizeClass(size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Block block;
+    auto &free_blocks = free_blocks_[size_class];
+    // a cached block is reused only on the numa node it is bound to
+    const int node = NumaUtils::GetThreadNode();
+    auto cached    = std::find_if(free_blocks.rbegin(), free_blocks.rend(),
+                               [node](const std::pair<void *, Block> &item) { return item.second.node == node; });
+    if (cached != free_blocks.rend()) {
+        *data = cached->first;
+        block = cached->second;
+        free_blocks.erase(std::next(cached).base());
+        cached_bytes_ -= block.size;
+        num_pool_hits_++;
+    } else {
+        RETURN_ON_NEQ(AllocateBlock(data, size_class, block), TNN_OK);
+    }
+    blocks_[*data] = block;
+    bytes_in_use_ += block.size;
+    num_allocations_++;
+    return TNN_OK;
+}
+
+Status PoolMemoryAllocator::Free(void *data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = blocks_.find(data);
+    if (iter == blocks_.end()) {
+        return Status(TNNERR_PARAM_ERR, "memory is not allocated by this allocator");
+    }
+    Block block = iter->second;
+    blocks_.erase(iter);
+    bytes_in_use_ -= block.size;
+    if (cached_bytes_ + block.size <= config_.max_cached_bytes) {
+        free_blocks_[block.size].push_back(std::make_pair(data, block));
+        cached_bytes_ += block.size;
+    } else {
+        FreeBlock(data, block);
+    }
+    return TNN_OK;
+}
+
+void PoolMemoryAllocator::Trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked();
+}
+
+void PoolMemoryAllocator::TrimLocked() {
+    for (auto &free_blocks : free_blocks_) {
+        for (auto &free_block : free_blocks.second) {
+            FreeBlock(free_block.first, free_block.second);
+        }
+    }
+    free_blocks_.clear();
+    cached_bytes_ = 0;
+}
+
+}  // namespace TNN_NS
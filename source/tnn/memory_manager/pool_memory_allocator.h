@@ -0,0 +1,53 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_POOL_MEMORY_ALLOCATOR_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_POOL_MEMORY_ALLOCATOR_H_
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "tnn/memory_manager/memory_allocator.h"
+
+namespace TNN_NS {
+
+// @brief PoolMemoryAllocator rounds the sizes up to size classes, 4 classes for each power of 2, and keeps
+// the freed blocks of each class for reuse until max_cached_bytes is reached.
+class PoolMemoryAllocator : public SystemMemoryAllocator {
+public:
+    explicit PoolMemoryAllocator(const AllocatorConfig &config);
+    virtual ~PoolMemoryAllocator();
+
+    virtual Status Allocate(void **data, size_t size) override;
+    virtual Status Free(void *data) override;
+    virtual void Trim() override;
+
+    static size_t GetSizeClass(size_t size);
+
+private:
+    void TrimLocked();
+
+    std::mutex mutex_;
+    // blocks in use
+    std::unordered_map<void *, Block> blocks_;
+    // cached blocks of each size class
+    std::map<size_t, std::vector<std::pair<void *, Block>>> free_blocks_;
+    size_t cached_bytes_ = 0;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_POOL_MEMORY_ALLOCATOR_H_
@@ -27,11 +27,13 @@ bool operator<(SharedMemoryId lhs, SharedMemoryId rhs) {
 
 std::map<SharedMemoryId, SharedMemory> SharedMemoryManager::s_shared_forward_memory;
 std::map<SharedMemoryId, std::vector<ISharedMemoryChangeListener *>> SharedMemoryManager::s_shared_memory_instances;
+std::mutex SharedMemoryManager::s_shared_memory_mutex;
 
 SharedMemory SharedMemoryManager::GetSharedMemory(int forward_memory_size, std::thread::id thread_id,
                                                   AbstractDevice *device, int device_id,
                                                   ISharedMemoryChangeListener *listener,
                                                   Status &status) {
+    std::lock_guard<std::mutex> lock(s_shared_memory_mutex);
     SharedMemoryId memory_id;
     memory_id.thread_id                                          = thread_id;
     memory_id.device_type                                        = device->GetDeviceType();
@@ -64,6 +66,7 @@ SharedMemory SharedMemoryManager::GetSharedMemory(int forward_memory_size, std::
 
 void SharedMemoryManager::ReleaseSharedMemory(std::thread::id thread_id, AbstractDevice *device, int device_id,
                                               ISharedMemoryChangeListener *listener) {
+    std::lock_guard<std::mutex> lock(s_shared_memory_mutex);
     SharedMemoryId memory_id;
     memory_id.thread_id                                          = thread_id;
     memory_id.device_type                                        = device->GetDeviceType();
@@ -79,6 +82,7 @@ void SharedMemoryManager::ReleaseSharedMemory(std::thread::id thread_id, Abstrac
     if (memory.shared_memory_ref_count == 0) {
         device->Free(memory.shared_memory_data);
         s_shared_forward_memory.erase(memory_id);
+        s_shared_memory_instances.erase(memory_id);
     }
 }
 
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <thread>
@@ -61,6 +62,8 @@ private:
     static std::map<SharedMemoryId, SharedMemory> s_shared_forward_memory;
     static std::map<SharedMemoryId, std::vector<ISharedMemoryChangeListener *>>
         s_shared_memory_instances;
+    // instances of different threads are created and released concurrently
+    static std::mutex s_shared_memory_mutex;
 };
 
 }  // namespace TNN_NS
@@ -0,0 +1,318 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_eliminate_reformat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // Pfinal priority: eliminate after all reformat layers are inserted
+    NetOptimizerRegister<NetOptimizerEliminateReformat> g_net_optimizer_eliminate_reformat(OptPriority::PFINAL);
+
+    std::string NetOptimizerEliminateReformat::Strategy() {
+        return kNetOptimizerEliminateReformat;
+    }
+
+    bool NetOptimizerEliminateReformat::IsSupported(const NetworkConfig &net_config) {
+        auto device = net_config.device_type;
+        return device == DEVICE_ARM || device == DEVICE_NAIVE;
+    }
+
+    static ReformatLayerParam *GetReformatParam(std::shared_ptr<LayerInfo> layer) {
+        if (!layer || layer->type != LAYER_REFORMAT || layer->inputs.size() != 1 || layer->outputs.size() != 1) {
+            return nullptr;
+        }
+        return dynamic_cast<ReformatLayerParam *>(layer->param.get());
+    }
+
+    static bool IsSameReformat(ReformatLayerParam *a, ReformatLayerParam *b) {
+        return a->src_type == b->src_type && a->dst_type == b->dst_type && a->src_format == b->src_format &&
+               a->dst_format == b->dst_format;
+    }
+
+    static bool IsInverseReformat(ReformatLayerParam *a, ReformatLayerParam *b) {
+        return a->src_type == b->dst_type && a->dst_type == b->src_type && a->src_format == b->dst_format &&
+               a->dst_format == b->src_format;
+    }
+
+    static bool IsSameBuffer(RawBuffer &a, RawBuffer &b) {
+        if (a.GetBytesSize() != b.GetBytesSize()) {
+            return false;
+        }
+        return a.GetBytesSize() == 0 || memcmp(a.force_to<char *>(), b.force_to<char *>(), a.GetBytesSize()) == 0;
+    }
+
+    // int8 blobs are equal after a round trip only if they are quantized with the same scale
+    static bool IsSameScale(NetResource *resource, const std::string &blob0, const std::string &blob1) {
+        if (!resource) {
+            return false;
+        }
+        auto scale0 =
+            std::dynamic_pointer_cast<IntScaleResource>(GetLayerResource(resource, blob0 + BLOB_SCALE_SUFFIX));
+        auto scale1 =
+            std::dynamic_pointer_cast<IntScaleResource>(GetLayerResource(resource, blob1 + BLOB_SCALE_SUFFIX));
+        if (!scale0 || !scale1) {
+            return false;
+        }
+        return IsSameBuffer(scale0->scale_handle, scale1->scale_handle) &&
+               IsSameBuffer(scale0->bias_handle, scale1->bias_handle);
+    }
+
+    Status NetOptimizerEliminateReformat::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        const int count = (const int)structure->layers.size();
+        if (count <= 1) {
+            return TNN_OK;
+        }
+
+        auto reformat_layer =
+            std::find_if(structure->layers.begin(), structure->layers.end(),
+                         [](std::shared_ptr<LayerInfo> iter) { return iter->type == LAYER_REFORMAT; });
+        if (reformat_layer == structure->layers.end()) {
+            return TNN_OK;
+        }
+
+        SplitReformat(structure);
+
+        // every step rebuilds the graph, run until none of them changes the structure
+        bool changed = true;
+        while (changed) {
+            changed = ShareReformat(structure) || CancelReformat(structure, resource) || FoldReformat(structure) ||
+                      RemoveUnusedReformat(structure);
+        }
+        producers_.clear();
+        consumers_.clear();
+
+        return TNN_OK;
+    }
+
+    /*
+     * The precision passes insert one reformat for all the converted outputs of a layer,
+     * split them into one reformat per blob so that each blob can be optimized on its own.
+     */
+    void NetOptimizerEliminateReformat::SplitReformat(NetStructure *structure) {
+        std::vector<std::shared_ptr<LayerInfo>> layers_split;
+        for (auto layer : structure->layers) {
+            auto param = dynamic_cast<ReformatLayerParam *>(layer->param.get());
+            if (layer->type != LAYER_REFORMAT || !param || layer->inputs.size() <= 1 ||
+                layer->inputs.size() != layer->outputs.size()) {
+                layers_split.push_back(layer);
+                continue;
+            }
+            for (int i = 0; i < layer->inputs.size(); i++) {
+                std::shared_ptr<LayerInfo> new_layer = std::shared_ptr<LayerInfo>(new LayerInfo());
+                new_layer->type                      = layer->type;
+                new_layer->type_str                  = layer->type_str;
+                new_layer->name                      = i == 0 ? layer->name : layer->name + "_" + std::to_string(i);
+                new_layer->param = std::shared_ptr<LayerParam>(new ReformatLayerParam(*param));
+                new_layer->inputs.push_back(layer->inputs[i]);
+                new_layer->outputs.push_back(layer->outputs[i]);
+                layers_split.push_back(new_layer);
+            }
+        }
+        structure->layers = layers_split;
+    }
+
+    // share the first reformat of a blob among all the layers reading the same conversion
+    bool NetOptimizerEliminateReformat::ShareReformat(NetStructure *structure) {
+        std::map<std::string, std::vector<std::shared_ptr<LayerInfo>>> reformats;
+        std::set<LayerInfo *> removed;
+        for (auto layer : structure->layers) {
+            auto param = GetReformatParam(layer);
+            if (!param) {
+                continue;
+            }
+            auto input  = layer->inputs[0];
+            auto output = layer->outputs[0];
+            bool shared = false;
+            for (auto other : reformats[input]) {
+                if (IsSameReformat(GetReformatParam(other), param) && structure->outputs.count(output) == 0) {
+                    LOGD("Share refomat layer: %s with %s\n", layer->name.c_str(), other->name.c_str());
+                    ReplaceInput(structure, output, other->outputs[0]);
+                    RemoveBlob(structure, output);
+                    removed.insert(layer.get());
+                    shared = true;
+                    break;
+                }
+            }
+            if (!shared) {
+                reformats[input].push_back(layer);
+            }
+        }
+        RemoveLayers(structure, removed);
+        return !removed.empty();
+    }
+
+    /*
+     * A reformat reading the output of its inverse gives back the original blob. Only the round trips
+     * through fp32 are cancelled, the ones through fp16 or int8 lose precision on purpose.
+     */
+    bool NetOptimizerEliminateReformat::CancelReformat(NetStructure *structure, NetResource *resource) {
+        UpdateGraph(structure);
+        std::set<LayerInfo *> removed;
+        for (auto layer : structure->layers) {
+            auto param = GetReformatParam(layer);
+            if (!param || removed.count(layer.get()) > 0) {
+                continue;
+            }
+            auto mid      = layer->inputs[0];
+            auto output   = layer->outputs[0];
+            auto producer = producers_.count(mid) > 0 ? producers_[mid] : nullptr;
+            auto prev     = GetReformatParam(producer);
+            if (!prev || removed.count(producer.get()) > 0 || !IsInverseReformat(prev, param)) {
+                continue;
+            }
+            auto input = producer->inputs[0];
+            if (prev->dst_type != DATA_TYPE_FLOAT || structure->outputs.count(output) > 0) {
+                continue;
+            }
+            if (prev->src_type == DATA_TYPE_INT8 && !IsSameScale(resource, input, output)) {
+                continue;
+            }
+
+            LOGD("Cancel refomat layer: %s with %s\n", layer->name.c_str(), producer->name.c_str());
+            ReplaceInput(structure, output, input);
+            RemoveBlob(structure, output);
+            removed.insert(layer.get());
+        }
+        RemoveLayers(structure, removed);
+        return !removed.empty();
+    }
+
+    /*
+     * Int8 conv kernels apply relu in their epilogue, and relu commutes with the dequant, so
+     * int8 conv -> dequant -> fp32 relu becomes int8 conv with relu -> dequant.
+     */
+    bool NetOptimizerEliminateReformat::FoldReformat(NetStructure *structure) {
+        UpdateGraph(structure);
+        std::set<LayerInfo *> removed;
+        for (auto layer : structure->layers) {
+            auto conv_param = dynamic_cast<ConvLayerParam *>(layer->param.get());
+            if (layer->type != LAYER_CONVOLUTION || !conv_param || !conv_param->quantized ||
+                conv_param->activation_type != ActivationType_None || layer->outputs.size() != 1) {
+                continue;
+            }
+            auto conv_out = layer->outputs[0];
+            if (structure->outputs.count(conv_out) > 0 || consumers_[conv_out].size() != 1) {
+                continue;
+            }
+            auto reformat = consumers_[conv_out][0];
+            auto param    = GetReformatParam(reformat);
+            if (!param || param->src_type != DATA_TYPE_INT8 || param->dst_type != DATA_TYPE_FLOAT) {
+                continue;
+            }
+            auto reformat_out = reformat->outputs[0];
+            if (structure->outputs.count(reformat_out) > 0 || consumers_[reformat_out].size() != 1) {
+                continue;
+            }
+            auto relu = consumers_[reformat_out][0];
+            if (relu->type != LAYER_RELU || relu->param->quantized || relu->inputs.size() != 1 ||
+                relu->outputs.size() != 1) {
+                continue;
+            }
+
+            LOGD("Fold relu layer: %s into %s\n", relu->name.c_str(), layer->name.c_str());
+            // the param is shared with the interpreted structure, fold into a copy of it
+            auto fused_param             = std::make_shared<ConvLayerParam>(*conv_param);
+            fused_param->activation_type = ActivationType_ReLU;
+            layer->param                 = fused_param;
+            reformat->outputs[0]         = relu->outputs[0];
+            RemoveBlob(structure, reformat_out);
+            removed.insert(relu.get());
+        }
+        RemoveLayers(structure, removed);
+        return !removed.empty();
+    }
+
+    bool NetOptimizerEliminateReformat::RemoveUnusedReformat(NetStructure *structure) {
+        UpdateGraph(structure);
+        std::set<LayerInfo *> removed;
+        for (auto layer : structure->layers) {
+            if (!GetReformatParam(layer)) {
+                continue;
+            }
+            auto output = layer->outputs[0];
+            if (consumers_[output].empty() && structure->outputs.count(output) == 0) {
+                LOGD("Remove unused refomat layer: %s\n", layer->name.c_str());
+                RemoveBlob(structure, output);
+                removed.insert(layer.get());
+            }
+        }
+        RemoveLayers(structure, removed);
+        return !removed.empty();
+    }
+
+    void NetOptimizerEliminateReformat::UpdateGraph(NetStructure *structure) {
+        producers_.clear();
+        consumers_.clear();
+        for (auto layer : structure->layers) {
+            for (auto input : layer->inputs) {
+                consumers_[input].push_back(layer);
+            }
+            for (auto output : layer->outputs) {
+                producers_[output] = layer;
+            }
+        }
+    }
+
+    void NetOptimizerEliminateReformat::RemoveLayers(NetStructure *structure, const std::set<LayerInfo *> &removed) {
+        if (removed.empty()) {
+            return;
+        }
+        std::vector<std::shared_ptr<LayerInfo>> layers_kept;
+        for (auto layer : structure->layers) {
+            if (removed.count(layer.get()) == 0) {
+                layers_kept.push_back(layer);
+            }
+        }
+        structure->layers = layers_kept;
+    }
+
+    void NetOptimizerEliminateReformat::RemoveBlob(NetStructure *structure, const std::string &blob) {
+        structure->blobs.erase(blob);
+        structure->blobs_format.erase(blob);
+    }
+
+    void NetOptimizerEliminateReformat::ReplaceInput(NetStructure *structure, const std::string &from,
+                                                     const std::string &to) {
+        for (auto layer : structure->layers) {
+            for (auto &input : layer->inputs) {
+                if (input == from) {
+                    input = to;
+                }
+            }
+        }
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
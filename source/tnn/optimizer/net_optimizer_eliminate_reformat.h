@@ -0,0 +1,61 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_ELIMINATE_REFORMAT_H_
+#define TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_ELIMINATE_REFORMAT_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+#include "tnn/optimizer/net_optimizer.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    //@brief net optimize: remove the redundant reformat layers left by the precision and layout passes,
+    // share one copy among the consumers of a blob, cancel inverse pairs and fold relu into int8 conv
+    class NetOptimizerEliminateReformat : public NetOptimizer {
+    public:
+        virtual std::string Strategy();
+        virtual bool IsSupported(const NetworkConfig &net_config);
+        virtual Status Optimize(NetStructure *structure, NetResource *resource);
+
+    private:
+        void SplitReformat(NetStructure *structure);
+        bool ShareReformat(NetStructure *structure);
+        bool CancelReformat(NetStructure *structure, NetResource *resource);
+        bool FoldReformat(NetStructure *structure);
+        bool RemoveUnusedReformat(NetStructure *structure);
+
+        void UpdateGraph(NetStructure *structure);
+        void RemoveLayers(NetStructure *structure, const std::set<LayerInfo *> &removed);
+        void RemoveBlob(NetStructure *structure, const std::string &blob);
+        void ReplaceInput(NetStructure *structure, const std::string &from, const std::string &to);
+
+        std::map<std::string, std::shared_ptr<LayerInfo>> producers_;
+        std::map<std::string, std::vector<std::shared_ptr<LayerInfo>>> consumers_;
+    };
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_ELIMINATE_REFORMAT_H_
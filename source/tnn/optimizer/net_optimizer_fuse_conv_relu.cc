@@ -88,8 +88,11 @@ namespace optimizer {
                 }
 
                 if (!is_input_of_others) {
-                    conv_param->activation_type = activation->second;
-                    layer_info_prev->outputs    = layer_info_current->outputs;
+                    // the param is shared with the interpreted structure, fuse into a copy of it
+                    auto fused_param             = std::make_shared<ConvLayerParam>(*conv_param);
+                    fused_param->activation_type = activation->second;
+                    layer_info_prev->param       = fused_param;
+                    layer_info_prev->outputs     = layer_info_current->outputs;
                 } else {
                     layers_fused.push_back(layer_info_current);
                 }
@@ -0,0 +1,175 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/optimizer/net_optimizer_insert_fallback_reformat.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // Pdevice priority: the fallback layers are wrapped after the precision and layout of the device layers are decided
+    NetOptimizerRegister<NetOptimizerInsertFallbackReformat> g_net_optimizer_insert_fallback_reformat(
+        OptPriority::PDEVICE);
+    static const std::string nchw_name_suffix       = "_nchw";
+    static const std::string reformat_name_suffix   = "_fallback_reformat";
+    static const std::string fallback_reformat_type = "FallbackReformat";
+
+    std::string NetOptimizerInsertFallbackReformat::Strategy() {
+        return kNetOptimizerInsertFallbackReformat;
+    }
+
+    bool NetOptimizerInsertFallbackReformat::IsSupported(const NetworkConfig &net_config) {
+        net_config_ = net_config;
+        return GetDevice(net_config.device_type) && TNN_NS::GetFallbackDevice(net_config.device_type);
+    }
+
+    AbstractDevice *NetOptimizerInsertFallbackReformat::GetFallbackDevice(const NetworkConfig &net_config,
+                                                                         NetStructure *structure) {
+        // a specified data format overrides the nchw layout of the fallback blobs,
+        // and int8 blobs are not reformatted to nchw
+        if (net_config.data_format != DATA_FORMAT_AUTO || GetQuantizedInfoFromNetStructure(structure)) {
+            return nullptr;
+        }
+        return TNN_NS::GetFallbackDevice(net_config.device_type);
+    }
+
+    bool NetOptimizerInsertFallbackReformat::IsFallbackLayer(AbstractDevice *device, AbstractDevice *fallback_device,
+                                                             LayerType type) {
+        return device && fallback_device && type != LAYER_REFORMAT && !device->IsLayerAccImplemented(type) &&
+               fallback_device->IsLayerAccImplemented(type);
+    }
+
+    static std::shared_ptr<LayerInfo> CreateReformat(std::string name, bool src_nchw, DataType device_type) {
+        std::shared_ptr<LayerInfo> new_layer = std::shared_ptr<LayerInfo>(new LayerInfo());
+        new_layer->type                      = LAYER_REFORMAT;
+        new_layer->type_str                  = fallback_reformat_type;
+        new_layer->name                      = name;
+        ReformatLayerParam *param            = new ReformatLayerParam();
+        new_layer->param                     = std::shared_ptr<LayerParam>(param);
+        // the fallback layers run in fp32 nchw, the device ones in nc4hw4 of the device precision
+        param->src_type   = src_nchw ? DATA_TYPE_FLOAT : device_type;
+        param->dst_type   = src_nchw ? device_type : DATA_TYPE_FLOAT;
+        param->src_format = src_nchw ? DATA_FORMAT_NCHW : DATA_FORMAT_NC4HW4;
+        param->dst_format = src_nchw ? DATA_FORMAT_NC4HW4 : DATA_FORMAT_NCHW;
+        param->type       = src_nchw ? NCHW_2_NC4HW4 : NC4HW4_2_NCHW;
+        return new_layer;
+    }
+
+    Status NetOptimizerInsertFallbackReformat::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        auto device          = GetDevice(net_config_.device_type);
+        auto fallback_device = GetFallbackDevice(net_config_, structure);
+        if (!fallback_device) {
+            return TNN_OK;
+        }
+        // skip if the fallback layers have been wrapped, the structure may be optimized by another instance
+        for (auto layer : structure->layers) {
+            if (layer->type_str == fallback_reformat_type) {
+                return TNN_OK;
+            }
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        std::map<std::string, std::vector<std::shared_ptr<LayerInfo>>> consumers;
+        std::set<LayerInfo *> fallback_layers;
+        for (auto layer : layers_orig) {
+            for (auto input : layer->inputs) {
+                consumers[input].push_back(layer);
+            }
+            if (IsFallbackLayer(device, fallback_device, layer->type)) {
+                fallback_layers.insert(layer.get());
+            }
+        }
+        if (fallback_layers.empty()) {
+            return TNN_OK;
+        }
+
+        auto device_type   = net_config_.precision == PRECISION_LOW ? DATA_TYPE_BFP16 : DATA_TYPE_FLOAT;
+        auto add_nchw_blob = [&](const std::string &name) {
+            structure->blobs.insert(name);
+            structure->blobs_format[name] = DATA_FORMAT_NCHW;
+        };
+
+        /*
+         * The inputs of a fallback layer are reformatted to nchw once, before its first fallback consumer.
+         * Its outputs are produced in nchw, and reformatted back only if a device layer or the user reads them.
+         */
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        std::map<std::string, std::string> nchw_blobs;
+        for (auto cur_layer : layers_orig) {
+            if (fallback_layers.count(cur_layer.get()) == 0) {
+                layers_fused.push_back(cur_layer);
+                continue;
+            }
+            LOGD("Fallback layer: %s\n", cur_layer->name.c_str());
+
+            for (auto &cur_in : cur_layer->inputs) {
+                if (nchw_blobs.count(cur_in) == 0) {
+                    auto new_out   = cur_in + nchw_name_suffix;
+                    auto new_layer = CreateReformat(cur_in + reformat_name_suffix, false, device_type);
+                    new_layer->inputs.push_back(cur_in);
+                    new_layer->outputs.push_back(new_out);
+                    add_nchw_blob(new_out);
+                    nchw_blobs[cur_in] = new_out;
+                    layers_fused.push_back(new_layer);
+                }
+                cur_in = nchw_blobs[cur_in];
+            }
+            layers_fused.push_back(cur_layer);
+
+            for (auto &cur_out : cur_layer->outputs) {
+                auto new_out = cur_out + nchw_name_suffix;
+                add_nchw_blob(new_out);
+                nchw_blobs[cur_out] = new_out;
+
+                bool device_used = structure->outputs.count(cur_out) > 0;
+                for (auto consumer : consumers[cur_out]) {
+                    device_used |= fallback_layers.count(consumer.get()) == 0;
+                }
+                if (device_used) {
+                    auto new_layer = CreateReformat(cur_out + reformat_name_suffix, true, device_type);
+                    new_layer->inputs.push_back(new_out);
+                    new_layer->outputs.push_back(cur_out);
+                    layers_fused.push_back(new_layer);
+                } else {
+                    structure->blobs.erase(cur_out);
+                    structure->blobs_format.erase(cur_out);
+                }
+                cur_out = new_out;
+            }
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -0,0 +1,55 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_INSERT_FALLBACK_REFORMAT_H_
+#define TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_INSERT_FALLBACK_REFORMAT_H_
+
+#include <string>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+#include "tnn/optimizer/net_optimizer.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    //@brief net optimize: run the layers not implemented on the device with the fallback device,
+    // and insert reformat layers between the nc4hw4 blobs of the device and the fp32 nchw ones of the fallback
+    class NetOptimizerInsertFallbackReformat : public NetOptimizer {
+    public:
+        virtual std::string Strategy();
+        virtual bool IsSupported(const NetworkConfig &net_config);
+        virtual Status Optimize(NetStructure *structure, NetResource *resource);
+
+        // @brief get the device running the fallback layers of the network, nullptr if the layers are not
+        // wrapped by the reformat layers, like in a quantized network or with a specified data format
+        static AbstractDevice *GetFallbackDevice(const NetworkConfig &net_config, NetStructure *structure);
+
+        // @brief whether the layer runs on the fallback device instead of the device
+        static bool IsFallbackLayer(AbstractDevice *device, AbstractDevice *fallback_device, LayerType type);
+
+    private:
+        NetworkConfig net_config_;
+    };
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_OPTIMIZER_NET_OPTIMIZER_INSERT_FALLBACK_REFORMAT_H_
@@ -0,0 +1,282 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_insert_layout_reformat.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/cpu_utils.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // Plast priority: layout is decided after all fuse and precision reformat
+    NetOptimizerRegister<NetOptimizerInsertLayoutReformat> g_net_optimizer_insert_layout_reformat(OptPriority::PLAST);
+    static const std::string nhwc_name_suffix   = "_nhwc";
+    static const std::string nc4hw4_name_suffix = "_nc4hw4";
+
+    std::string NetOptimizerInsertLayoutReformat::Strategy() {
+        return kNetOptimizerInsertLayoutReformat;
+    }
+
+    bool NetOptimizerInsertLayoutReformat::IsSupported(const NetworkConfig &net_config) {
+        auto device = net_config.device_type;
+        device_     = GetDevice(device);
+        precision_  = net_config.precision;
+        // nhwc is only implemented for fp32, and a specified data format overrides the assigned layouts
+        return device == DEVICE_ARM && precision_ != PRECISION_LOW && net_config.data_format == DATA_FORMAT_AUTO;
+    }
+
+    bool NetOptimizerInsertLayoutReformat::IsNhwcImplemented(LayerType type) {
+        if (type == LAYER_REFORMAT) {
+            return false;
+        }
+        auto layouts = device_->GetImplementedLayout(type)->layouts;
+        return std::find(layouts.begin(), layouts.end(), DATA_FORMAT_NHWC) != layouts.end();
+    }
+
+    bool NetOptimizerInsertLayoutReformat::IsFp16Used(NetStructure *structure) {
+        if ((precision_ != PRECISION_NORMAL && precision_ != PRECISION_AUTO) || !CpuUtils::CpuSupportFp16()) {
+            return false;
+        }
+        for (auto layer : structure->layers) {
+            if (device_->GetImplementedPrecision(layer->type)->fp16_implemented) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool IsChannelPreserved(LayerType type) {
+        static const std::set<LayerType> channel_preserved_layers = {
+            LAYER_POOLING, LAYER_RELU,       LAYER_RELU6,  LAYER_SIGMOID, LAYER_UPSAMPLE, LAYER_ADD,
+            LAYER_SUB,     LAYER_MUL,        LAYER_DIV,    LAYER_MAXIMUM, LAYER_MINIMUM,  LAYER_BATCH_NORM,
+            LAYER_SCALE,   LAYER_PRELU,      LAYER_CLIP,   LAYER_REFORMAT};
+        return channel_preserved_layers.count(type) > 0;
+    }
+
+    /*
+     * Channels are known before the instance is reshaped: from the input shapes, the conv params, and the
+     * layers which keep or concat the channels. Blobs with unknown channels stay in nc4hw4.
+     */
+    std::map<std::string, int> NetOptimizerInsertLayoutReformat::InferBlobChannels(NetStructure *structure) {
+        std::map<std::string, int> channels;
+        for (auto iter : structure->inputs_shape_map) {
+            if (iter.second.size() > 1) {
+                channels[iter.first] = iter.second[1];
+            }
+        }
+
+        for (auto layer : structure->layers) {
+            int channel = 0;
+            if (layer->type == LAYER_CONVOLUTION || layer->type == LAYER_DECONVOLUTION) {
+                auto conv_param = dynamic_cast<ConvLayerParam *>(layer->param.get());
+                channel         = conv_param ? conv_param->output_channel : 0;
+            } else if (layer->type == LAYER_CONCAT || IsChannelPreserved(layer->type)) {
+                auto concat_param = dynamic_cast<ConcatLayerParam *>(layer->param.get());
+                bool concat_c     = concat_param && concat_param->axis == 1;
+                for (auto input : layer->inputs) {
+                    if (channels.count(input) == 0) {
+                        channel = 0;
+                        break;
+                    }
+                    channel = concat_c ? channel + channels[input] : std::max(channel, channels[input]);
+                }
+            }
+            if (channel > 0) {
+                for (auto output : layer->outputs) {
+                    channels[output] = channel;
+                }
+            }
+        }
+        return channels;
+    }
+
+    static std::shared_ptr<LayerInfo> CreateReformat(std::string name, bool src_nhwc) {
+        std::shared_ptr<LayerInfo> new_layer = std::shared_ptr<LayerInfo>(new LayerInfo());
+        new_layer->type                      = LAYER_REFORMAT;
+        new_layer->type_str                  = "LayoutReformat";
+        new_layer->name                      = name;
+        ReformatLayerParam *param            = new ReformatLayerParam();
+        new_layer->param                     = std::shared_ptr<LayerParam>(param);
+        // only layout here, data type is unchanged
+        param->src_type   = DATA_TYPE_FLOAT;
+        param->dst_type   = DATA_TYPE_FLOAT;
+        param->src_format = src_nhwc ? DATA_FORMAT_NHWC : DATA_FORMAT_NC4HW4;
+        param->dst_format = src_nhwc ? DATA_FORMAT_NC4HW4 : DATA_FORMAT_NHWC;
+        param->type       = src_nhwc ? NHWC_2_NC4HW4 : NC4HW4_2_NHWC;
+        return new_layer;
+    }
+
+    Status NetOptimizerInsertLayoutReformat::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        const int count                                     = (const int)layers_orig.size();
+        if (count <= 1) {
+            return TNN_OK;
+        }
+
+        // skip if layouts have been assigned, the structure may be optimized by another instance
+        if (!structure->blobs_format.empty()) {
+            return TNN_OK;
+        }
+
+        // skip if network is quantized or runs in mixed precision
+        if (GetQuantizedInfoFromNetStructure(structure) || IsFp16Used(structure)) {
+            return TNN_OK;
+        }
+        for (auto layer : layers_orig) {
+            if (layer->type == LAYER_REFORMAT) {
+                return TNN_OK;
+            }
+        }
+
+        auto channels = InferBlobChannels(structure);
+
+        std::map<std::string, std::shared_ptr<LayerInfo>> producers;
+        std::map<std::string, std::vector<std::shared_ptr<LayerInfo>>> consumers;
+        std::set<std::string> nhwc_blobs;
+        for (auto layer : layers_orig) {
+            for (auto input : layer->inputs) {
+                consumers[input].push_back(layer);
+            }
+            for (auto output : layer->outputs) {
+                producers[output] = layer;
+                // net inputs and outputs stay in nc4hw4 for the blob converter
+                if (!IsNhwcImplemented(layer->type) || layer->outputs.size() != 1 ||
+                    structure->outputs.count(output) > 0 || structure->inputs_shape_map.count(output) > 0) {
+                    continue;
+                }
+                // the padding of nc4hw4 only dominates for low channel blobs
+                if (channels.count(output) > 0 && channels[output] < 4) {
+                    nhwc_blobs.insert(output);
+                }
+            }
+        }
+
+        // conv reads and writes both layouts, other layers run in nhwc only if their outputs are nhwc
+        auto is_conv     = [](std::shared_ptr<LayerInfo> layer) { return layer->type == LAYER_CONVOLUTION; };
+        auto is_run_nhwc = [&](std::shared_ptr<LayerInfo> layer) {
+            if (!IsNhwcImplemented(layer->type)) {
+                return false;
+            }
+            for (auto output : layer->outputs) {
+                if (nhwc_blobs.count(output) == 0) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        // cost of a reformat per spatial position: read one layout and write the other
+        auto reformat_cost = [&](const std::string &blob) {
+            int channel = channels.count(blob) > 0 ? channels[blob] : 4;
+            return channel + ROUND_UP(channel, 4);
+        };
+
+        /*
+         * Cost model per spatial position: every access to an nhwc blob saves the channel padding of nc4hw4,
+         * while the layers which can not read the blob in nhwc share one reformatted copy, and the inputs of a
+         * non-conv producer have to be reformatted to nhwc. Demote the blobs without net benefit until stable.
+         */
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto iter = nhwc_blobs.begin(); iter != nhwc_blobs.end();) {
+                auto blob        = *iter;
+                int padding      = ROUND_UP(channels[blob], 4) - channels[blob];
+                int saving       = padding;
+                int cost         = 0;
+                bool need_nc4hw4 = false;
+                for (auto consumer : consumers[blob]) {
+                    if (is_conv(consumer) || is_run_nhwc(consumer)) {
+                        saving += padding;
+                    } else {
+                        need_nc4hw4 = true;
+                    }
+                }
+                if (need_nc4hw4) {
+                    cost += reformat_cost(blob);
+                }
+                auto producer = producers[blob];
+                if (!is_conv(producer)) {
+                    for (auto input : producer->inputs) {
+                        if (nhwc_blobs.count(input) == 0) {
+                            cost += reformat_cost(input);
+                        }
+                    }
+                }
+
+                if (saving <= cost) {
+                    iter    = nhwc_blobs.erase(iter);
+                    changed = true;
+                } else {
+                    ++iter;
+                }
+            }
+        }
+        if (nhwc_blobs.empty()) {
+            return TNN_OK;
+        }
+
+        // insert one shared reformat for each blob read in the other layout, before its first such consumer
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        std::map<std::string, std::string> reformatted;
+        for (auto cur_layer : layers_orig) {
+            bool need_nhwc = is_run_nhwc(cur_layer);
+            for (auto &cur_in : cur_layer->inputs) {
+                bool is_nhwc = nhwc_blobs.count(cur_in) > 0;
+                if (is_conv(cur_layer) || is_nhwc == need_nhwc) {
+                    continue;
+                }
+                if (reformatted.count(cur_in) == 0) {
+                    auto new_out = cur_in + (is_nhwc ? nc4hw4_name_suffix : nhwc_name_suffix);
+                    auto new_layer = CreateReformat(new_out, is_nhwc);
+                    new_layer->inputs.push_back(cur_in);
+                    new_layer->outputs.push_back(new_out);
+                    structure->blobs.insert(new_out);
+                    structure->blobs_format[new_out] = is_nhwc ? DATA_FORMAT_NC4HW4 : DATA_FORMAT_NHWC;
+                    reformatted[cur_in]              = new_out;
+
+                    LOGD("Insert layout refomat layer: src %s dst %s\n", cur_in.c_str(), new_out.c_str());
+                    layers_fused.push_back(new_layer);
+                }
+                cur_in = reformatted[cur_in];
+            }
+            layers_fused.push_back(cur_layer);
+        }
+
+        for (auto blob : nhwc_blobs) {
+            structure->blobs_format[blob] = DATA_FORMAT_NHWC;
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -15,13 +15,14 @@
 #include "tnn/optimizer/net_optimizer_manager.h"
 
 #include <algorithm>
+#include <sstream>
 
 namespace TNN_NS {
 
 namespace optimizer {
 
-    std::map<std::string, shared_ptr<NetOptimizer>> &NetOptimizerManager::GetNetOptimizerMap() {
-        static std::map<std::string, std::shared_ptr<NetOptimizer>> s_net_optimizer_map;
+    std::map<std::string, shared_ptr<NetOptimizerCreator>> &NetOptimizerManager::GetNetOptimizerMap() {
+        static std::map<std::string, std::shared_ptr<NetOptimizerCreator>> s_net_optimizer_map;
         return s_net_optimizer_map;
     }
 
@@ -30,12 +31,15 @@ namespace optimizer {
         return s_net_optimizer_seq;
     }
 
+    /*
+     * Instances may be optimized concurrently: the sequence is sorted at registration and only read here,
+     * and each optimization runs its own optimizers.
+     */
     Status NetOptimizerManager::Optimize(NetStructure *structure, NetResource *resource, const NetworkConfig &net_config) {
         auto &optimizer_map = NetOptimizerManager::GetNetOptimizerMap();
-        std::sort(NetOptimizerManager::GetNetOptimizerSeq().begin(), NetOptimizerManager::GetNetOptimizerSeq().end());
 
         for (auto iter : NetOptimizerManager::GetNetOptimizerSeq()) {
-            auto optimizer = optimizer_map[iter.second];
+            std::shared_ptr<NetOptimizer> optimizer(optimizer_map.at(iter.second)->CreateNetOptimizer());
             if (optimizer->IsSupported(net_config)) {
                 auto status = optimizer->Optimize(structure, resource);
                 if (status != TNN_OK) {
@@ -47,11 +51,23 @@ namespace optimizer {
         return TNN_OK;
     }
 
-    void NetOptimizerManager::RegisterNetOptimizer(NetOptimizer *optimizer, OptPriority prior) {
+    std::string NetOptimizerManager::GetOptimizeKey(const NetworkConfig &net_config) {
+        // all the fields read by IsSupported of the optimizers
+        std::stringstream key;
+        key << net_config.device_type << "_" << net_config.precision << "_" << net_config.data_format;
+        return key.str();
+    }
+
+    void NetOptimizerManager::RegisterNetOptimizer(NetOptimizerCreator *creator, OptPriority prior) {
+        std::shared_ptr<NetOptimizer> optimizer(creator ? creator->CreateNetOptimizer() : nullptr);
         if (optimizer && optimizer->Strategy().length() > 0) {
             auto &optimizer_map                  = NetOptimizerManager::GetNetOptimizerMap();
-            optimizer_map[optimizer->Strategy()] = std::shared_ptr<NetOptimizer>(optimizer);
-            NetOptimizerManager::GetNetOptimizerSeq().push_back(std::make_pair(prior, optimizer->Strategy()));
+            auto &optimizer_seq                  = NetOptimizerManager::GetNetOptimizerSeq();
+            optimizer_map[optimizer->Strategy()] = std::shared_ptr<NetOptimizerCreator>(creator);
+            optimizer_seq.push_back(std::make_pair(prior, optimizer->Strategy()));
+            std::sort(optimizer_seq.begin(), optimizer_seq.end());
+        } else {
+            delete creator;
         }
     }
 
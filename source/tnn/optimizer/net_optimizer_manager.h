@@ -39,18 +39,40 @@ namespace optimizer {
         //
         P2 = 2,
         // LAST
-        PLAST = 1000
+        PLAST = 1000,
+        // DEVICE, after the precision and layout of the device layers are decided
+        PDEVICE = 1001,
+        // FINAL, after all reformat layers are inserted
+        PFINAL = 1002
     } OptPriority;
 
+    //@brief creates a new optimizer for each optimization, the optimizers keep the state of their config
+    class NetOptimizerCreator {
+    public:
+        virtual ~NetOptimizerCreator() {}
+        virtual NetOptimizer *CreateNetOptimizer() = 0;
+    };
+
+    template <typename T>
+    class TypeNetOptimizerCreator : public NetOptimizerCreator {
+    public:
+        virtual NetOptimizer *CreateNetOptimizer() {
+            return new T();
+        }
+    };
+
     //@brief net optimize: fuse relu and relu6 to convolution
     class NetOptimizerManager {
     public:
         static Status Optimize(NetStructure *structure, NetResource *resource, const NetworkConfig &net_config);
 
-        static void RegisterNetOptimizer(NetOptimizer *ptimizer, OptPriority prior);
+        //@brief key of the network config, the configs of the same key are optimized to the same structure
+        static std::string GetOptimizeKey(const NetworkConfig &net_config);
+
+        static void RegisterNetOptimizer(NetOptimizerCreator *creator, OptPriority prior);
 
     private:
-        static std::map<std::string, std::shared_ptr<NetOptimizer>> &GetNetOptimizerMap();
+        static std::map<std::string, std::shared_ptr<NetOptimizerCreator>> &GetNetOptimizerMap();
 
         static std::vector<std::pair<OptPriority, std::string>> &GetNetOptimizerSeq();
     };
@@ -59,7 +81,7 @@ namespace optimizer {
     class NetOptimizerRegister {
     public:
         explicit NetOptimizerRegister(OptPriority p) {
-            NetOptimizerManager::RegisterNetOptimizer(new T(), p);
+            NetOptimizerManager::RegisterNetOptimizer(new TypeNetOptimizerCreator<T>(), p);
         }
     };
 
@@ -28,6 +28,15 @@ static const std::string kNetOptimizerInsertInt8Reformat =
 static const std::string kNetOptimizerInsertFp16Reformat =
     "net_optimizer_insert_fp16_reformat";
 
+static const std::string kNetOptimizerInsertLayoutReformat =
+    "net_optimizer_insert_layout_reformat";
+
+static const std::string kNetOptimizerInsertFallbackReformat =
+    "net_optimizer_insert_fallback_reformat";
+
+static const std::string kNetOptimizerEliminateReformat =
+    "net_optimizer_eliminate_reformat";
+
 static const std::string kNetOptimizerRemoveLayers =
     "net_optimizer_remove_layers";
 }
@@ -0,0 +1,43 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/allocator_utils.h"
+
+#include "tnn/memory_manager/memory_allocator.h"
+#include "tnn/memory_manager/pool_memory_allocator.h"
+
+namespace TNN_NS {
+
+Status AllocatorUtils::SetAllocator(const AllocatorConfig& config) {
+    std::shared_ptr<MemoryAllocator> allocator;
+    if (config.type == ALLOCATOR_TYPE_SYSTEM) {
+        allocator = std::make_shared<SystemMemoryAllocator>(config);
+    } else if (config.type == ALLOCATOR_TYPE_POOL) {
+        allocator = std::make_shared<PoolMemoryAllocator>(config);
+    } else {
+        return Status(TNNERR_PARAM_ERR, "allocator type is not supported");
+    }
+    MemoryAllocator::SetHostAllocator(allocator);
+    return TNN_OK;
+}
+
+AllocatorStats AllocatorUtils::GetAllocatorStats() {
+    return MemoryAllocator::GetHostStats();
+}
+
+void AllocatorUtils::TrimAllocator() {
+    MemoryAllocator::GetHostAllocator()->Trim();
+}
+
+}  // namespace TNN_NS
@@ -25,7 +25,7 @@ BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc) {
     info.data_type = desc.data_type;
     int count      = 0;
     if (desc.data_format == DATA_FORMAT_NC4HW4) {
-        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * desc.dims[2] * desc.dims[3];
+        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * DimsVectorUtils::Count(desc.dims, 2);
     } else if (desc.data_format == DATA_FORMAT_NHWC4) {
         count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * ROUND_UP(desc.dims[2] * desc.dims[3], 4);
     } else {
@@ -15,6 +15,7 @@
 #include "tnn/utils/cpu_utils.h"
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <vector>
 
 #ifdef _OPENMP
@@ -348,4 +349,75 @@ bool CpuUtils::CpuSupportFp16() {
     return fp16arith;
 }
 
+#if defined(__ANDROID__) || defined(__linux__)
+// parse a sysfs list like "0-3,8-11"
+static std::vector<int> ReadSysfsList(const char* path) {
+    std::vector<int> ids;
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return ids;
+
+    char line[4096];
+    char* s = fgets(line, 4096, fp);
+    fclose(fp);
+    while (s && *s) {
+        int begin = 0, n = 0;
+        if (sscanf(s, "%d%n", &begin, &n) != 1)
+            break;
+        s += n;
+        int end = begin;
+        if (*s == '-') {
+            if (sscanf(s + 1, "%d%n", &end, &n) != 1)
+                break;
+            s += n + 1;
+        }
+        for (int i = begin; i <= end; i++) {
+            ids.push_back(i);
+        }
+        if (*s != ',')
+            break;
+        s++;
+    }
+    return ids;
+}
+#endif
+
+int CpuUtils::GetNumaNodeCount() {
+#if defined(__ANDROID__) || defined(__linux__)
+    static int node_count = -1;
+    if (node_count < 0) {
+        auto nodes = ReadSysfsList("/sys/devices/system/node/online");
+        int count  = 1;
+        for (auto node : nodes) {
+            count = std::max(count, node + 1);
+        }
+        node_count = count;
+    }
+    return node_count;
+#else
+    return 1;
+#endif
+}
+
+Status CpuUtils::GetNumaNodeCpuList(int node, std::vector<int>& cpu_list) {
+    cpu_list.clear();
+#if defined(__ANDROID__) || defined(__linux__)
+    char path[256];
+    snprintf(path, 256, "/sys/devices/system/node/node%d/cpulist", node);
+    cpu_list = ReadSysfsList(path);
+    if (cpu_list.empty() && node == 0 && GetNumaNodeCount() == 1) {
+        // kernel without numa
+        int cpu_count = (int)sysconf(_SC_NPROCESSORS_CONF);
+        for (int i = 0; i < cpu_count; i++) {
+            cpu_list.push_back(i);
+        }
+    }
+#endif
+    if (cpu_list.empty()) {
+        LOGE("numa node %d has no cpus\n", node);
+        return Status(TNNERR_PARAM_ERR, "numa node has no cpus");
+    }
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
@@ -16,7 +16,7 @@
 
 namespace TNN_NS {
 
-int DimsVectorUtils::Count(DimsVector dims, int start_index, int end_index) {
+int DimsVectorUtils::Count(const DimsVector &dims, int start_index, int end_index) {
     if (dims.size() < start_index) {
         return 0;
     }
@@ -32,21 +32,14 @@ int DimsVectorUtils::Count(DimsVector dims, int start_index, int end_index) {
     return result;
 }
 
-DimsVector DimsVectorUtils::Max(DimsVector dims0, DimsVector dims1, int start_index, int end_index) {
-    DimsVector max_dims;
-    DimsVector small_dims;
-    if (dims0.size() >= dims1.size()) {
-        max_dims   = dims0;
-        small_dims = dims1;
-    } else {
-        max_dims   = dims1;
-        small_dims = dims0;
-    }
-
+DimsVector DimsVectorUtils::Max(const DimsVector &dims0, const DimsVector &dims1, int start_index, int end_index) {
+    const DimsVector &small_dims = dims0.size() >= dims1.size() ? dims1 : dims0;
     if (small_dims.size() <= start_index) {
         return small_dims;
     }
 
+    DimsVector max_dims = dims0.size() >= dims1.size() ? dims0 : dims1;
+
     if (-1 == end_index || end_index > small_dims.size()) {
         end_index = static_cast<int>(small_dims.size());
     }
@@ -58,7 +51,7 @@ DimsVector DimsVectorUtils::Max(DimsVector dims0, DimsVector dims1, int start_in
     return max_dims;
 }
 
-bool DimsVectorUtils::Equal(DimsVector dims0, DimsVector dims1, int start_index, int end_index) {
+bool DimsVectorUtils::Equal(const DimsVector &dims0, const DimsVector &dims1, int start_index, int end_index) {
     if (dims0.size() <= start_index) {
         return false;
     }
@@ -79,7 +72,7 @@ bool DimsVectorUtils::Equal(DimsVector dims0, DimsVector dims1, int start_index,
     return true;
 }
 
-DimsVector DimsVectorUtils::NCHW2NHWC(DimsVector dims) {
+DimsVector DimsVectorUtils::NCHW2NHWC(const DimsVector &dims) {
     ASSERT(dims.size() == 4);
     const int n           = dims[0];
     const int c           = dims[1];
@@ -89,7 +82,7 @@ DimsVector DimsVectorUtils::NCHW2NHWC(DimsVector dims) {
     return nhwc;
 }
 
-DimsVector DimsVectorUtils::NHWC2NCHW(DimsVector dims) {
+DimsVector DimsVectorUtils::NHWC2NCHW(const DimsVector &dims) {
     ASSERT(dims.size() == 4);
     const int n           = dims[0];
     const int h           = dims[1];
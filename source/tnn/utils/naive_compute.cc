@@ -280,6 +280,160 @@ template void NaiveConv<bfp16_t, float, float, bfp16_t>(void *input_ptr, void *o
                                                         int dilation, int activation_type,
                                                         float *scale, int scale_len);
 
+/*
+ * 3d pooling funtion
+ * blob data format must be NCDHW
+ */
+template <typename T, typename Tacc>
+void NaivePooling3D(T *input_ptr, T *output_ptr, DimsVector dims_input, DimsVector dims_output, int stride_d,
+                    int stride_y, int stride_x, int kernel_d, int kernel_y, int kernel_x, int pad_d, int pad_y,
+                    int pad_x, int pool_type) {
+    auto input_depth = dims_input[2], input_height = dims_input[3], input_width = dims_input[4];
+    auto output_depth = dims_output[2], output_height = dims_output[3], output_width = dims_output[4];
+    auto channel      = dims_output[1];
+    auto input_plane  = input_depth * input_height * input_width;
+    auto output_plane = output_depth * output_height * output_width;
+    for (int n = 0; n < dims_output[0]; n++) {
+        for (int c = 0; c < channel; c++) {
+            T *input_c  = input_ptr + (n * channel + c) * input_plane;
+            T *output_c = output_ptr + (n * channel + c) * output_plane;
+            for (int d = 0; d < output_depth; d++) {
+                for (int h = 0; h < output_height; h++) {
+                    for (int w = 0; w < output_width; w++) {
+                        int dstart = d * stride_d - pad_d;
+                        int hstart = h * stride_y - pad_y;
+                        int wstart = w * stride_x - pad_x;
+                        int dend   = std::min(dstart + kernel_d, input_depth);
+                        int hend   = std::min(hstart + kernel_y, input_height);
+                        int wend   = std::min(wstart + kernel_x, input_width);
+                        dstart     = std::max(dstart, 0);
+                        hstart     = std::max(hstart, 0);
+                        wstart     = std::max(wstart, 0);
+
+                        // max pooling for pool_type 0, average pooling over the valid window for pool_type 1
+                        Tacc calc_val = pool_type == 0 ? static_cast<Tacc>(-FLT_MAX) : static_cast<Tacc>(0);
+                        for (int ind = dstart; ind < dend; ++ind) {
+                            for (int inh = hstart; inh < hend; ++inh) {
+                                for (int inw = wstart; inw < wend; ++inw) {
+                                    int position = (ind * input_height + inh) * input_width + inw;
+                                    auto cur_val = static_cast<Tacc>(input_c[position]);
+                                    calc_val = pool_type == 0 ? std::max(cur_val, calc_val) : calc_val + cur_val;
+                                }
+                            }
+                        }
+                        if (pool_type != 0) {
+                            calc_val = calc_val / ((dend - dstart) * (hend - hstart) * (wend - wstart));
+                        }
+                        output_c[(d * output_height + h) * output_width + w] = static_cast<T>(calc_val);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template void NaivePooling3D<float, float>(float *input_ptr, float *output_ptr, DimsVector dims_input,
+                                           DimsVector dims_output, int stride_d, int stride_y, int stride_x,
+                                           int kernel_d, int kernel_y, int kernel_x, int pad_d, int pad_y, int pad_x,
+                                           int pool_type);
+
+template void NaivePooling3D<bfp16_t, float>(bfp16_t *input_ptr, bfp16_t *output_ptr, DimsVector dims_input,
+                                             DimsVector dims_output, int stride_d, int stride_y, int stride_x,
+                                             int kernel_d, int kernel_y, int kernel_x, int pad_d, int pad_y,
+                                             int pad_x, int pool_type);
+
+/*
+ * 3d convolution funtion
+ * input & output data_format is NCDHW, weights are in [oc][ic / group][kd][kh][kw]
+ * depthwise is supported
+ */
+template <typename Tin, typename Tw, typename Tacc, typename Tout>
+void NaiveConv3D(void *input_ptr, void *output_ptr, void *weight_ptr, void *bias, DimsVector dims_input,
+                 DimsVector dims_output, int stride_d, int stride_y, int stride_x, int kernel_size_d,
+                 int kernel_size_y, int kernel_size_x, int pad_d, int pad_y, int pad_x, int group, int dilation_d,
+                 int dilation_y, int dilation_x, int activation_type) {
+    Tin *input_data               = static_cast<Tin *>(input_ptr);
+    Tw *weight_data               = static_cast<Tw *>(weight_ptr);
+    Tout *output_data             = static_cast<Tout *>(output_ptr);
+    Tacc *bias_data               = static_cast<Tacc *>(bias);
+    int number                    = dims_output[0];
+    int output_channel            = dims_output[1];
+    int output_depth              = dims_output[2];
+    int output_height             = dims_output[3];
+    int output_width              = dims_output[4];
+    int input_channel             = dims_input[1];
+    int input_depth               = dims_input[2];
+    int input_height              = dims_input[3];
+    int input_width               = dims_input[4];
+    int output_channels_per_group = output_channel / group;
+    int input_channels_per_group  = input_channel / group;
+    int kernel_volume             = kernel_size_d * kernel_size_y * kernel_size_x;
+
+    for (int n = 0; n < number; ++n) {
+        for (int output_c = 0; output_c < output_channel; ++output_c) {
+            int g             = output_c / output_channels_per_group;
+            int input_c_start = g * input_channels_per_group;
+            Tw *weight_c      = weight_data + output_c * input_channels_per_group * kernel_volume;
+            for (int d = 0; d < output_depth; ++d) {
+                for (int h = 0; h < output_height; ++h) {
+                    for (int w = 0; w < output_width; ++w) {
+                        Tacc result = static_cast<Tacc>(0.0f);
+                        for (int ic = 0; ic < input_channels_per_group; ++ic) {
+                            Tin *input_c = input_data + (n * input_channel + input_c_start + ic) * input_depth *
+                                                            input_height * input_width;
+                            for (int kd = 0; kd < kernel_size_d; ++kd) {
+                                int input_d = d * stride_d - pad_d + kd * dilation_d;
+                                if (input_d < 0 || input_d >= input_depth) {
+                                    continue;
+                                }
+                                for (int kh = 0; kh < kernel_size_y; ++kh) {
+                                    int input_h = h * stride_y - pad_y + kh * dilation_y;
+                                    if (input_h < 0 || input_h >= input_height) {
+                                        continue;
+                                    }
+                                    for (int kw = 0; kw < kernel_size_x; ++kw) {
+                                        int input_w = w * stride_x - pad_x + kw * dilation_x;
+                                        if (input_w < 0 || input_w >= input_width) {
+                                            continue;
+                                        }
+                                        int input_position = (input_d * input_height + input_h) * input_width +
+                                                             input_w;
+                                        int weight_position =
+                                            ((ic * kernel_size_d + kd) * kernel_size_y + kh) * kernel_size_x + kw;
+                                        result += input_c[input_position] * weight_c[weight_position];
+                                    }
+                                }
+                            }
+                        }
+                        if (bias_data) {
+                            result += bias_data[output_c];
+                        }
+                        FloatActivate(result, activation_type);
+                        int output_position =
+                            (((n * output_channel + output_c) * output_depth + d) * output_height + h) * output_width +
+                            w;
+                        output_data[output_position] = result;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template void NaiveConv3D<float, float, float, float>(void *input_ptr, void *output_ptr, void *weight_ptr, void *bias,
+                                                      DimsVector dims_input, DimsVector dims_output, int stride_d,
+                                                      int stride_y, int stride_x, int kernel_size_d,
+                                                      int kernel_size_y, int kernel_size_x, int pad_d, int pad_y,
+                                                      int pad_x, int group, int dilation_d, int dilation_y,
+                                                      int dilation_x, int activation_type);
+
+template void NaiveConv3D<bfp16_t, float, float, bfp16_t>(void *input_ptr, void *output_ptr, void *weight_ptr,
+                                                          void *bias, DimsVector dims_input, DimsVector dims_output,
+                                                          int stride_d, int stride_y, int stride_x, int kernel_size_d,
+                                                          int kernel_size_y, int kernel_size_x, int pad_d, int pad_y,
+                                                          int pad_x, int group, int dilation_d, int dilation_y,
+                                                          int dilation_x, int activation_type);
+
 template <typename T>
 void NaivePermute(const int count, T *bottom_data, const std::vector<int> &permute_order,
                 const std::vector<int> &old_steps, const std::vector<int> &new_steps, const int num_axes,
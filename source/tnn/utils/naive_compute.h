@@ -40,6 +40,17 @@ void NaiveConv(void *input_ptr, void *output_ptr, void *weight_ptr, void *bias,
             DimsVector dims_output, int stride_y, int stride_x, int kernel_size_y, int kernel_size_x, int pad_y,
             int pad_x, int group, int dilation, int activation_type, float *scale, int scale_len);
 
+template <typename T, typename Tacc>
+void NaivePooling3D(T *input_ptr, T *output_ptr, DimsVector dims_input, DimsVector dims_output, int stride_d,
+                    int stride_y, int stride_x, int kernel_d, int kernel_y, int kernel_x, int pad_d, int pad_y,
+                    int pad_x, int pool_type);
+
+template <typename Tin, typename Tw, typename Tacc, typename Tout>
+void NaiveConv3D(void *input_ptr, void *output_ptr, void *weight_ptr, void *bias, DimsVector dims_input,
+                 DimsVector dims_output, int stride_d, int stride_y, int stride_x, int kernel_size_d,
+                 int kernel_size_y, int kernel_size_x, int pad_d, int pad_y, int pad_x, int group, int dilation_d,
+                 int dilation_y, int dilation_x, int activation_type);
+
 // float fc
 template <typename T>
 void NaiveFC(T *input_ptr, T *output_ptr, T *weight_data, float *bias, DimsVector dims_input, DimsVector dims_output);
@@ -0,0 +1,148 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/numa_utils.h"
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "tnn/utils/omp_utils.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TNN_NUMA_SUPPORTED 1
+#endif
+
+namespace TNN_NS {
+
+// bits of the node and cpu masks passed to the kernel
+static const int kMaskBits    = 1024;
+static const int kBitsPerLong = 8 * sizeof(unsigned long);
+static const int kMaskLongs   = kMaskBits / kBitsPerLong;
+
+static thread_local int g_thread_node = -1;
+
+#ifdef TNN_NUMA_SUPPORTED
+static std::vector<unsigned long> NodeMask(int node) {
+    std::vector<unsigned long> mask(kMaskLongs, 0);
+    mask[node / kBitsPerLong] |= 1UL << (node % kBitsPerLong);
+    return mask;
+}
+#endif
+
+int NumaUtils::GetThreadNode() {
+    return g_thread_node;
+}
+
+size_t NumaUtils::GetPageSize() {
+#ifdef TNN_NUMA_SUPPORTED
+    return (size_t)sysconf(_SC_PAGESIZE);
+#else
+    return 4096;
+#endif
+}
+
+Status NumaUtils::BindMemory(void *data, size_t size, int node) {
+    if (!data || size == 0 || node < 0 || node >= kMaskBits) {
+        return Status(TNNERR_PARAM_ERR, "invalid memory or numa node");
+    }
+#ifdef TNN_NUMA_SUPPORTED
+    // mbind works on whole pages, only the pages owned by the caller are bound
+    const size_t page_size = GetPageSize();
+    if ((uintptr_t)data % page_size != 0) {
+        return Status(TNNERR_PARAM_ERR, "numa memory must be page aligned");
+    }
+    size_t bytes_size = (size + page_size - 1) / page_size * page_size;
+    auto mask         = NodeMask(node);
+    if (syscall(__NR_mbind, data, bytes_size, MPOL_PREFERRED, mask.data(), kMaskBits, 0)) {
+        return Status(TNNERR_DEVICE_NOT_SUPPORT, "mbind failed");
+    }
+    return TNN_OK;
+#else
+    return Status(TNNERR_DEVICE_NOT_SUPPORT, "numa is only supported on linux");
+#endif
+}
+
+std::vector<unsigned long> NumaUtils::GetCpuMask(const std::vector<int> &cpu_list) {
+    std::vector<unsigned long> mask(kMaskLongs, 0);
+    for (auto cpu : cpu_list) {
+        if (cpu >= 0 && cpu < kMaskBits) {
+            mask[cpu / kBitsPerLong] |= 1UL << (cpu % kBitsPerLong);
+        }
+    }
+    return mask;
+}
+
+Status NumaUtils::PinThreads(const std::vector<unsigned long> &cpu_mask, int num_threads) {
+    if ((int)cpu_mask.size() != kMaskLongs) {
+        return Status(TNNERR_PARAM_ERR, "invalid cpu mask");
+    }
+#ifdef TNN_NUMA_SUPPORTED
+    // the calling thread is omp thread 0
+    std::atomic<int> failed(0);
+    OMP_SET_THREADS_(num_threads);
+    OMP_PARALLEL_FOR_
+    for (int t = 0; t < num_threads; t++) {
+        unsigned long current[kMaskLongs] = {0};
+        bool is_subset = syscall(__NR_sched_getaffinity, 0, sizeof(current), current) > 0;
+        for (int i = 0; is_subset && i < kMaskLongs; i++) {
+            is_subset = (current[i] & ~cpu_mask[i]) == 0;
+        }
+        if (!is_subset && syscall(__NR_sched_setaffinity, 0, sizeof(current), cpu_mask.data())) {
+            failed++;
+        }
+    }
+    if (failed > 0) {
+        return Status(TNNERR_SET_CPU_AFFINITY, "pin threads to numa node failed");
+    }
+    return TNN_OK;
+#else
+    return Status(TNNERR_SET_CPU_AFFINITY, "numa is only supported on linux");
+#endif
+}
+
+NumaNodeGuard::NumaNodeGuard(int node) : node_(node) {
+    if (node_ < 0 || node_ >= kMaskBits) {
+        return;
+    }
+    last_node_    = g_thread_node;
+    g_thread_node = node_;
+#ifdef TNN_NUMA_SUPPORTED
+    last_mask_.assign(kMaskLongs, 0);
+    if (syscall(__NR_get_mempolicy, &last_mode_, last_mask_.data(), kMaskBits, nullptr, 0)) {
+        return;
+    }
+    auto mask   = NodeMask(node_);
+    policy_set_ = syscall(__NR_set_mempolicy, MPOL_PREFERRED, mask.data(), kMaskBits) == 0;
+#endif
+}
+
+NumaNodeGuard::~NumaNodeGuard() {
+    if (node_ < 0 || node_ >= kMaskBits) {
+        return;
+    }
+    g_thread_node = last_node_;
+#ifdef TNN_NUMA_SUPPORTED
+    if (policy_set_) {
+        // the default and local policies take no nodes
+        bool has_nodes = last_mode_ != MPOL_DEFAULT && last_mode_ != MPOL_LOCAL;
+        syscall(__NR_set_mempolicy, last_mode_, has_nodes ? last_mask_.data() : nullptr, has_nodes ? kMaskBits : 0);
+    }
+#endif
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,67 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// @brief NumaUtils places memory and threads on numa nodes with the mbind, set_mempolicy and
+// sched_setaffinity syscalls on linux and android, it does nothing on other systems.
+class NumaUtils {
+public:
+    // @brief numa node of the innermost NumaNodeGuard of the calling thread, -1 if none
+    static int GetThreadNode();
+
+    static size_t GetPageSize();
+
+    // @brief bind the pages of data to the numa node, the pages are placed when they are first touched.
+    // data must be page aligned, and the caller must own all the pages up to size rounded to whole pages,
+    // like the memory mapped by the host allocator for a numa node
+    static Status BindMemory(void *data, size_t size, int node);
+
+    // @brief mask of the cpus in cpu_list for PinThreads
+    static std::vector<unsigned long> GetCpuMask(const std::vector<int> &cpu_list);
+
+    // @brief pin the calling thread and the omp threads it starts to the cpus of cpu_mask, the threads
+    // already running on a subset of cpu_mask are not changed. it allocates no memory, so it can run
+    // at the beginning of every forward
+    static Status PinThreads(const std::vector<unsigned long> &cpu_mask, int num_threads);
+};
+
+// @brief while the guard is alive, the pages first touched by the calling thread are placed on the numa
+// node and the device memory allocated by the thread is bound to it. node < 0 does nothing.
+class NumaNodeGuard {
+public:
+    explicit NumaNodeGuard(int node);
+    ~NumaNodeGuard();
+
+private:
+    int node_        = -1;
+    int last_node_   = -1;
+    bool policy_set_ = false;
+    int last_mode_   = 0;
+    std::vector<unsigned long> last_mask_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
@@ -18,6 +18,8 @@
 #ifdef _OPENMP
 
 #include <omp.h>
+#define OMP_PARALLEL_ _Pragma("omp parallel")
+#define OMP_FOR_NOWAIT_ _Pragma("omp for nowait")
 #define OMP_PARALLEL_FOR_ _Pragma("omp parallel for")
 #define OMP_PARALLEL_FOR_GUIDED_ _Pragma("omp parallel for")
 #define OMP_PARALLEL_FOR_DYNAMIC_ _Pragma("omp parallel for schedule(dynamic)")
@@ -30,6 +32,8 @@
 
 #else
 
+#define OMP_PARALLEL_
+#define OMP_FOR_NOWAIT_
 #define OMP_PARALLEL_FOR_
 #define OMP_PARALLEL_FOR_GUIDED_
 #define OMP_PARALLEL_FOR_DYNAMIC_
@@ -0,0 +1,148 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/perf_counter_utils.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <string>
+
+#include "tnn/utils/omp_utils.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TNN_PERF_COUNTER_SUPPORTED 1
+#endif
+
+namespace TNN_NS {
+
+#ifdef TNN_PERF_COUNTER_SUPPORTED
+static int OpenCounter(int counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (counter) {
+        case PERF_COUNTER_CYCLES:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_COUNTER_INSTRUCTIONS:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_COUNTER_L1D_MISSES:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PERF_COUNTER_LLC_MISSES:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PERF_COUNTER_BRANCH_MISSES:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        default:
+            return -1;
+    }
+    // count the calling thread on any cpu
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+PerfCounters::~PerfCounters() {
+    Close();
+}
+
+Status PerfCounters::Open() {
+    Close();
+#ifdef TNN_PERF_COUNTER_SUPPORTED
+    // a counter opened by a thread counts that thread only, so open them on each omp thread
+    const int num_threads = OMP_MAX_THREADS_NUM_;
+    fds_.assign(num_threads * PERF_COUNTER_NUM, -1);
+    OMP_PARALLEL_FOR_
+    for (int t = 0; t < num_threads; t++) {
+        int thread_id = OMP_TID_;
+        if (thread_id >= num_threads || fds_[thread_id * PERF_COUNTER_NUM] >= 0) {
+            continue;
+        }
+        for (int c = 0; c < PERF_COUNTER_NUM; c++) {
+            fds_[thread_id * PERF_COUNTER_NUM + c] = OpenCounter(c);
+        }
+    }
+    if (fds_[PERF_COUNTER_CYCLES] < 0) {
+        // thread 0 is the calling thread
+        std::string error = strerror(errno);
+        Close();
+        return Status(TNNERR_DEVICE_NOT_SUPPORT, "perf_event_open failed: " + error);
+    }
+    begin_.assign(fds_.size(), Sample());
+    end_.assign(fds_.size(), Sample());
+    return TNN_OK;
+#else
+    return Status(TNNERR_DEVICE_NOT_SUPPORT, "perf counters are only supported on linux");
+#endif
+}
+
+void PerfCounters::Close() {
+#ifdef TNN_PERF_COUNTER_SUPPORTED
+    for (auto fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+    fds_.clear();
+}
+
+bool PerfCounters::IsOpened() {
+    return !fds_.empty();
+}
+
+void PerfCounters::Read(std::vector<Sample> &samples) {
+#ifdef TNN_PERF_COUNTER_SUPPORTED
+    for (size_t i = 0; i < fds_.size(); i++) {
+        if (fds_[i] < 0 || read(fds_[i], &samples[i], sizeof(Sample)) != sizeof(Sample)) {
+            samples[i] = Sample();
+        }
+    }
+#endif
+}
+
+void PerfCounters::Begin() {
+    Read(begin_);
+}
+
+void PerfCounters::End(double *counts) {
+    Read(end_);
+    for (size_t i = 0; i < fds_.size(); i++) {
+        if (end_[i].value < begin_[i].value || end_[i].enabled < begin_[i].enabled) {
+            continue;
+        }
+        double value   = (double)(end_[i].value - begin_[i].value);
+        double enabled = (double)(end_[i].enabled - begin_[i].enabled);
+        double running = (double)(end_[i].running - begin_[i].running);
+        // the counter was multiplexed with others for part of the time
+        if (running > 0 && running < enabled) {
+            value = value * enabled / running;
+        }
+        counts[i % PERF_COUNTER_NUM] += value;
+    }
+}
+
+}  // namespace TNN_NS
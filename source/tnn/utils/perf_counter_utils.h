@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_PERF_COUNTER_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_PERF_COUNTER_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+typedef enum {
+    PERF_COUNTER_CYCLES        = 0,
+    PERF_COUNTER_INSTRUCTIONS  = 1,
+    PERF_COUNTER_L1D_MISSES    = 2,
+    PERF_COUNTER_LLC_MISSES    = 3,
+    PERF_COUNTER_BRANCH_MISSES = 4,
+    PERF_COUNTER_NUM           = 5,
+} PerfCounterType;
+
+// @brief PerfCounters reads the hardware counters of the cpu with perf_event_open on linux and android.
+// The counters are opened on each omp thread by Open, so the threads of the parallel loops are counted
+// as long as the number of threads is unchanged. Begin and End must be called from one thread.
+class PerfCounters {
+public:
+    ~PerfCounters();
+
+    // @brief open the counters on the current omp threads, fails if the cycles can not be counted
+    Status Open();
+
+    void Close();
+
+    bool IsOpened();
+
+    // @brief sample the counters at the begin of a span
+    void Begin();
+
+    // @brief add the counts since Begin summed over all threads to counts, scaled if multiplexed
+    void End(double *counts);
+
+private:
+    struct Sample {
+        unsigned long long value   = 0;
+        unsigned long long enabled = 0;
+        unsigned long long running = 0;
+    };
+
+    void Read(std::vector<Sample> &samples);
+
+    // fd of each thread and counter, -1 if not supported
+    std::vector<int> fds_;
+    std::vector<Sample> begin_;
+    std::vector<Sample> end_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_PERF_COUNTER_UTILS_H_
@@ -0,0 +1,108 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+ThreadPool::ThreadPool(int num_threads) {
+    for (int i = 0; i < num_threads; i++) {
+        workers_.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool *ThreadPool::GetShared() {
+    static ThreadPool pool(std::max((int)std::thread::hardware_concurrency() - 1, 0));
+    return &pool;
+}
+
+int ThreadPool::GetThreadCount() {
+    return (int)workers_.size();
+}
+
+void ThreadPool::WorkerLoop() {
+    OMP_SET_THREADS_(1);
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+/*
+ * The indices are taken one by one from a counter shared by the calling thread
+ * and the workers. A worker which starts after all the indices are taken finds
+ * none left, so the call only waits for the indices being run.
+ */
+void ThreadPool::ParallelFor(int count, const std::function<void(int)> &func) {
+    struct State {
+        std::atomic<int> next = {0};
+        int done              = 0;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto state       = std::make_shared<State>();
+    auto run_indices = [state, count, &func]() {
+        int done = 0;
+        for (int i = state->next++; i < count; i = state->next++) {
+            func(i);
+            done++;
+        }
+        if (done > 0) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done += done;
+            state->condition.notify_all();
+        }
+    };
+
+    int num_tasks = std::min(count - 1, GetThreadCount());
+    if (num_tasks > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int i = 0; i < num_tasks; i++) {
+            tasks_.push_back(run_indices);
+        }
+    }
+    condition_.notify_all();
+
+    run_indices();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&] { return state->done == count; });
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,59 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_THREAD_POOL_H_
+#define TNN_SOURCE_TNN_UTILS_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+// @brief ThreadPool runs tasks on a fixed number of worker threads. The workers run one omp thread
+// each, the tasks are spread over the workers already.
+class ThreadPool {
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    // @brief the pool shared by the instances of the process, with a worker less than the cores
+    // as the calling thread takes part in the tasks
+    static ThreadPool *GetShared();
+
+    int GetThreadCount();
+
+    // @brief run func(0) to func(count - 1) on the calling thread and the free workers, and return when
+    // all of them are done. The calling thread runs the indices no worker takes, so the call never
+    // waits for the workers busy with the tasks of other callers.
+    void ParallelFor(int count, const std::function<void(int)> &func);
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_THREAD_POOL_H_
@@ -0,0 +1,158 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/utils/weight_quant_utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace TNN_NS {
+
+// the weights and scale of the weight only quantized layer, nullptr if the layer has no weights
+static RawBuffer *GetWeightHandle(LayerResource *resource, RawBuffer **scale_handle) {
+    if (auto conv_res = dynamic_cast<ConvLayerResource *>(resource)) {
+        *scale_handle = &conv_res->scale_handle;
+        return &conv_res->filter_handle;
+    }
+    if (auto fc_res = dynamic_cast<InnerProductLayerResource *>(resource)) {
+        *scale_handle = &fc_res->scale_handle;
+        return &fc_res->weight_handle;
+    }
+    return nullptr;
+}
+
+Status WeightQuantUtils::QuantizeWeights(RawBuffer &weights, int rows, int group_size, int bits,
+                                         RawBuffer &quantized, RawBuffer &scales) {
+    if (bits != 8 && bits != 4) {
+        return Status(TNNERR_PARAM_ERR, "weight quantization bits must be 8 or 4");
+    }
+    RawBuffer weights_f32 = ConvertHalfHandle(weights);
+    if (weights_f32.GetDataType() != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_PARAM_ERR, "only float weights can be quantized");
+    }
+    const int count = weights_f32.GetDataCount();
+    if (rows <= 0 || count % rows != 0) {
+        return Status(TNNERR_PARAM_ERR, "weight count is not a multiple of rows");
+    }
+    const int row_size = count / rows;
+    group_size         = group_size > 0 ? group_size : row_size;
+    if (row_size % group_size != 0) {
+        return Status(TNNERR_PARAM_ERR, "group size must divide the row size of the weights");
+    }
+
+    const int groups = count / group_size;
+    const int qmax   = (1 << (bits - 1)) - 1;
+    quantized        = RawBuffer(count);
+    quantized.SetDataType(DATA_TYPE_INT8);
+    scales = RawBuffer(groups * sizeof(float));
+    scales.SetDataType(DATA_TYPE_FLOAT);
+
+    auto weight_data = weights_f32.force_to<float *>();
+    auto quant_data  = quantized.force_to<int8_t *>();
+    auto scale_data  = scales.force_to<float *>();
+    for (int g = 0; g < groups; g++) {
+        auto group_weight = weight_data + g * group_size;
+        float max_abs     = 0;
+        for (int i = 0; i < group_size; i++) {
+            max_abs = std::max(max_abs, std::fabs(group_weight[i]));
+        }
+        const float scale = max_abs / qmax;
+        scale_data[g]     = scale;
+        for (int i = 0; i < group_size; i++) {
+            int value = scale > 0 ? (int)std::round(group_weight[i] / scale) : 0;
+            quant_data[g * group_size + i] = (int8_t)std::min(std::max(value, -qmax), qmax);
+        }
+    }
+    return TNN_OK;
+}
+
+RawBuffer WeightQuantUtils::DequantizeWeights(RawBuffer &quantized, RawBuffer &scales) {
+    const int count  = quantized.GetBytesSize();
+    const int groups = scales.GetDataCount();
+    RawBuffer weights(count * sizeof(float));
+    if (count <= 0 || groups <= 0 || count % groups != 0) {
+        LOGE("invalid weight only quantized buffer, count: %d scales: %d\n", count, groups);
+        return weights;
+    }
+    const int group_size = count / groups;
+    auto quant_data      = quantized.force_to<int8_t *>();
+    auto scale_data      = scales.force_to<float *>();
+    auto weight_data     = weights.force_to<float *>();
+    for (int i = 0; i < count; i++) {
+        weight_data[i] = quant_data[i] * scale_data[i / group_size];
+    }
+    return weights;
+}
+
+bool WeightQuantUtils::IsInt4Weights(RawBuffer &quantized) {
+    auto data = quantized.force_to<int8_t *>();
+    return std::all_of(data, data + quantized.GetBytesSize(), [](int8_t v) { return v >= -8 && v <= 7; });
+}
+
+bool WeightQuantUtils::IsWeightOnlyQuantized(LayerParam *param, LayerResource *resource) {
+    if (!param || param->quantized || !resource) {
+        return false;
+    }
+    RawBuffer *scale_handle = nullptr;
+    auto weight_handle      = GetWeightHandle(resource, &scale_handle);
+    return weight_handle && weight_handle->GetDataType() == DATA_TYPE_INT8 && weight_handle->GetBytesSize() > 0 &&
+           scale_handle->GetBytesSize() > 0;
+}
+
+Status WeightQuantUtils::DequantizeLayerResource(LayerParam *param, LayerResource *resource,
+                                                 std::shared_ptr<LayerResource> &dequantized) {
+    if (!IsWeightOnlyQuantized(param, resource)) {
+        return Status(TNNERR_PARAM_ERR, "layer weights are not weight only quantized");
+    }
+    if (auto conv_res = dynamic_cast<ConvLayerResource *>(resource)) {
+        auto conv_copy           = std::make_shared<ConvLayerResource>(*conv_res);
+        conv_copy->filter_handle = DequantizeWeights(conv_res->filter_handle, conv_res->scale_handle);
+        conv_copy->scale_handle  = RawBuffer();
+        dequantized              = conv_copy;
+    } else {
+        auto fc_res            = dynamic_cast<InnerProductLayerResource *>(resource);
+        auto fc_copy           = std::make_shared<InnerProductLayerResource>(*fc_res);
+        fc_copy->weight_handle = DequantizeWeights(fc_res->weight_handle, fc_res->scale_handle);
+        fc_copy->scale_handle  = RawBuffer();
+        dequantized            = fc_copy;
+    }
+    return TNN_OK;
+}
+
+Status WeightQuantUtils::QuantizeLayerResource(LayerParam *param, LayerResource *resource, int bits,
+                                               int group_size) {
+    if (!param || param->quantized) {
+        return Status(TNNERR_PARAM_ERR, "the layer is already quantized");
+    }
+    int rows = 0;
+    if (auto conv_param = dynamic_cast<ConvLayerParam *>(param)) {
+        rows = conv_param->output_channel;
+    } else if (auto fc_param = dynamic_cast<InnerProductLayerParam *>(param)) {
+        rows = fc_param->num_output;
+    }
+    RawBuffer *scale_handle = nullptr;
+    auto weight_handle      = GetWeightHandle(resource, &scale_handle);
+    if (!weight_handle || rows <= 0) {
+        return Status(TNNERR_PARAM_ERR, "only Convolution, Deconvolution and InnerProduct weights can be quantized");
+    }
+
+    RawBuffer quantized, scales;
+    RETURN_ON_NEQ(QuantizeWeights(*weight_handle, rows, group_size, bits, quantized, scales), TNN_OK);
+    *weight_handle = quantized;
+    *scale_handle  = scales;
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,58 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_UTILS_WEIGHT_QUANT_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_WEIGHT_QUANT_UTILS_H_
+
+#include <memory>
+
+#include "tnn/core/status.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// @brief WeightQuantUtils handles weight only quantized layers: the weights of a Convolution, Deconvolution
+// or InnerProduct layer are int8 with one float scale in scale_handle for each group of consecutive weights,
+// weight = value * scale. the param is not quantized and the layer runs in float. int4 weights are int8
+// values in [-8, 7], they are packed two per byte in the model file only.
+class WeightQuantUtils {
+public:
+    // @brief quantize rows of float weights symmetrically to int8 or int4 values.
+    // @param group_size weights sharing one scale, it must divide the row size. 0 for one scale per row
+    static Status QuantizeWeights(RawBuffer &weights, int rows, int group_size, int bits, RawBuffer &quantized,
+                                  RawBuffer &scales);
+
+    // @brief float weights of the quantized values, the group size is the number of values per scale
+    static RawBuffer DequantizeWeights(RawBuffer &quantized, RawBuffer &scales);
+
+    // @brief whether all the quantized values fit in int4
+    static bool IsInt4Weights(RawBuffer &quantized);
+
+    // @brief whether the weights of the layer are weight only quantized
+    static bool IsWeightOnlyQuantized(LayerParam *param, LayerResource *resource);
+
+    // @brief copy of the resource with float weights, the other buffers are shared with the resource
+    static Status DequantizeLayerResource(LayerParam *param, LayerResource *resource,
+                                          std::shared_ptr<LayerResource> &dequantized);
+
+    // @brief quantize the float weights of a Convolution, Deconvolution or InnerProduct layer in place
+    static Status QuantizeLayerResource(LayerParam *param, LayerResource *resource, int bits, int group_size);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_WEIGHT_QUANT_UTILS_H_
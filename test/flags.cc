@@ -52,4 +52,10 @@ DEFINE_string(pr, "AUTO", precision_message);
 
 DEFINE_string(is, "", input_shape_message);
 
+DEFINE_bool(pf, false, profile_message);
+
+DEFINE_string(pt, "", profile_trace_message);
+
+DEFINE_bool(pc, false, profile_counters_message);
+
 }  // namespace TNN_NS
@@ -61,6 +61,12 @@ static const char input_shape_message[] = "input shape: name[n,c,h,w]";
 
 static const char network_type_message[] = "network type: NAIVE, NPU, COREML, SNPE, OPENVINO, default NAIVE";
 
+static const char profile_message[] = "profile each layer and print the per-layer table(default false)";
+
+static const char profile_trace_message[] = "write the profile timeline to a chrome trace json file, implies -pf";
+
+static const char profile_counters_message[] = "capture the cpu counters of each layer with perf_event_open, implies -pf";
+
 DECLARE_bool(h);
 
 DECLARE_string(mt);
@@ -97,6 +103,12 @@ DECLARE_string(pr);
 
 DECLARE_string(is);
 
+DECLARE_bool(pf);
+
+DECLARE_string(pt);
+
+DECLARE_bool(pc);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_FLAGS_H_
@@ -111,9 +111,10 @@ namespace test {
                     blob_converter->ConvertToMat(*output_mat_map[name], output_params_map[name], command_queue);
                 }
             }
-#if TNN_PROFILE
-            instance->StartProfile();
-#endif
+            bool profile = FLAGS_pf || FLAGS_pc || !FLAGS_pt.empty();
+            if (profile) {
+                instance->StartProfile(FLAGS_pc);
+            }
             
             std::string model_name = FLAGS_mp;
             if(FLAGS_mp.find_last_of("/") != -1) {
@@ -146,9 +147,13 @@ namespace test {
                 }
                 timer.Stop();
             }
-#if TNN_PROFILE
-            instance->FinishProfile(true);
-#endif
+            if (profile) {
+                instance->FinishProfile(true);
+                if (!FLAGS_pt.empty()) {
+                    std::ofstream trace_stream(FLAGS_pt);
+                    trace_stream << instance->GetProfileTrace();
+                }
+            }
             CheckResult("Forward", ret);
 
             if (!FLAGS_op.empty()) {
@@ -202,6 +207,9 @@ namespace test {
         printf("    -is \"<input shape>\"   \t%s \n", input_shape_message);
         printf("    -fc \"<format for compare>\t%s \n", output_format_cmp_message);
         printf("    -nt \"<network type>\t%s \n", output_format_cmp_message);
+        printf("    -pf                     \t%s \n", profile_message);
+        printf("    -pt \"<trace path>\"    \t%s \n", profile_trace_message);
+        printf("    -pc                     \t%s \n", profile_counters_message);
     }
 
     void SetCpuAffinity() {
@@ -0,0 +1,154 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+#include "tools/converter/source/optimizer/tnn_optimize_pass.h"
+
+namespace TNN_NS {
+
+class ShapeFoldingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        structure_.inputs_shape_map["data"] = {1, 8, 16, 16};
+        structure_.blobs.insert("data");
+    }
+
+    void AddLayer(LayerType type, const std::string &name, const std::string &input, const std::string &output,
+                  std::shared_ptr<LayerParam> param) {
+        auto layer     = std::make_shared<LayerInfo>();
+        layer->type    = type;
+        layer->name    = name;
+        layer->inputs  = {input};
+        layer->outputs = {output};
+        layer->param   = param;
+        structure_.layers.push_back(layer);
+        structure_.blobs.insert(output);
+    }
+
+    std::shared_ptr<LayerParam> ReshapeParam(std::vector<int> shape) {
+        auto param      = std::make_shared<ReshapeLayerParam>();
+        param->shape    = shape;
+        param->num_axes = (int)shape.size();
+        return param;
+    }
+
+    std::shared_ptr<LayerParam> UpsampleParam(std::vector<float> scales, std::vector<int> dims) {
+        auto param    = std::make_shared<UpsampleLayerParam>();
+        param->mode   = 1;
+        param->scales = scales;
+        param->dims   = dims;
+        return param;
+    }
+
+    Status ShapeFolding(bool fixed_shape) {
+        auto pass = TNN_CONVERTER::TnnOptimizePassManager::get()->search("ShapeFolding");
+        if (!pass) {
+            return Status(TNNERR_CONVERT_UNSUPPORT_PASS, "ShapeFolding is not registered");
+        }
+        TNN_CONVERTER::TnnOptimizeOptions options;
+        options.fixed_shape = fixed_shape;
+        pass->SetOptions(options);
+        return pass->exec(structure_, resource_);
+    }
+
+    std::vector<std::string> GetLayerNames() {
+        std::vector<std::string> names;
+        for (auto layer : structure_.layers) {
+            names.push_back(layer->name);
+        }
+        return names;
+    }
+
+    NetStructure structure_;
+    NetResource resource_;
+};
+
+TEST_F(ShapeFoldingTest, KeepLayersDependingOnShapes) {
+    // identities at the declared input shape only
+    AddLayer(LAYER_RESHAPE, "reshape", "data", "b0", ReshapeParam({1, 8, 16, 16}));
+    AddLayer(LAYER_UPSAMPLE, "upsample", "b0", "b1", UpsampleParam({1, 1}, {16, 16}));
+    auto slice_param     = std::make_shared<StrideSliceLayerParam>();
+    slice_param->begins  = {0, 0, 0, 0};
+    slice_param->ends    = {16, 16, 8, 1};
+    slice_param->strides = {1, 1, 1, 1};
+    AddLayer(LAYER_STRIDED_SLICE, "slice", "b1", "out", slice_param);
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)ShapeFolding(false), TNN_CONVERT_OK);
+    std::vector<std::string> names = {"reshape", "upsample", "slice"};
+    EXPECT_EQ(GetLayerNames(), names);
+}
+
+TEST_F(ShapeFoldingTest, RemoveIdentityLayers) {
+    auto pad_param  = std::make_shared<PadLayerParam>();
+    pad_param->pads = {0, 0, 0, 0, 0, 0};
+    AddLayer(LAYER_PAD, "pad", "data", "b0", pad_param);
+    auto permute_param    = std::make_shared<PermuteLayerParam>();
+    permute_param->orders = {0, 1, 2, 3};
+    AddLayer(LAYER_PERMUTE, "permute", "b0", "b1", permute_param);
+    AddLayer(LAYER_CONCAT, "concat", "b1", "b2", std::make_shared<ConcatLayerParam>());
+    AddLayer(LAYER_UPSAMPLE, "upsample", "b2", "b3", UpsampleParam({1, 1}, {}));
+    AddLayer(LAYER_RELU, "relu", "b3", "out", std::make_shared<LayerParam>());
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)ShapeFolding(false), TNN_CONVERT_OK);
+    std::vector<std::string> names = {"relu"};
+    EXPECT_EQ(GetLayerNames(), names);
+    EXPECT_EQ(structure_.layers[0]->inputs[0], "data");
+}
+
+TEST_F(ShapeFoldingTest, KeepPaddingAndScaling) {
+    auto pad_param  = std::make_shared<PadLayerParam>();
+    pad_param->pads = {1, -1, 0, 0, 0, 0};
+    AddLayer(LAYER_PAD, "pad", "data", "b0", pad_param);
+    AddLayer(LAYER_UPSAMPLE, "upsample", "b0", "out", UpsampleParam({2, 2}, {}));
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)ShapeFolding(true), TNN_CONVERT_OK);
+    std::vector<std::string> names = {"pad", "upsample"};
+    EXPECT_EQ(GetLayerNames(), names);
+}
+
+TEST_F(ShapeFoldingTest, FixedShapeRemovesIdentitiesAtInputShapes) {
+    AddLayer(LAYER_RELU, "relu", "data", "b0", std::make_shared<LayerParam>());
+    AddLayer(LAYER_RESHAPE, "reshape", "b0", "b1", ReshapeParam({1, 8, 16, 16}));
+    AddLayer(LAYER_UPSAMPLE, "upsample", "b1", "b2", UpsampleParam({1, 1}, {16, 16}));
+    AddLayer(LAYER_RESHAPE, "flat", "b2", "out", ReshapeParam({1, -1, 1, 1}));
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)ShapeFolding(true), TNN_CONVERT_OK);
+    std::vector<std::string> names = {"relu", "flat"};
+    EXPECT_EQ(GetLayerNames(), names);
+    EXPECT_EQ(structure_.layers[1]->inputs[0], "b0");
+}
+
+TEST_F(ShapeFoldingTest, KeepOutputName) {
+    AddLayer(LAYER_RELU, "relu", "data", "b0", std::make_shared<LayerParam>());
+    auto permute_param    = std::make_shared<PermuteLayerParam>();
+    permute_param->orders = {0, 1, 2, 3};
+    AddLayer(LAYER_PERMUTE, "permute", "b0", "out", permute_param);
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)ShapeFolding(false), TNN_CONVERT_OK);
+    std::vector<std::string> names = {"relu"};
+    EXPECT_EQ(GetLayerNames(), names);
+    EXPECT_EQ(structure_.layers[0]->outputs[0], "out");
+}
+
+}  // namespace TNN_NS
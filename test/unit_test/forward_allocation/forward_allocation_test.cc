@@ -0,0 +1,155 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/memory_manager/memory_allocator.h"
+
+// count the heap allocations of the whole process while enabled, the steady state forward of a network
+// must not allocate. the global operator new is replaced, so the test runs in its own binary. the host
+// allocator does not go through operator new, its stats are checked as well
+static std::atomic<bool> g_count_allocations(false);
+static std::atomic<int> g_allocation_count(0);
+
+void* operator new(size_t size) {
+    if (g_count_allocations) {
+        g_allocation_count++;
+    }
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+namespace TNN_NS {
+
+static const char* g_forward_test_proto =
+    "\"1 11 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 r0 p0 c1 g0 d0 a0 s0 out data ,\""
+    "\"out ,\""
+    "\" 9 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 r0 ,\""
+    "\"Pooling pool0 1 1 r0 p0 0 2 2 2 2 0 0 -1 -1 -1 0 ,\""
+    "\"Convolution conv1 1 1 p0 c1 1 16 16 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Convolution conv2 1 1 c1 g0 2 16 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    // depthwise with a channel multiplier of 2, the channels of each group are repacked
+    "\"Convolution conv3 1 1 c1 d0 16 16 32 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Add add0 2 1 g0 p0 a0 1 ,\""
+    "\"Sigmoid sigmoid0 1 1 a0 s0 ,\""
+    "\"Concat concat0 3 1 s0 p0 d0 out 1 ,\"";
+
+// the model of the test net is generated in memory, the proto is interpreted as usual
+class ForwardTestInterpreter : public ModelInterpreter {
+public:
+    Status InterpretTestNet() {
+        std::string proto = g_forward_test_proto;
+        RETURN_ON_NEQ(InterpretProto(proto), TNN_OK);
+
+        for (auto& layer : GetNetStructure()->layers) {
+            if (layer->type != LAYER_CONVOLUTION) {
+                continue;
+            }
+            auto param       = dynamic_cast<ConvLayerParam*>(layer->param.get());
+            int filter_count = param->output_channel * param->input_channel / param->group * param->kernels[0] *
+                               param->kernels[1];
+
+            auto resource           = std::make_shared<ConvLayerResource>();
+            resource->filter_handle = RawBuffer(filter_count * sizeof(float));
+            resource->bias_handle   = RawBuffer(param->output_channel * sizeof(float));
+            InitRandom(resource->filter_handle.force_to<float*>(), filter_count, 0.1f);
+            InitRandom(resource->bias_handle.force_to<float*>(), param->output_channel, 0.1f);
+            GetNetResource()->resource_map[layer->name] = resource;
+        }
+        return TNN_OK;
+    }
+};
+
+static void ExpectForwardAllocationFree(NetworkConfig net_config) {
+    ModelConfig model_config;
+
+    auto interpreter = std::make_shared<ForwardTestInterpreter>();
+    Status status    = interpreter->InterpretTestNet();
+    ASSERT_EQ((int)status, TNN_OK);
+
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, InputShapesMap());
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP() << "the device is not supported";
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    // the first forward may still grow the shared workspace of the context
+    status = instance->Forward();
+    if (status == TNNERR_SET_CPU_AFFINITY) {
+        GTEST_SKIP() << "the threads can not be pinned";
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    auto host_stats     = MemoryAllocator::GetHostStats();
+    g_allocation_count  = 0;
+    g_count_allocations = true;
+    for (int i = 0; i < 3; ++i) {
+        status = instance->Forward();
+    }
+    g_count_allocations = false;
+
+    EXPECT_EQ((int)status, TNN_OK);
+    EXPECT_EQ(g_allocation_count, 0);
+    auto forward_host_stats = MemoryAllocator::GetHostStats();
+    EXPECT_EQ(forward_host_stats.num_allocations, host_stats.num_allocations);
+    EXPECT_EQ(forward_host_stats.bytes_in_use, host_stats.bytes_in_use);
+}
+
+static NetworkConfig GetForwardTestNetworkConfig() {
+    NetworkConfig net_config;
+    net_config.device_type = ConvertDeviceType(FLAGS_dt);
+    return net_config;
+}
+
+TEST(ForwardAllocationTest, SteadyStateForwardAllocationFree) {
+    auto net_config = GetForwardTestNetworkConfig();
+    // the reference accs of the naive device are not tuned for the hot path
+    if (net_config.device_type != DEVICE_ARM) {
+        GTEST_SKIP() << "only the arm forward is allocation free";
+    }
+    ExpectForwardAllocationFree(net_config);
+}
+
+TEST(ForwardAllocationTest, NumaPinnedForwardAllocationFree) {
+    auto net_config = GetForwardTestNetworkConfig();
+    if (net_config.device_type != DEVICE_ARM) {
+        GTEST_SKIP() << "only the arm forward is allocation free";
+    }
+    // the threads are pinned to the cpus of the node at the beginning of every forward
+    net_config.numa_node = 0;
+    ExpectForwardAllocationFree(net_config);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,463 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+#ifdef TNN_ARM_ENABLE
+#include "tnn/device/arm/acc/convolution/arm_conv_layer_acc_factory.h"
+#endif
+
+namespace TNN_NS {
+
+/*
+ * The layer benchmark runs the layers of realistic shapes on the device and prints one row per shape and impl.
+ * The results are still compared with the naive device, so a forced impl producing wrong results fails the case.
+ */
+class LayerBenchmark : public LayerTest {
+protected:
+    void Bench(LayerType type, const std::string &shape, const std::string &imp, LayerParam *param,
+               LayerResource *resource, std::vector<BlobDesc> &inputs_desc, std::vector<BlobDesc> &outputs_desc,
+               int weight_bytes = 0) {
+        type_         = type;
+        weight_bytes_ = weight_bytes;
+        time_avg_     = 0.f;
+        Run(type, param, resource, inputs_desc, outputs_desc);
+        if (HasFailure() || time_avg_ <= 0.f) {
+            return;
+        }
+
+        std::string gflops = "-";
+        if (gflops_ > 0.f) {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%.2f", gflops_);
+            gflops = buffer;
+        }
+        printf("%-12s %-40s %-16s avg %9.3f ms  min %9.3f ms  %8s GFLOPS  %8.2f GB/s\n",
+               param->name.c_str(), shape.c_str(), imp.c_str(),
+               time_avg_, time_min_, gflops.c_str(), dram_thrp_);
+    }
+
+    float GetCalcMflops(LayerParam *param, std::vector<Blob *> inputs, std::vector<Blob *> outputs) {
+        auto dims_input  = inputs[0]->GetBlobDesc().dims;
+        auto dims_output = outputs[0]->GetBlobDesc().dims;
+        float flops      = 0.f;
+        if (type_ == LAYER_CONVOLUTION || type_ == LAYER_DECONVOLUTION) {
+            auto conv_param = dynamic_cast<ConvLayerParam *>(param);
+            // deconv scatters each input pixel to the kernel window of the output
+            auto &dims = type_ == LAYER_CONVOLUTION ? dims_output : dims_input;
+            int channel = type_ == LAYER_CONVOLUTION ? dims_input[1] : dims_output[1];
+            flops       = 2.0f * DimsVectorUtils::Count(dims) * channel / conv_param->group * conv_param->kernels[0] *
+                    conv_param->kernels[1];
+        } else if (type_ == LAYER_POOLING) {
+            auto pool_param = dynamic_cast<PoolingLayerParam *>(param);
+            flops = 1.0f * DimsVectorUtils::Count(dims_output) * pool_param->kernels[0] * pool_param->kernels[1];
+        } else if (type_ == LAYER_INNER_PRODUCT) {
+            flops = 2.0f * DimsVectorUtils::Count(dims_input) * dims_output[1];
+        } else if (type_ == LAYER_SOFTMAX) {
+            // max, exp, sum and div of each element
+            flops = 4.0f * DimsVectorUtils::Count(dims_input);
+        }
+        return flops / 1000.f / 1000.f;
+    }
+
+    float GetCalcDramThrp(float avg_time) {
+        // the weights are read once in each forward
+        return LayerTest::GetCalcDramThrp(avg_time) + weight_bytes_ / 1000.f / 1000.f / avg_time;
+    }
+
+    LayerType type_   = LAYER_NOT_SUPPORT;
+    int weight_bytes_ = 0;
+};
+
+static std::shared_ptr<ConvLayerResource> CreateConvResource(int filter_count, int bias_count) {
+    auto resource = std::make_shared<ConvLayerResource>();
+    RawBuffer filter(filter_count * sizeof(float));
+    RawBuffer bias(bias_count * sizeof(float));
+    InitRandom(filter.force_to<float *>(), filter_count, 1.0f);
+    InitRandom(bias.force_to<float *>(), bias_count, 1.0f);
+    resource->filter_handle = filter;
+    resource->bias_handle   = bias;
+    return resource;
+}
+
+struct ConvShape {
+    int input_channel;
+    int output_channel;
+    int size;
+    int kernel;
+    int stride;
+    int group;
+};
+
+static std::ostream &operator<<(std::ostream &os, const ConvShape &shape) {
+    return os << "c" << shape.input_channel << "->" << shape.output_channel << " " << shape.size << "x"
+              << shape.size << " k" << shape.kernel << " s" << shape.stride << " g" << shape.group;
+}
+
+class ConvLayerBenchmark : public LayerBenchmark, public ::testing::WithParamInterface<ConvShape> {};
+
+// 1x1, 3x3, depthwise, group and c3 convs of mobilenet, resnet and shufflenet
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, ConvLayerBenchmark,
+                         ::testing::Values(
+                             // 1x1
+                             ConvShape{32, 64, 112, 1, 1, 1}, ConvShape{64, 128, 56, 1, 1, 1},
+                             ConvShape{128, 128, 56, 1, 1, 1}, ConvShape{256, 256, 28, 1, 1, 1},
+                             ConvShape{512, 512, 14, 1, 1, 1}, ConvShape{1024, 1024, 7, 1, 1, 1},
+                             ConvShape{24, 144, 56, 1, 1, 1}, ConvShape{960, 160, 7, 1, 1, 1},
+                             // 3x3
+                             ConvShape{16, 16, 112, 3, 1, 1}, ConvShape{64, 64, 56, 3, 1, 1},
+                             ConvShape{128, 128, 28, 3, 1, 1}, ConvShape{256, 256, 14, 3, 1, 1},
+                             ConvShape{512, 512, 7, 3, 1, 1}, ConvShape{64, 128, 56, 3, 2, 1},
+                             // depthwise
+                             ConvShape{32, 32, 112, 3, 1, 32}, ConvShape{64, 64, 112, 3, 2, 64},
+                             ConvShape{128, 128, 56, 3, 1, 128}, ConvShape{256, 256, 28, 3, 1, 256},
+                             ConvShape{512, 512, 14, 3, 1, 512}, ConvShape{1024, 1024, 7, 3, 1, 1024},
+                             ConvShape{96, 96, 28, 5, 1, 96},
+                             // group
+                             ConvShape{64, 64, 56, 3, 1, 4}, ConvShape{128, 128, 28, 3, 1, 8},
+                             ConvShape{240, 240, 28, 1, 1, 3}, ConvShape{256, 256, 14, 3, 1, 32},
+                             // c3
+                             ConvShape{3, 32, 224, 3, 2, 1}, ConvShape{3, 16, 224, 3, 1, 1},
+                             ConvShape{3, 64, 224, 7, 2, 1}));
+
+TEST_P(ConvLayerBenchmark, ConvLayer) {
+    auto shape       = GetParam();
+    const int pad    = shape.kernel / 2;
+    const int output = (shape.size + 2 * pad - shape.kernel) / shape.stride + 1;
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(1, shape.input_channel, shape.size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    ConvLayerParam param;
+    param.name           = "Conv";
+    param.input_channel  = shape.input_channel;
+    param.output_channel = shape.output_channel;
+    param.group          = shape.group;
+    param.kernels        = {shape.kernel, shape.kernel};
+    param.dialations     = {1, 1};
+    param.strides        = {shape.stride, shape.stride};
+    param.pads           = {pad, pad, pad, pad};
+    param.bias           = 1;
+
+    // resource
+    int filter_count = shape.input_channel * shape.output_channel * shape.kernel * shape.kernel / shape.group;
+    auto resource    = CreateConvResource(filter_count, shape.output_channel);
+    int weight_bytes = filter_count * sizeof(float);
+
+    std::ostringstream name;
+    name << shape;
+
+    // time the impl chosen by the heuristics only if the impls can not be forced
+    std::vector<std::string> imp_names = {"Auto"};
+#ifdef TNN_ARM_ENABLE
+    std::vector<ArmConvImpType> candidates = {ARM_CONV_IMP_AUTO};
+    std::string prefix;
+    if (ConvertDeviceType(FLAGS_dt) == DEVICE_ARM) {
+        // the arm group conv runs each group with the impls of the group shape
+        bool group_conv      = shape.group != 1 && shape.group != shape.input_channel;
+        int group            = group_conv ? shape.group : 1;
+        ConvLayerParam local = param;
+        local.input_channel  = shape.input_channel / group;
+        local.output_channel = shape.output_channel / group;
+        local.group          = group_conv ? 1 : shape.group;
+        BlobDesc input_desc, output_desc;
+        input_desc.dims  = {1, local.input_channel, shape.size, shape.size};
+        output_desc.dims = {1, local.output_channel, output, output};
+        Blob input_blob(input_desc), output_blob(output_desc);
+        candidates = ArmConvLayerAccFactory::GetCandidatesFP({&input_blob}, {&output_blob}, &local, resource.get());
+        prefix     = group_conv ? "Group/" : "";
+        imp_names.clear();
+        for (int i = 0; i < candidates.size(); i++) {
+            // the first candidate is the one chosen by the heuristics
+            imp_names.push_back(prefix + ArmConvLayerAccFactory::GetImpName(candidates[i]) + (i == 0 ? "*" : ""));
+        }
+    }
+#endif
+
+    std::vector<float> times;
+    for (int i = 0; i < imp_names.size(); i++) {
+#ifdef TNN_ARM_ENABLE
+        ArmConvLayerAccFactory::SetForcedImpFP(candidates[i]);
+#endif
+        Bench(LAYER_CONVOLUTION, name.str(), imp_names[i], &param, resource.get(), inputs_desc, outputs_desc,
+              weight_bytes);
+        times.push_back(time_avg_);
+    }
+#ifdef TNN_ARM_ENABLE
+    ArmConvLayerAccFactory::SetForcedImpFP(ARM_CONV_IMP_AUTO);
+#endif
+
+    int best = 0;
+    for (int i = 1; i < times.size(); i++) {
+        if (times[i] > 0.f && times[i] < times[best]) {
+            best = i;
+        }
+    }
+    // the heuristics are wrong if another impl is faster by more than 10 percent
+    if (best != 0 && times[best] * 1.1f < times[0]) {
+        printf("%-12s %-40s %-16s is %.2fx faster than the prefered %s\n", "", name.str().c_str(),
+               imp_names[best].c_str(), times[0] / times[best], imp_names[0].c_str());
+    }
+}
+
+class DeconvLayerBenchmark : public LayerBenchmark, public ::testing::WithParamInterface<ConvShape> {};
+
+// upsampling deconvs of segmentation and detection heads
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, DeconvLayerBenchmark,
+                         ::testing::Values(ConvShape{256, 128, 14, 4, 2, 1}, ConvShape{128, 64, 28, 4, 2, 1},
+                                           ConvShape{64, 64, 56, 2, 2, 1}, ConvShape{256, 256, 14, 4, 2, 256},
+                                           ConvShape{64, 32, 56, 3, 1, 1}));
+
+TEST_P(DeconvLayerBenchmark, DeconvLayer) {
+    auto shape    = GetParam();
+    const int pad = shape.stride == 1 ? shape.kernel / 2 : (shape.kernel - shape.stride) / 2;
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(1, shape.input_channel, shape.size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    ConvLayerParam param;
+    param.name           = "Deconv";
+    param.input_channel  = shape.input_channel;
+    param.output_channel = shape.output_channel;
+    param.group          = shape.group;
+    param.kernels        = {shape.kernel, shape.kernel};
+    param.dialations     = {1, 1};
+    param.strides        = {shape.stride, shape.stride};
+    param.pads           = {pad, pad, pad, pad};
+    param.bias           = 1;
+
+    // resource
+    int filter_count = shape.input_channel * shape.output_channel * shape.kernel * shape.kernel / shape.group;
+    auto resource    = CreateConvResource(filter_count, shape.output_channel);
+
+    std::ostringstream name;
+    name << shape;
+    Bench(LAYER_DECONVOLUTION, name.str(), "Auto", &param, resource.get(), inputs_desc, outputs_desc,
+          filter_count * sizeof(float));
+}
+
+class PoolingLayerBenchmark : public LayerBenchmark,
+                              public ::testing::WithParamInterface<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, PoolingLayerBenchmark,
+                         ::testing::Values(
+                             // channel, size, kernel (0: global), stride, pool type (0: max, 1: avg)
+                             std::make_tuple(64, 112, 3, 2, 0), std::make_tuple(64, 112, 2, 2, 0),
+                             std::make_tuple(256, 56, 3, 1, 0), std::make_tuple(256, 56, 2, 2, 1),
+                             std::make_tuple(1024, 7, 0, 1, 1), std::make_tuple(2048, 7, 0, 1, 1),
+                             std::make_tuple(512, 14, 0, 1, 0)));
+
+TEST_P(PoolingLayerBenchmark, PoolingLayer) {
+    // get param
+    int channel   = std::get<0>(GetParam());
+    int size      = std::get<1>(GetParam());
+    int kernel    = std::get<2>(GetParam());
+    int stride    = std::get<3>(GetParam());
+    int pool_type = std::get<4>(GetParam());
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(1, channel, size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    PoolingLayerParam param;
+    param.name           = "Pooling";
+    param.kernels_params = {kernel, kernel};
+    param.kernels        = {kernel, kernel};
+    param.strides        = {stride, stride};
+    param.pads           = kernel == 3 ? std::vector<int>{1, 1, 1, 1} : std::vector<int>{0, 0, 0, 0};
+    param.pad_type       = -1;
+    param.pool_type      = pool_type;
+    param.kernel_indexs  = {-1, -1};
+
+    std::ostringstream name;
+    name << "c" << channel << " " << size << "x" << size << " " << (kernel ? "k" + std::to_string(kernel) : "global")
+         << " s" << stride << (pool_type ? " avg" : " max");
+    Bench(LAYER_POOLING, name.str(), "Auto", &param, nullptr, inputs_desc, outputs_desc);
+}
+
+class InnerProductLayerBenchmark : public LayerBenchmark,
+                                   public ::testing::WithParamInterface<std::tuple<int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, InnerProductLayerBenchmark,
+                         ::testing::Values(
+                             // batch, input channel, size, output channel
+                             std::make_tuple(1, 1024, 1, 1000), std::make_tuple(1, 2048, 1, 1000),
+                             std::make_tuple(1, 512, 7, 4096), std::make_tuple(1, 4096, 1, 4096),
+                             std::make_tuple(8, 1024, 1, 1000), std::make_tuple(1, 128, 1, 128)));
+
+TEST_P(InnerProductLayerBenchmark, InnerProductLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int size           = std::get<2>(GetParam());
+    int output_channel = std::get<3>(GetParam());
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, input_channel, size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    InnerProductLayerParam param;
+    param.name       = "InnerProduct";
+    param.num_output = output_channel;
+    param.has_bias   = 1;
+    param.axis       = 1;
+
+    // resource
+    InnerProductLayerResource resource;
+    int filter_count = output_channel * input_channel * size * size;
+    RawBuffer filter(filter_count * sizeof(float));
+    RawBuffer bias(output_channel * sizeof(float));
+    InitRandom(filter.force_to<float *>(), filter_count, 1.0f);
+    InitRandom(bias.force_to<float *>(), output_channel, 1.0f);
+    resource.weight_handle = filter;
+    resource.bias_handle   = bias;
+
+    std::ostringstream name;
+    name << "n" << batch << " c" << input_channel << "x" << size << "x" << size << "->" << output_channel;
+    Bench(LAYER_INNER_PRODUCT, name.str(), "Auto", &param, &resource, inputs_desc, outputs_desc,
+          filter_count * sizeof(float));
+}
+
+class SoftmaxLayerBenchmark : public LayerBenchmark,
+                              public ::testing::WithParamInterface<std::tuple<int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, SoftmaxLayerBenchmark,
+                         ::testing::Values(
+                             // channel, height, width, axis
+                             std::make_tuple(1000, 1, 1, 1), std::make_tuple(21, 128, 128, 1),
+                             std::make_tuple(2, 256, 256, 1), std::make_tuple(64, 128, 128, 2),
+                             std::make_tuple(8, 64, 1024, 3)));
+
+TEST_P(SoftmaxLayerBenchmark, SoftmaxLayer) {
+    // get param
+    int channel = std::get<0>(GetParam());
+    int height  = std::get<1>(GetParam());
+    int width   = std::get<2>(GetParam());
+    int axis    = std::get<3>(GetParam());
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(1, channel, height, width, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    SoftmaxLayerParam param;
+    param.name = "Softmax";
+    param.axis = axis;
+
+    std::ostringstream name;
+    name << "c" << channel << " " << height << "x" << width << " axis" << axis;
+    Bench(LAYER_SOFTMAX, name.str(), "Auto", &param, nullptr, inputs_desc, outputs_desc);
+}
+
+class ConcatLayerBenchmark : public LayerBenchmark,
+                             public ::testing::WithParamInterface<std::tuple<int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, ConcatLayerBenchmark,
+                         ::testing::Values(
+                             // channel, size, input count, axis
+                             std::make_tuple(64, 56, 2, 1), std::make_tuple(58, 28, 2, 1),
+                             std::make_tuple(256, 28, 4, 1), std::make_tuple(128, 14, 2, 2),
+                             std::make_tuple(32, 56, 3, 3)));
+
+TEST_P(ConcatLayerBenchmark, ConcatLayer) {
+    // get param
+    int channel     = std::get<0>(GetParam());
+    int size        = std::get<1>(GetParam());
+    int input_count = std::get<2>(GetParam());
+    int axis        = std::get<3>(GetParam());
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(1, channel, size, input_count, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    ConcatLayerParam param;
+    param.name = "Concat";
+    param.axis = axis;
+
+    std::ostringstream name;
+    name << input_count << " x c" << channel << " " << size << "x" << size << " axis" << axis;
+    Bench(LAYER_CONCAT, name.str(), "Auto", &param, nullptr, inputs_desc, outputs_desc);
+}
+
+class ReformatLayerBenchmark : public LayerBenchmark,
+                               public ::testing::WithParamInterface<std::tuple<int, int, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, ReformatLayerBenchmark,
+                         ::testing::Combine(
+                             // channel
+                             testing::Values(32, 256),
+                             // size
+                             testing::Values(14, 56),
+                             // src type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_INT8)));
+
+TEST_P(ReformatLayerBenchmark, ReformatLayer) {
+    // get param
+    int channel             = std::get<0>(GetParam());
+    int size                = std::get<1>(GetParam());
+    DataType src_type       = std::get<2>(GetParam());
+    DataType dst_type       = src_type == DATA_TYPE_INT8 ? DATA_TYPE_FLOAT : DATA_TYPE_INT8;
+    if (ConvertDeviceType(FLAGS_dt) != DEVICE_ARM) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(1, channel, size, 1, src_type);
+    auto outputs_desc = CreateOutputBlobsDesc(1, dst_type);
+
+    // param
+    ReformatLayerParam param;
+    param.name     = "Reformat";
+    param.src_type = src_type;
+    param.dst_type = dst_type;
+
+    std::ostringstream name;
+    name << "c" << channel << " " << size << "x" << size << (src_type == DATA_TYPE_INT8 ? " int8->fp32" : " fp32->int8");
+    Bench(LAYER_REFORMAT, name.str(), "Auto", &param, nullptr, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
+
+GTEST_API_ int main(int argc, char **argv) {
+    // a single forward is too noisy to compare the impls
+    gflags::SetCommandLineOptionWithMode("ic", "20", gflags::SET_FLAGS_DEFAULT);
+    gflags::SetCommandLineOptionWithMode("wc", "5", gflags::SET_FLAGS_DEFAULT);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+    if (TNN_NS::FLAGS_h) {
+        printf("    -dt \"<device type>\"  %s \n", TNN_NS::device_type_message);
+        printf("    -lp \"<dependent library path>\"  %s \n", TNN_NS::library_path_message);
+        printf("    -ic \"<number>\"        %s \n", TNN_NS::iterations_count_message);
+        printf("    -wc \"<number>\"        %s \n", TNN_NS::warm_up_count_message);
+        printf("    -th \"<number>\"        %s \n", TNN_NS::cpu_thread_num_message);
+        return 0;
+    }
+    return RUN_ALL_TESTS();
+}
@@ -165,6 +165,9 @@ Status LayerTest::CreateInputBlobs(std::vector<BlobDesc>& inputs_desc) {
     for (auto blob_desc : inputs_desc) {
         BlobDesc device_blob_desc    = blob_desc;
         device_blob_desc.device_type = device_->GetDeviceType();
+        if (device_data_format_ != DATA_FORMAT_AUTO) {
+            device_blob_desc.data_format = device_data_format_;
+        }
 
         Blob *cpu_input_blob, *device_input_blob;
         if (blob_desc.data_type == DATA_TYPE_INT8) {
@@ -196,6 +199,9 @@ Status LayerTest::CreateOutputBlobs(std::vector<BlobDesc>& outputs_desc) {
     for (auto blob_desc : outputs_desc) {
         BlobDesc device_blob_desc    = blob_desc;
         device_blob_desc.device_type = device_->GetDeviceType();
+        if (device_data_format_ != DATA_FORMAT_AUTO) {
+            device_blob_desc.data_format = device_data_format_;
+        }
 
         Blob *cpu_output_blob, *device_output_blob;
         if (blob_desc.data_type == DATA_TYPE_INT8) {
@@ -312,6 +318,15 @@ Status LayerTest::InitInputBlobsDataRandom() {
             LOGE("input blob_converter failed (%s)\n", ret.description().c_str());
         }
 
+        if (device_input_blob->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+            // the blob converter works on packed formats only
+            auto &dims = blob_desc.dims;
+            DataFormatConverter::ConvertBetweenNHWCAndNCHW<float>(
+                static_cast<float*>(input_data), static_cast<float*>(device_input_blob->GetHandle().base), dims[0],
+                dims[1], dims[2], dims[3], DataFormatConverter::NCHW2NHWC);
+            continue;
+        }
+
         // CONVERT TO DEVICE BLOB
         BlobConverter blob_converter(device_input_blob);
         ret = blob_converter.ConvertFromMat(source, param, command_queue);
@@ -358,7 +373,7 @@ Status LayerTest::Forward() {
     EXPECT_EQ_OR_RETURN(status, TNN_OK);
 #endif
 
-#if TNN_PROFILE && defined(TNN_UNIT_TEST_BENCHMARK)
+#ifdef TNN_UNIT_TEST_BENCHMARK
     device_context_->StartProfile();
 #endif
     struct timezone zone;
@@ -366,6 +381,19 @@ Status LayerTest::Forward() {
     struct timeval time2;
     gettimeofday(&time1, &zone);
     float min = FLT_MAX, max = FLT_MIN, sum = 0.0f;
+    for (int i = 0; i < FLAGS_wc; ++i) {
+        status = device_context_->OnInstanceForwardBegin();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+
+        status = device_layer_->Forward();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+
+        status = device_context_->OnInstanceForwardEnd();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+
+        status = device_context_->Synchronize();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+    }
     for (int i = 0; i < FLAGS_ic; ++i) {
         gettimeofday(&time1, &zone);
 
@@ -387,12 +415,17 @@ Status LayerTest::Forward() {
         max         = fmax(max, delta);
         sum += delta;
     }
-#if TNN_PROFILE && defined(TNN_UNIT_TEST_BENCHMARK)
+#ifdef TNN_UNIT_TEST_BENCHMARK
     auto profile_result = device_context_->FinishProfile();
     auto result_str = profile_result->GetProfilingDataInfo();
     printf("%s", result_str.c_str());
 #endif
 
+    time_min_  = min;
+    time_avg_  = sum / (float)FLAGS_ic;
+    gflops_    = GetCalcMflops(param_, cpu_layer_->GetInputBlobs(), cpu_layer_->GetOutputBlobs()) / time_avg_;
+    dram_thrp_ = GetCalcDramThrp(time_avg_);
+
     /*
      * shows the timings of device layer.
      * Used for benchmarking.
@@ -401,9 +434,7 @@ Status LayerTest::Forward() {
         printf(
             "device %s time cost: min =   %g ms  |  max =  %g ms  |  avg = %g ms |"
             "  gflops = %g G | dram thrp = %g GB/s\n",
-            FLAGS_dt.c_str(), min, max, sum / (float)FLAGS_ic,
-            GetCalcMflops(param_, cpu_layer_->GetInputBlobs(), cpu_layer_->GetOutputBlobs()) * FLAGS_ic / sum,
-            GetCalcDramThrp(sum / (float)FLAGS_ic));
+            FLAGS_dt.c_str(), min, max, time_avg_, gflops_, dram_thrp_);
     }
     return TNN_OK;
 }
@@ -439,7 +470,14 @@ Status LayerTest::Compare() {
         TNN_NS::Mat dev_cpu_mat(DEVICE_NAIVE, mat_type, dims);
         BlobConverter blob_converter_dev(device_output_blob);
 
-        Status ret = blob_converter_dev.ConvertToMat(dev_cpu_mat, MatConvertParam(), command_queue);
+        Status ret = TNN_OK;
+        if (device_output_blob->GetBlobDesc().data_format == DATA_FORMAT_NHWC) {
+            ret = DataFormatConverter::ConvertBetweenNHWCAndNCHW<float>(
+                static_cast<float*>(device_output_blob->GetHandle().base), static_cast<float*>(dev_cpu_mat.GetData()),
+                dims[0], dims[1], dims[2], dims[3], DataFormatConverter::NHWC2NCHW);
+        } else {
+            ret = blob_converter_dev.ConvertToMat(dev_cpu_mat, MatConvertParam(), command_queue);
+        }
         if (ret != TNN_OK) {
             LOGE("output blob_converter failed (%s)\n", ret.description().c_str());
             return ret;
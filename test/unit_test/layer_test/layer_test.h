@@ -65,6 +65,13 @@ protected:
     std::vector<Blob*> device_inputs_;
     std::vector<Blob*> device_outputs_;
     int ensure_input_positive_ = 0;
+    // data format of the device blobs, nhwc blobs are filled and read back on the host
+    DataFormat device_data_format_ = DATA_FORMAT_AUTO;
+    // timings of the device layer in the last run: ms, GFLOPS and GB/s
+    float time_min_  = 0.f;
+    float time_avg_  = 0.f;
+    float gflops_    = 0.f;
+    float dram_thrp_ = 0.f;
 
 private:
     Status CreateLayers(LayerType type);
@@ -81,6 +88,7 @@ private:
     Status AllocateInputBlobs();
     Status AllocateOutputBlobs();
 
+protected:
     virtual float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
         return 0.f;
     }
@@ -53,6 +53,24 @@ std::vector<BlobDesc> CreateInputBlobsDesc(int batch, int channel, int height, i
     return inputs_desc;
 }
 
+std::vector<BlobDesc> CreateInputBlobsDesc(int batch, int channel, int depth, int height, int width, int blob_count,
+                                           DataType data_type) {
+    // blob desc
+    std::vector<BlobDesc> inputs_desc;
+    for (int i = 0; i < blob_count; i++) {
+        BlobDesc input_desc;
+        input_desc.dims.push_back(batch);
+        input_desc.dims.push_back(channel);
+        input_desc.dims.push_back(depth);
+        input_desc.dims.push_back(height);
+        input_desc.dims.push_back(width);
+        input_desc.device_type = DEVICE_NAIVE;
+        input_desc.data_type   = data_type;
+        inputs_desc.push_back(input_desc);
+    }
+    return inputs_desc;
+}
+
 std::vector<BlobDesc> CreateOutputBlobsDesc(int blob_count, DataType data_type) {
     std::vector<BlobDesc> outputs_desc;
     for (int i = 0; i < blob_count; ++i) {
@@ -24,6 +24,9 @@ std::vector<BlobDesc> CreateInputBlobsDesc(int batch, int channel, int size, int
 std::vector<BlobDesc> CreateInputBlobsDesc(int batch, int channel, int height, int width, int blob_count,
                                            DataType data_type);
 
+std::vector<BlobDesc> CreateInputBlobsDesc(int batch, int channel, int depth, int height, int width, int blob_count,
+                                           DataType data_type);
+
 std::vector<BlobDesc> CreateOutputBlobsDesc(int blob_count, DataType data_type);
 
 int ReadBlobFromFile(Blob* blob, std::string path);
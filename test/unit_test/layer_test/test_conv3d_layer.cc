@@ -0,0 +1,103 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class Conv3DLayerTest
+    : public LayerTest,
+      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int, ActivationType, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, Conv3DLayerTest,
+                         ::testing::Combine(  // channel per group
+                             testing::Values(1, 3, 4, 10),
+                             // dhw
+                             testing::Values(5, 8),
+                             // group
+                             testing::Values(1, 2),
+                             // kernel
+                             testing::Values(1, 3),
+                             // dilation
+                             testing::Values(1, 2),
+                             // stride
+                             testing::Values(1, 2),
+                             // pads
+                             testing::Values(0, 1),
+                             // activation
+                             testing::Values(ActivationType_ReLU, ActivationType_ReLU6),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16)));
+
+TEST_P(Conv3DLayerTest, Conv3DLayer) {
+    // get param
+    int batch             = 1;
+    int channel_per_group = std::get<0>(GetParam());
+    int input_size        = std::get<1>(GetParam());
+    int group             = std::get<2>(GetParam());
+    int channel           = group * channel_per_group;
+    int kernel            = std::get<3>(GetParam());
+    int dilation          = std::get<4>(GetParam());
+    int stride            = std::get<5>(GetParam());
+    int pad               = std::get<6>(GetParam());
+    auto activation       = std::get<7>(GetParam());
+    auto dtype            = std::get<8>(GetParam());
+    DeviceType dev        = ConvertDeviceType(FLAGS_dt);
+
+    // 5 dims blobs are supported by the arm and naive devices
+    if (DEVICE_ARM != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+    if (dtype == DATA_TYPE_BFP16 && DEVICE_ARM != dev) {
+        GTEST_SKIP();
+    }
+
+    // blob desc, the depth differs from the height and width
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size + 1, input_size, input_size, 1, dtype);
+    auto outputs_desc = CreateOutputBlobsDesc(1, dtype);
+
+    // param
+    ConvLayerParam param;
+    param.name            = "Conv3D";
+    param.input_channel   = channel;
+    param.output_channel  = channel;
+    param.group           = group;
+    param.kernels         = {kernel, kernel, kernel};
+    param.dialations      = {dilation, dilation, dilation};
+    param.strides         = {stride, stride, stride};
+    param.pads            = {pad, pad, pad, pad, pad, pad};
+    param.pad_type        = -1;
+    param.bias            = 1;
+    param.activation_type = activation;
+
+    // resource
+    ConvLayerResource resource;
+    int filter_count = channel * channel * kernel * kernel * kernel / group;
+    RawBuffer filter(filter_count * sizeof(float));
+    float* filter_data = filter.force_to<float*>();
+    RawBuffer bias(channel * sizeof(float));
+    float* bias_data = bias.force_to<float*>();
+    InitRandom(filter_data, filter_count, 1.0f);
+    InitRandom(bias_data, channel, 1.0f);
+    resource.filter_handle = filter;
+    resource.bias_handle   = bias;
+
+    Run(LAYER_CONVOLUTION_3D, &param, &resource, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,88 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class ConvSparseLayerTest : public LayerTest,
+                            public ::testing::WithParamInterface<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, ConvSparseLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),
+                                            // input channel
+                                            testing::Values(3, 16, 35),
+                                            // output channel
+                                            testing::Values(4, 10, 32),
+                                            // hw
+                                            testing::Values(1, 7, 16),
+                                            // activation
+                                            testing::Values(ActivationType_None, ActivationType_ReLU,
+                                                            ActivationType_ReLU6)));
+
+TEST_P(ConvSparseLayerTest, ConvLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int output_channel = std::get<2>(GetParam());
+    int input_size     = std::get<3>(GetParam());
+    int activation     = std::get<4>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+    if (((input_channel % 4) != 0 || (output_channel % 4) != 0) && DEVICE_METAL == dev) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, input_channel, input_size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    ConvLayerParam param;
+    param.name            = "Conv";
+    param.input_channel   = input_channel;
+    param.output_channel  = output_channel;
+    param.group           = 1;
+    param.kernels         = {1, 1};
+    param.dialations      = {1, 1};
+    param.strides         = {1, 1};
+    param.pads            = {0, 0, 0, 0};
+    param.bias            = 1;
+    param.activation_type = activation;
+
+    // resource, 80 percent of the 4x1 blocks are pruned
+    ConvLayerResource resource;
+    int filter_count = output_channel * input_channel;
+    RawBuffer filter(filter_count * sizeof(float));
+    float* filter_data = filter.force_to<float*>();
+    RawBuffer bias(output_channel * sizeof(float));
+    InitRandom(filter_data, filter_count, 1.0f);
+    InitRandom(bias.force_to<float*>(), output_channel, 1.0f);
+    for (int o = 0; o < output_channel; o++) {
+        for (int i = 0; i < input_channel; i++) {
+            if ((o / 4 * 7 + i * 3) % 5 != 0) {
+                filter_data[o * input_channel + i] = 0.f;
+            }
+        }
+    }
+    resource.filter_handle = filter;
+    resource.bias_handle   = bias;
+
+    Run(LAYER_CONVOLUTION, &param, &resource, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class InnerProductSparseLayerTest : public LayerTest,
+                                    public ::testing::WithParamInterface<std::tuple<int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, InnerProductSparseLayerTest,
+                         ::testing::Combine(testing::Values(1, 2), testing::Values(4, 16, 19),
+                                            testing::Values(1, 3),
+                                            // output channel
+                                            testing::Values(5, 32)));
+
+TEST_P(InnerProductSparseLayerTest, InnerProductLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int input_size     = std::get<2>(GetParam());
+    int output_channel = std::get<3>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+    if (DEVICE_METAL == dev || DEVICE_OPENCL == dev) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, input_channel, input_size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    InnerProductLayerParam param;
+    param.name       = "InnerProduct";
+    param.num_output = output_channel;
+    param.has_bias   = 1;
+    param.axis       = 1;
+
+    // resource, 80 percent of the 4x1 blocks are pruned
+    InnerProductLayerResource resource;
+    int input_count  = input_channel * input_size * input_size;
+    int filter_count = output_channel * input_count;
+    RawBuffer filter(filter_count * sizeof(float));
+    float* filter_data = filter.force_to<float*>();
+    RawBuffer bias(output_channel * sizeof(float));
+    InitRandom(filter_data, filter_count, 1.0f);
+    InitRandom(bias.force_to<float*>(), output_channel, 1.0f);
+    for (int o = 0; o < output_channel; o++) {
+        for (int i = 0; i < input_count; i++) {
+            if ((o / 4 * 7 + i * 3) % 5 != 0) {
+                filter_data[o * input_count + i] = 0.f;
+            }
+        }
+    }
+    resource.weight_handle = filter;
+    resource.bias_handle   = bias;
+
+    Run(LAYER_INNER_PRODUCT, &param, &resource, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
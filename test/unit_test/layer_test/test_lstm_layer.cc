@@ -0,0 +1,94 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class LSTMLayerTest
+    : public LayerTest,
+      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, bool, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, LSTMLayerTest,
+                         ::testing::Combine(  // seq
+                             testing::Values(1, 5),
+                             // batch
+                             testing::Values(1, 3, 5),
+                             // input
+                             testing::Values(3, 8),
+                             // hidden
+                             testing::Values(3, 8, 17),
+                             // direction
+                             testing::Values(0, 1, 2),
+                             // initial states
+                             testing::Values(false, true),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16)));
+
+TEST_P(LSTMLayerTest, LSTMLayer) {
+    // get param
+    int seq             = std::get<0>(GetParam());
+    int batch           = std::get<1>(GetParam());
+    int input           = std::get<2>(GetParam());
+    int hidden          = std::get<3>(GetParam());
+    int direction       = std::get<4>(GetParam());
+    bool initial_states = std::get<5>(GetParam());
+    auto dtype          = std::get<6>(GetParam());
+    int directions      = direction == 2 ? 2 : 1;
+    DeviceType dev      = ConvertDeviceType(FLAGS_dt);
+
+    if (DEVICE_ARM != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+    if (dtype == DATA_TYPE_BFP16 && DEVICE_ARM != dev) {
+        GTEST_SKIP();
+    }
+
+    // blob desc, x [seq][batch][input][1] and the states [direction][batch][hidden][1]
+    auto inputs_desc = CreateInputBlobsDesc(seq, batch, input, 1, 1, dtype);
+    if (initial_states) {
+        auto states_desc = CreateInputBlobsDesc(directions, batch, hidden, 1, 2, dtype);
+        inputs_desc.insert(inputs_desc.end(), states_desc.begin(), states_desc.end());
+    }
+    auto outputs_desc = CreateOutputBlobsDesc(3, dtype);
+
+    // param
+    LSTMLayerParam param;
+    param.name        = "LSTM";
+    param.hidden_size = hidden;
+    param.direction   = direction;
+
+    // resource
+    RecurrentLayerResource resource;
+    int weight_count     = directions * 4 * hidden * input;
+    int recurrence_count = directions * 4 * hidden * hidden;
+    int bias_count       = directions * 2 * 4 * hidden;
+    RawBuffer weight(weight_count * sizeof(float));
+    RawBuffer recurrence(recurrence_count * sizeof(float));
+    RawBuffer bias(bias_count * sizeof(float));
+    InitRandom(weight.force_to<float*>(), weight_count, 0.5f);
+    InitRandom(recurrence.force_to<float*>(), recurrence_count, 0.5f);
+    InitRandom(bias.force_to<float*>(), bias_count, 0.5f);
+    resource.weight_handle     = weight;
+    resource.recurrence_handle = recurrence;
+    resource.bias_handle       = bias;
+
+    Run(LAYER_LSTM, &param, &resource, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,307 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+// nhwc layout is only implemented by the arm layer accs of low channel layers
+class NhwcLayerTest : public LayerTest {
+protected:
+    bool SkipDevice() {
+        device_data_format_ = DATA_FORMAT_NHWC;
+        return ConvertDeviceType(FLAGS_dt) != DEVICE_ARM;
+    }
+};
+
+class NhwcConvLayerTest : public NhwcLayerTest,
+                          public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NhwcConvLayerTest,
+                         ::testing::Combine(  // batch
+                             testing::Values(1, 2),
+                             // channel
+                             testing::Values(1, 2, 3, 5),
+                             // hw
+                             testing::Values(9, 16),
+                             // group
+                             testing::Values(1, 2),
+                             // kernel
+                             testing::Values(1, 3),
+                             // dilation
+                             testing::Values(1, 2),
+                             // stride
+                             testing::Values(1, 2),
+                             // pads
+                             testing::Values(0, 1)));
+
+TEST_P(NhwcConvLayerTest, ConvLayer) {
+    // get param
+    int batch             = std::get<0>(GetParam());
+    int channel_per_group = std::get<1>(GetParam());
+    int input_size        = std::get<2>(GetParam());
+    int group             = std::get<3>(GetParam());
+    int channel           = group * channel_per_group;
+    int kernel            = std::get<4>(GetParam());
+    int dilation          = std::get<5>(GetParam());
+    int stride            = std::get<6>(GetParam());
+    int pad               = std::get<7>(GetParam());
+
+    if (SkipDevice()) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param, group 2 with one channel per group runs as depthwise
+    ConvLayerParam param;
+    param.name            = "Conv";
+    param.input_channel   = channel;
+    param.output_channel  = channel;
+    param.group           = group;
+    param.kernels         = {kernel, kernel};
+    param.dialations      = {dilation, dilation};
+    param.strides         = {stride, stride};
+    param.pads            = {pad, pad, pad, pad};
+    param.bias            = 1;
+    param.activation_type = ActivationType_ReLU;
+
+    // resource
+    ConvLayerResource resource;
+    int filter_count = channel * channel * kernel * kernel / group;
+    RawBuffer filter(filter_count * sizeof(float));
+    float* filter_data = filter.force_to<float*>();
+    RawBuffer bias(channel * sizeof(float));
+    float* bias_data = bias.force_to<float*>();
+    InitRandom(filter_data, filter_count, 1.0f);
+    InitRandom(bias_data, channel, 1.0f);
+    resource.filter_handle = filter;
+    resource.bias_handle   = bias;
+
+    Run(LAYER_CONVOLUTION, &param, &resource, inputs_desc, outputs_desc);
+}
+
+class NhwcPoolingLayerTest : public NhwcLayerTest,
+                             public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NhwcPoolingLayerTest,
+                         ::testing::Combine(BASIC_BATCH_CHANNEL_SIZE,
+                                            // kernel
+                                            testing::Values(3, 2),
+                                            // stride
+                                            testing::Values(1, 2),
+                                            // pool type
+                                            testing::Values(0, 1)));
+
+TEST_P(NhwcPoolingLayerTest, PoolingLayer) {
+    // get param
+    int batch      = std::get<0>(GetParam());
+    int channel    = std::get<1>(GetParam());
+    int input_size = std::get<2>(GetParam());
+    int kernel     = std::get<3>(GetParam());
+    int stride     = std::get<4>(GetParam());
+    int pool_type  = std::get<5>(GetParam());
+
+    if (SkipDevice()) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    PoolingLayerParam param;
+    param.name           = "Pooling";
+    param.kernels_params = {kernel, kernel};
+    param.kernels        = {kernel, kernel};
+    param.strides        = {stride, stride};
+    if (kernel == 3)
+        param.pads = {1, 1, 1, 1};
+    else
+        param.pads = {0, 0, 0, 0};
+    param.pad_type  = -1;
+    param.pool_type = pool_type;
+    param.kernel_indexs.push_back(-1);
+    param.kernel_indexs.push_back(-1);
+
+    Run(LAYER_POOLING, &param, nullptr, inputs_desc, outputs_desc);
+}
+
+class NhwcUpsampleLayerTest : public NhwcLayerTest,
+                              public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, float>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NhwcUpsampleLayerTest,
+                         ::testing::Combine(BASIC_BATCH_CHANNEL_SIZE,
+                                            // resize type 1:nearest 2:bilinear
+                                            testing::Values(1, 2),
+                                            // align_corners
+                                            testing::Values(0, 1),
+                                            // scale
+                                            testing::Values(0.5, 1.45, 2)));
+
+TEST_P(NhwcUpsampleLayerTest, UpsampleLayer) {
+    // get param
+    int batch         = std::get<0>(GetParam());
+    int channel       = std::get<1>(GetParam());
+    int input_size    = std::get<2>(GetParam());
+    int mode          = std::get<3>(GetParam());
+    int align_corners = std::get<4>(GetParam());
+    float scale       = std::get<5>(GetParam());
+
+    if (SkipDevice() || batch > 1) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    UpsampleLayerParam param;
+    param.name          = "Upsample";
+    param.mode          = mode;
+    param.align_corners = align_corners;
+    param.scales        = {scale, scale};
+
+    Run(LAYER_UPSAMPLE, &param, nullptr, inputs_desc, outputs_desc);
+}
+
+class NhwcConcatLayerTest : public NhwcLayerTest,
+                            public ::testing::WithParamInterface<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NhwcConcatLayerTest,
+                         ::testing::Combine(BASIC_BATCH_CHANNEL_SIZE,
+                                            // axis
+                                            testing::Values(1, 2, 3),
+                                            // input cnt
+                                            testing::Values(2, 3)));
+
+TEST_P(NhwcConcatLayerTest, ConcatLayer) {
+    // get param
+    int batch       = std::get<0>(GetParam());
+    int channel     = std::get<1>(GetParam());
+    int input_size  = std::get<2>(GetParam());
+    int axis        = std::get<3>(GetParam());
+    int input_count = std::get<4>(GetParam());
+
+    if (SkipDevice()) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, input_count, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    ConcatLayerParam param;
+    param.name = "Concat";
+    param.axis = axis;
+
+    Run(LAYER_CONCAT, &param, nullptr, inputs_desc, outputs_desc);
+}
+
+class NhwcBinaryLayerTest : public NhwcLayerTest,
+                            public ::testing::WithParamInterface<std::tuple<int, int, int, LayerType, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NhwcBinaryLayerTest,
+                         ::testing::Combine(BASIC_BATCH_CHANNEL_SIZE,
+                                            // layer type
+                                            testing::Values(LAYER_ADD, LAYER_SUB, LAYER_MUL, LAYER_MAXIMUM),
+                                            // -1: two inputs of same size, 0: scalar, 1: channel, 2: chw, 3: hw weight
+                                            testing::Values(-1, 0, 1, 2, 3)));
+
+TEST_P(NhwcBinaryLayerTest, BinaryLayer) {
+    // get param
+    int batch            = std::get<0>(GetParam());
+    int channel          = std::get<1>(GetParam());
+    int input_size       = std::get<2>(GetParam());
+    LayerType layer_type = std::get<3>(GetParam());
+    int param_size_type  = std::get<4>(GetParam());
+
+    if (SkipDevice()) {
+        GTEST_SKIP();
+    }
+
+    std::vector<int> param_dims;
+    if (0 == param_size_type) {
+        param_dims = {1, 1, 1, 1};
+    } else if (1 == param_size_type) {
+        param_dims = {1, channel, 1, 1};
+    } else if (2 == param_size_type) {
+        param_dims = {1, channel, input_size, input_size};
+    } else if (3 == param_size_type) {
+        param_dims = {1, 1, input_size, input_size};
+    }
+
+    // resource
+    std::shared_ptr<EltwiseLayerResource> resource = nullptr;
+    if (param_size_type >= 0) {
+        int param_count = DimsVectorUtils::Count(param_dims);
+        resource.reset(new EltwiseLayerResource());
+        RawBuffer buffer(param_count * sizeof(float));
+        InitRandom(buffer.force_to<float*>(), param_count, 1.0f);
+        resource->element_handle = buffer;
+        resource->element_shape  = param_dims;
+    }
+
+    // blob desc
+    int input_count   = param_size_type >= 0 ? 1 : 2;
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, input_count, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    MultidirBroadcastLayerParam param;
+    param.name               = "Binary";
+    param.weight_input_index = param_size_type >= 0 ? 1 : -1;
+
+    Run(layer_type, &param, resource.get(), inputs_desc, outputs_desc);
+}
+
+class NhwcActivationLayerTest : public NhwcLayerTest,
+                                public ::testing::WithParamInterface<std::tuple<int, int, int, LayerType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NhwcActivationLayerTest,
+                         ::testing::Combine(BASIC_BATCH_CHANNEL_SIZE,
+                                            // layer type
+                                            testing::Values(LAYER_RELU, LAYER_RELU6, LAYER_SIGMOID)));
+
+TEST_P(NhwcActivationLayerTest, ActivationLayer) {
+    // get param
+    int batch            = std::get<0>(GetParam());
+    int channel          = std::get<1>(GetParam());
+    int input_size       = std::get<2>(GetParam());
+    LayerType layer_type = std::get<3>(GetParam());
+
+    if (SkipDevice()) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, DATA_TYPE_FLOAT);
+    auto outputs_desc = CreateOutputBlobsDesc(1, DATA_TYPE_FLOAT);
+
+    // param
+    LayerParam param;
+    param.name = "Activation";
+
+    Run(layer_type, &param, nullptr, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
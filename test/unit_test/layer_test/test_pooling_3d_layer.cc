@@ -0,0 +1,78 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+
+namespace TNN_NS {
+
+class Pooling3DLayerTest : public LayerTest,
+                           public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, Pooling3DLayerTest,
+                         ::testing::Combine(  // channel
+                             testing::Values(1, 3, 4, 10),
+                             // dhw
+                             testing::Values(7, 16),
+                             // kernel
+                             testing::Values(3, 2),
+                             // stride
+                             testing::Values(1, 2),
+                             // pool type
+                             testing::Values(0, 1),
+                             // datatype
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16)));
+
+TEST_P(Pooling3DLayerTest, Pooling3DLayer) {
+    // get param
+    int batch          = 1;
+    int channel        = std::get<0>(GetParam());
+    int input_size     = std::get<1>(GetParam());
+    int kernel         = std::get<2>(GetParam());
+    int stride         = std::get<3>(GetParam());
+    int pool_type      = std::get<4>(GetParam());
+    DataType data_type = std::get<5>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    // 5 dims blobs are supported by the arm and naive devices
+    if (DEVICE_ARM != dev && DEVICE_NAIVE != dev) {
+        GTEST_SKIP();
+    }
+    if (data_type == DATA_TYPE_BFP16 && DEVICE_ARM != dev) {
+        GTEST_SKIP();
+    }
+
+    // blob desc, the depth differs from the height and width
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size - 1, input_size, input_size, 1, data_type);
+    auto outputs_desc = CreateOutputBlobsDesc(1, data_type);
+
+    // param
+    PoolingLayerParam param;
+    param.name           = "Pooling3D";
+    param.kernels_params = {kernel, kernel, kernel};
+    param.kernels        = {kernel, kernel, kernel};
+    param.strides        = {stride, stride, stride};
+    if (kernel == 3)
+        param.pads = {1, 1, 1, 1, 1, 1};
+    else
+        param.pads = {0, 0, 0, 0, 0, 0};
+    param.pad_type      = -1;
+    param.pool_type     = pool_type;
+    param.kernel_indexs = {-1, -1, -1};
+
+    Run(LAYER_POOLING_3D, &param, nullptr, inputs_desc, outputs_desc);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,139 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/net_test/net_test_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+Status TestNetInterpreter::InterpretTestNet(const std::string &proto) {
+    std::string content = proto;
+    RETURN_ON_NEQ(InterpretProto(content), TNN_OK);
+
+    for (auto &layer : GetNetStructure()->layers) {
+        if (layer->type != LAYER_CONVOLUTION) {
+            continue;
+        }
+        auto param       = dynamic_cast<ConvLayerParam *>(layer->param.get());
+        int filter_count = param->output_channel * param->input_channel / param->group * param->kernels[0] *
+                           param->kernels[1];
+
+        auto resource           = std::make_shared<ConvLayerResource>();
+        resource->name          = layer->name;
+        resource->filter_handle = RawBuffer(filter_count * sizeof(float));
+        resource->bias_handle   = RawBuffer(param->output_channel * sizeof(float));
+        InitRandom(resource->filter_handle.force_to<float *>(), filter_count, 0.1f);
+        InitRandom(resource->bias_handle.force_to<float *>(), param->output_channel, 0.1f);
+        GetNetResource()->resource_map[layer->name] = resource;
+    }
+    return TNN_OK;
+}
+
+static std::string ReadTestFile(const std::string &path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+Status PackTestNet(TestNetInterpreter &interpreter, const std::string &name, ModelConfig &model_config) {
+    std::string proto_path = testing::TempDir() + name + ".tnnproto";
+    std::string model_path = testing::TempDir() + name + ".tnnmodel";
+    ModelPacker packer(interpreter.GetNetStructure(), interpreter.GetNetResource());
+    RETURN_ON_NEQ(packer.Pack(proto_path, model_path), TNN_OK);
+    model_config.model_type = MODEL_TYPE_TNN;
+    model_config.params     = {ReadTestFile(proto_path), ReadTestFile(model_path)};
+    return TNN_OK;
+}
+
+NetworkConfig GetTestNetworkConfig() {
+    NetworkConfig net_config;
+    net_config.device_type = ConvertDeviceType(FLAGS_dt);
+    net_config.precision   = PRECISION_HIGH;
+    return net_config;
+}
+
+Status SetTestNetInputs(Instance *instance, unsigned int seed) {
+    BlobMap input_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    void *command_queue = nullptr;
+    RETURN_ON_NEQ(instance->GetCommandQueue(&command_queue), TNN_OK);
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (auto iter : input_blobs) {
+        auto dims = iter.second->GetBlobDesc().dims;
+        Mat mat(DEVICE_NAIVE, NCHW_FLOAT, dims);
+        auto data = static_cast<float *>(mat.GetData());
+        for (int i = 0; i < DimsVectorUtils::Count(dims); ++i) {
+            data[i] = distribution(generator);
+        }
+        BlobConverter converter(iter.second);
+        RETURN_ON_NEQ(converter.ConvertFromMat(mat, MatConvertParam(), command_queue), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+Status GetTestNetOutputs(Instance *instance, TestNetData &outputs) {
+    BlobMap output_blobs;
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    void *command_queue = nullptr;
+    RETURN_ON_NEQ(instance->GetCommandQueue(&command_queue), TNN_OK);
+
+    outputs.clear();
+    for (auto iter : output_blobs) {
+        auto dims = iter.second->GetBlobDesc().dims;
+        Mat mat(DEVICE_NAIVE, NCHW_FLOAT, dims);
+        BlobConverter converter(iter.second);
+        RETURN_ON_NEQ(converter.ConvertToMat(mat, MatConvertParam(), command_queue), TNN_OK);
+
+        auto data            = static_cast<float *>(mat.GetData());
+        outputs[iter.first] = std::vector<float>(data, data + DimsVectorUtils::Count(dims));
+    }
+    return TNN_OK;
+}
+
+int CompareTestNetOutputs(TestNetData &outputs, TestNetData &ref_outputs, float ep) {
+    if (outputs.size() != ref_outputs.size()) {
+        LOGE("output count %d != %d\n", (int)outputs.size(), (int)ref_outputs.size());
+        return -1;
+    }
+    for (auto iter : ref_outputs) {
+        auto output = outputs.find(iter.first);
+        if (output == outputs.end() || output->second.size() != iter.second.size()) {
+            LOGE("output %s mismatch\n", iter.first.c_str());
+            return -1;
+        }
+        if (CompareData(output->second.data(), iter.second.data(), iter.second.size(), ep) != 0) {
+            LOGE("output %s mismatch\n", iter.first.c_str());
+            return -1;
+        }
+    }
+    return 0;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,54 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TEST_UNIT_TEST_NET_TEST_NET_TEST_UTILS_H_
+#define TNN_TEST_UNIT_TEST_NET_TEST_NET_TEST_UTILS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+
+namespace TNN_NS {
+
+typedef std::map<std::string, std::vector<float>> TestNetData;
+
+// @brief TestNetInterpreter interprets the proto of a test net, the weights of
+// the convolution layers are generated randomly instead of read from a model
+class TestNetInterpreter : public ModelInterpreter {
+public:
+    Status InterpretTestNet(const std::string &proto);
+};
+
+// @brief pack the test net into the temp dir and read it back as the params of a tnn model config
+Status PackTestNet(TestNetInterpreter &interpreter, const std::string &name, ModelConfig &model_config);
+
+// @brief network config of the device under test, see the -dt flag
+NetworkConfig GetTestNetworkConfig();
+
+// @brief fill the inputs of the instance with random data, the same seed gives the same data
+Status SetTestNetInputs(Instance *instance, unsigned int seed);
+
+// @brief copy the outputs of the instance into nchw float data
+Status GetTestNetOutputs(Instance *instance, TestNetData &outputs);
+
+// @brief compare the outputs of two instances, return 0 if all of them are equal within ep
+int CompareTestNetOutputs(TestNetData &outputs, TestNetData &ref_outputs, float ep);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_NET_TEST_NET_TEST_UTILS_H_
@@ -0,0 +1,117 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/memory_manager/blob_memory_size_info.h"
+
+namespace TNN_NS {
+
+static const char *g_bind_memory_test_proto =
+    "\"1 3 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 out data ,\""
+    "\"out ,\""
+    "\" 2 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 out ,\"";
+
+// external memory of the devices is 32 bytes aligned, with some bytes readable past the data
+class ExternalMemory {
+public:
+    ExternalMemory(BlobDesc desc, DeviceType device_type) {
+        auto size_info = GetDevice(device_type)->Calculate(desc);
+        bytes_size_    = GetBlobMemoryBytesSize(size_info) + 64;
+        buffer_.resize(bytes_size_ + 32);
+    }
+    void *GetData() {
+        return (void *)(((uintptr_t)buffer_.data() + 31) / 32 * 32);
+    }
+    int GetBytesSize() {
+        return bytes_size_;
+    }
+
+private:
+    std::vector<char> buffer_;
+    int bytes_size_ = 0;
+};
+
+static std::shared_ptr<Instance> CreateBindTestInstance(std::shared_ptr<TestNetInterpreter> interpreter,
+                                                        Status &status) {
+    auto net_config = GetTestNetworkConfig();
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, InputShapesMap());
+    return instance;
+}
+
+TEST(BindBlobMemoryTest, ReshapeRevalidatesExternalMemory) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_bind_memory_test_proto), TNN_OK);
+    Status status;
+    auto instance = CreateBindTestInstance(interpreter, status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    auto ref_instance = CreateBindTestInstance(interpreter, status);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    auto device_type = GetTestNetworkConfig().device_type;
+    BlobMap output_blobs;
+    ASSERT_EQ((int)instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    Blob *output = output_blobs["out"];
+
+    // the memory is bound for a shape smaller than the shape the instance is created with
+    ASSERT_EQ((int)instance->Reshape({{"data", {1, 8, 8, 8}}}), TNN_OK);
+    BlobDesc desc = output->GetBlobDesc();
+    ExternalMemory memory(desc, device_type);
+    EXPECT_NE((int)instance->BindBlobMemory("out", memory.GetData(), memory.GetBytesSize() - 128, desc.data_format),
+              TNN_OK);
+    ASSERT_EQ((int)instance->BindBlobMemory("out", memory.GetData(), memory.GetBytesSize(), desc.data_format),
+              TNN_OK);
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    EXPECT_EQ(output->GetHandle().base, memory.GetData());
+
+    // a larger shape is rejected, and the previous shape is kept
+    EXPECT_NE((int)instance->Reshape({{"data", {1, 8, 16, 16}}}), TNN_OK);
+    DimsVector small_dims = {1, 16, 8, 8};
+    EXPECT_EQ(output->GetBlobDesc().dims, small_dims);
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+
+    // a larger memory bound to the blob accepts the larger shape
+    desc.dims = {1, 16, 16, 16};
+    ExternalMemory large_memory(desc, device_type);
+    ASSERT_EQ((int)instance->BindBlobMemory("out", large_memory.GetData(), large_memory.GetBytesSize(),
+                                            desc.data_format),
+              TNN_OK);
+    ASSERT_EQ((int)instance->Reshape({{"data", {1, 8, 16, 16}}}), TNN_OK);
+
+    TestNetData ref_outputs, outputs;
+    ASSERT_EQ((int)SetTestNetInputs(ref_instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)ref_instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(ref_instance.get(), ref_outputs), TNN_OK);
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), outputs), TNN_OK);
+    EXPECT_EQ(output->GetHandle().base, large_memory.GetData());
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,136 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+
+namespace TNN_NS {
+
+// c0 and c1 are views of cat, s0 and s1 views of r, sl a view of s1 at channel 4
+static const char *g_blob_views_test_proto =
+    "\"1 11 1 4206624770 ,\""
+    "\"data 1 8 8 8 ,\""
+    "\" c0 c1 cat r s0 s1 sl out0 out1 out2 data ,\""
+    "\"out0 out1 out2 ,\""
+    "\" 9 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 8 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv1 1 1 data c1 1 8 8 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Concat concat0 2 1 c0 c1 cat 1 ,\""
+    "\"ReLU relu0 1 1 cat r ,\""
+    "\"SplitV split0 1 2 r s0 s1 1 2 8 8 ,\""
+    "\"Convolution conv2 1 1 s0 out0 1 8 4 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"StridedSlice slice0 1 1 s1 sl 4 0 4 0 0 4 0 8 0 0 4 1 1 1 1 ,\""
+    "\"Convolution conv3 1 1 sl out1 1 4 4 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Convolution conv4 1 1 s1 out2 1 8 4 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+// the strided slice layer keeps the ends resolved for the first batch, so the reshape test has no slice
+static const char *g_blob_views_reshape_test_proto =
+    "\"1 9 1 4206624770 ,\""
+    "\"data 1 8 8 8 ,\""
+    "\" c0 c1 cat r s0 s1 out0 out1 data ,\""
+    "\"out0 out1 ,\""
+    "\" 7 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 8 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv1 1 1 data c1 1 8 8 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Concat concat0 2 1 c0 c1 cat 1 ,\""
+    "\"ReLU relu0 1 1 cat r ,\""
+    "\"SplitV split0 1 2 r s0 s1 1 2 8 8 ,\""
+    "\"Convolution conv2 1 1 s0 out0 1 8 4 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Convolution conv3 1 1 s1 out1 1 8 4 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+static std::shared_ptr<Instance> CreateViewsTestInstance(std::shared_ptr<TestNetInterpreter> interpreter,
+                                                         DeviceType device_type, InputShapesMap shapes,
+                                                         Status &status) {
+    auto net_config        = GetTestNetworkConfig();
+    net_config.device_type = device_type;
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, shapes);
+    return instance;
+}
+
+static Status ForwardViewsTestInstance(Instance *instance, TestNetData &outputs) {
+    RETURN_ON_NEQ(SetTestNetInputs(instance, 1), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+    return GetTestNetOutputs(instance, outputs);
+}
+
+TEST(BlobViewsTest, ViewsMatchCopies) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_blob_views_test_proto), TNN_OK);
+    Status status;
+    auto device_type = GetTestNetworkConfig().device_type;
+    auto instance    = CreateViewsTestInstance(interpreter, device_type, InputShapesMap(), status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    auto ref_instance = CreateViewsTestInstance(interpreter, DEVICE_NAIVE, InputShapesMap(), status);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    TestNetData outputs, ref_outputs;
+    ASSERT_EQ((int)ForwardViewsTestInstance(instance.get(), outputs), TNN_OK);
+    ASSERT_EQ((int)ForwardViewsTestInstance(ref_instance.get(), ref_outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.001f), 0);
+}
+
+/*
+ * The views need batch 1, the instance is created with batch 2 and reshaped to
+ * batch 1 and back, which plans the views and drops them again.
+ */
+TEST(BlobViewsTest, ReshapeReplansViews) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_blob_views_reshape_test_proto), TNN_OK);
+    InputShapesMap batch1_shapes = {{"data", {1, 8, 8, 8}}};
+    InputShapesMap batch2_shapes = {{"data", {2, 8, 8, 8}}};
+    Status status;
+    auto device_type = GetTestNetworkConfig().device_type;
+    auto instance    = CreateViewsTestInstance(interpreter, device_type, batch2_shapes, status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    auto batch1_instance = CreateViewsTestInstance(interpreter, device_type, batch1_shapes, status);
+    ASSERT_EQ((int)status, TNN_OK);
+    auto batch2_instance = CreateViewsTestInstance(interpreter, device_type, batch2_shapes, status);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    int batch2_memory_size = 0;
+    ASSERT_EQ((int)instance->GetForwardMemorySize(batch2_memory_size), TNN_OK);
+
+    TestNetData outputs, ref_outputs;
+    ASSERT_EQ((int)instance->Reshape(batch1_shapes), TNN_OK);
+    ASSERT_EQ((int)ForwardViewsTestInstance(instance.get(), outputs), TNN_OK);
+    ASSERT_EQ((int)ForwardViewsTestInstance(batch1_instance.get(), ref_outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+
+    // the memory is still planned for batch 2, the views share it
+    int batch1_memory_size = 0;
+    ASSERT_EQ((int)instance->GetForwardMemorySize(batch1_memory_size), TNN_OK);
+    if (device_type == DEVICE_ARM) {
+        EXPECT_LT(batch1_memory_size, batch2_memory_size);
+    } else {
+        EXPECT_LE(batch1_memory_size, batch2_memory_size);
+    }
+
+    ASSERT_EQ((int)instance->Reshape(batch2_shapes), TNN_OK);
+    ASSERT_EQ((int)ForwardViewsTestInstance(instance.get(), outputs), TNN_OK);
+    ASSERT_EQ((int)ForwardViewsTestInstance(batch2_instance.get(), ref_outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+    ASSERT_EQ((int)instance->GetForwardMemorySize(batch1_memory_size), TNN_OK);
+    EXPECT_EQ(batch1_memory_size, batch2_memory_size);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,175 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/optimizer/net_optimizer_eliminate_reformat.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+class EliminateReformatTest : public ::testing::Test {
+protected:
+    void AddLayer(LayerType type, const std::string &name, std::vector<std::string> inputs,
+                  std::vector<std::string> outputs, std::shared_ptr<LayerParam> param = nullptr) {
+        auto layer     = std::make_shared<LayerInfo>();
+        layer->type    = type;
+        layer->name    = name;
+        layer->inputs  = inputs;
+        layer->outputs = outputs;
+        layer->param   = param ? param : std::make_shared<LayerParam>();
+        structure_.layers.push_back(layer);
+        structure_.blobs.insert(inputs.begin(), inputs.end());
+        structure_.blobs.insert(outputs.begin(), outputs.end());
+    }
+
+    void AddReformat(const std::string &name, const std::string &input, const std::string &output,
+                     DataType src_type, DataType dst_type) {
+        auto param        = std::make_shared<ReformatLayerParam>();
+        param->src_type   = src_type;
+        param->dst_type   = dst_type;
+        param->src_format = DATA_FORMAT_NC4HW4;
+        param->dst_format = DATA_FORMAT_NC4HW4;
+        AddLayer(LAYER_REFORMAT, name, {input}, {output}, param);
+    }
+
+    void AddScale(const std::string &blob, float scale) {
+        auto resource          = std::make_shared<IntScaleResource>();
+        resource->scale_handle = RawBuffer(sizeof(float));
+        resource->bias_handle  = RawBuffer(sizeof(float));
+        resource->scale_handle.force_to<float *>()[0] = scale;
+        resource->bias_handle.force_to<float *>()[0]  = 0;
+        resource_.resource_map[blob + BLOB_SCALE_SUFFIX] = resource;
+    }
+
+    Status Optimize() {
+        optimizer::NetOptimizerEliminateReformat optimizer;
+        return optimizer.Optimize(&structure_, &resource_);
+    }
+
+    int CountLayers(LayerType type) {
+        int count = 0;
+        for (auto layer : structure_.layers) {
+            count += layer->type == type ? 1 : 0;
+        }
+        return count;
+    }
+
+    std::shared_ptr<LayerInfo> GetLayer(const std::string &name) {
+        for (auto layer : structure_.layers) {
+            if (layer->name == name) {
+                return layer;
+            }
+        }
+        return nullptr;
+    }
+
+    NetStructure structure_;
+    NetResource resource_;
+};
+
+TEST_F(EliminateReformatTest, ShareSameReformat) {
+    AddLayer(LAYER_RELU, "relu", {"data"}, {"r"});
+    AddReformat("reformat0", "r", "h0", DATA_TYPE_FLOAT, DATA_TYPE_HALF);
+    AddReformat("reformat1", "r", "h1", DATA_TYPE_FLOAT, DATA_TYPE_HALF);
+    AddLayer(LAYER_SIGMOID, "sigmoid0", {"h0"}, {"out0"});
+    AddLayer(LAYER_SIGMOID, "sigmoid1", {"h1"}, {"out1"});
+    structure_.outputs = {"out0", "out1"};
+
+    ASSERT_EQ((int)Optimize(), TNN_OK);
+    EXPECT_EQ(CountLayers(LAYER_REFORMAT), 1);
+    EXPECT_EQ(GetLayer("sigmoid1")->inputs[0], "h0");
+    EXPECT_EQ(structure_.blobs.count("h1"), 0);
+}
+
+TEST_F(EliminateReformatTest, CancelRoundTripThroughFloat) {
+    AddLayer(LAYER_RELU, "relu", {"data"}, {"h"});
+    AddReformat("to_float", "h", "f", DATA_TYPE_HALF, DATA_TYPE_FLOAT);
+    AddReformat("to_half", "f", "h2", DATA_TYPE_FLOAT, DATA_TYPE_HALF);
+    AddLayer(LAYER_SIGMOID, "sigmoid", {"h2"}, {"out"});
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)Optimize(), TNN_OK);
+    EXPECT_EQ(CountLayers(LAYER_REFORMAT), 0);
+    EXPECT_EQ(GetLayer("sigmoid")->inputs[0], "h");
+}
+
+TEST_F(EliminateReformatTest, KeepRoundTripThroughHalf) {
+    // the precision lost by the fp16 copy is kept
+    AddLayer(LAYER_RELU, "relu", {"data"}, {"f"});
+    AddReformat("to_half", "f", "h", DATA_TYPE_FLOAT, DATA_TYPE_HALF);
+    AddReformat("to_float", "h", "f2", DATA_TYPE_HALF, DATA_TYPE_FLOAT);
+    AddLayer(LAYER_SIGMOID, "sigmoid", {"f2"}, {"out"});
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)Optimize(), TNN_OK);
+    EXPECT_EQ(CountLayers(LAYER_REFORMAT), 2);
+    EXPECT_EQ(GetLayer("sigmoid")->inputs[0], "f2");
+}
+
+TEST_F(EliminateReformatTest, CancelInt8RoundTripWithSameScale) {
+    AddLayer(LAYER_RELU, "relu", {"data"}, {"q0"});
+    AddReformat("dequant0", "q0", "f0", DATA_TYPE_INT8, DATA_TYPE_FLOAT);
+    AddReformat("quant0", "f0", "q1", DATA_TYPE_FLOAT, DATA_TYPE_INT8);
+    AddLayer(LAYER_SIGMOID, "sigmoid0", {"q1"}, {"out0"});
+    AddLayer(LAYER_RELU, "relu1", {"data"}, {"q2"});
+    AddReformat("dequant1", "q2", "f1", DATA_TYPE_INT8, DATA_TYPE_FLOAT);
+    AddReformat("quant1", "f1", "q3", DATA_TYPE_FLOAT, DATA_TYPE_INT8);
+    AddLayer(LAYER_SIGMOID, "sigmoid1", {"q3"}, {"out1"});
+    structure_.outputs = {"out0", "out1"};
+    AddScale("q0", 0.5f);
+    AddScale("q1", 0.5f);
+    AddScale("q2", 0.5f);
+    AddScale("q3", 0.25f);
+
+    ASSERT_EQ((int)Optimize(), TNN_OK);
+    EXPECT_EQ(GetLayer("sigmoid0")->inputs[0], "q0");
+    EXPECT_EQ(GetLayer("sigmoid1")->inputs[0], "q3");
+    EXPECT_EQ(CountLayers(LAYER_REFORMAT), 2);
+}
+
+TEST_F(EliminateReformatTest, FoldReluIntoInt8Conv) {
+    auto conv_param             = std::make_shared<ConvLayerParam>();
+    conv_param->quantized       = true;
+    conv_param->activation_type = ActivationType_None;
+    AddLayer(LAYER_CONVOLUTION, "conv", {"data"}, {"q"}, conv_param);
+    AddReformat("dequant", "q", "f", DATA_TYPE_INT8, DATA_TYPE_FLOAT);
+    AddLayer(LAYER_RELU, "relu", {"f"}, {"r"});
+    AddLayer(LAYER_SIGMOID, "sigmoid", {"r"}, {"out"});
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)Optimize(), TNN_OK);
+    EXPECT_EQ(CountLayers(LAYER_RELU), 0);
+    auto conv = GetLayer("conv");
+    EXPECT_EQ(dynamic_cast<ConvLayerParam *>(conv->param.get())->activation_type, ActivationType_ReLU);
+    // the interpreted param is not changed
+    EXPECT_EQ(conv_param->activation_type, ActivationType_None);
+    EXPECT_EQ(GetLayer("dequant")->outputs[0], "r");
+}
+
+TEST_F(EliminateReformatTest, KeepNetworkOutputs) {
+    AddLayer(LAYER_RELU, "relu", {"data"}, {"h"});
+    AddReformat("to_float", "h", "f", DATA_TYPE_HALF, DATA_TYPE_FLOAT);
+    AddReformat("to_half", "f", "out", DATA_TYPE_FLOAT, DATA_TYPE_HALF);
+    structure_.outputs = {"out"};
+
+    ASSERT_EQ((int)Optimize(), TNN_OK);
+    EXPECT_EQ(CountLayers(LAYER_REFORMAT), 2);
+}
+
+}  // namespace TNN_NS
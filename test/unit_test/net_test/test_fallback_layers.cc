@@ -0,0 +1,123 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "tnn/core/abstract_device.h"
+
+namespace TNN_NS {
+
+// lrn has no arm acc, its output is read by the user and by a device layer
+static const char *g_fallback_test_proto =
+    "\"1 4 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 l out data ,\""
+    "\"l out ,\""
+    "\" 3 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 8 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"LRN lrn0 1 1 c0 l 0.0001 0.75 1 5 ,\""
+    "\"Convolution conv1 1 1 l out 1 8 8 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+// bfp16 outputs near zero lose the relative precision, the error is measured against the largest value
+static float GetMaxRelativeError(TestNetData &outputs, TestNetData &ref_outputs) {
+    float max_error = 0.0f;
+    for (auto iter : ref_outputs) {
+        auto &output = outputs[iter.first];
+        if (output.size() != iter.second.size()) {
+            return FLT_MAX;
+        }
+        float max_value = 0.0f, max_diff = 0.0f;
+        for (size_t i = 0; i < output.size(); i++) {
+            max_value = std::max(max_value, std::fabs(iter.second[i]));
+            max_diff  = std::max(max_diff, std::fabs(output[i] - iter.second[i]));
+        }
+        max_error = std::max(max_error, max_value > 0.0f ? max_diff / max_value : max_diff);
+    }
+    return max_error;
+}
+
+static std::shared_ptr<Instance> CreateFallbackTestInstance(std::shared_ptr<TestNetInterpreter> interpreter,
+                                                            NetworkConfig net_config, Status &status) {
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, InputShapesMap());
+    return instance;
+}
+
+static Status ForwardFallbackTestInstance(Instance *instance, TestNetData &outputs) {
+    RETURN_ON_NEQ(SetTestNetInputs(instance, 1), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+    return GetTestNetOutputs(instance, outputs);
+}
+
+TEST(FallbackLayersTest, MatchNaiveReference) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_fallback_test_proto), TNN_OK);
+    auto ref_config        = GetTestNetworkConfig();
+    ref_config.device_type = DEVICE_NAIVE;
+    Status status;
+    auto ref_instance = CreateFallbackTestInstance(interpreter, ref_config, status);
+    ASSERT_EQ((int)status, TNN_OK);
+    TestNetData ref_outputs;
+    ASSERT_EQ((int)ForwardFallbackTestInstance(ref_instance.get(), ref_outputs), TNN_OK);
+
+    // bfp16 blobs of the device layers are reformatted to the fp32 blobs of the fallback layer,
+    // the naive device itself runs lrn in fp32 only
+    std::vector<Precision> precisions = {PRECISION_HIGH};
+    if (GetFallbackDevice(GetTestNetworkConfig().device_type)) {
+        precisions.push_back(PRECISION_LOW);
+    }
+    for (auto precision : precisions) {
+        auto net_config      = GetTestNetworkConfig();
+        net_config.precision = precision;
+        auto instance        = CreateFallbackTestInstance(interpreter, net_config, status);
+        if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+            GTEST_SKIP();
+        }
+        ASSERT_EQ((int)status, TNN_OK);
+        TestNetData outputs;
+        ASSERT_EQ((int)ForwardFallbackTestInstance(instance.get(), outputs), TNN_OK);
+        if (precision == PRECISION_LOW) {
+            EXPECT_LT(GetMaxRelativeError(outputs, ref_outputs), 0.02f);
+        } else {
+            EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.001f), 0);
+        }
+    }
+}
+
+/*
+ * The fallback layers are not wrapped when the data format of the blobs is
+ * specified, the network must not run them on the device blobs then.
+ */
+TEST(FallbackLayersTest, RejectSpecifiedDataFormat) {
+    auto net_config = GetTestNetworkConfig();
+    auto device     = GetDevice(net_config.device_type);
+    if (!device || !GetFallbackDevice(net_config.device_type) || device->IsLayerAccImplemented(LAYER_LRN)) {
+        GTEST_SKIP();
+    }
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_fallback_test_proto), TNN_OK);
+    net_config.data_format = DATA_FORMAT_NC4HW4;
+    Status status;
+    auto instance = CreateFallbackTestInstance(interpreter, net_config, status);
+    EXPECT_NE((int)status, TNN_OK);
+}
+
+}  // namespace TNN_NS
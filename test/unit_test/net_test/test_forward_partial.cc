@@ -0,0 +1,116 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "test/test_utils.h"
+#include "test/unit_test/net_test/net_test_utils.h"
+
+namespace TNN_NS {
+
+// out1 is computed by a wide branch whose memory is not needed for out0
+static const char *g_forward_partial_test_proto =
+    "\"1 6 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 r0 out0 c1 out1 data ,\""
+    "\"out0 out1 ,\""
+    "\" 5 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 r0 ,\""
+    "\"Convolution conv1 1 1 r0 out0 1 16 8 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Convolution conv2 1 1 data c1 1 8 64 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv3 1 1 c1 out1 1 64 8 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+static std::shared_ptr<Instance> CreatePartialTestInstance(Status &status) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    status           = interpreter->InterpretTestNet(g_forward_partial_test_proto);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+    auto net_config = GetTestNetworkConfig();
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, InputShapesMap());
+    return instance;
+}
+
+static int CompareOutput(TestNetData &outputs, TestNetData &ref_outputs, const std::string &name) {
+    auto &ref = ref_outputs[name];
+    return outputs[name].size() == ref.size() ? CompareData(outputs[name].data(), ref.data(), ref.size(), 0.0f) : -1;
+}
+
+TEST(ForwardPartialTest, PartialOutputMatchesForward) {
+    Status status;
+    auto instance = CreatePartialTestInstance(status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    TestNetData ref_outputs, outputs;
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), ref_outputs), TNN_OK);
+
+    for (auto name : {"out0", "out1"}) {
+        ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+        ASSERT_EQ((int)instance->ForwardPartial({name}), TNN_OK);
+        ASSERT_EQ((int)GetTestNetOutputs(instance.get(), outputs), TNN_OK);
+        EXPECT_EQ(CompareOutput(outputs, ref_outputs, name), 0);
+    }
+    EXPECT_NE((int)instance->ForwardPartial({"c0"}), TNN_OK);
+}
+
+TEST(ForwardPartialTest, PartialMemoryPlan) {
+    Status status;
+    auto instance = CreatePartialTestInstance(status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    TestNetData ref_outputs, outputs;
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), ref_outputs), TNN_OK);
+    int full_memory_size = 0;
+    ASSERT_EQ((int)instance->GetForwardMemorySize(full_memory_size), TNN_OK);
+
+    // the wide branch of out1 is not planned
+    ASSERT_EQ((int)instance->SetPartialOutputs({"out0"}), TNN_OK);
+    int partial_memory_size = 0;
+    ASSERT_EQ((int)instance->GetForwardMemorySize(partial_memory_size), TNN_OK);
+    EXPECT_LT(partial_memory_size, full_memory_size);
+
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->ForwardPartial({"out0"}), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), outputs), TNN_OK);
+    EXPECT_EQ(CompareOutput(outputs, ref_outputs, "out0"), 0);
+
+    // the layers of out1 have no memory
+    EXPECT_NE((int)instance->Forward(), TNN_OK);
+    EXPECT_NE((int)instance->ForwardPartial({"out1"}), TNN_OK);
+
+    // all the layers are planned again
+    ASSERT_EQ((int)instance->SetPartialOutputs({}), TNN_OK);
+    ASSERT_EQ((int)instance->GetForwardMemorySize(partial_memory_size), TNN_OK);
+    EXPECT_EQ(partial_memory_size, full_memory_size);
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+}
+
+}  // namespace TNN_NS
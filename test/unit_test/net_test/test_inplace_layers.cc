@@ -0,0 +1,99 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+
+namespace TNN_NS {
+
+/*
+ * relu0 must not overwrite c0, which add0 reads later, and sig0 must not
+ * overwrite the network output mid. add0 and reshape0 overwrite dying inputs.
+ */
+static const char *g_inplace_test_proto =
+    "\"1 8 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 r0 mid s0 a rs out data ,\""
+    "\"mid out ,\""
+    "\" 7 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 8 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 r0 ,\""
+    "\"Convolution conv1 1 1 r0 mid 1 8 8 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Sigmoid sig0 1 1 mid s0 ,\""
+    "\"Add add0 2 1 s0 c0 a ,\""
+    "\"Reshape reshape0 1 1 a rs 0 4 4 0 0 -1 1 0 ,\""
+    "\"Convolution conv2 1 1 rs out 1 8 8 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+static std::shared_ptr<Instance> CreateInplaceTestInstance(std::shared_ptr<TestNetInterpreter> interpreter,
+                                                           DeviceType device_type, Status &status) {
+    auto net_config        = GetTestNetworkConfig();
+    net_config.device_type = device_type;
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, InputShapesMap());
+    return instance;
+}
+
+TEST(InplaceLayersTest, KeepInputsStillInUse) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_inplace_test_proto), TNN_OK);
+    Status status;
+    auto instance = CreateInplaceTestInstance(interpreter, GetTestNetworkConfig().device_type, status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    auto ref_instance = CreateInplaceTestInstance(interpreter, DEVICE_NAIVE, status);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    TestNetData outputs, ref_outputs;
+    ASSERT_EQ((int)SetTestNetInputs(ref_instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)ref_instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(ref_instance.get(), ref_outputs), TNN_OK);
+    // the second forward reads no data left by the first one
+    for (unsigned int seed : {2, 1}) {
+        ASSERT_EQ((int)SetTestNetInputs(instance.get(), seed), TNN_OK);
+        ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    }
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.001f), 0);
+}
+
+/*
+ * The in place plan must match a plan without in place layers, which the
+ * partial forward of conv1 alone gives for mid.
+ */
+TEST(InplaceLayersTest, PartialForwardMatches) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_inplace_test_proto), TNN_OK);
+    Status status;
+    auto instance = CreateInplaceTestInstance(interpreter, GetTestNetworkConfig().device_type, status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    TestNetData outputs, partial_outputs;
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), outputs), TNN_OK);
+    ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)instance->ForwardPartial({"mid"}), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(instance.get(), partial_outputs), TNN_OK);
+    ASSERT_EQ(outputs["mid"].size(), partial_outputs["mid"].size());
+    EXPECT_EQ(outputs["mid"], partial_outputs["mid"]);
+}
+
+}  // namespace TNN_NS
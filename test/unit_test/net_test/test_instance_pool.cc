@@ -0,0 +1,140 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/instance_pool.h"
+#include "tnn/core/tnn.h"
+
+namespace TNN_NS {
+
+static const char *g_instance_pool_test_proto =
+    "\"1 3 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 out data ,\""
+    "\"out ,\""
+    "\" 2 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 out ,\"";
+
+class InstancePoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        TestNetInterpreter interpreter;
+        ASSERT_EQ((int)interpreter.InterpretTestNet(g_instance_pool_test_proto), TNN_OK);
+        ModelConfig model_config;
+        ASSERT_EQ((int)PackTestNet(interpreter, "instance_pool_test", model_config), TNN_OK);
+        ASSERT_EQ((int)tnn_.Init(model_config), TNN_OK);
+        net_config_ = GetTestNetworkConfig();
+    }
+
+    Status InitPool(InstancePool &pool, int num_instances, int num_arenas) {
+        InstancePoolConfig pool_config;
+        pool_config.num_instances = num_instances;
+        pool_config.num_arenas    = num_arenas;
+        return pool.Init(tnn_, net_config_, pool_config);
+    }
+
+    TNN tnn_;
+    NetworkConfig net_config_;
+};
+
+static Status ForwardLease(InstancePool::Lease &lease, TestNetData &outputs) {
+    RETURN_ON_NEQ(SetTestNetInputs(lease.GetInstance().get(), 1), TNN_OK);
+    RETURN_ON_NEQ(lease->Forward(), TNN_OK);
+    return GetTestNetOutputs(lease.GetInstance().get(), outputs);
+}
+
+TEST_F(InstancePoolTest, InitFailureLeavesPoolEmpty) {
+    InstancePool pool;
+    Status status = InitPool(pool, 2, 1);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    EXPECT_EQ(pool.GetStats().num_instances, 2);
+
+    // the instances and arenas of the previous init are not kept by a failed init
+    net_config_.device_type = DEVICE_OPENCL;
+    if (GetDevice(DEVICE_OPENCL)) {
+        GTEST_SKIP();
+    }
+    EXPECT_NE((int)InitPool(pool, 2, 1), TNN_OK);
+    EXPECT_EQ(pool.GetStats().num_instances, 0);
+    InstancePool::Lease lease;
+    EXPECT_EQ((int)pool.Acquire(lease, 0), TNNERR_INST_ERR);
+    EXPECT_FALSE(lease.IsValid());
+
+    net_config_ = GetTestNetworkConfig();
+    ASSERT_EQ((int)InitPool(pool, 2, 0), TNN_OK);
+    EXPECT_NE((int)InitPool(pool, 0, 0), TNN_OK);
+    EXPECT_EQ((int)pool.Acquire(lease, 0), TNNERR_INST_ERR);
+}
+
+TEST_F(InstancePoolTest, AcquireTimeout) {
+    InstancePool pool;
+    Status status = InitPool(pool, 1, 0);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    InstancePool::Lease lease, other;
+    ASSERT_EQ((int)pool.Acquire(lease), TNN_OK);
+    EXPECT_EQ((int)pool.Acquire(other, 10), TNNERR_INST_TIMEOUT);
+    EXPECT_FALSE(other.IsValid());
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.num_leased, 1);
+    EXPECT_EQ(stats.num_timeouts, 1);
+
+    lease.Release();
+    ASSERT_EQ((int)pool.Acquire(other, 10), TNN_OK);
+    EXPECT_TRUE(other.IsValid());
+}
+
+TEST_F(InstancePoolTest, InstancesShareArena) {
+    InstancePool pool;
+    // instances 0 and 2 share arena 0, instance 1 uses arena 1
+    Status status = InitPool(pool, 3, 2);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+
+    InstancePool::Lease lease0, lease1, lease2;
+    ASSERT_EQ((int)pool.Acquire(lease0), TNN_OK);
+    ASSERT_EQ((int)pool.Acquire(lease1), TNN_OK);
+    // the idle instance is not leased while the other instance of its arena is
+    EXPECT_EQ((int)pool.Acquire(lease2, 10), TNNERR_INST_TIMEOUT);
+
+    TestNetData outputs0, outputs1;
+    ASSERT_EQ((int)ForwardLease(lease0, outputs0), TNN_OK);
+    ASSERT_EQ((int)ForwardLease(lease1, outputs1), TNN_OK);
+    lease0.Release();
+    ASSERT_EQ((int)pool.Acquire(lease2, 10), TNN_OK);
+
+    InstancePool ref_pool;
+    ASSERT_EQ((int)InitPool(ref_pool, 1, 0), TNN_OK);
+    InstancePool::Lease ref_lease;
+    ASSERT_EQ((int)ref_pool.Acquire(ref_lease), TNN_OK);
+    TestNetData ref_outputs;
+    ASSERT_EQ((int)ForwardLease(ref_lease, ref_outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs0, ref_outputs, 0.0f), 0);
+    EXPECT_EQ(CompareTestNetOutputs(outputs1, ref_outputs, 0.0f), 0);
+}
+
+}  // namespace TNN_NS
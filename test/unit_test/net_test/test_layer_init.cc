@@ -0,0 +1,127 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "tnn/utils/thread_pool.h"
+
+namespace TNN_NS {
+
+static const char *g_layer_init_test_proto =
+    "\"1 6 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 c1 c2 c3 out data ,\""
+    "\"out ,\""
+    "\" 5 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv1 1 1 c0 c1 1 16 16 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Convolution conv2 1 1 c1 c2 16 16 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv3 1 1 c2 c3 1 16 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv4 1 1 c3 out 1 16 8 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+TEST(ThreadPoolTest, RunsEachIndexOnce) {
+    ThreadPool pool(3);
+    for (int count : {0, 1, 2, 100}) {
+        std::vector<std::atomic<int>> runs(count);
+        for (auto &run : runs) {
+            run = 0;
+        }
+        pool.ParallelFor(count, [&](int i) { runs[i]++; });
+        for (int i = 0; i < count; i++) {
+            EXPECT_EQ(runs[i].load(), 1);
+        }
+    }
+}
+
+// the callers run the indices left by the busy workers, nested calls included
+TEST(ThreadPoolTest, CallersShareBusyWorkers) {
+    ThreadPool pool(2);
+    std::atomic<int> total(0);
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; t++) {
+        callers.push_back(std::thread([&]() {
+            pool.ParallelFor(8, [&](int i) { pool.ParallelFor(4, [&](int j) { total++; }); });
+        }));
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(total.load(), 4 * 8 * 4);
+}
+
+static std::shared_ptr<Instance> CreateLayerInitTestInstance(std::shared_ptr<TestNetInterpreter> interpreter,
+                                                             NetworkConfig net_config, Status &status) {
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(net_config, model_config);
+    status        = instance->Init(interpreter, InputShapesMap());
+    return instance;
+}
+
+// the instances initialized at once share the pool, and prepare the same weights as one initialized alone
+TEST(LayerInitTest, ConcurrentInitsMatch) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_layer_init_test_proto), TNN_OK);
+    Status status;
+    auto ref_instance = CreateLayerInitTestInstance(interpreter, GetTestNetworkConfig(), status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    TestNetData ref_outputs;
+    ASSERT_EQ((int)SetTestNetInputs(ref_instance.get(), 1), TNN_OK);
+    ASSERT_EQ((int)ref_instance->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetTestNetOutputs(ref_instance.get(), ref_outputs), TNN_OK);
+
+    const int count = 4;
+    std::vector<std::shared_ptr<Instance>> instances(count);
+    std::vector<Status> init_status(count);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < count; i++) {
+        threads.push_back(std::thread([&, i]() {
+            instances[i] = CreateLayerInitTestInstance(interpreter, GetTestNetworkConfig(), init_status[i]);
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < count; i++) {
+        ASSERT_EQ((int)init_status[i], TNN_OK);
+        TestNetData outputs;
+        ASSERT_EQ((int)SetTestNetInputs(instances[i].get(), 1), TNN_OK);
+        ASSERT_EQ((int)instances[i]->Forward(), TNN_OK);
+        ASSERT_EQ((int)GetTestNetOutputs(instances[i].get(), outputs), TNN_OK);
+        EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+    }
+}
+
+// a data format the layer accs do not support fails the init of the first layer
+TEST(LayerInitTest, RejectUnsupportedDataFormat) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_layer_init_test_proto), TNN_OK);
+    auto net_config        = GetTestNetworkConfig();
+    net_config.data_format = net_config.device_type == DEVICE_NAIVE ? DATA_FORMAT_NC4HW4 : DATA_FORMAT_NCDHW;
+    Status status;
+    auto instance = CreateLayerInitTestInstance(interpreter, net_config, status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    EXPECT_NE((int)status, TNN_OK);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,112 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "tnn/core/tnn.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+
+namespace TNN_NS {
+
+static const char *g_lazy_load_test_proto =
+    "\"1 4 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 r0 c1 out data ,\""
+    "\"out ,\""
+    "\" 4 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 r0 ,\""
+    "\"Convolution conv1 1 1 r0 c1 2 16 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv2 1 1 c1 out 1 16 8 1 1 1 1 0 0 1 -1 1 1 0 ,\"";
+
+static std::string ReadFile(const std::string &path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static Status ForwardTestNet(std::shared_ptr<Instance> instance, TestNetData &outputs) {
+    RETURN_ON_NEQ(SetTestNetInputs(instance.get(), 1), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+    return GetTestNetOutputs(instance.get(), outputs);
+}
+
+TEST(LazyLoadTest, ReleasedResourceForwardMatchesEagerLoad) {
+    TestNetInterpreter interpreter;
+    ASSERT_EQ((int)interpreter.InterpretTestNet(g_lazy_load_test_proto), TNN_OK);
+
+    std::string proto_path = testing::TempDir() + "lazy_load_test.tnnproto";
+    std::string model_path = testing::TempDir() + "lazy_load_test.tnnmodel";
+    ModelPacker packer(interpreter.GetNetStructure(), interpreter.GetNetResource());
+    ASSERT_EQ((int)packer.Pack(proto_path, model_path), TNN_OK);
+
+    auto net_config = GetTestNetworkConfig();
+    Status status;
+
+    ModelConfig eager_config;
+    eager_config.params = {ReadFile(proto_path), ReadFile(model_path)};
+    TNN eager_tnn;
+    ASSERT_EQ((int)eager_tnn.Init(eager_config), TNN_OK);
+    auto eager_instance = eager_tnn.CreateInst(net_config, status);
+    if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    TestNetData ref_outputs;
+    ASSERT_EQ((int)ForwardTestNet(eager_instance, ref_outputs), TNN_OK);
+
+    // the resources of the packed layers are released once the first instance is initialized
+    ModelConfig lazy_config;
+    lazy_config.params             = {ReadFile(proto_path), model_path};
+    lazy_config.lazy_load_resource = true;
+    TNN lazy_tnn;
+    ASSERT_EQ((int)lazy_tnn.Init(lazy_config), TNN_OK);
+    auto lazy_instance = lazy_tnn.CreateInst(net_config, status);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    TestNetData outputs;
+    ASSERT_EQ((int)ForwardTestNet(lazy_instance, outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+
+    // forward and reshape again after the release
+    ASSERT_EQ((int)ForwardTestNet(lazy_instance, outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+    ASSERT_EQ((int)lazy_instance->Reshape({{"data", {1, 8, 12, 12}}}), TNN_OK);
+    ASSERT_EQ((int)ForwardTestNet(lazy_instance, outputs), TNN_OK);
+    ASSERT_EQ((int)lazy_instance->Reshape({{"data", {1, 8, 16, 16}}}), TNN_OK);
+    ASSERT_EQ((int)ForwardTestNet(lazy_instance, outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+
+    // the released resources are loaded from the model file again by a new instance
+    auto reloaded_instance = lazy_tnn.CreateInst(net_config, status);
+    ASSERT_EQ((int)status, TNN_OK);
+    ASSERT_EQ((int)ForwardTestNet(reloaded_instance, outputs), TNN_OK);
+    EXPECT_EQ(CompareTestNetOutputs(outputs, ref_outputs, 0.0f), 0);
+}
+
+TEST(LazyLoadTest, MissingModelFileFails) {
+    ModelConfig lazy_config;
+    lazy_config.params             = {g_lazy_load_test_proto, testing::TempDir() + "lazy_load_missing.tnnmodel"};
+    lazy_config.lazy_load_resource = true;
+    TNN lazy_tnn;
+    EXPECT_NE((int)lazy_tnn.Init(lazy_config), TNN_OK);
+}
+
+}  // namespace TNN_NS
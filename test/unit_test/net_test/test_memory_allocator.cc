@@ -0,0 +1,144 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <thread>
+#include <vector>
+
+#include "tnn/memory_manager/pool_memory_allocator.h"
+
+namespace TNN_NS {
+
+static const size_t kTestHugePageSize = 2 * 1024 * 1024;
+
+TEST(MemoryAllocatorTest, PoolReusesSizeClass) {
+    AllocatorConfig config;
+    config.max_cached_bytes = 4096;
+    PoolMemoryAllocator allocator(config);
+
+    void *data = nullptr, *other = nullptr;
+    ASSERT_EQ((int)allocator.Allocate(&data, 1000), TNN_OK);
+    EXPECT_EQ((uintptr_t)data % 64, 0);
+    ASSERT_EQ((int)allocator.Free(data), TNN_OK);
+    // 1000 and 1020 bytes are in the same size class
+    ASSERT_EQ((int)allocator.Allocate(&other, 1020), TNN_OK);
+    EXPECT_EQ(other, data);
+    auto stats = allocator.GetStats();
+    EXPECT_EQ(stats.num_pool_hits, 1);
+    EXPECT_EQ(stats.num_allocations, 2);
+    EXPECT_EQ(stats.bytes_in_use, PoolMemoryAllocator::GetSizeClass(1000));
+    ASSERT_EQ((int)allocator.Free(other), TNN_OK);
+    EXPECT_EQ((int)allocator.Free(other), TNNERR_PARAM_ERR);
+
+    // blocks above max_cached_bytes go back to the system
+    ASSERT_EQ((int)allocator.Allocate(&data, 8192), TNN_OK);
+    ASSERT_EQ((int)allocator.Free(data), TNN_OK);
+    EXPECT_EQ(allocator.GetStats().bytes_reserved, PoolMemoryAllocator::GetSizeClass(1000));
+    allocator.Trim();
+    EXPECT_EQ(allocator.GetStats().bytes_reserved, 0);
+}
+
+TEST(MemoryAllocatorTest, HugePagesAboveThreshold) {
+    AllocatorConfig config;
+    config.huge_page_threshold = 64 * 1024;
+    SystemMemoryAllocator allocator(config);
+
+    void *small = nullptr, *large = nullptr;
+    ASSERT_EQ((int)allocator.Allocate(&small, 1000), TNN_OK);
+    ASSERT_EQ((int)allocator.Allocate(&large, 100 * 1024), TNN_OK);
+    auto stats = allocator.GetStats();
+#if defined(__ANDROID__) || defined(__linux__)
+    EXPECT_EQ((uintptr_t)large % kTestHugePageSize, 0);
+    EXPECT_EQ(stats.bytes_huge_page, kTestHugePageSize);
+#else
+    EXPECT_EQ(stats.bytes_huge_page, 0);
+#endif
+    EXPECT_EQ(stats.bytes_reserved, 1000 + 100 * 1024);
+    // the whole huge page is writable
+    memset(large, 1, kTestHugePageSize);
+    ASSERT_EQ((int)allocator.Free(large), TNN_OK);
+    ASSERT_EQ((int)allocator.Free(small), TNN_OK);
+    stats = allocator.GetStats();
+    EXPECT_EQ(stats.bytes_huge_page, 0);
+    EXPECT_EQ(stats.bytes_reserved, 0);
+}
+
+TEST(MemoryAllocatorTest, HugeTlbFallsBack) {
+    // without reserved huge pages the memory is mapped for transparent huge pages instead
+    AllocatorConfig config;
+    config.huge_page_threshold = 64 * 1024;
+    config.use_hugetlb         = true;
+    SystemMemoryAllocator allocator(config);
+
+    std::vector<void *> blocks(4, nullptr);
+    for (auto &data : blocks) {
+        ASSERT_EQ((int)allocator.Allocate(&data, 3 * kTestHugePageSize / 2), TNN_OK);
+        ASSERT_NE(data, nullptr);
+        memset(data, 1, 3 * kTestHugePageSize / 2);
+    }
+#if defined(__ANDROID__) || defined(__linux__)
+    EXPECT_EQ(allocator.GetStats().bytes_huge_page, blocks.size() * 2 * kTestHugePageSize);
+#endif
+    for (auto data : blocks) {
+        ASSERT_EQ((int)allocator.Free(data), TNN_OK);
+    }
+    EXPECT_EQ(allocator.GetStats().bytes_huge_page, 0);
+}
+
+TEST(MemoryAllocatorTest, HostMemoryFreedAfterAllocatorReplaced) {
+    auto last = MemoryAllocator::GetHostAllocator();
+    const size_t bytes_in_use = MemoryAllocator::GetHostStats().bytes_in_use;
+
+    // the threads free the memory of the allocators replaced meanwhile
+    const int thread_count = 4;
+    std::vector<std::thread> threads;
+    std::vector<int> failures(thread_count, 0);
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([t, &failures]() {
+            for (int i = 0; i < 1000; i++) {
+                void *data = nullptr;
+                if (MemoryAllocator::GetHostAllocator()->Allocate(&data, 64 + i) != TNN_OK ||
+                    MemoryAllocator::FreeHostMemory(data) != TNN_OK) {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 100; i++) {
+        AllocatorConfig config;
+        std::shared_ptr<MemoryAllocator> allocator;
+        if (i % 2) {
+            allocator = std::make_shared<PoolMemoryAllocator>(config);
+        } else {
+            allocator = std::make_shared<SystemMemoryAllocator>(config);
+        }
+        MemoryAllocator::SetHostAllocator(allocator);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    MemoryAllocator::SetHostAllocator(last);
+
+    for (int t = 0; t < thread_count; t++) {
+        EXPECT_EQ(failures[t], 0);
+    }
+    EXPECT_EQ(MemoryAllocator::GetHostStats().bytes_in_use, bytes_in_use);
+}
+
+}  // namespace TNN_NS
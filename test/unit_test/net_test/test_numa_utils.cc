@@ -0,0 +1,117 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <stdint.h>
+
+#include "tnn/memory_manager/pool_memory_allocator.h"
+#include "tnn/utils/numa_utils.h"
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace TNN_NS {
+
+// numa policy of the page of data, false if it is not known
+static bool GetMemoryPolicy(void *data, int &mode, unsigned long &nodes) {
+    unsigned long mask[16] = {0};
+    if (syscall(__NR_get_mempolicy, &mode, mask, 16 * 8 * sizeof(unsigned long), data, MPOL_F_ADDR)) {
+        return false;
+    }
+    nodes = mask[0];
+    return true;
+}
+
+// mbind may be not allowed in a container
+static bool IsNumaBindSupported() {
+    const size_t page_size = NumaUtils::GetPageSize();
+    void *data = mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    bool supported = NumaUtils::BindMemory(data, page_size, 0) == TNN_OK;
+    munmap(data, page_size);
+    return supported;
+}
+
+TEST(NumaUtilsTest, BindMemoryRejectsUnownedPages) {
+    const size_t page_size = NumaUtils::GetPageSize();
+    void *data = mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(data, MAP_FAILED);
+    // the page of memory not aligned to a page may be shared with other memory
+    EXPECT_EQ((int)NumaUtils::BindMemory((char *)data + 64, 64, 0), TNNERR_PARAM_ERR);
+    EXPECT_EQ((int)NumaUtils::BindMemory(data, page_size, -1), TNNERR_PARAM_ERR);
+    EXPECT_EQ((int)NumaUtils::BindMemory(nullptr, page_size, 0), TNNERR_PARAM_ERR);
+    munmap(data, 2 * page_size);
+}
+
+TEST(NumaUtilsTest, AllocatorBindsPagesOfNode) {
+    if (!IsNumaBindSupported()) {
+        GTEST_SKIP();
+    }
+    const size_t page_size = NumaUtils::GetPageSize();
+    SystemMemoryAllocator allocator((AllocatorConfig()));
+    void *data = nullptr;
+    {
+        NumaNodeGuard guard(0);
+        ASSERT_EQ((int)allocator.Allocate(&data, 1000), TNN_OK);
+    }
+    EXPECT_EQ((uintptr_t)data % page_size, 0);
+    int mode            = 0;
+    unsigned long nodes = 0;
+    ASSERT_TRUE(GetMemoryPolicy(data, mode, nodes));
+    EXPECT_EQ(mode, MPOL_PREFERRED);
+    EXPECT_EQ(nodes, 1UL);
+    EXPECT_EQ((int)allocator.Free(data), TNN_OK);
+
+    // the memory allocated out of a guard keeps the default policy
+    ASSERT_EQ((int)allocator.Allocate(&data, 1000), TNN_OK);
+    ASSERT_TRUE(GetMemoryPolicy(data, mode, nodes));
+    EXPECT_EQ(mode, MPOL_DEFAULT);
+    EXPECT_EQ((int)allocator.Free(data), TNN_OK);
+    EXPECT_EQ(allocator.GetStats().bytes_reserved, 0);
+}
+
+TEST(NumaUtilsTest, PoolReusesBlocksOfSameNode) {
+    AllocatorConfig config;
+    config.max_cached_bytes = 1 << 20;
+    PoolMemoryAllocator allocator(config);
+    void *data = nullptr;
+    void *node_data = nullptr;
+    {
+        NumaNodeGuard guard(0);
+        ASSERT_EQ((int)allocator.Allocate(&node_data, 1000), TNN_OK);
+        ASSERT_EQ((int)allocator.Free(node_data), TNN_OK);
+    }
+    ASSERT_EQ((int)allocator.Allocate(&data, 1000), TNN_OK);
+    EXPECT_NE(data, node_data);
+    EXPECT_EQ(allocator.GetStats().num_pool_hits, 0);
+    ASSERT_EQ((int)allocator.Free(data), TNN_OK);
+    {
+        NumaNodeGuard guard(0);
+        ASSERT_EQ((int)allocator.Allocate(&data, 1000), TNN_OK);
+        EXPECT_EQ(data, node_data);
+        EXPECT_EQ(allocator.GetStats().num_pool_hits, 1);
+        ASSERT_EQ((int)allocator.Free(data), TNN_OK);
+    }
+}
+
+}  // namespace TNN_NS
+
+#endif
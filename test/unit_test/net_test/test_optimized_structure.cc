@@ -0,0 +1,180 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/memory_manager/shared_memory_manager.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+
+namespace TNN_NS {
+
+static const char *g_optimized_structure_test_proto =
+    "\"1 3 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 out data ,\""
+    "\"out ,\""
+    "\" 2 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 out ,\"";
+
+// look up the structure cached for the config, nullptr if no instance of the config has been created.
+// the optimize func fails, so that a missing structure is not cached by the lookup
+static std::shared_ptr<NetStructure> GetCachedStructure(TestNetInterpreter *interpreter,
+                                                        const NetworkConfig &net_config) {
+    std::shared_ptr<NetStructure> structure;
+    Status status = interpreter->GetOptimizedNetStructure(
+        optimizer::NetOptimizerManager::GetOptimizeKey(net_config),
+        [](NetStructure *) { return Status(TNNERR_NET_ERR, "the structure is not cached"); }, structure);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+    return structure;
+}
+
+static Status CreateTestInstance(std::shared_ptr<TestNetInterpreter> interpreter, NetworkConfig net_config,
+                                 std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+TEST(OptimizedStructureTest, StructurePerConfig) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_optimized_structure_test_proto), TNN_OK);
+    NetStructure *interpreted = interpreter->GetNetStructure();
+    auto conv_param           = dynamic_cast<ConvLayerParam *>(interpreted->layers[0]->param.get());
+    ASSERT_NE(conv_param, nullptr);
+
+    std::vector<NetworkConfig> net_configs(3, GetTestNetworkConfig());
+    net_configs[1].precision   = PRECISION_LOW;
+    net_configs[2].data_format = DATA_FORMAT_NC4HW4;
+
+    std::vector<std::shared_ptr<Instance>> instances;
+    std::vector<std::shared_ptr<NetStructure>> structures;
+    for (auto &net_config : net_configs) {
+        std::shared_ptr<Instance> instance;
+        Status status = CreateTestInstance(interpreter, net_config, instance);
+        if (status == TNNERR_DEVICE_NOT_SUPPORT) {
+            GTEST_SKIP();
+        }
+        ASSERT_EQ((int)status, TNN_OK);
+        instances.push_back(instance);
+
+        auto structure = GetCachedStructure(interpreter.get(), net_config);
+        ASSERT_NE(structure, nullptr);
+        EXPECT_NE(structure.get(), interpreted);
+        for (auto other : structures) {
+            EXPECT_NE(structure, other);
+        }
+        structures.push_back(structure);
+    }
+
+    // the passes run on the copies, the relu is not fused into the interpreted conv
+    ASSERT_EQ(interpreted->layers.size(), 2);
+    EXPECT_EQ(interpreted->layers[0]->type, LAYER_CONVOLUTION);
+    EXPECT_EQ(interpreted->layers[1]->type, LAYER_RELU);
+    EXPECT_EQ(conv_param->activation_type, ActivationType_None);
+    EXPECT_EQ(interpreted->outputs.size(), 1);
+    EXPECT_EQ(interpreted->outputs.count("out"), 1);
+}
+
+TEST(OptimizedStructureTest, ConcurrentInstancesShareStructure) {
+    auto interpreter = std::make_shared<TestNetInterpreter>();
+    ASSERT_EQ((int)interpreter->InterpretTestNet(g_optimized_structure_test_proto), TNN_OK);
+    auto net_config = GetTestNetworkConfig();
+
+    const int thread_count = 4;
+    std::vector<std::shared_ptr<Instance>> instances(thread_count);
+    std::vector<Status> statuses(thread_count);
+    std::vector<std::shared_ptr<NetStructure>> structures(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t]() {
+            statuses[t] = CreateTestInstance(interpreter, net_config, instances[t]);
+            // the structure of a key is not replaced once cached
+            structures[t] = GetCachedStructure(interpreter.get(), net_config);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (statuses[0] == TNNERR_DEVICE_NOT_SUPPORT) {
+        GTEST_SKIP();
+    }
+    for (int t = 0; t < thread_count; t++) {
+        ASSERT_EQ((int)statuses[t], TNN_OK);
+        ASSERT_NE(structures[t], nullptr);
+        EXPECT_EQ(structures[t], structures[0]);
+    }
+    EXPECT_EQ(GetCachedStructure(interpreter.get(), net_config), structures[0]);
+
+    for (auto &instance : instances) {
+        ASSERT_EQ((int)SetTestNetInputs(instance.get(), 1), TNN_OK);
+        ASSERT_EQ((int)instance->Forward(), TNN_OK);
+    }
+}
+
+class TestSharedMemoryListener : public ISharedMemoryChangeListener {
+public:
+    virtual void OnSharedForwardMemoryChanged(void *memory) override {}
+};
+
+TEST(SharedMemoryManagerTest, ConcurrentGetAndRelease) {
+    auto device = GetDevice(GetTestNetworkConfig().device_type);
+    ASSERT_NE(device, nullptr);
+
+    // all the threads use the memory of one id, as the instances created on one thread do
+    const auto thread_id   = std::this_thread::get_id();
+    const int thread_count = 4;
+    std::vector<TestSharedMemoryListener> listeners(thread_count);
+    std::vector<int> failures(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 200; i++) {
+                Status status;
+                int size    = 64 * (1 + (i + t) % 8);
+                auto memory = SharedMemoryManager::GetSharedMemory(size, thread_id, device, 0, &listeners[t], status);
+                if (status != TNN_OK || !memory.shared_memory_data || memory.shared_memory_size < size) {
+                    failures[t]++;
+                }
+                SharedMemoryManager::ReleaseSharedMemory(thread_id, device, 0, &listeners[t]);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < thread_count; t++) {
+        EXPECT_EQ(failures[t], 0);
+    }
+
+    // every get is released, the memory of the id is allocated again
+    Status status;
+    TestSharedMemoryListener listener;
+    auto memory = SharedMemoryManager::GetSharedMemory(64, thread_id, device, 0, &listener, status);
+    ASSERT_EQ((int)status, TNN_OK);
+    EXPECT_EQ(memory.shared_memory_size, 64);
+    EXPECT_EQ(memory.shared_memory_ref_count, 1);
+    SharedMemoryManager::ReleaseSharedMemory(thread_id, device, 0, &listener);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,85 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "tnn/core/profile.h"
+
+namespace TNN_NS {
+
+TEST(ProfilingRecorderTest, WorkersRecordCurrentLayer) {
+    const int thread_count = 4;
+    const int layer_count  = 8;
+    ProfilingRecorder recorder;
+    recorder.Start(1024);
+    for (int i = 0; i < layer_count; i++) {
+        int layer_id = recorder.AddLayer(std::make_shared<ProfilingData>());
+        recorder.BeginLayer(layer_id);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < thread_count; t++) {
+            workers.emplace_back([&recorder, t]() { ProfilingScope scope(&recorder, t + 1); });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        recorder.EndLayer();
+    }
+    recorder.Stop();
+    EXPECT_EQ(recorder.GetCurrentLayer(), -1);
+
+    auto spans = recorder.GetSpans();
+    ASSERT_EQ(spans.size(), layer_count * (thread_count + 1));
+    std::vector<int> worker_spans(layer_count, 0);
+    for (auto &span : spans) {
+        ASSERT_GE(span.layer_id, 0);
+        ASSERT_LT(span.layer_id, layer_count);
+        worker_spans[span.layer_id] += span.thread_id > 0 ? 1 : 0;
+    }
+    for (int i = 0; i < layer_count; i++) {
+        EXPECT_EQ(worker_spans[i], thread_count);
+    }
+}
+
+// the worker spans wrap around in their own ring, the layer spans of the table are kept
+TEST(ProfilingRecorderTest, WorkerSpansKeepLayerSpans) {
+    const int capacity    = 16;
+    const int layer_count = 8;
+    ProfilingRecorder recorder;
+    recorder.Start(capacity);
+    for (int i = 0; i < layer_count; i++) {
+        int layer_id = recorder.AddLayer(std::make_shared<ProfilingData>());
+        recorder.BeginLayer(layer_id);
+        for (int t = 0; t < capacity; t++) {
+            ProfilingScope scope(&recorder, t + 1);
+        }
+        recorder.EndLayer();
+    }
+    recorder.Stop();
+
+    auto spans = recorder.GetSpans();
+    ASSERT_EQ(spans.size(), layer_count + capacity);
+    for (int i = 0; i < layer_count; i++) {
+        EXPECT_EQ(spans[i].thread_id, 0);
+        EXPECT_EQ(spans[i].layer_id, i);
+    }
+    for (int i = layer_count; i < spans.size(); i++) {
+        EXPECT_GT(spans[i].thread_id, 0);
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,257 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "test/test_utils.h"
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/compiled_network.h"
+#include "tnn/core/tnn.h"
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+// generated by tnn2cpp from the test net at build time, see test/unit_test/CMakeLists.txt. the raw weights of
+// the packed layers are only kept in the second one.
+Status Init_tnn2cpp_test_tnnproto(CompiledNetwork &network);
+Status Init_tnn2cpp_raw_test_tnnproto(CompiledNetwork &network);
+
+static std::string ReadModelFile(const std::string &name) {
+    std::ifstream file(std::string(TNN2CPP_TEST_DIR) + "/" + name, std::ios::in | std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static std::vector<float> GetTestInput(const DimsVector &dims, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> data(DimsVectorUtils::Count(dims));
+    for (auto &value : data) {
+        value = distribution(generator);
+    }
+    return data;
+}
+
+static Status SetBlobData(Blob *blob, std::vector<float> &data) {
+    Mat mat(DEVICE_NAIVE, NCHW_FLOAT, blob->GetBlobDesc().dims, data.data());
+    BlobConverter converter(blob);
+    return converter.ConvertFromMat(mat, MatConvertParam(), nullptr);
+}
+
+static Status GetBlobData(Blob *blob, std::vector<float> &data) {
+    const auto &dims = blob->GetBlobDesc().dims;
+    data.resize(DimsVectorUtils::Count(dims));
+    Mat mat(DEVICE_NAIVE, NCHW_FLOAT, dims, data.data());
+    BlobConverter converter(blob);
+    return converter.ConvertToMat(mat, MatConvertParam(), nullptr);
+}
+
+// the generated network runs the same accs as the network interpreted from the same model, so the outputs
+// are identical bit by bit, whether the weights are packed ahead of time or at init
+static void ExpectSameAsDefaultNetwork(Status (*init_network)(CompiledNetwork &), bool use_packed_weights) {
+    NetworkConfig net_config;
+    net_config.device_type = ConvertDeviceType(TNN2CPP_TEST_DEVICE);
+    net_config.precision   = PRECISION_HIGH;
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    model_config.params     = {ReadModelFile("tnn2cpp_test.tnnproto"), ReadModelFile("tnn2cpp_test.tnnmodel")};
+
+    TNN net;
+    ASSERT_EQ((int)net.Init(model_config), TNN_OK);
+    Status status;
+    auto instance = net.CreateInst(net_config, status);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    CompiledNetwork network;
+    network.SetUsePackedWeights(use_packed_weights);
+    ASSERT_EQ((int)init_network(network), TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    ASSERT_EQ((int)instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    ASSERT_EQ((int)instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+
+    for (unsigned int seed : {1, 2}) {
+        for (auto iter : input_blobs) {
+            auto data = GetTestInput(iter.second->GetBlobDesc().dims, seed);
+            ASSERT_EQ((int)SetBlobData(iter.second, data), TNN_OK);
+            Blob *blob = network.GetBlob(iter.first);
+            ASSERT_NE(blob, nullptr);
+            ASSERT_EQ((int)SetBlobData(blob, data), TNN_OK);
+        }
+        ASSERT_EQ((int)instance->Forward(), TNN_OK);
+        ASSERT_EQ((int)network.Forward(), TNN_OK);
+
+        for (auto iter : output_blobs) {
+            Blob *blob = network.GetBlob(iter.first);
+            ASSERT_NE(blob, nullptr);
+            std::vector<float> ref_output, output;
+            ASSERT_EQ((int)GetBlobData(iter.second, ref_output), TNN_OK);
+            ASSERT_EQ((int)GetBlobData(blob, output), TNN_OK);
+            ASSERT_EQ(output.size(), ref_output.size());
+            EXPECT_EQ(memcmp(output.data(), ref_output.data(), output.size() * sizeof(float)), 0) << iter.first;
+        }
+    }
+}
+
+TEST(Tnn2CppTest, PackedWeightsMatchDefaultNetwork) {
+    ExpectSameAsDefaultNetwork(Init_tnn2cpp_test_tnnproto, true);
+    ExpectSameAsDefaultNetwork(Init_tnn2cpp_raw_test_tnnproto, true);
+}
+
+TEST(Tnn2CppTest, UnpackedWeightsMatchDefaultNetwork) {
+    ExpectSameAsDefaultNetwork(Init_tnn2cpp_raw_test_tnnproto, false);
+}
+
+// without the raw weights the packed layers can not be packed at init
+TEST(Tnn2CppTest, DroppedRawWeightsNeedPackedWeights) {
+    if (ConvertDeviceType(TNN2CPP_TEST_DEVICE) != DEVICE_ARM) {
+        GTEST_SKIP() << "only the arm accs take packed weights";
+    }
+    CompiledNetwork network;
+    network.SetUsePackedWeights(false);
+    EXPECT_NE((int)Init_tnn2cpp_test_tnnproto(network), TNN_OK);
+}
+
+// forward a 3x3 conv on the test device, the layer acc is handed the packed weights before init if they are
+// not empty. the weights it holds after init are returned in layer_packed_weights. if init_status is given, the
+// status of the init is returned in it and the conv is only forwarded if the init succeeds.
+static void ForwardConv(const PackedWeights &packed_weights, std::vector<float> &output,
+                        PackedWeights &layer_packed_weights, Status *init_status = nullptr) {
+    const int channels = 8;
+    DimsVector dims    = {1, channels, 16, 16};
+
+    auto device = GetDevice(ConvertDeviceType(TNN2CPP_TEST_DEVICE));
+    ASSERT_NE(device, nullptr);
+    std::shared_ptr<Context> context(device->CreateContext(0));
+    ASSERT_NE(context, nullptr);
+
+    ConvLayerParam param;
+    param.type           = "Convolution";
+    param.name           = "conv";
+    param.input_channel  = channels;
+    param.output_channel = channels;
+    param.kernels        = {3, 3};
+    param.strides        = {1, 1};
+    param.pads           = {1, 1, 1, 1};
+    param.dialations     = {1, 1};
+    param.bias           = 1;
+
+    ConvLayerResource resource;
+    auto weights = GetTestInput({channels, channels, 3, 3}, 3);
+    auto bias    = GetTestInput({channels}, 4);
+    resource.filter_handle = RawBuffer(weights.size() * sizeof(float), (const char *)weights.data());
+    resource.bias_handle   = RawBuffer(bias.size() * sizeof(float), (const char *)bias.data());
+
+    BlobDesc desc;
+    desc.device_type = device->GetDeviceType();
+    desc.data_type   = DATA_TYPE_FLOAT;
+    desc.data_format = DATA_FORMAT_NC4HW4;
+    desc.dims        = dims;
+    Blob input(desc, true), output_blob(desc, true);
+    std::vector<Blob *> inputs = {&input}, outputs = {&output_blob};
+
+    std::shared_ptr<BaseLayer> layer(CreateLayer(LAYER_CONVOLUTION));
+    ASSERT_NE(layer, nullptr);
+    ASSERT_EQ((int)layer->PrepareInit(context.get(), &param, &resource, inputs, outputs, device), TNN_OK);
+    if (!packed_weights.buffers.empty()) {
+        ASSERT_EQ((int)layer->SetPackedWeights(packed_weights), TNN_OK);
+    }
+    Status status = layer->InitLayerAcc();
+    if (init_status) {
+        *init_status = status;
+        if (status != TNN_OK) {
+            return;
+        }
+    }
+    ASSERT_EQ((int)status, TNN_OK);
+    ASSERT_EQ((int)layer->Reshape(), TNN_OK);
+
+    auto data = GetTestInput(dims, 5);
+    ASSERT_EQ((int)SetBlobData(&input, data), TNN_OK);
+    ASSERT_EQ((int)layer->Forward(), TNN_OK);
+    ASSERT_EQ((int)GetBlobData(&output_blob, output), TNN_OK);
+    layer_packed_weights = layer->GetPackedWeights();
+}
+
+// the packed weights are only taken in the layout of the impl the layer acc selects, e.g. the weights packed
+// for another arch are packed again at init
+TEST(Tnn2CppTest, MismatchedPackedLayoutIsPackedAtInit) {
+    if (ConvertDeviceType(TNN2CPP_TEST_DEVICE) != DEVICE_ARM) {
+        GTEST_SKIP() << "only the arm accs take packed weights";
+    }
+    std::vector<float> ref_output, output;
+    PackedWeights packed_weights, unused;
+    ASSERT_NO_FATAL_FAILURE(ForwardConv(PackedWeights(), ref_output, packed_weights));
+    ASSERT_FALSE(packed_weights.layout.empty());
+    ASSERT_FALSE(packed_weights.buffers.empty());
+
+    // zeros in place of the packed weights, the conv only outputs the bias if they are taken
+    PackedWeights zero_weights = {packed_weights.layout, {}};
+    for (auto &buffer : packed_weights.buffers) {
+        RawBuffer zeros(buffer.GetBytesSize());
+        zeros.SetDataType(buffer.GetDataType());
+        zero_weights.buffers.push_back(zeros);
+    }
+    ASSERT_NO_FATAL_FAILURE(ForwardConv(zero_weights, output, unused));
+    ASSERT_EQ(output.size(), ref_output.size());
+    EXPECT_NE(memcmp(output.data(), ref_output.data(), output.size() * sizeof(float)), 0);
+
+    zero_weights.layout = "conv_common/another_arch/0";
+    ASSERT_NO_FATAL_FAILURE(ForwardConv(zero_weights, output, unused));
+    ASSERT_EQ(output.size(), ref_output.size());
+    EXPECT_EQ(memcmp(output.data(), ref_output.data(), output.size() * sizeof(float)), 0);
+
+    // the weights of another arch can not be packed again if the raw weights are dropped
+    zero_weights.repackable = false;
+    Status status;
+    ASSERT_NO_FATAL_FAILURE(ForwardConv(zero_weights, output, unused, &status));
+    EXPECT_NE((int)status, TNN_OK);
+}
+
+// the packed weights in the read-only data are used in place, not copied
+TEST(Tnn2CppTest, ReadOnlyPackedWeightsAreNotCopied) {
+    if (ConvertDeviceType(TNN2CPP_TEST_DEVICE) != DEVICE_ARM) {
+        GTEST_SKIP() << "only the arm accs take packed weights";
+    }
+    std::vector<float> ref_output, output;
+    PackedWeights packed_weights, layer_packed_weights;
+    ASSERT_NO_FATAL_FAILURE(ForwardConv(PackedWeights(), ref_output, packed_weights));
+    ASSERT_FALSE(packed_weights.buffers.empty());
+
+    PackedWeights views(packed_weights.layout, {}, false);
+    for (auto &buffer : packed_weights.buffers) {
+        RawBuffer view = RawBuffer::ReadOnlyView(buffer.GetBytesSize(), buffer.force_to<const char *>());
+        view.SetDataType(buffer.GetDataType());
+        views.buffers.push_back(view);
+    }
+    ASSERT_NO_FATAL_FAILURE(ForwardConv(views, output, layer_packed_weights));
+    ASSERT_EQ(output.size(), ref_output.size());
+    EXPECT_EQ(memcmp(output.data(), ref_output.data(), output.size() * sizeof(float)), 0);
+
+    ASSERT_EQ(layer_packed_weights.buffers.size(), views.buffers.size());
+    for (int i = 0; i < views.buffers.size(); i++) {
+        EXPECT_TRUE(layer_packed_weights.buffers[i].IsReadOnly());
+        EXPECT_EQ(layer_packed_weights.buffers[i].force_to<const char *>(), views.buffers[i].force_to<const char *>());
+    }
+}
+
+}  // namespace TNN_NS
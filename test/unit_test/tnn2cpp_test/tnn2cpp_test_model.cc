@@ -0,0 +1,42 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <stdio.h>
+
+#include "test/unit_test/net_test/net_test_utils.h"
+#include "test/unit_test/tnn2cpp_test/tnn2cpp_test_net.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+
+using namespace TNN_NS;
+
+// packs the test net of tnn2cpp_test into a tnn model, see test/unit_test/CMakeLists.txt
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s [tnnproto] [tnnmodel]\n", argv[0]);
+        return -1;
+    }
+
+    TestNetInterpreter interpreter;
+    Status status = interpreter.InterpretTestNet(g_tnn2cpp_test_proto);
+    if (status == TNN_OK) {
+        ModelPacker packer(interpreter.GetNetStructure(), interpreter.GetNetResource());
+        status = packer.Pack(argv[1], argv[2]);
+    }
+    if (status != TNN_OK) {
+        fprintf(stderr, "pack the test net failed: %s\n", status.description().c_str());
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TEST_UNIT_TEST_TNN2CPP_TEST_TNN2CPP_TEST_NET_H_
+#define TNN_TEST_UNIT_TEST_TNN2CPP_TEST_TNN2CPP_TEST_NET_H_
+
+namespace TNN_NS {
+
+// the test net is packed into a model by tnn2cpp_test_model, then tnn2cpp generates the compiled network
+// from it. the convs run the gemm, winograd, 1x1, depthwise and group impls of the arm device.
+static const char *g_tnn2cpp_test_proto =
+    "\"1 10 1 4206624770 ,\""
+    "\"data 1 8 16 16 ,\""
+    "\" c0 r0 c1 c2 c3 p0 c4 out data ,\""
+    "\"out ,\""
+    "\" 8 ,\""
+    "\"Convolution conv0 1 1 data c0 1 8 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"ReLU relu0 1 1 c0 r0 ,\""
+    "\"Convolution conv1 1 1 r0 c1 1 16 16 1 1 1 1 0 0 1 -1 1 1 0 ,\""
+    "\"Convolution conv2 1 1 c1 c2 16 16 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Convolution conv3 1 1 c2 c3 2 16 16 3 3 1 1 1 1 1 -1 1 1 0 ,\""
+    "\"Pooling pool0 1 1 c3 p0 0 2 2 2 2 0 0 -1 -1 -1 0 ,\""
+    "\"Convolution conv4 1 1 p0 c4 1 16 8 5 5 1 1 2 2 1 -1 1 1 0 ,\""
+    "\"Concat concat0 2 1 p0 c4 out 1 ,\"";
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_TNN2CPP_TEST_TNN2CPP_TEST_NET_H_
@@ -25,6 +25,7 @@ void ShowUsage() {
     printf("    -dt \"<device type>\"  %s \n", device_type_message);
     printf("    -lp \"<dependent library path>\"  %s \n", library_path_message);
     printf("    -ic \"<number>\"        %s \n", iterations_count_message);
+    printf("    -wc \"<number>\"        %s \n", warm_up_count_message);
     printf("    -ub \"<bool>\"          %s \n", unit_test_benchmark_message);
     printf("    -th \"<bumber>\"        %s \n", cpu_thread_num_message);
 }
@@ -0,0 +1,113 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <fstream>
+#include <sstream>
+
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(CommonSubexpressionElimination);
+
+std::string TnnOptimizeCommonSubexpressionEliminationPass::PassName() {
+    return "CommonSubexpressionElimination";
+}
+
+// the layer type, inputs, param and resource as saved in the tnn model, without the layer name.
+// empty if the layer can not be saved
+static std::string GetLayerKey(TNN_NS::LayerInfo& layer, TNN_NS::NetResource& net_resource) {
+    if (!layer.param) {
+        return "";
+    }
+    std::stringstream key;
+    key << layer.type_str << " " << layer.param->quantized << " " << layer.inputs.size() << " ";
+    for (const auto& input : layer.inputs) {
+        key << input << " ";
+    }
+    key << layer.outputs.size() << " ";
+
+    // the layers without interpreter, e.g. the activations, have neither param nor resource to save
+    auto resource_iter          = net_resource.resource_map.find(layer.name);
+    auto& layer_interpreter_map = TNN_NS::ModelInterpreter::GetLayerInterpreterMap();
+    auto interpreter_iter       = layer_interpreter_map.find(layer.type);
+    if (interpreter_iter == layer_interpreter_map.end() || interpreter_iter->second == nullptr) {
+        return resource_iter == net_resource.resource_map.end() ? key.str() : "";
+    }
+    auto layer_interpreter = interpreter_iter->second;
+
+    const auto layer_name = layer.param->name;
+    layer.param->name     = "";
+
+    std::stringbuf param_buffer;
+    std::ofstream param_stream;
+    param_stream.std::basic_ios<char>::rdbuf(&param_buffer);
+    auto status = layer_interpreter->SaveProto(param_stream, layer.param.get());
+    key << param_buffer.str() << " ";
+
+    if (status == TNN_NS::TNN_OK && resource_iter != net_resource.resource_map.end()) {
+        std::stringstream resource_stream;
+        TNN_NS::Serializer serializer(resource_stream);
+        status = layer_interpreter->SaveResource(serializer, layer.param.get(), resource_iter->second.get());
+        key << resource_stream.str();
+    }
+    layer.param->name = layer_name;
+    return status == TNN_NS::TNN_OK ? key.str() : "";
+}
+
+TNN_NS::Status TnnOptimizeCommonSubexpressionEliminationPass::exec(TNN_NS::NetStructure& net_structure,
+                                                                   TNN_NS::NetResource& net_resource) {
+    // merging two layers may make their consumers the same, repeat until nothing changes
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        std::map<std::string, std::shared_ptr<TNN_NS::LayerInfo>> layer_keys;
+        // copy, the duplicated layers are erased
+        auto layers = net_structure.layers;
+        for (auto& layer : layers) {
+            const auto key = GetLayerKey(*layer, net_resource);
+            if (key.empty()) {
+                continue;
+            }
+            auto key_iter = layer_keys.find(key);
+            if (key_iter == layer_keys.end()) {
+                layer_keys[key] = layer;
+                continue;
+            }
+            // the names of the model outputs are kept
+            bool is_model_output = false;
+            for (const auto& output_name : layer->outputs) {
+                is_model_output = is_model_output || net_structure.outputs.count(output_name) > 0;
+            }
+            if (is_model_output) {
+                continue;
+            }
+            auto& kept_layer = key_iter->second;
+            for (int i = 0; i < layer->outputs.size(); i++) {
+                ReplaceLayerInputs(net_structure, layer->outputs[i], kept_layer->outputs[i]);
+            }
+            EraseLayer(net_structure, net_resource, layer);
+            changed = true;
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(CommonSubexpressionElimination);
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,226 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(ConstantFolding);
+
+std::string TnnOptimizeConstantFoldingPass::PassName() {
+    return "ConstantFolding";
+}
+
+static bool IsFloatBuffer(TNN_NS::RawBuffer& buffer) {
+    return buffer.GetBytesSize() > 0 && buffer.GetDataType() == TNN_NS::DATA_TYPE_FLOAT;
+}
+
+// the constant is a scalar or has one value per output channel, i.e. broadcasts like [1, C, 1, 1]
+static bool IsChannelConstant(TNN_NS::RawBuffer& buffer, TNN_NS::DimsVector shape, int channels) {
+    if (!IsFloatBuffer(buffer)) {
+        return false;
+    }
+    const int count = buffer.GetDataCount();
+    if (count == 1) {
+        return true;
+    }
+    if (count != channels || shape.empty() || shape.size() > 4) {
+        return false;
+    }
+    shape.insert(shape.begin(), 4 - shape.size(), 1);
+    return shape[0] == 1 && shape[1] == channels && shape[2] == 1 && shape[3] == 1;
+}
+
+// y = x * scale + bias of the output channels, folded into the weights and bias of the producer
+struct ChannelAffine {
+    std::vector<float> scale;
+    std::vector<float> bias;
+};
+
+static bool GetChannelAffine(TNN_NS::LayerInfo& layer, TNN_NS::LayerResource* resource, int channels,
+                             ChannelAffine& affine) {
+    affine.scale.assign(channels, 1.0f);
+    affine.bias.assign(channels, 0.0f);
+    if (layer.inputs.size() != 1 || layer.outputs.size() != 1 || !resource || layer.param->quantized) {
+        return false;
+    }
+
+    if (layer.type == TNN_NS::LAYER_BATCH_NORM || layer.type == TNN_NS::LAYER_SCALE) {
+        auto bn_resource = dynamic_cast<TNN_NS::BatchNormLayerResource*>(resource);
+        if (!bn_resource || !IsChannelConstant(bn_resource->scale_handle, {1, channels}, channels)) {
+            return false;
+        }
+        const bool has_bias = bn_resource->bias_handle.GetBytesSize() > 0;
+        if (has_bias && !IsChannelConstant(bn_resource->bias_handle, {1, channels}, channels)) {
+            return false;
+        }
+        auto scale           = bn_resource->scale_handle.force_to<float*>();
+        auto bias            = bn_resource->bias_handle.force_to<float*>();
+        const int scale_step = bn_resource->scale_handle.GetDataCount() == 1 ? 0 : 1;
+        const int bias_step  = has_bias && bn_resource->bias_handle.GetDataCount() == 1 ? 0 : 1;
+        for (int c = 0; c < channels; c++) {
+            affine.scale[c] = scale[c * scale_step];
+            affine.bias[c]  = has_bias ? bias[c * bias_step] : 0.0f;
+        }
+        return true;
+    }
+
+    if (layer.type != TNN_NS::LAYER_MUL && layer.type != TNN_NS::LAYER_ADD && layer.type != TNN_NS::LAYER_SUB &&
+        layer.type != TNN_NS::LAYER_DIV) {
+        return false;
+    }
+    auto param            = dynamic_cast<TNN_NS::MultidirBroadcastLayerParam*>(layer.param.get());
+    auto eltwise_resource = dynamic_cast<TNN_NS::EltwiseLayerResource*>(resource);
+    if (!param || !eltwise_resource ||
+        !IsChannelConstant(eltwise_resource->element_handle, eltwise_resource->element_shape, channels)) {
+        return false;
+    }
+    // k - x and k / x are not affine in x
+    if (param->weight_input_index != 1 && (layer.type == TNN_NS::LAYER_SUB || layer.type == TNN_NS::LAYER_DIV)) {
+        return false;
+    }
+    auto element   = eltwise_resource->element_handle.force_to<float*>();
+    const int step = eltwise_resource->element_handle.GetDataCount() == 1 ? 0 : 1;
+    for (int c = 0; c < channels; c++) {
+        const float k = element[c * step];
+        if (layer.type == TNN_NS::LAYER_MUL) {
+            affine.scale[c] = k;
+        } else if (layer.type == TNN_NS::LAYER_ADD) {
+            affine.bias[c] = k;
+        } else if (layer.type == TNN_NS::LAYER_SUB) {
+            affine.bias[c] = -k;
+        } else {
+            if (k == 0.0f) {
+                return false;
+            }
+            affine.scale[c] = 1.0f / k;
+        }
+    }
+    return true;
+}
+
+static void FoldChannelAffine(TNN_NS::RawBuffer& weight, TNN_NS::RawBuffer& bias, int channels,
+                              const ChannelAffine& affine) {
+    if (bias.GetBytesSize() == 0) {
+        bias = TNN_NS::RawBuffer(channels * sizeof(float));
+        bias.SetDataType(TNN_NS::DATA_TYPE_FLOAT);
+    }
+    auto weight_data       = weight.force_to<float*>();
+    auto bias_data         = bias.force_to<float*>();
+    const int channel_size = weight.GetDataCount() / channels;
+    for (int c = 0; c < channels; c++) {
+        auto channel_weight = weight_data + c * channel_size;
+        for (int i = 0; i < channel_size; i++) {
+            channel_weight[i] *= affine.scale[c];
+        }
+        bias_data[c] = bias_data[c] * affine.scale[c] + affine.bias[c];
+    }
+}
+
+// fold the constant per channel Mul/Add/Sub/Div, BatchNorm and Scale following a Convolution or InnerProduct
+// into its weights, the float weights are evaluated here once instead of on every forward
+static bool FoldIntoProducer(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                             std::shared_ptr<TNN_NS::LayerInfo> layer) {
+    auto& resource_map = net_resource.resource_map;
+    if (layer->outputs.size() != 1 || layer->param->quantized || resource_map.count(layer->name) == 0) {
+        return false;
+    }
+    const auto& output_name = layer->outputs[0];
+    if (net_structure.outputs.count(output_name) > 0 || GetBlobConsumerCount(net_structure, output_name) != 1) {
+        return false;
+    }
+    std::shared_ptr<TNN_NS::LayerInfo> follower = nullptr;
+    for (const auto& candidate : net_structure.layers) {
+        if (candidate->inputs.size() == 1 && candidate->inputs[0] == output_name) {
+            follower = candidate;
+            break;
+        }
+    }
+    if (!follower || resource_map.count(follower->name) == 0) {
+        return false;
+    }
+
+    TNN_NS::RawBuffer* weight = nullptr;
+    TNN_NS::RawBuffer* bias   = nullptr;
+    int channels              = 0;
+    if (layer->type == TNN_NS::LAYER_CONVOLUTION) {
+        auto param    = dynamic_cast<TNN_NS::ConvLayerParam*>(layer->param.get());
+        auto resource = dynamic_cast<TNN_NS::ConvLayerResource*>(resource_map[layer->name].get());
+        // the activation is applied before the follower
+        if (!param || !resource || param->activation_type != TNN_NS::ActivationType_None) {
+            return false;
+        }
+        weight   = &resource->filter_handle;
+        bias     = &resource->bias_handle;
+        channels = param->output_channel;
+    } else if (layer->type == TNN_NS::LAYER_INNER_PRODUCT) {
+        auto param    = dynamic_cast<TNN_NS::InnerProductLayerParam*>(layer->param.get());
+        auto resource = dynamic_cast<TNN_NS::InnerProductLayerResource*>(resource_map[layer->name].get());
+        if (!param || !resource || param->transpose != 0) {
+            return false;
+        }
+        weight   = &resource->weight_handle;
+        bias     = &resource->bias_handle;
+        channels = param->num_output;
+    } else {
+        return false;
+    }
+    if (channels <= 0 || !IsFloatBuffer(*weight) || weight->GetDataCount() % channels != 0) {
+        return false;
+    }
+    if (bias->GetBytesSize() > 0 && (!IsFloatBuffer(*bias) || bias->GetDataCount() != channels)) {
+        return false;
+    }
+
+    ChannelAffine affine;
+    if (!GetChannelAffine(*follower, resource_map[follower->name].get(), channels, affine)) {
+        return false;
+    }
+    FoldChannelAffine(*weight, *bias, channels, affine);
+    if (layer->type == TNN_NS::LAYER_CONVOLUTION) {
+        dynamic_cast<TNN_NS::ConvLayerParam*>(layer->param.get())->bias = 1;
+    } else {
+        dynamic_cast<TNN_NS::InnerProductLayerParam*>(layer->param.get())->has_bias = 1;
+    }
+
+    // the producer writes the output of the follower directly
+    auto follower_output = follower->outputs[0];
+    EraseLayer(net_structure, net_resource, follower);
+    net_structure.blobs.erase(output_name);
+    net_structure.blobs.insert(follower_output);
+    layer->outputs[0] = follower_output;
+    return true;
+}
+
+TNN_NS::Status TnnOptimizeConstantFoldingPass::exec(TNN_NS::NetStructure& net_structure,
+                                                    TNN_NS::NetResource& net_resource) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        // copy, folding erases layers. an erased follower has no resource left and is skipped
+        auto layers = net_structure.layers;
+        for (auto& layer : layers) {
+            changed = FoldIntoProducer(net_structure, net_resource, layer) || changed;
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(ConstantFolding);
+}  // namespace TNN_CONVERTER
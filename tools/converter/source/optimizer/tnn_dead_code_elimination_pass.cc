@@ -0,0 +1,55 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <set>
+
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(DeadCodeElimination);
+
+std::string TnnOptimizeDeadCodeEliminationPass::PassName() {
+    return "DeadCodeElimination";
+}
+
+TNN_NS::Status TnnOptimizeDeadCodeEliminationPass::exec(TNN_NS::NetStructure& net_structure,
+                                                        TNN_NS::NetResource& net_resource) {
+    // walk the layers backwards from the model outputs, a layer is live if any of its outputs is read
+    std::set<std::string> live_blobs = net_structure.outputs;
+    std::vector<std::shared_ptr<TNN_NS::LayerInfo>> dead_layers;
+    auto& layers = net_structure.layers;
+    for (auto iter = layers.rbegin(); iter != layers.rend(); iter++) {
+        auto& layer  = *iter;
+        bool is_live = false;
+        for (const auto& output_name : layer->outputs) {
+            is_live = is_live || live_blobs.count(output_name) > 0;
+        }
+        if (!is_live) {
+            dead_layers.push_back(layer);
+            continue;
+        }
+        live_blobs.insert(layer->inputs.begin(), layer->inputs.end());
+    }
+    for (auto& layer : dead_layers) {
+        LOGD("DeadCodeElimination: erase layer %s\n", layer->name.c_str());
+        EraseLayer(net_structure, net_resource, layer);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(DeadCodeElimination);
+}  // namespace TNN_CONVERTER
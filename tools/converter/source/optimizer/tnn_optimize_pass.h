@@ -20,6 +20,12 @@
 
 namespace TNN_CONVERTER {
 
+struct TnnOptimizeOptions {
+    // the model only runs with the input shapes it is converted with, the layers which are identities
+    // at these shapes are removed
+    bool fixed_shape = false;
+};
+
 class TnnOptimizePass {
 public:
     TnnOptimizePass()          = default;
@@ -27,6 +33,13 @@ public:
 
     virtual TNN_NS::Status exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) = 0;
     virtual std::string PassName()                                                                      = 0;
+
+    void SetOptions(const TnnOptimizeOptions& options) {
+        options_ = options;
+    }
+
+protected:
+    TnnOptimizeOptions options_;
 };
 
 class TnnOptimizePassManager {
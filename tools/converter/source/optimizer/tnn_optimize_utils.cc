@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn_optimize_utils.h"
+
+#include <algorithm>
+
+#include "tnn/interpreter/tnn/objseri.h"
+
+namespace TNN_CONVERTER {
+
+int GetBlobConsumerCount(TNN_NS::NetStructure& net_structure, const std::string& blob_name) {
+    int count = 0;
+    for (const auto& layer : net_structure.layers) {
+        count += (int)std::count(layer->inputs.begin(), layer->inputs.end(), blob_name);
+    }
+    return count;
+}
+
+void ReplaceLayerInputs(TNN_NS::NetStructure& net_structure, const std::string& old_name, const std::string& new_name) {
+    for (const auto& layer : net_structure.layers) {
+        std::replace(layer->inputs.begin(), layer->inputs.end(), old_name, new_name);
+    }
+}
+
+void RenameBlob(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource, const std::string& old_name,
+                const std::string& new_name) {
+    for (const auto& layer : net_structure.layers) {
+        std::replace(layer->inputs.begin(), layer->inputs.end(), old_name, new_name);
+        std::replace(layer->outputs.begin(), layer->outputs.end(), old_name, new_name);
+    }
+    if (net_structure.outputs.erase(old_name) > 0) {
+        net_structure.outputs.insert(new_name);
+    }
+    if (net_structure.blobs.erase(old_name) > 0) {
+        net_structure.blobs.insert(new_name);
+    }
+    auto& resource_map = net_resource.resource_map;
+    auto scale_iter    = resource_map.find(old_name + BLOB_SCALE_SUFFIX);
+    if (scale_iter != resource_map.end()) {
+        auto blob_scale = scale_iter->second;
+        resource_map.erase(scale_iter);
+        resource_map[new_name + BLOB_SCALE_SUFFIX] = blob_scale;
+    }
+}
+
+void EraseLayer(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                std::shared_ptr<TNN_NS::LayerInfo> layer) {
+    auto& resource_map = net_resource.resource_map;
+    resource_map.erase(layer->name);
+    for (const auto& output_name : layer->outputs) {
+        resource_map.erase(output_name + BLOB_SCALE_SUFFIX);
+        net_structure.blobs.erase(output_name);
+    }
+    auto& layers = net_structure.layers;
+    layers.erase(std::remove(layers.begin(), layers.end(), layer), layers.end());
+}
+
+}  // namespace TNN_CONVERTER
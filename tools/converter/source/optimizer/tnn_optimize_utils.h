@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_UTILS_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_UTILS_H_
+#include <string>
+
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_CONVERTER {
+
+// number of layers reading the blob, a layer reading it twice counts twice
+int GetBlobConsumerCount(TNN_NS::NetStructure& net_structure, const std::string& blob_name);
+
+// let the consumers of old_name read new_name instead
+void ReplaceLayerInputs(TNN_NS::NetStructure& net_structure, const std::string& old_name, const std::string& new_name);
+
+// rename the blob in its producer, consumers, model outputs and blob scale
+void RenameBlob(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource, const std::string& old_name,
+                const std::string& new_name);
+
+// remove the layer from the net with its resource and the blobs it produces
+void EraseLayer(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                std::shared_ptr<TNN_NS::LayerInfo> layer);
+
+}  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_UTILS_H_
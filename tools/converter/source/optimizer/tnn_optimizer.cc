@@ -19,13 +19,16 @@
 namespace TNN_CONVERTER {
 
 TNN_NS::Status TnnOptimizer::Optimize(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) {
-    std::vector<std::string> optimize_pass = {"EliminateUnusefulNode", "TransformReduceMean"};
+    std::vector<std::string> optimize_pass = {"EliminateUnusefulNode", "TransformReduceMean", "ConstantFolding",
+                                              "ShapeFolding", "CommonSubexpressionElimination",
+                                              "DeadCodeElimination"};
     for (auto pass_name : optimize_pass) {
         auto pass = TnnOptimizePassManager::get()->search(pass_name);
         if (pass == nullptr) {
             LOGE("Unsupport optimize pass %s\n", pass_name.c_str());
             return TNN_NS::TNNERR_CONVERT_UNSUPPORT_PASS;
         }
+        pass->SetOptions(options_);
         pass->exec(net_structure, net_resource);
     }
     return TNN_NS::TNN_CONVERT_OK;
@@ -17,13 +17,17 @@
 #include "tnn/core/status.h"
 #include "tnn/interpreter/net_resource.h"
 #include "tnn/interpreter/net_structure.h"
+#include "tnn_optimize_pass.h"
 
 namespace TNN_CONVERTER {
 class TnnOptimizer {
 public:
-    TnnOptimizer(){};
+    TnnOptimizer(const TnnOptimizeOptions& options = TnnOptimizeOptions()) : options_(options){};
     ~TnnOptimizer(){};
     TNN_NS::Status Optimize(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource);
+
+private:
+    TnnOptimizeOptions options_;
 };
 }  // namespace TNN_CONVERTER
 
@@ -0,0 +1,186 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <memory>
+
+#include "tnn/core/blob.h"
+#include "tnn/layer/base_layer.h"
+#include "tnn_optimize_pass.h"
+#include "tnn_optimize_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(ShapeFolding);
+
+std::string TnnOptimizeShapeFoldingPass::PassName() {
+    return "ShapeFolding";
+}
+
+// propagate the static input shapes with the shape inference of the runtime layers. blobs after a layer whose
+// shape can not be inferred are left out. InferOutputShape fills the derived fields of the params (e.g. the pads
+// of SAME padding) the same way the runtime does, so the saved params do not change.
+static std::map<std::string, TNN_NS::DimsVector> InferBlobShapes(TNN_NS::NetStructure& net_structure,
+                                                                 TNN_NS::NetResource& net_resource) {
+    std::map<std::string, TNN_NS::DimsVector> blob_shapes;
+    std::map<std::string, std::shared_ptr<TNN_NS::Blob>> blobs;
+    auto create_blob = [&](const std::string& name, const TNN_NS::DimsVector& dims) {
+        TNN_NS::BlobDesc desc;
+        desc.device_type = TNN_NS::DEVICE_NAIVE;
+        desc.data_type   = TNN_NS::DATA_TYPE_FLOAT;
+        desc.name        = name;
+        desc.dims        = dims;
+        blobs[name]      = std::make_shared<TNN_NS::Blob>(desc);
+    };
+    for (const auto& iter : net_structure.inputs_shape_map) {
+        if (iter.second.empty() || *std::min_element(iter.second.begin(), iter.second.end()) <= 0) {
+            continue;
+        }
+        create_blob(iter.first, iter.second);
+        blob_shapes[iter.first] = iter.second;
+    }
+
+    for (const auto& layer_info : net_structure.layers) {
+        std::vector<TNN_NS::Blob*> inputs;
+        for (const auto& name : layer_info->inputs) {
+            if (blobs.count(name) > 0) {
+                inputs.push_back(blobs[name].get());
+            }
+        }
+        std::shared_ptr<TNN_NS::BaseLayer> layer(TNN_NS::CreateLayer(layer_info->type));
+        if (!layer || inputs.size() != layer_info->inputs.size() || layer_info->outputs.empty()) {
+            continue;
+        }
+        std::vector<TNN_NS::Blob*> outputs;
+        for (const auto& name : layer_info->outputs) {
+            create_blob(name, {});
+            outputs.push_back(blobs[name].get());
+        }
+        layer->SetLayerName(layer_info->name);
+        auto resource_iter = net_resource.resource_map.find(layer_info->name);
+        auto resource = resource_iter != net_resource.resource_map.end() ? resource_iter->second.get() : nullptr;
+        layer->InferShapeAhead(inputs, outputs, layer_info->param.get(), resource);
+
+        for (auto output : outputs) {
+            auto dims = output->GetBlobDesc().dims;
+            if (dims.empty() || *std::min_element(dims.begin(), dims.end()) <= 0) {
+                blobs.erase(output->GetBlobDesc().name);
+                continue;
+            }
+            blob_shapes[output->GetBlobDesc().name] = dims;
+        }
+    }
+    return blob_shapes;
+}
+
+// the output is the input whatever the input shapes are
+static bool IsIdentityForAllShapes(TNN_NS::LayerInfo& layer) {
+    switch (layer.type) {
+        case TNN_NS::LAYER_CONCAT:
+            return true;
+        case TNN_NS::LAYER_UPSAMPLE: {
+            auto param = dynamic_cast<TNN_NS::UpsampleLayerParam*>(layer.param.get());
+            return param && param->dims.empty() && !param->scales.empty() &&
+                   std::all_of(param->scales.begin(), param->scales.end(), [](float s) { return s == 1.0f; });
+        }
+        case TNN_NS::LAYER_PAD: {
+            // negative pads crop, a crop and a pad of the same size keep the shape but not the data
+            auto param = dynamic_cast<TNN_NS::PadLayerParam*>(layer.param.get());
+            return param && std::all_of(param->pads.begin(), param->pads.end(), [](int p) { return p == 0; });
+        }
+        case TNN_NS::LAYER_PERMUTE: {
+            auto param = dynamic_cast<TNN_NS::PermuteLayerParam*>(layer.param.get());
+            if (!param) {
+                return false;
+            }
+            for (int i = 0; i < param->orders.size(); i++) {
+                if (param->orders[i] != i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// the output is the input at the shapes the model is converted with, e.g. a reshape to the fixed input shape
+static bool IsIdentityForFixedShapes(TNN_NS::LayerInfo& layer) {
+    switch (layer.type) {
+        case TNN_NS::LAYER_RESHAPE:
+        case TNN_NS::LAYER_FLATTEN:
+        case TNN_NS::LAYER_UPSAMPLE:
+            return true;
+        case TNN_NS::LAYER_STRIDED_SLICE: {
+            // a negative stride reverses the data
+            auto param = dynamic_cast<TNN_NS::StrideSliceLayerParam*>(layer.param.get());
+            return param && std::all_of(param->strides.begin(), param->strides.end(), [](int s) { return s == 1; });
+        }
+        default:
+            return IsIdentityForAllShapes(layer);
+    }
+}
+
+static bool IsIdentityLayer(TNN_NS::LayerInfo& layer, const std::map<std::string, TNN_NS::DimsVector>& blob_shapes,
+                            bool fixed_shape) {
+    if (layer.inputs.size() != 1 || layer.outputs.size() != 1 || layer.param->quantized) {
+        return false;
+    }
+    if (!fixed_shape) {
+        return IsIdentityForAllShapes(layer);
+    }
+
+    auto input_iter  = blob_shapes.find(layer.inputs[0]);
+    auto output_iter = blob_shapes.find(layer.outputs[0]);
+    if (input_iter == blob_shapes.end() || output_iter == blob_shapes.end() ||
+        input_iter->second != output_iter->second) {
+        return false;
+    }
+    return IsIdentityForFixedShapes(layer);
+}
+
+TNN_NS::Status TnnOptimizeShapeFoldingPass::exec(TNN_NS::NetStructure& net_structure,
+                                                 TNN_NS::NetResource& net_resource) {
+    // the shapes are only used if the model is converted for its fixed input shapes
+    std::map<std::string, TNN_NS::DimsVector> blob_shapes;
+    if (options_.fixed_shape) {
+        blob_shapes = InferBlobShapes(net_structure, net_resource);
+    }
+    // copy, the identity layers are erased
+    auto layers = net_structure.layers;
+    for (auto& layer : layers) {
+        if (!IsIdentityLayer(*layer, blob_shapes, options_.fixed_shape)) {
+            continue;
+        }
+        const auto input_name  = layer->inputs[0];
+        const auto output_name = layer->outputs[0];
+        if (net_structure.outputs.count(output_name) == 0) {
+            ReplaceLayerInputs(net_structure, output_name, input_name);
+            EraseLayer(net_structure, net_resource, layer);
+            continue;
+        }
+        // keep the name of the model output, the producer of the input writes it directly
+        if (net_structure.inputs_shape_map.count(input_name) > 0 || net_structure.outputs.count(input_name) > 0) {
+            continue;
+        }
+        EraseLayer(net_structure, net_resource, layer);
+        RenameBlob(net_structure, net_resource, input_name, output_name);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(ShapeFolding);
+}  // namespace TNN_CONVERTER
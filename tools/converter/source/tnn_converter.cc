@@ -42,7 +42,9 @@ int Run(int argc, char* argv[]) {
         return status;
     }
     // TODO optimize the model
-    TnnOptimizer tnn_optimizer;
+    TnnOptimizeOptions optimize_options;
+    optimize_options.fixed_shape = FLAGS_fs;
+    TnnOptimizer tnn_optimizer(optimize_options);
     status = tnn_optimizer.Optimize(net_structure, net_resource);
     if (status != TNN_NS::TNN_CONVERT_OK) {
         LOGE("Converter: optimize %s failed!\n", FLAGS_mp.c_str());
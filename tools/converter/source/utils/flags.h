@@ -26,6 +26,9 @@ static const char output_dir_message[] = "specify output path: <the>/<path>/<to>
 
 static const char model_type_message[] = "specify model type: Caffe, TF, TFLite.";
 
+static const char fixed_shape_message[] =
+    "the model only runs with its input shapes, remove the layers which do not change the data at these shapes.";
+
 DECLARE_bool(h);
 
 DECLARE_string(mp);
@@ -34,6 +37,8 @@ DECLARE_string(od);
 
 DECLARE_string(mt);
 
+DECLARE_bool(fs);
+
 }  // namespace TNN_CONVERTER
 
 #endif  // TNNCONVERTER_SRC_FLAGS_H_
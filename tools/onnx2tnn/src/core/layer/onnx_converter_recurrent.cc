@@ -0,0 +1,153 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_converter_recurrent.h"
+
+// the input of a node, empty if omitted
+static std::string NodeInput(NodeProto &node, int index) {
+    return index < node.input_size() ? node.input(index) : std::string();
+}
+
+// the constant initial states are not inputs of the layer, only zeros are supported
+static bool IsZeroWeight(const std::string &name, OnnxNetInfo &net_info) {
+    const onnx::TensorProto &tensor = net_info.weights_map[name];
+    const float *data               = get_tensor_proto_data(tensor);
+    int size                        = get_tensor_proto_data_size(tensor);
+    for (int i = 0; i < size; i++) {
+        if (data[i] != 0.f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+string OnnxConverterRecurrent::TNNLayerParam(NodeProto &node,
+                                             OnnxNetInfo &net_info) {
+    const std::string &onnx_op = node.op_type();
+    ostringstream layer_param;
+
+    const bool is_lstm      = onnx_op == "LSTM";
+    int hidden_size         = (int)get_node_attr_i(node, "hidden_size", 0);
+    std::string direction_s = get_node_attr_s(node, "direction", "forward");
+    int direction           = 0;
+    if (direction_s == "reverse") {
+        direction = 1;
+    } else if (direction_s == "bidirectional") {
+        direction = 2;
+    }
+
+    // the default activations only
+    std::vector<std::string> activations = {"Sigmoid", "Tanh"};
+    if (is_lstm) {
+        activations.push_back("Tanh");
+    }
+    for (int i = 0; i < node.attribute_size(); i++) {
+        const onnx::AttributeProto &attr = node.attribute(i);
+        if (attr.name() != "activations") {
+            continue;
+        }
+        for (int j = 0; j < attr.strings_size(); j++) {
+            if (attr.strings(j) != activations[j % activations.size()]) {
+                DLog("error::%s convert failed: unsupported activation %s\n",
+                     onnx_op.c_str(), attr.strings(j).c_str());
+                assert(0);
+            }
+        }
+    }
+    if (get_node_attr_f(node, "clip", 0.f) != 0.f ||
+        get_node_attr_i(node, "input_forget", 0) != 0 ||
+        get_node_attr_i(node, "layout", 0) != 0) {
+        DLog("error::%s convert failed: clip, input_forget and layout are "
+             "not supported\n",
+             onnx_op.c_str());
+        assert(0);
+    }
+
+    // X, W, R, B, sequence_lens, initial_h, initial_c, P
+    // the layer always runs the whole sequence, the static sequence length
+    // is unknown here to check the lengths against it
+    if (!NodeInput(node, 4).empty()) {
+        DLog("error::%s convert failed: sequence_lens is not supported\n",
+             onnx_op.c_str());
+        assert(0);
+    }
+    if (!NodeInput(node, 7).empty()) {
+        DLog("error::%s convert failed: peepholes are not supported\n",
+             onnx_op.c_str());
+        assert(0);
+    }
+    // the initial states follow x in the layer inputs
+    bool state_omitted = false;
+    for (int i = 5; i < (is_lstm ? 7 : 6); i++) {
+        const std::string state = NodeInput(node, i);
+        bool is_weight          = net_info.weights_map.find(state) !=
+                         net_info.weights_map.end();
+        if (is_weight && !IsZeroWeight(state, net_info)) {
+            DLog("error::%s convert failed: the constant initial states must "
+                 "be zeros\n",
+                 onnx_op.c_str());
+            assert(0);
+        }
+        if (!state.empty() && !is_weight && state_omitted) {
+            DLog("error::%s convert failed: initial_c without initial_h\n",
+                 onnx_op.c_str());
+            assert(0);
+        }
+        state_omitted = state.empty() || is_weight;
+    }
+
+    layer_param << hidden_size << " " << direction << " ";
+    if (!is_lstm) {
+        layer_param << get_node_attr_i(node, "linear_before_reset", 0) << " ";
+    }
+    return layer_param.str();
+}
+
+int OnnxConverterRecurrent::WriteTNNModel(serializer *net_writer,
+                                          NodeProto &node,
+                                          OnnxNetInfo &net_info) {
+    const std::string &onnx_op = node.op_type();
+    std::string name = !node.name().empty() ? node.name() : node.output(0);
+    const std::string &tnn_layer_type = TNNOpType(node, net_info);
+
+    //写头信息
+    net_writer->put_int(0);  //触发type from string
+    net_writer->put_string(tnn_layer_type);
+    net_writer->put_string(name);
+
+    //写数据
+    net_writer->put_string(name);
+    auto W = get_node_attr_tensor(node, "W", net_info, 1);
+    auto R = get_node_attr_tensor(node, "R", net_info, 2);
+    WriteTensorData(W, net_writer, net_info.data_type);
+    WriteTensorData(R, net_writer, net_info.data_type);
+
+    // B is optional, [direction][2 * gates * hidden]
+    if (!NodeInput(node, 3).empty()) {
+        auto B = get_node_attr_tensor(node, "B", net_info, 3);
+        WriteTensorData(B, net_writer, net_info.data_type);
+    } else {
+        int bias_count = (int)W.dims(0) * 2 * (int)W.dims(1);
+        std::vector<float> bias(bias_count, 0.0f);
+        WriteRawData(bias.data(), bias_count, net_writer, net_info.data_type);
+    }
+
+    //有权值写入的返回1， 没有的返回0
+    return 1;
+}
+
+REGISTER_OP_CONVERTER_RECURRENT(Lstm, LSTM);
+
+REGISTER_OP_CONVERTER_RECURRENT(Gru, GRU);
@@ -35,7 +35,8 @@ string OnnxOpConverter::TNNLayerProto(NodeProto &node,
 
     for (int j = 0; j < (int)node.input_size(); j++) {
         const std::string &input_name = node.input(j);
-        if (net_info.weights_map.find(input_name) !=
+        // the omitted optional inputs are empty
+        if (input_name.empty() || net_info.weights_map.find(input_name) !=
             net_info.weights_map.end()) {
             input_size--;
         }
@@ -46,7 +47,7 @@ string OnnxOpConverter::TNNLayerProto(NodeProto &node,
         std::string input_name = node.input(j);
 
         // check weight
-        if (net_info.weights_map.find(input_name) !=
+        if (input_name.empty() || net_info.weights_map.find(input_name) !=
             net_info.weights_map.end()) {
             continue;
         }
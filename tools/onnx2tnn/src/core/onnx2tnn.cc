@@ -448,13 +448,28 @@ int Onnx2TNN::OnnxExtractBlobWeights() {
                     // }
                 }
             }
+        } else if (onnx_op == "LSTM" || onnx_op == "GRU") {
+            // the recurrent layers write all their outputs, the omitted ones get names of their own
+            onnx::NodeProto* mutable_node = mutable_graph->mutable_node(i);
+            const int output_count        = onnx_op == "LSTM" ? 3 : 2;
+            if (name.empty()) {
+                name = onnx_op + "_" + std::to_string(i);
+            }
+            while (mutable_node->output_size() < output_count) {
+                mutable_node->add_output("");
+            }
+            for (int j = 0; j < output_count; j++) {
+                if (mutable_node->output(j).empty()) {
+                    mutable_node->set_output(j, name + "_output_" + std::to_string(j));
+                }
+            }
         }
 
         for (int j = 0; j < (int)node.input_size(); j++) {
             const std::string& input_name = node.input(j);
 
-            // check weight
-            if (weights.find(input_name) != weights.end()) {
+            // check weight, the omitted optional inputs are empty
+            if (input_name.empty() || weights.find(input_name) != weights.end()) {
                 continue;
             }
 
@@ -21,6 +21,7 @@
 #include "tnn/interpreter/tnn/objseri.h"
 #include "tnn/interpreter/tnn/model_packer.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/weight_quant_utils.h"
 
 namespace TNN_NS {
 
@@ -177,6 +178,41 @@ Status Calibration::RunCalibration(DataSet& dataset) {
     return TNN_OK;
 }
 
+Status Calibration::QuantizeWeightsOnly(int bits, int group_size) {
+    NetStructure* net_struct  = interpreter_->GetNetStructure();
+    NetResource* net_resource = interpreter_->GetNetResource();
+    if (net_struct == nullptr || net_resource == nullptr) {
+        LOGE("net struct or net resource is null\n");
+        return TNNERR_INVALID_MODEL;
+    }
+
+    for (auto& layer_info : net_struct->layers) {
+        if (layer_info->type != LAYER_CONVOLUTION && layer_info->type != LAYER_DECONVOLUTION &&
+            layer_info->type != LAYER_INNER_PRODUCT) {
+            continue;
+        }
+        auto resource_iter = net_resource->resource_map.find(layer_info->name);
+        if (resource_iter == net_resource->resource_map.end()) {
+            continue;
+        }
+        LayerParam* param       = layer_info->param.get();
+        LayerResource* resource = resource_iter->second.get();
+        Status status = WeightQuantUtils::QuantizeLayerResource(param, resource, bits, group_size);
+        if (status != TNN_OK && group_size > 0) {
+            // the group does not divide the weights of an output channel
+            printf("layer %s: %s, quantize per output channel\n", layer_info->name.c_str(),
+                   status.description().c_str());
+            status = WeightQuantUtils::QuantizeLayerResource(param, resource, bits, 0);
+        }
+        if (status != TNN_OK) {
+            LOGE("quantize weights of layer %s falied!\n", layer_info->name.c_str());
+            return status;
+        }
+    }
+
+    return TNN_OK;
+}
+
 Status Calibration::Serialize(std::string proto_path, std::string model_path) {
     NetStructure* net_struct  = interpreter_->GetNetStructure();
     NetResource* net_resource = interpreter_->GetNetResource();
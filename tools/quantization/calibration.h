@@ -51,6 +51,12 @@ public:
     // @param dataset calibration inputs
     Status RunCalibration(DataSet& dataset);
 
+    // @brief quantize the weights of Convolution, Deconvolution and InnerProduct
+    // layers only, the blobs stay float and no dataset is needed.
+    // @param bits 8 or 4
+    // @param group_size weights sharing one scale, 0 for one scale per output channel
+    Status QuantizeWeightsOnly(int bits, int group_size);
+
     // @brief int net with network config, net structure and net resource info
     // @param proto_path, file path to save the quantized proto.
     // @param model_path, file path to save the quantized model.
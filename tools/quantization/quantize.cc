@@ -167,7 +167,7 @@ bool CheckNumberString(std::string num_str) {
 void PrintConfig() {
     printf(
         "usage:\n./quantization_cmd [-h] [-p] [-m] [-i] [-b] [-w] [-n] [-s] "
-        "[-c]\n"
+        "[-c] [-q] [-g]\n"
         "\t-h, --help        \t show this message\n"
         "\t-p, --proto       \t(require) tnn proto file name\n"
         "\t-m, --model       \t(require) tnn model file name\n"
@@ -186,7 +186,13 @@ void PrintConfig() {
         "1.0,1.0,1.0 \n"
         "\t\tformula: y = (x - bias) * scale\n"
         "\t-c, --merge_channel\t(optional) merge blob channel when quantize "
-        "blob\n");
+        "blob\n"
+        "\t-q, --weight_bits  \t(optional) quantize the weights only, the "
+        "blobs stay float and -i is not needed\n"
+        "\t\t8: int8\n"
+        "\t\t4: int4\n"
+        "\t-g, --group_size   \t(optional) weights sharing one scale when "
+        "quantize the weights only, 0: one scale per output channel (default)\n");
 }
 
 int main(int argc, char* argv[]) {
@@ -194,6 +200,8 @@ int main(int argc, char* argv[]) {
     std::string proto_file_name;
     std::string model_file_name;
     std::string input_path;
+    int weight_bits = 0;
+    int group_size  = 0;
 
     CalibrationParam cali_params;
     cali_params.blob_quantize_method    = MIN_MAX;
@@ -210,10 +218,12 @@ int main(int argc, char* argv[]) {
                                     {"bias", required_argument, 0, 'n'},
                                     {"scale", required_argument, 0, 's'},
                                     {"merge_channel", no_argument, 0, 'c'},
+                                    {"weight_bits", required_argument, 0, 'q'},
+                                    {"group_size", required_argument, 0, 'g'},
                                     {"help", no_argument, 0, 'h'},
                                     {0, 0, 0, 0}};
 
-    const char* optstring = "p:m:i:b:w:n:s:ch";
+    const char* optstring = "p:m:i:b:w:n:s:cq:g:h";
 
     if (argc == 1) {
         PrintConfig();
@@ -276,6 +286,18 @@ int main(int argc, char* argv[]) {
                 printf("merge channel: true\n");
                 cali_params.merge_blob_channel = true;
                 break;
+            case 'q':
+                printf("weight bits: %s\n", optarg);
+                weight_bits = atoi(optarg);
+                if (weight_bits != 8 && weight_bits != 4) {
+                    printf("invalid weight bits: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            case 'g':
+                printf("group size: %s\n", optarg);
+                group_size = atoi(optarg);
+                break;
             case 'h':
             case '?':
                 PrintConfig();
@@ -293,6 +315,27 @@ int main(int argc, char* argv[]) {
 
     NetworkConfig net_config;
     net_config.device_type = DEVICE_NAIVE;
+    if (weight_bits > 0) {
+        Calibration calibration;
+        Status status = calibration.Init(net_config, model_config);
+        if (status != TNN_OK) {
+            printf("calibration init falied!\n");
+            return -1;
+        }
+        status = calibration.QuantizeWeightsOnly(weight_bits, group_size);
+        if (status != TNN_OK) {
+            printf("quantize weights falied!\n");
+            return -1;
+        }
+        status = calibration.Serialize("model_quantized.tnnproto", "model_quantized.tnnmodel");
+        if (status != TNN_OK) {
+            printf("calibration serialize falied!\n");
+            return -1;
+        }
+        printf("quantize model weights success!\n");
+        return 0;
+    }
+
     DataSet dataset;
     ret = ImportDataSet(dataset, input_path);
     if (CheckResult("import data set", ret) != true)
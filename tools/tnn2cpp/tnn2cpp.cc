@@ -0,0 +1,664 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/core/compiled_network.h"
+#include "tnn/core/default_network.h"
+#include "tnn/interpreter/abstract_model_interpreter.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/optimizer/net_optimizer_insert_fallback_reformat.h"
+
+using namespace TNN_NS;
+
+static std::string PathtoVarname(const char* path) {
+    const char* lastslash = strrchr(path, '/');
+    const char* name      = lastslash == NULL ? path : lastslash + 1;
+
+    std::string varname = name;
+    for (auto& c : varname) {
+        if (!isalnum(c)) {
+            c = '_';
+        }
+    }
+    return varname;
+}
+
+static bool ReadFile(const char* path, std::string& content) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        fprintf(stderr, "open %s failed\n", path);
+        return false;
+    }
+    content = std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// floats are printed with 9 significant digits, which round trips every float value
+static std::string FloatLiteral(float value) {
+    if (std::isnan(value)) {
+        return "std::numeric_limits<float>::quiet_NaN()";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "std::numeric_limits<float>::infinity()" : "-std::numeric_limits<float>::infinity()";
+    }
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.9gf", value);
+    std::string literal = buf;
+    if (literal.find_first_of(".en") == std::string::npos) {
+        literal.insert(literal.size() - 1, ".");
+    }
+    return literal;
+}
+
+static std::string StringLiteral(const std::string& value) {
+    std::string literal = "\"";
+    for (auto c : value) {
+        if (c == '"' || c == '\\') {
+            literal += '\\';
+        }
+        literal += c;
+    }
+    return literal + "\"";
+}
+
+// writes the fields of a layer param as assignments to the generated param
+class ParamWriter {
+public:
+    explicit ParamWriter(std::ostream& os) : os_(os) {}
+
+    void Field(const char* name, int value) {
+        os_ << "        param->" << name << " = " << value << ";\n";
+    }
+    void Field(const char* name, bool value) {
+        os_ << "        param->" << name << " = " << (value ? "true" : "false") << ";\n";
+    }
+    void Field(const char* name, float value) {
+        os_ << "        param->" << name << " = " << FloatLiteral(value) << ";\n";
+    }
+    void Field(const char* name, const std::string& value) {
+        os_ << "        param->" << name << " = " << StringLiteral(value) << ";\n";
+    }
+    void Field(const char* name, const std::vector<int>& value) {
+        os_ << "        param->" << name << " = {";
+        for (size_t i = 0; i < value.size(); i++) {
+            os_ << (i == 0 ? "" : ", ") << value[i];
+        }
+        os_ << "};\n";
+    }
+    void Field(const char* name, const std::vector<float>& value) {
+        os_ << "        param->" << name << " = {";
+        for (size_t i = 0; i < value.size(); i++) {
+            os_ << (i == 0 ? "" : ", ") << FloatLiteral(value[i]);
+        }
+        os_ << "};\n";
+    }
+    void EnumField(const char* name, const char* enum_name, int value) {
+        os_ << "        param->" << name << " = (" << enum_name << ")" << value << ";\n";
+    }
+
+private:
+    std::ostream& os_;
+};
+
+#define PARAM_FIELD(field) writer.Field(#field, p->field)
+#define PARAM_ENUM_FIELD(field, enum_name) writer.EnumField(#field, #enum_name, (int)p->field)
+
+template <typename T>
+static T* ParamAs(LayerParam* param) {
+    return typeid(*param) == typeid(T) ? static_cast<T*>(param) : nullptr;
+}
+
+// the params are emitted per struct, a param struct not listed here cannot be compiled
+static Status WriteParam(std::ostream& os, LayerParam* param) {
+    if (param == nullptr) {
+        os << "        auto param = std::make_shared<LayerParam>();\n";
+        return TNN_OK;
+    }
+
+    std::ostringstream fields;
+    ParamWriter writer(fields);
+    std::string type_name;
+    if (ParamAs<LayerParam>(param)) {
+        type_name = "LayerParam";
+    } else if (ParamAs<ElementWiseLayerParam>(param)) {
+        type_name = "ElementWiseLayerParam";
+    } else if (auto p = ParamAs<BatchNormLayerParam>(param)) {
+        type_name = "BatchNormLayerParam";
+        PARAM_FIELD(channels);
+        PARAM_FIELD(eps);
+    } else if (auto p = ParamAs<InstanceNormLayerParam>(param)) {
+        type_name = "InstanceNormLayerParam";
+        PARAM_FIELD(channels);
+        PARAM_FIELD(eps);
+    } else if (auto p = ParamAs<ConvLayerParam>(param)) {
+        type_name = "ConvLayerParam";
+        PARAM_FIELD(pad_type);
+        PARAM_FIELD(input_channel);
+        PARAM_FIELD(output_channel);
+        PARAM_FIELD(pads);
+        PARAM_FIELD(kernels);
+        PARAM_FIELD(strides);
+        PARAM_FIELD(dialations);
+        PARAM_FIELD(group);
+        PARAM_FIELD(bias);
+        PARAM_FIELD(activation_type);
+    } else if (auto p = ParamAs<PadLayerParam>(param)) {
+        type_name = "PadLayerParam";
+        PARAM_FIELD(pads);
+        PARAM_FIELD(type);
+        PARAM_FIELD(value);
+    } else if (auto p = ParamAs<PoolingLayerParam>(param)) {
+        type_name = "PoolingLayerParam";
+        PARAM_FIELD(pool_type);
+        PARAM_FIELD(pad_type);
+        PARAM_FIELD(ceil_mode);
+        PARAM_FIELD(pads);
+        PARAM_FIELD(kernels);
+        PARAM_FIELD(kernels_params);
+        PARAM_FIELD(strides);
+        PARAM_FIELD(kernel_indexs);
+    } else if (auto p = ParamAs<UpsampleLayerParam>(param)) {
+        type_name = "UpsampleLayerParam";
+        PARAM_FIELD(mode);
+        PARAM_FIELD(align_corners);
+        PARAM_FIELD(scales);
+        PARAM_FIELD(dims);
+    } else if (auto p = ParamAs<SoftmaxLayerParam>(param)) {
+        type_name = "SoftmaxLayerParam";
+        PARAM_FIELD(axis);
+    } else if (auto p = ParamAs<PowLayerParam>(param)) {
+        type_name = "PowLayerParam";
+        PARAM_FIELD(exponent);
+        PARAM_FIELD(scale);
+        PARAM_FIELD(shift);
+    } else if (auto p = ParamAs<NormalizeLayerParam>(param)) {
+        type_name = "NormalizeLayerParam";
+        PARAM_FIELD(epsilon);
+        PARAM_FIELD(axis);
+        PARAM_FIELD(p);
+        PARAM_FIELD(across_spatial);
+        PARAM_FIELD(channel_shared);
+    } else if (auto p = ParamAs<ReshapeLayerParam>(param)) {
+        type_name = "ReshapeLayerParam";
+        PARAM_FIELD(reshape_type);
+        PARAM_FIELD(axis);
+        PARAM_FIELD(num_axes);
+        PARAM_FIELD(shape);
+    } else if (auto p = ParamAs<PermuteLayerParam>(param)) {
+        type_name = "PermuteLayerParam";
+        PARAM_FIELD(orders);
+    } else if (auto p = ParamAs<ScaleLayerParam>(param)) {
+        type_name = "ScaleLayerParam";
+        PARAM_FIELD(axis);
+        PARAM_FIELD(num_axes);
+        PARAM_FIELD(bias_term);
+    } else if (auto p = ParamAs<SplitVLayerParam>(param)) {
+        type_name = "SplitVLayerParam";
+        PARAM_FIELD(axis);
+        PARAM_FIELD(slices);
+    } else if (dynamic_cast<ReduceLayerParam*>(param)) {
+        auto p = static_cast<ReduceLayerParam*>(param);
+        if (typeid(*param) == typeid(ReduceSumLayerParam)) {
+            type_name = "ReduceSumLayerParam";
+        } else if (typeid(*param) == typeid(ReduceMeanLayerParam)) {
+            type_name = "ReduceMeanLayerParam";
+        } else if (typeid(*param) == typeid(ReduceMaxLayerParam)) {
+            type_name = "ReduceMaxLayerParam";
+        } else {
+            type_name = "ReduceLayerParam";
+        }
+        PARAM_FIELD(keep_dims);
+        PARAM_FIELD(axis);
+        PARAM_FIELD(all_reduce);
+    } else if (auto p = ParamAs<InnerProductLayerParam>(param)) {
+        type_name = "InnerProductLayerParam";
+        PARAM_FIELD(num_output);
+        PARAM_FIELD(has_bias);
+        PARAM_FIELD(transpose);
+        PARAM_FIELD(axis);
+    } else if (auto p = ParamAs<ConcatLayerParam>(param)) {
+        type_name = "ConcatLayerParam";
+        PARAM_FIELD(axis);
+    } else if (auto p = ParamAs<PReluLayerParam>(param)) {
+        type_name = "PReluLayerParam";
+        PARAM_FIELD(channel_shared);
+        PARAM_FIELD(has_filler);
+    } else if (auto p = ParamAs<EluLayerParam>(param)) {
+        type_name = "EluLayerParam";
+        PARAM_FIELD(alpha);
+    } else if (auto p = ParamAs<ClipLayerParam>(param)) {
+        type_name = "ClipLayerParam";
+        PARAM_FIELD(min);
+        PARAM_FIELD(max);
+    } else if (auto p = ParamAs<SeluLayerParam>(param)) {
+        type_name = "SeluLayerParam";
+        PARAM_FIELD(alpha);
+        PARAM_FIELD(gamma);
+    } else if (auto p = ParamAs<StrideSliceLayerParam>(param)) {
+        type_name = "StrideSliceLayerParam";
+        PARAM_FIELD(begins);
+        PARAM_FIELD(ends);
+        PARAM_FIELD(strides);
+    } else if (auto p = ParamAs<SliceLayerParam>(param)) {
+        type_name = "SliceLayerParam";
+        PARAM_FIELD(slices);
+        PARAM_FIELD(axis);
+    } else if (auto p = ParamAs<MultidirBroadcastLayerParam>(param)) {
+        type_name = "MultidirBroadcastLayerParam";
+        PARAM_FIELD(input0_broadcast_type);
+        PARAM_FIELD(input1_broadcast_type);
+        PARAM_FIELD(weight_input_index);
+    } else if (auto p = ParamAs<HardSwishLayerParam>(param)) {
+        type_name = "HardSwishLayerParam";
+        PARAM_FIELD(input0_broadcast_type);
+        PARAM_FIELD(input1_broadcast_type);
+        PARAM_FIELD(weight_input_index);
+        PARAM_FIELD(alpha);
+        PARAM_FIELD(beta);
+    } else if (auto p = ParamAs<HardSigmoidLayerParam>(param)) {
+        type_name = "HardSigmoidLayerParam";
+        PARAM_FIELD(alpha);
+        PARAM_FIELD(beta);
+    } else if (auto p = ParamAs<ReformatLayerParam>(param)) {
+        type_name = "ReformatLayerParam";
+        PARAM_ENUM_FIELD(src_type, DataType);
+        PARAM_ENUM_FIELD(dst_type, DataType);
+        PARAM_ENUM_FIELD(src_format, DataFormat);
+        PARAM_ENUM_FIELD(dst_format, DataFormat);
+        PARAM_ENUM_FIELD(type, ReformatType);
+    } else if (auto p = ParamAs<ShuffleLayerParam>(param)) {
+        type_name = "ShuffleLayerParam";
+        PARAM_FIELD(group);
+    } else if (auto p = ParamAs<LRNLayerParam>(param)) {
+        type_name = "LRNLayerParam";
+        PARAM_FIELD(alpha);
+        PARAM_FIELD(beta);
+        PARAM_FIELD(bias);
+        PARAM_FIELD(size);
+    } else if (auto p = ParamAs<ReorgLayerParam>(param)) {
+        type_name = "ReorgLayerParam";
+        PARAM_FIELD(stride);
+        PARAM_FIELD(reverse);
+    } else if (auto p = ParamAs<SignedMulLayerParam>(param)) {
+        type_name = "SignedMulLayerParam";
+        PARAM_FIELD(alpha);
+        PARAM_FIELD(beta);
+        PARAM_FIELD(gamma);
+    } else if (auto p = ParamAs<SqueezeLayerParam>(param)) {
+        type_name = "SqueezeLayerParam";
+        PARAM_FIELD(axes);
+    } else if (auto p = ParamAs<ArgMaxOrMinLayerParam>(param)) {
+        type_name = "ArgMaxOrMinLayerParam";
+        PARAM_FIELD(mode);
+        PARAM_FIELD(axis);
+        PARAM_FIELD(keep_dims);
+        PARAM_FIELD(select_last_index);
+    } else if (auto p = ParamAs<PixelShuffleLayerParam>(param)) {
+        type_name = "PixelShuffleLayerParam";
+        PARAM_FIELD(upscale_factor);
+    } else if (auto p = ParamAs<LSTMLayerParam>(param)) {
+        type_name = "LSTMLayerParam";
+        PARAM_FIELD(hidden_size);
+        PARAM_FIELD(direction);
+    } else if (auto p = ParamAs<GRULayerParam>(param)) {
+        type_name = "GRULayerParam";
+        PARAM_FIELD(hidden_size);
+        PARAM_FIELD(direction);
+        PARAM_FIELD(linear_before_reset);
+    } else {
+        fprintf(stderr, "tnn2cpp: the param of layer %s (%s) is not supported\n", param->name.c_str(),
+                param->type.c_str());
+        return Status(TNNERR_PARAM_ERR, "tnn2cpp: unsupported layer param");
+    }
+
+    ParamWriter base_writer(os);
+    os << "        auto param = std::make_shared<" << type_name << ">();\n";
+    // the type of the pad and reformat params hides the layer type
+    base_writer.Field("LayerParam::type", param->type);
+    base_writer.Field("name", param->name);
+    base_writer.Field("quantized", param->quantized);
+    os << fields.str();
+    return TNN_OK;
+}
+
+// the weights are emitted as aligned static arrays. the raw weights are copied into the resources at init, the
+// layers may write them, the packed weights are used in place
+class ResourceWriter {
+public:
+    ResourceWriter(std::ostream& weights_os, std::ostream& os) : weights_os_(weights_os), os_(os) {}
+
+    // the expression of a raw buffer of a new array of the bytes of the buffer
+    std::string Array(const char* prefix, RawBuffer& buffer, bool read_only) {
+        if (buffer.GetBytesSize() == 0) {
+            return "RawBuffer()";
+        }
+        std::string var = prefix + std::to_string(array_count_++);
+        weights_os_ << "alignas(64) static const unsigned char " << var << "[] = {";
+        auto data = buffer.force_to<unsigned char*>();
+        char hex[8];
+        for (int i = 0; i < buffer.GetBytesSize(); i++) {
+            snprintf(hex, sizeof(hex), "0x%02x,", data[i]);
+            weights_os_ << (i % 16 == 0 ? "\n    " : "") << hex;
+        }
+        weights_os_ << "\n};\n";
+
+        return std::string(read_only ? "CompiledNetwork::MakeReadOnlyBuffer(" : "CompiledNetwork::MakeBuffer(") +
+               var + ", sizeof(" + var + "), (DataType)" + std::to_string((int)buffer.GetDataType()) + ")";
+    }
+    void Buffer(const char* name, RawBuffer& buffer) {
+        if (buffer.GetBytesSize() == 0 || skip_buffers_) {
+            return;
+        }
+        os_ << "        resource->" << name << " = " << Array("kWeight", buffer, false) << ";\n";
+    }
+    // the raw weights of a layer with packed weights are left out of its resource
+    void SetSkipBuffers(bool skip_buffers) {
+        skip_buffers_ = skip_buffers;
+    }
+    // the packed weights keep their layout, the layer accs pack the weights at init if it is not the one of the
+    // impl they select, e.g. on another arch, which needs the raw weights
+    void PackedBuffers(PackedWeights& packed_weights, bool repackable) {
+        if (packed_weights.buffers.empty()) {
+            os_ << "        packed_weights.push_back(PackedWeights());\n";
+            return;
+        }
+        os_ << "        packed_weights.push_back(PackedWeights(" << StringLiteral(packed_weights.layout) << ", {";
+        for (size_t i = 0; i < packed_weights.buffers.size(); i++) {
+            os_ << (i == 0 ? "" : ", ") << Array("kPacked", packed_weights.buffers[i], true);
+        }
+        os_ << "}, " << (repackable ? "true" : "false") << "));\n";
+    }
+    void Field(const char* name, const std::vector<int>& value) {
+        os_ << "        resource->" << name << " = {";
+        for (size_t i = 0; i < value.size(); i++) {
+            os_ << (i == 0 ? "" : ", ") << value[i];
+        }
+        os_ << "};\n";
+    }
+
+private:
+    std::ostream& weights_os_;
+    std::ostream& os_;
+    int array_count_   = 0;
+    bool skip_buffers_ = false;
+};
+
+#define RESOURCE_BUFFER(field) writer.Buffer(#field, r->field)
+
+template <typename T>
+static T* ResourceAs(LayerResource* resource) {
+    return typeid(*resource) == typeid(T) ? static_cast<T*>(resource) : nullptr;
+}
+
+static Status WriteResource(ResourceWriter& writer, std::ostream& os, const std::string& layer_name,
+                            LayerResource* resource) {
+    if (resource == nullptr) {
+        os << "        std::shared_ptr<LayerResource> resource;\n";
+        return TNN_OK;
+    }
+
+    if (auto r = ResourceAs<ConvLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<ConvLayerResource>();\n";
+        RESOURCE_BUFFER(filter_handle);
+        RESOURCE_BUFFER(bias_handle);
+        RESOURCE_BUFFER(scale_handle);
+    } else if (auto r = ResourceAs<InnerProductLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<InnerProductLayerResource>();\n";
+        RESOURCE_BUFFER(weight_handle);
+        RESOURCE_BUFFER(bias_handle);
+        RESOURCE_BUFFER(scale_handle);
+    } else if (auto r = ResourceAs<BatchNormLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<BatchNormLayerResource>();\n";
+        RESOURCE_BUFFER(scale_handle);
+        RESOURCE_BUFFER(bias_handle);
+    } else if (auto r = ResourceAs<InstanceNormLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<InstanceNormLayerResource>();\n";
+        RESOURCE_BUFFER(scale_handle);
+        RESOURCE_BUFFER(bias_handle);
+    } else if (auto r = ResourceAs<EltwiseLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<EltwiseLayerResource>();\n";
+        RESOURCE_BUFFER(element_handle);
+        writer.Field("element_shape", r->element_shape);
+    } else if (auto r = ResourceAs<PReluLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<PReluLayerResource>();\n";
+        RESOURCE_BUFFER(slope_handle);
+    } else if (auto r = ResourceAs<ConstLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<ConstLayerResource>();\n";
+        RESOURCE_BUFFER(weight_handle);
+    } else if (auto r = ResourceAs<RecurrentLayerResource>(resource)) {
+        os << "        auto resource = std::make_shared<RecurrentLayerResource>();\n";
+        RESOURCE_BUFFER(weight_handle);
+        RESOURCE_BUFFER(recurrence_handle);
+        RESOURCE_BUFFER(bias_handle);
+    } else {
+        fprintf(stderr, "tnn2cpp: the resource of layer %s is not supported\n", layer_name.c_str());
+        return Status(TNNERR_PARAM_ERR, "tnn2cpp: unsupported layer resource");
+    }
+    return TNN_OK;
+}
+
+/*
+ * The network is initialized once with the interpreter, the optimizer and the memory planner. The
+ * resolved layers, blob descs, blob offsets and weights are emitted, so the generated network only
+ * creates the layer accs and runs them.
+ */
+static Status GenerateCpp(const char* proto_path, const char* model_path, const char* cpp_path,
+                          DeviceType device_type, Precision precision, bool keep_raw_weights) {
+    std::string proto_content, model_content;
+    if (!ReadFile(proto_path, proto_content) || !ReadFile(model_path, model_content)) {
+        return Status(TNNERR_FIND_MODEL, "tnn2cpp: open model failed");
+    }
+
+    std::shared_ptr<AbstractModelInterpreter> interpreter(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return Status(TNNERR_NET_ERR, "tnn2cpp: create interpreter failed");
+    }
+    std::vector<std::string> params = {proto_content, model_content};
+    RETURN_ON_NEQ(interpreter->Interpret(params), TNN_OK);
+
+    NetworkConfig net_config;
+    net_config.device_type       = device_type;
+    net_config.precision         = precision;
+    net_config.share_memory_mode = SHARE_MEMORY_MODE_SET_FROM_EXTERNAL;
+    ModelConfig model_config;
+
+    DefaultNetwork network;
+    RETURN_ON_NEQ(network.Init(net_config, model_config, interpreter.get(), InputShapesMap()), TNN_OK);
+
+    int memory_size = 0;
+    RETURN_ON_NEQ(network.GetForwardMemorySize(memory_size), TNN_OK);
+    // the offsets of the blobs are taken from the planned memory, it is never touched here
+    std::vector<char> memory(memory_size + 1);
+    RETURN_ON_NEQ(network.SetForwardMemory(memory.data()), TNN_OK);
+
+    NetStructure* net_structure = network.GetNetStructure();
+    NetResource* net_resource   = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetResource();
+    if (GetQuantizedInfoFromNetStructure(net_structure)) {
+        return Status(TNNERR_PARAM_ERR, "tnn2cpp: quantized models are not supported");
+    }
+
+    std::map<std::string, PackedWeights> packed_weights;
+    RETURN_ON_NEQ(network.GetPackedWeights(packed_weights), TNN_OK);
+
+    BlobMap all_blobs;
+    RETURN_ON_NEQ(network.GetAllBlobs(all_blobs), TNN_OK);
+    // the blobs removed by the optimizer are left in the net structure without memory
+    BlobMap blobs;
+    for (auto& layer_info : net_structure->layers) {
+        for (auto& name : layer_info->inputs) {
+            blobs[name] = all_blobs[name];
+        }
+        for (auto& name : layer_info->outputs) {
+            blobs[name] = all_blobs[name];
+        }
+    }
+
+    std::ostringstream blob_os;
+    std::map<std::string, int> blob_indexes;
+    for (auto& iter : blobs) {
+        auto& desc = iter.second->GetBlobDesc();
+        if ((int)desc.dims.size() > kCompiledMaxDims) {
+            return Status(TNNERR_PARAM_ERR, "tnn2cpp: too many dims of blob " + iter.first);
+        }
+        auto offset = (char*)iter.second->GetHandle().base + iter.second->GetHandle().bytes_offset - memory.data();
+        blob_os << "    {" << StringLiteral(iter.first) << ", {";
+        for (size_t i = 0; i < desc.dims.size(); i++) {
+            blob_os << (i == 0 ? "" : ", ") << desc.dims[i];
+        }
+        blob_os << "}, " << desc.dims.size() << ", (DataType)" << desc.data_type << ", (DataFormat)" << desc.data_format
+                << ", " << offset << "},\n";
+        int index                = (int)blob_indexes.size();
+        blob_indexes[iter.first] = index;
+    }
+
+    // the layers fall back to the same device as in DefaultNetwork
+    auto device          = GetDevice(device_type);
+    auto fallback_device = optimizer::NetOptimizerInsertFallbackReformat::GetFallbackDevice(net_config, net_structure);
+
+    std::ostringstream layer_os, layer_blob_os, init_os, weights_os;
+    ResourceWriter resource_writer(weights_os, init_os);
+    int layer_blob_count = 0;
+    for (auto& layer_info : net_structure->layers) {
+        auto type                = layer_info->type;
+        DeviceType layer_device  = device_type;
+        if (optimizer::NetOptimizerInsertFallbackReformat::IsFallbackLayer(device, fallback_device, type)) {
+            layer_device = fallback_device->GetDeviceType();
+        }
+
+        int inputs_begin = layer_blob_count;
+        for (auto& name : layer_info->inputs) {
+            layer_blob_os << (layer_blob_count++ % 16 == 0 ? "\n    " : " ") << blob_indexes[name] << ",";
+        }
+        int outputs_begin = layer_blob_count;
+        for (auto& name : layer_info->outputs) {
+            layer_blob_os << (layer_blob_count++ % 16 == 0 ? "\n    " : " ") << blob_indexes[name] << ",";
+        }
+        layer_os << "    {(LayerType)" << type << ", " << StringLiteral(layer_info->name) << ", (DeviceType)"
+                 << layer_device << ", " << inputs_begin << ", " << layer_info->inputs.size() << ", "
+                 << outputs_begin << ", " << layer_info->outputs.size() << "},\n";
+
+        init_os << "    {\n";
+        RETURN_ON_NEQ(WriteParam(init_os, layer_info->param.get()), TNN_OK);
+        init_os << "        params.push_back(param);\n";
+        auto resource         = GetLayerResource(net_resource, layer_info->name);
+        auto& layer_packed    = packed_weights[layer_info->name];
+        bool skip_raw_weights = !keep_raw_weights && !layer_packed.buffers.empty();
+        resource_writer.SetSkipBuffers(skip_raw_weights);
+        RETURN_ON_NEQ(WriteResource(resource_writer, init_os, layer_info->name, resource.get()), TNN_OK);
+        init_os << "        resources.push_back(resource);\n";
+        resource_writer.PackedBuffers(layer_packed, !skip_raw_weights);
+        init_os << "    }\n";
+    }
+    if (layer_blob_count == 0) {
+        layer_blob_os << "\n    0,";
+    }
+
+    std::string varname = PathtoVarname(proto_path);
+    std::ofstream os(cpp_path);
+    if (!os) {
+        return Status(TNNERR_PACK_MODEL, "tnn2cpp: open output failed");
+    }
+    os << "// generated by tnn2cpp from " << proto_path << ", do not edit\n\n";
+    os << "#include <limits>\n\n";
+    os << "#include \"tnn/core/compiled_network.h\"\n\n";
+    os << "namespace TNN_NS {\n\n";
+    os << "// name, dims, dims size, data type, data format, offset in the forward memory\n";
+    os << "static constexpr CompiledBlobInfo kBlobs[] = {\n" << blob_os.str() << "};\n\n";
+    os << "static constexpr int kLayerBlobs[] = {" << layer_blob_os.str() << "\n};\n\n";
+    os << "// type, name, device type, inputs begin, inputs count, outputs begin, outputs count\n";
+    os << "static constexpr CompiledLayerInfo kLayers[] = {\n" << layer_os.str() << "};\n\n";
+    os << "static constexpr size_t kMemorySize = " << memory_size << ";\n\n";
+    os << weights_os.str() << "\n";
+    os << "Status Init_" << varname << "(CompiledNetwork &network) {\n";
+    os << "    std::vector<std::shared_ptr<LayerParam>> params;\n";
+    os << "    std::vector<std::shared_ptr<LayerResource>> resources;\n";
+    os << "    std::vector<PackedWeights> packed_weights;\n";
+    os << init_os.str();
+    os << "    CompiledNetInfo info = {(DeviceType)" << device_type << ", (Precision)" << precision
+       << ", kMemorySize, kBlobs, " << blob_indexes.size() << ", kLayers, " << net_structure->layers.size()
+       << ", kLayerBlobs};\n";
+    os << "    return network.Init(info, params, resources, packed_weights);\n";
+    os << "}\n\n";
+    os << "}  // namespace TNN_NS\n";
+    return TNN_OK;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4 || argc > 7) {
+        fprintf(stderr, "Usage: %s [tnnproto] [tnnmodel] [cpppath] [device_type: ARM|X86|NAIVE, default ARM] "
+                        "[precision: AUTO|HIGH|NORMAL|LOW, default AUTO] "
+                        "[raw weights of the packed layers: DROP|KEEP, default DROP]\n", argv[0]);
+        return -1;
+    }
+
+    DeviceType device_type = DEVICE_ARM;
+    if (argc > 4) {
+        std::string device = argv[4];
+        if (device == "X86") {
+            device_type = DEVICE_X86;
+        } else if (device == "NAIVE") {
+            device_type = DEVICE_NAIVE;
+        } else if (device != "ARM") {
+            fprintf(stderr, "tnn2cpp: unsupported device type %s\n", argv[4]);
+            return -1;
+        }
+    }
+    Precision precision = PRECISION_AUTO;
+    if (argc > 5) {
+        std::string value = argv[5];
+        if (value == "HIGH") {
+            precision = PRECISION_HIGH;
+        } else if (value == "NORMAL") {
+            precision = PRECISION_NORMAL;
+        } else if (value == "LOW") {
+            precision = PRECISION_LOW;
+        } else if (value != "AUTO") {
+            fprintf(stderr, "tnn2cpp: unsupported precision %s\n", argv[5]);
+            return -1;
+        }
+    }
+
+    // the raw weights are only needed to pack the weights again if the packed ones do not fit, e.g. on another arch
+    bool keep_raw_weights = false;
+    if (argc > 6) {
+        std::string value = argv[6];
+        if (value == "KEEP") {
+            keep_raw_weights = true;
+        } else if (value != "DROP") {
+            fprintf(stderr, "tnn2cpp: unsupported raw weights option %s\n", argv[6]);
+            return -1;
+        }
+    }
+
+    Status ret = GenerateCpp(argv[1], argv[2], argv[3], device_type, precision, keep_raw_weights);
+    if (ret != TNN_OK) {
+        fprintf(stderr, "tnn2cpp failed: %s\n", ret.description().c_str());
+        return -1;
+    }
+    return 0;
+}